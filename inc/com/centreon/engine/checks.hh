@@ -22,6 +22,7 @@
 #  define CCE_CHECKS_HH
 
 #  include <sys/time.h>
+#  include "com/centreon/engine/namespace.hh"
 #  include "com/centreon/engine/objects/contact.hh"
 #  include "com/centreon/engine/objects/host.hh"
 #  include "com/centreon/engine/objects/service.hh"
@@ -115,6 +116,8 @@ int is_service_result_fresh(
       service* temp_service,
       time_t current_time,
       int log_this);
+// updates the freshness and orphan deadlines of a service
+void update_service_check_deadlines(service* svc);
 // checks host dependencie
 unsigned int check_host_dependencies(
                host* hst,
@@ -128,6 +131,8 @@ int is_host_result_fresh(
       host* temp_host,
       time_t current_time,
       int log_this);
+// updates the freshness and orphan deadlines of a host
+void update_host_check_deadlines(host* hst);
 
 // Route/Host Check Functions
 int perform_on_demand_host_check(
@@ -186,6 +191,24 @@ int determine_host_reachability(host* hst);
 
 #  ifdef __cplusplus
 }
+
+CCE_BEGIN()
+
+namespace checks {
+  class queued_result;
+}
+
+CCE_END()
+
+// handles a check result queued by the checker, queued can be NULL
+int handle_async_service_check_result(
+      service* temp_service,
+      check_result* queued_check_result,
+      com::centreon::engine::checks::queued_result* queued);
+int handle_async_host_check_result_3x(
+      host* temp_host,
+      check_result* queued_check_result,
+      com::centreon::engine::checks::queued_result* queued);
 #  endif // C++
 
 #endif // !CCE_CHECKS_HH
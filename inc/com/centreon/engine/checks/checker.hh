@@ -21,11 +21,16 @@
 #  define CCE_CHECKS_CHECKER_HH
 
 #  include <queue>
+#  include <vector>
+#  include "com/centreon/concurrency/condvar.hh"
 #  include "com/centreon/concurrency/mutex.hh"
+#  include "com/centreon/concurrency/thread.hh"
 #  include "com/centreon/engine/checks.hh"
+#  include "com/centreon/engine/checks/queued_result.hh"
 #  include "com/centreon/engine/commands/command.hh"
 #  include "com/centreon/engine/commands/command_listener.hh"
 #  include "com/centreon/engine/commands/result.hh"
+#  include "com/centreon/engine/mpsc_queue.hh"
 #  include "com/centreon/engine/namespace.hh"
 #  include "com/centreon/engine/objects/host.hh"
 #  include "com/centreon/engine/objects/service.hh"
@@ -39,15 +44,25 @@ namespace                checks {
    *  @brief Run object and reap the result.
    *
    *  Checker is a singleton to run host or service and reap the
-   *  result.
+   *  result. On-demand host checks are not waited for, callers can
+   *  register continuations that are run once the state of the host
+   *  has been processed. Aggressive host checking still waits for
+   *  them with run_sync().
    */
   class                  checker
     : public commands::command_listener {
   public:
+    typedef void         (*host_callback)(host* hst, void* arg);
+
+    void                 add_host_continuation(
+                           host* hst,
+                           host_callback callback,
+                           void* arg);
     static checker&      instance();
     static void          load();
     void                 push_check_result(
                            check_result const& result);
+    void                 push_check_result(queued_result* result);
     void                 reap();
     bool                 reaper_is_empty();
     void                 run(
@@ -66,6 +81,13 @@ namespace                checks {
                            bool reschedule_check = false,
                            int* time_is_valid = NULL,
                            time_t* preferred_time = NULL);
+    void                 run_host_continuations(host* hst);
+    bool                 run_on_demand(
+                           host* hst,
+                           int* check_result_code,
+                           int check_options,
+                           int use_cached_result,
+                           unsigned long check_timestamp_horizon);
     void                 run_sync(
                            host* hst,
                            int* check_result_code,
@@ -75,20 +97,79 @@ namespace                checks {
     static void          unload();
 
   private:
+    class                parser : public concurrency::thread {
+    public:
+                         parser(checker* c);
+                         ~parser() throw ();
+      void               push(queued_result* result);
+      void               quit();
+
+    private:
+                         parser(parser const& right);
+      parser&            operator=(parser const& right);
+      void               _run();
+
+      checker*           _c;
+      concurrency::condvar
+                         _cv;
+      concurrency::mutex _lock;
+      std::queue<queued_result*>
+                         _queue;
+      bool               _quit;
+    };
+
+    struct               host_continuation {
+      void*              arg;
+      host_callback      callback;
+    };
+
+    struct               partial_result {
+      unsigned long      command_id;
+      int                early_timeout;
+      int                exited_ok;
+      timeval            finish_time;
+      char*              output;
+      int                return_code;
+      partial_result*    next;
+    };
+
                          checker();
                          checker(checker const& right);
                          ~checker() throw ();
     checker&             operator=(checker const& right);
     void                 finished(commands::result const& res) throw ();
+    void                 _cancel_host_continuations();
     int                  _execute_sync(host* hst);
+    void                 _run(
+                           host* hst,
+                           int check_options,
+                           double latency,
+                           bool scheduled_check,
+                           bool reschedule_check,
+                           int* time_is_valid,
+                           time_t* preferred_time,
+                           int use_cached_result,
+                           unsigned long check_timestamp_horizon);
+    void                 _start_parsers(unsigned int count);
+    void                 _stop_parsers();
 
-    umap<unsigned long, check_result>
+    concurrency::condvar _cv_parsed;
+    umultimap<host*, host_continuation>
+                         _host_continuations;
+    unsigned int         _host_continuations_generation;
+    umap<unsigned long, queued_result*>
                          _list_id;
     concurrency::mutex   _mut_reap;
-    std::queue<check_result>
+    std::queue<queued_result*>
+                         _parsed;
+    std::vector<parser*> _parsers;
+    unsigned int         _parsing;
+    mpsc_queue<partial_result>
+                         _partials;
+    mpsc_queue<queued_result>
+                         _results;
+    std::queue<queued_result*>
                          _to_reap;
-    umap<unsigned long, check_result>
-                         _to_reap_partial;
   };
 }
 
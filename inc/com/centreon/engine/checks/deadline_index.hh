@@ -0,0 +1,141 @@
+/*
+** Copyright 2017 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CCE_CHECKS_DEADLINE_INDEX_HH
+#  define CCE_CHECKS_DEADLINE_INDEX_HH
+
+#  include <cstddef>
+#  include <ctime>
+#  include <map>
+#  include "com/centreon/engine/namespace.hh"
+#  include "com/centreon/unordered_hash.hh"
+
+CCE_BEGIN()
+
+namespace               checks {
+  /**
+   *  @class deadline_index deadline_index.hh
+   *  @brief Objects sorted by the time they must be looked at again.
+   *
+   *  Each object has at most one deadline. Periodic checks (freshness,
+   *  orphans) pop the objects whose deadline has passed instead of
+   *  walking all the objects.
+   */
+  template              <typename T>
+  class                 deadline_index {
+  public:
+                        deadline_index() {}
+                        ~deadline_index() throw () {}
+
+    /**
+     *  Remove all the objects.
+     */
+    void                clear() {
+      _deadlines.clear();
+      _position.clear();
+      return ;
+    }
+
+    /**
+     *  Check if the index is empty.
+     *
+     *  @return True if no object has a deadline.
+     */
+    bool                empty() const throw () {
+      return (_deadlines.empty());
+    }
+
+    /**
+     *  Remove the deadline of an object.
+     *
+     *  @param[in] obj  Object, nothing is done if it has no deadline.
+     */
+    void                erase(T* obj) {
+      typename position_map::iterator it(_position.find(obj));
+      if (it != _position.end()) {
+        _deadlines.erase(it->second);
+        _position.erase(it);
+      }
+      return ;
+    }
+
+    /**
+     *  Pop the object with the earliest passed deadline.
+     *
+     *  @param[in]  now  Current time, deadlines lower or equal have
+     *                   passed.
+     *  @param[out] obj  Object whose deadline has passed.
+     *
+     *  @return True if an object was popped.
+     */
+    bool                pop(time_t now, T*& obj) {
+      typename deadline_map::iterator it(_deadlines.begin());
+      if ((it == _deadlines.end()) || (it->first > now))
+        return (false);
+      obj = it->second;
+      _position.erase(obj);
+      _deadlines.erase(it);
+      return (true);
+    }
+
+    /**
+     *  Set the deadline of an object, replacing its previous one.
+     *
+     *  @param[in] obj       Object.
+     *  @param[in] deadline  Time the object must be looked at again.
+     */
+    void                set(T* obj, time_t deadline) {
+      typename position_map::iterator it(_position.find(obj));
+      if (it != _position.end()) {
+        if (it->second->first == deadline)
+          return ;
+        _deadlines.erase(it->second);
+        it->second = _deadlines.insert(std::make_pair(deadline, obj));
+      }
+      else
+        _position[obj] = _deadlines.insert(std::make_pair(deadline, obj));
+      return ;
+    }
+
+    /**
+     *  Get the number of objects with a deadline.
+     *
+     *  @return Number of objects.
+     */
+    std::size_t         size() const throw () {
+      return (_deadlines.size());
+    }
+
+  private:
+    typedef std::multimap<time_t, T*>
+                        deadline_map;
+    typedef umap<T*, typename deadline_map::iterator>
+                        position_map;
+
+                        deadline_index(deadline_index const& right);
+    deadline_index&     operator=(deadline_index const& right);
+
+    deadline_map        _deadlines;
+    position_map        _position;
+  };
+}
+
+CCE_END()
+
+#endif // !CCE_CHECKS_DEADLINE_INDEX_HH
@@ -0,0 +1,64 @@
+/*
+** Copyright 2017 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CCE_CHECKS_QUEUED_RESULT_HH
+#  define CCE_CHECKS_QUEUED_RESULT_HH
+
+#  include "com/centreon/engine/checks.hh"
+#  include "com/centreon/engine/namespace.hh"
+#  include "com/centreon/engine/objects/host.hh"
+#  include "com/centreon/engine/objects/service.hh"
+
+CCE_BEGIN()
+
+namespace                checks {
+  /**
+   *  @class queued_result queued_result.hh "com/centreon/engine/checks/queued_result.hh"
+   *  @brief Check result waiting to be reaped.
+   *
+   *  The check_result structure is shared with modules and must keep
+   *  its layout. Data only used by the engine while a result goes
+   *  through the checker is kept beside it.
+   */
+  class                  queued_result {
+  public:
+                         queued_result();
+                         ~queued_result() throw ();
+
+    check_result         cr;
+    unsigned long        check_timestamp_horizon;
+    host*                host_ptr;
+    char*                long_output;
+    queued_result*       next;
+    unsigned int         object_generation;
+    bool                 output_parsed;
+    char*                perf_data;
+    service*             service_ptr;
+    char*                short_output;
+    bool                 use_cached_result;
+
+  private:
+                         queued_result(queued_result const& right);
+    queued_result&       operator=(queued_result const& right);
+  };
+}
+
+CCE_END()
+
+#endif // !CCE_CHECKS_QUEUED_RESULT_HH
@@ -36,7 +36,8 @@
 #  define EXTERNAL_COMMAND_STATS               8
 #  define PARALLEL_HOST_CHECK_STATS            9
 #  define SERIAL_HOST_CHECK_STATS              10
-#  define MAX_CHECK_STATS_TYPES                11
+#  define REAPED_CHECK_RESULT_STATS            11
+#  define MAX_CHECK_STATS_TYPES                12
 #  define CHECK_STATS_BUCKETS                  15
 
 /**
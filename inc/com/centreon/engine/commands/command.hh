@@ -25,6 +25,7 @@
 #  include "com/centreon/engine/commands/command_listener.hh"
 #  include "com/centreon/engine/commands/result.hh"
 #  include "com/centreon/engine/macros/defines.hh"
+#  include "com/centreon/engine/macros/plan.hh"
 #  include "com/centreon/engine/namespace.hh"
 
 CCE_BEGIN()
@@ -35,7 +36,9 @@ namespace                      commands {
    *  @brief Execute command and send the result.
    *
    *  Command execute a command line with their arguments and
-   *  notify listener at the end of the command.
+   *  notify listener at the end of the command. The command line is
+   *  compiled once so that processing it only computes the macros it
+   *  references.
    */
   class                        command {
   public:
@@ -75,6 +78,7 @@ namespace                      commands {
     std::string                _command_line;
     command_listener*          _listener;
     std::string                _name;
+    macros::plan               _plan;
   };
 }
 
@@ -45,6 +45,7 @@ namespace        commands {
     void         add(char const* name, char const* value);
     void         add(std::string const& line);
     void         add(std::string const& name, std::string const& value);
+    void         add(environment const& right);
     char**       data() throw ();
 
   private:
@@ -51,11 +51,18 @@ namespace               commands {
                         raw(raw const& right);
                         ~raw() throw ();
     raw&                operator=(raw const& right);
+    static void         build_environment_macros(
+                          nagios_macros& macros,
+                          environment& env);
     command*            clone() const;
     unsigned long       run(
                           std::string const& process_cmd,
                           nagios_macros& macros,
                           unsigned int timeout);
+    unsigned long       run(
+                          std::string const& process_cmd,
+                          environment& env,
+                          unsigned int timeout);
     void                run(
                           std::string const& process_cmd,
                           nagios_macros& macros,
@@ -69,25 +76,26 @@ namespace               commands {
     static void         _build_argv_macro_environment(
                           nagios_macros const& macros,
                           environment& env);
-    static void         _build_contact_address_environment(
-                          nagios_macros const& macros,
-                          environment& env);
-    static void         _build_custom_contact_macro_environment(
-                          nagios_macros& macros,
-                          environment& env);
-    static void         _build_custom_host_macro_environment(
-                          nagios_macros& macros,
+    static void         _build_constant_macrosx_environment(
                           environment& env);
-    static void         _build_custom_service_macro_environment(
-                          nagios_macros& macros,
+    static void         _build_contact_environment(
+                          contact const& cntct,
                           environment& env);
-    static void         _build_environment_macros(
-                          nagios_macros& macros,
+    static void         _build_custom_macro_environment(
+                          char const* prefix,
+                          customvariablesmember const* vars,
                           environment& env);
     static void         _build_macrosx_environment(
                           nagios_macros& macros,
                           environment& env);
+    static environment const&
+                        _get_object_environment(host const& hst);
+    static environment const&
+                        _get_object_environment(service const& svc);
+    static environment const&
+                        _get_object_environment(contact const& cntct);
     process*            _get_free_process();
+    static void         _update_environment_cache();
 
     concurrency::mutex  _lock;
     umap<process*, unsigned long>
@@ -0,0 +1,134 @@
+/*
+** Copyright 2017 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CCE_COMMANDS_SYSTEM_RUNNER_HH
+#  define CCE_COMMANDS_SYSTEM_RUNNER_HH
+
+#  include <deque>
+#  include <string>
+#  include <sys/time.h>
+#  include "com/centreon/concurrency/mutex.hh"
+#  include "com/centreon/engine/commands/command_listener.hh"
+#  include "com/centreon/engine/commands/environment.hh"
+#  include "com/centreon/engine/commands/raw.hh"
+#  include "com/centreon/engine/commands/result.hh"
+#  include "com/centreon/engine/macros/defines.hh"
+#  include "com/centreon/engine/namespace.hh"
+#  include "com/centreon/unordered_hash.hh"
+
+CCE_BEGIN()
+
+namespace               commands {
+  /**
+   *  @class system_runner system_runner.hh
+   *  @brief Run notification, event handler, obsessive compulsive
+   *         and performance data commands.
+   *
+   *  System runner is a singleton that executes the commands that
+   *  are not checks. When asynchronous system commands are enabled,
+   *  commands are started without blocking the main loop (within
+   *  the limit of each category) and their callbacks are executed
+   *  by reap(), in submission order inside a category. Otherwise
+   *  commands are executed synchronously.
+   */
+  class                 system_runner : public command_listener {
+  public:
+    enum                category {
+      notification = 0,
+      event_handler,
+      obsessive_command,
+      perfdata_command,
+      category_num
+    };
+
+    /**
+     *  @class callback system_runner.hh
+     *  @brief Called on the main thread when a command is over.
+     */
+    class               callback {
+    public:
+      virtual           ~callback() throw () {}
+      virtual void      finished(result const& res) throw () = 0;
+    };
+
+    /**
+     *  @class timeout_warning system_runner.hh
+     *  @brief Log a warning if a command timed out.
+     */
+    class               timeout_warning : public callback {
+    public:
+                        timeout_warning(std::string const& message);
+                        ~timeout_warning() throw ();
+      void              finished(result const& res) throw ();
+
+    private:
+      std::string       _message;
+    };
+
+    static system_runner&
+                        instance();
+    static void         load();
+    void                reap();
+    void                run(
+                          category c,
+                          std::string const& processed_cmd,
+                          nagios_macros& macros,
+                          unsigned int timeout,
+                          callback* cb);
+    static void         unload();
+
+  private:
+    struct              job {
+      category          cat;
+      callback*         cb;
+      std::string       cmd;
+      unsigned long     command_id;
+      bool              done;
+      environment       env;
+      result            res;
+      timeval           start_time;
+      unsigned int      timeout;
+    };
+
+                        system_runner();
+                        system_runner(system_runner const& right);
+                        ~system_runner() throw ();
+    system_runner&      operator=(system_runner const& right);
+    void                finished(result const& res) throw ();
+    static void         _broker_start(job const& j);
+    void                _collect();
+    void                _dispatch(job* j);
+    static unsigned int _limit(category c);
+    void                _start(job* j);
+
+    std::deque<job*>    _jobs[category_num];
+    concurrency::mutex  _lock;
+    umap<unsigned long, result>
+                        _finished;
+    unsigned int        _running[category_num];
+    umap<unsigned long, job*>
+                        _started;
+    std::deque<job*>    _waiting[category_num];
+    raw                 _raw;
+  };
+}
+
+CCE_END()
+
+#endif // !CCE_COMMANDS_SYSTEM_RUNNER_HH
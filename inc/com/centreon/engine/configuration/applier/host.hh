@@ -22,6 +22,9 @@
 
 #  include "com/centreon/engine/namespace.hh"
 
+// Forward declaration.
+struct             host_struct;
+
 CCE_BEGIN()
 
 namespace          configuration {
@@ -45,6 +48,10 @@ namespace          configuration {
                      configuration::host const& obj);
       void         resolve_object(
                      configuration::host const& obj);
+
+    private:
+      static void  _add_address(host_struct* h);
+      static void  _remove_address(host_struct* h);
     };
   }
 }
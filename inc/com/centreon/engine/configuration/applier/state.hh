@@ -71,6 +71,7 @@ namespace           configuration {
                       configuration::state& new_cfg,
                       retention::state& state,
                       bool waiting_thread = false);
+      unsigned int  generation() const throw ();
       static state& instance();
       static void   load();
       static void   unload();
@@ -115,6 +116,11 @@ namespace           configuration {
                     hosts_find(configuration::host::key_type const& k) const;
       umap<std::string, shared_ptr<host_struct> >::iterator
                     hosts_find(configuration::host::key_type const& k);
+      umultimap<std::string, host_struct*> const&
+                    hosts_by_address() const throw ();
+      umultimap<std::string, host_struct*>&
+                    hosts_by_address() throw ();
+      host_struct*  hosts_find_by_address(std::string const& address) const;
       umultimap<std::string, shared_ptr<hostdependency_struct> > const&
                     hostdependencies() const throw ();
       umultimap<std::string, shared_ptr<hostdependency_struct> >&
@@ -200,9 +206,11 @@ namespace           configuration {
                     ~state() throw ();
       state&        operator=(state const&);
       void          _apply(configuration::state const& new_cfg);
-      template      <typename ConfigurationType, typename ApplierType>
+      template      <typename ConfigurationType,
+                     typename ApplierType,
+                     typename ConfigurationSet>
       void          _apply(
-                      difference<std::set<ConfigurationType> > const& diff);
+                      difference<ConfigurationSet> const& diff);
       void          _apply(
                       configuration::state& new_cfg,
                       retention::state& state);
@@ -213,9 +221,9 @@ namespace           configuration {
                       bool waiting_thread,
                       retention::state* state = NULL);
       template      <typename ConfigurationType,
-                     typename ApplierType>
-      void          _resolve(
-                      std::set<ConfigurationType>& cfg);
+                     typename ApplierType,
+                     typename SetType>
+      void          _resolve(SetType& cfg);
 
       state*        _config;
 
@@ -229,8 +237,11 @@ namespace           configuration {
                     _contactgroups;
       concurrency::condvar
                     _cv_lock;
+      unsigned int  _generation;
       umap<std::string, shared_ptr<host_struct> >
                     _hosts;
+      umultimap<std::string, host_struct*>
+                    _hosts_by_address;
       umultimap<std::string, shared_ptr<hostdependency_struct> >
                     _hostdependencies;
       umultimap<std::string, shared_ptr<hostescalation_struct> >
@@ -22,6 +22,7 @@
 
 #  include <set>
 #  include <string>
+#  include "com/centreon/engine/configuration/indexed_set.hh"
 #  include "com/centreon/engine/configuration/object.hh"
 #  include "com/centreon/engine/namespace.hh"
 
@@ -46,6 +47,7 @@ namespace                  configuration {
     key_type const&        key() const throw ();
     void                   merge(object const& obj);
     bool                   parse(char const* key, char const* value);
+    static bool            sorted_setters() throw ();
 
     std::string const&     command_line() const throw ();
     std::string const&     command_name() const throw ();
@@ -66,8 +68,8 @@ namespace                  configuration {
     static setters const   _setters[];
   };
 
-  typedef shared_ptr<command> command_ptr;
-  typedef std::set<command>   set_command;
+  typedef shared_ptr<command>  command_ptr;
+  typedef indexed_set<command> set_command;
 }
 
 CCE_END()
@@ -23,6 +23,7 @@
 #  include <set>
 #  include <string>
 #  include "com/centreon/engine/commands/connector.hh"
+#  include "com/centreon/engine/configuration/indexed_set.hh"
 #  include "com/centreon/engine/configuration/object.hh"
 #  include "com/centreon/engine/namespace.hh"
 
@@ -47,6 +48,7 @@ namespace                  configuration {
     key_type const&        key() const throw ();
     void                   merge(object const& obj);
     bool                   parse(char const* key, char const* value);
+    static bool            sorted_setters() throw ();
 
     std::string const&     connector_line() const throw ();
     std::string const&     connector_name() const throw ();
@@ -65,8 +67,8 @@ namespace                  configuration {
     static setters const   _setters[];
   };
 
-  typedef shared_ptr<connector> connector_ptr;
-  typedef std::set<connector>   set_connector;
+  typedef shared_ptr<connector>  connector_ptr;
+  typedef indexed_set<connector> set_connector;
 }
 
 CCE_END()
@@ -24,6 +24,7 @@
 #  include <string>
 #  include <vector>
 #  include "com/centreon/engine/configuration/group.hh"
+#  include "com/centreon/engine/configuration/indexed_set.hh"
 #  include "com/centreon/engine/configuration/object.hh"
 #  include "com/centreon/engine/objects/customvariable.hh"
 #  include "com/centreon/engine/opt.hh"
@@ -52,6 +53,7 @@ namespace                  configuration {
     key_type const&        key() const throw ();
     void                   merge(object const& obj);
     bool                   parse(char const* key, char const* value);
+    static bool            sorted_setters() throw ();
 
     tab_string const&      address() const throw ();
     std::string const&     alias() const throw ();
@@ -123,8 +125,8 @@ namespace                  configuration {
     static setters const   _setters[];
   };
 
-  typedef shared_ptr<contact> contact_ptr;
-  typedef std::set<contact>   set_contact;
+  typedef shared_ptr<contact>  contact_ptr;
+  typedef indexed_set<contact> set_contact;
 }
 
 CCE_END()
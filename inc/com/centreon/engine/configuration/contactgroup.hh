@@ -22,6 +22,7 @@
 
 #  include <set>
 #  include "com/centreon/engine/configuration/group.hh"
+#  include "com/centreon/engine/configuration/indexed_set.hh"
 #  include "com/centreon/engine/configuration/object.hh"
 #  include "com/centreon/engine/opt.hh"
 #  include "com/centreon/engine/namespace.hh"
@@ -47,6 +48,7 @@ namespace                  configuration {
     key_type const&        key() const throw ();
     void                   merge(object const& obj);
     bool                   parse(char const* key, char const* value);
+    static bool            sorted_setters() throw ();
 
     std::string const&     alias() const throw ();
     set_string&            contactgroup_members() throw ();
@@ -73,8 +75,8 @@ namespace                  configuration {
     static setters const   _setters[];
   };
 
-  typedef shared_ptr<contactgroup> contactgroup_ptr;
-  typedef std::set<contactgroup>   set_contactgroup;
+  typedef shared_ptr<contactgroup>  contactgroup_ptr;
+  typedef indexed_set<contactgroup> set_contactgroup;
 }
 
 CCE_END()
@@ -0,0 +1,77 @@
+/*
+** Copyright 2017 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CCE_CONFIGURATION_FIND_SETTER_HH
+#  define CCE_CONFIGURATION_FIND_SETTER_HH
+
+#  include <cstddef>
+#  include <cstring>
+#  include "com/centreon/engine/namespace.hh"
+
+CCE_BEGIN()
+
+namespace  configuration {
+  /**
+   *  Find the setter of a property.
+   *
+   *  Setter tables must be sorted by name (in strcmp() order) as they
+   *  are looked up with a binary search.
+   *
+   *  @param[in] setters  The setter table.
+   *  @param[in] key      The property name.
+   *
+   *  @return The setter, NULL if the property is unknown.
+   */
+  template <typename T, std::size_t N>
+  T const* find_setter(T const (&setters)[N], char const* key) {
+    std::size_t low(0);
+    std::size_t high(N);
+    while (low < high) {
+      std::size_t middle((low + high) / 2);
+      int cmp(strcmp(setters[middle].name, key));
+      if (!cmp)
+        return (&setters[middle]);
+      if (cmp < 0)
+        low = middle + 1;
+      else
+        high = middle;
+    }
+    return (NULL);
+  }
+
+  /**
+   *  Check that a setter table is sorted by name (in strcmp() order),
+   *  without duplicates.
+   *
+   *  @param[in] setters  The setter table.
+   *
+   *  @return True if the table is sorted.
+   */
+  template <typename T, std::size_t N>
+  bool setters_are_sorted(T const (&setters)[N]) {
+    for (std::size_t i(1); i < N; ++i)
+      if (strcmp(setters[i - 1].name, setters[i].name) >= 0)
+        return (false);
+    return (true);
+  }
+}
+
+CCE_END()
+
+#endif // !CCE_CONFIGURATION_FIND_SETTER_HH
@@ -24,6 +24,7 @@
 #  include <set>
 #  include "com/centreon/engine/common.hh"
 #  include "com/centreon/engine/configuration/group.hh"
+#  include "com/centreon/engine/configuration/indexed_set.hh"
 #  include "com/centreon/engine/configuration/object.hh"
 #  include "com/centreon/engine/configuration/point_2d.hh"
 #  include "com/centreon/engine/configuration/point_3d.hh"
@@ -60,6 +61,7 @@ namespace                  configuration {
     void                   merge(configuration::hostextinfo const& obj);
     void                   merge(object const& obj);
     bool                   parse(char const* key, char const* value);
+    static bool            sorted_setters() throw ();
 
     std::string const&     action_url() const throw ();
     std::string const&     address() const throw ();
@@ -223,7 +225,7 @@ namespace                  configuration {
 
   typedef shared_ptr<host>  host_ptr;
   typedef std::list<host>   list_host;
-  typedef std::set<host>    set_host;
+  typedef indexed_set<host> set_host;
 }
 
 CCE_END()
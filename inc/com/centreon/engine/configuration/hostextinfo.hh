@@ -47,6 +47,7 @@ namespace                  configuration {
     void                   check_validity() const;
     void                   merge(object const& obj);
     bool                   parse(char const* key, char const* value);
+    static bool            sorted_setters() throw ();
 
     std::string const&     action_url() const throw ();
     point_2d const&        coords_2d() const throw ();
@@ -22,6 +22,7 @@
 
 #  include <set>
 #  include "com/centreon/engine/configuration/group.hh"
+#  include "com/centreon/engine/configuration/indexed_set.hh"
 #  include "com/centreon/engine/configuration/object.hh"
 #  include "com/centreon/engine/opt.hh"
 #  include "com/centreon/engine/namespace.hh"
@@ -47,6 +48,7 @@ namespace                  configuration {
     key_type const&        key() const throw ();
     void                   merge(object const& obj);
     bool                   parse(char const* key, char const* value);
+    static bool            sorted_setters() throw ();
 
     std::string const&     action_url() const throw ();
     std::string const&     alias() const throw ();
@@ -85,8 +87,8 @@ namespace                  configuration {
     static setters const   _setters[];
   };
 
-  typedef shared_ptr<hostgroup> hostgroup_ptr;
-  typedef std::set<hostgroup>   set_hostgroup;
+  typedef shared_ptr<hostgroup>  hostgroup_ptr;
+  typedef indexed_set<hostgroup> set_hostgroup;
 }
 
 CCE_END()
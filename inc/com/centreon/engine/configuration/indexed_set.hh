@@ -0,0 +1,211 @@
+/*
+** Copyright 2017 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CCE_CONFIGURATION_INDEXED_SET_HH
+#  define CCE_CONFIGURATION_INDEXED_SET_HH
+
+#  include <set>
+#  include <utility>
+#  include "com/centreon/engine/namespace.hh"
+#  include "com/centreon/unordered_hash.hh"
+
+CCE_BEGIN()
+
+namespace              configuration {
+  /**
+   *  @class indexed_set indexed_set.hh
+   *  @brief Ordered set of configuration objects indexed by key.
+   *
+   *  Objects are ordered like in a std::set (the configuration diff
+   *  relies on it) but can also be found by their key with a hash
+   *  lookup, without building a temporary object. Several objects
+   *  can share a key (services of a same first host and description
+   *  for example), the index keeps all of them.
+   */
+  template <typename T>
+  class                indexed_set : private std::set<T> {
+    typedef std::set<T>
+                       base;
+
+  public:
+    typedef typename base::const_iterator
+                       const_iterator;
+    typedef typename base::const_reference
+                       const_reference;
+    typedef typename base::const_reverse_iterator
+                       const_reverse_iterator;
+    typedef typename base::iterator
+                       iterator;
+    typedef typename T::key_type
+                       key_type;
+    typedef typename base::reference
+                       reference;
+    typedef typename base::reverse_iterator
+                       reverse_iterator;
+    typedef typename base::size_type
+                       size_type;
+    typedef typename base::value_type
+                       value_type;
+
+    using              base::begin;
+    using              base::count;
+    using              base::empty;
+    using              base::end;
+    using              base::find;
+    using              base::lower_bound;
+    using              base::rbegin;
+    using              base::rend;
+    using              base::size;
+    using              base::upper_bound;
+
+                       indexed_set() {}
+                       indexed_set(indexed_set const& right)
+      : base(right) {
+      _rebuild();
+    }
+                       ~indexed_set() throw () {}
+    indexed_set&       operator=(indexed_set const& right) {
+      if (this != &right) {
+        base::operator=(right);
+        _rebuild();
+      }
+      return (*this);
+    }
+
+    void               clear() {
+      base::clear();
+      _index.clear();
+      return ;
+    }
+
+    void               erase(iterator pos) {
+      std::pair<typename index::iterator, typename index::iterator>
+        range(_index.equal_range(pos->key()));
+      for (typename index::iterator it(range.first);
+           it != range.second;
+           ++it)
+        if (it->second == pos) {
+          _index.erase(it);
+          break ;
+        }
+      base::erase(pos);
+      return ;
+    }
+
+    size_type          erase(T const& value) {
+      iterator it(base::find(value));
+      if (it == base::end())
+        return (0);
+      erase(it);
+      return (1);
+    }
+
+    void               erase(iterator first, iterator last) {
+      while (first != last)
+        erase(first++);
+      return ;
+    }
+
+    /**
+     *  Find an object by its key.
+     *
+     *  @param[in] k  The object key.
+     *
+     *  @return Iterator to the object if found, end() otherwise.
+     */
+    const_iterator     find_key(key_type const& k) const {
+      typename index::const_iterator it(_index.find(k));
+      if (it == _index.end())
+        return (base::end());
+      return (it->second);
+    }
+
+    /**
+     *  Find an object by its key.
+     *
+     *  @param[in] k  The object key.
+     *
+     *  @return Iterator to the object if found, end() otherwise.
+     */
+    iterator           find_key(key_type const& k) {
+      typename index::iterator it(_index.find(k));
+      if (it == _index.end())
+        return (base::end());
+      return (it->second);
+    }
+
+    std::pair<iterator, bool>
+                       insert(T const& value) {
+      std::pair<iterator, bool> ret(base::insert(value));
+      if (ret.second)
+        _index.insert(std::make_pair(value.key(), ret.first));
+      return (ret);
+    }
+
+    iterator           insert(iterator hint, T const& value) {
+      size_type size(base::size());
+      iterator it(base::insert(hint, value));
+      if (base::size() != size)
+        _index.insert(std::make_pair(value.key(), it));
+      return (it);
+    }
+
+    template <typename U>
+    void               insert(U first, U last) {
+      for (; first != last; ++first)
+        insert(*first);
+      return ;
+    }
+
+    void               swap(indexed_set& right) {
+      base::swap(right);
+      _index.swap(right._index);
+      return ;
+    }
+
+    bool               operator==(indexed_set const& right) const {
+      return (static_cast<base const&>(*this) == right);
+    }
+
+    bool               operator!=(indexed_set const& right) const {
+      return (static_cast<base const&>(*this) != right);
+    }
+
+    bool               operator<(indexed_set const& right) const {
+      return (static_cast<base const&>(*this) < right);
+    }
+
+  private:
+    typedef umultimap<key_type, iterator>
+                       index;
+
+    void               _rebuild() {
+      _index.clear();
+      for (iterator it(base::begin()), end(base::end()); it != end; ++it)
+        _index.insert(std::make_pair(it->key(), it));
+      return ;
+    }
+
+    index              _index;
+  };
+}
+
+CCE_END()
+
+#endif // !CCE_CONFIGURATION_INDEXED_SET_HH
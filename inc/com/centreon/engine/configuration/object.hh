@@ -65,12 +65,15 @@ namespace                  configuration {
     bool                   operator!=(
                              object const& right) const throw ();
     virtual void           check_validity() const = 0;
+    static shared_ptr<object>
+                           clone(object const& obj);
     static shared_ptr<object>
                            create(std::string const& type_name);
     virtual void           merge(object const& obj) = 0;
     std::string const&     name() const throw ();
     virtual bool           parse(char const* key, char const* value);
     virtual bool           parse(std::string const& line);
+    static bool            sorted_setters() throw ();
     void                   resolve_template(
                              umap<std::string, shared_ptr<object> >& templates);
     bool                   should_register() const throw ();
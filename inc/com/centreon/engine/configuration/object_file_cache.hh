@@ -0,0 +1,98 @@
+/*
+** Copyright 2017 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CCE_CONFIGURATION_OBJECT_FILE_CACHE_HH
+#  define CCE_CONFIGURATION_OBJECT_FILE_CACHE_HH
+
+#  include <ctime>
+#  include <list>
+#  include <string>
+#  include <sys/types.h>
+#  include <utility>
+#  include <vector>
+#  include "com/centreon/engine/configuration/object.hh"
+#  include "com/centreon/engine/namespace.hh"
+#  include "com/centreon/unordered_hash.hh"
+
+CCE_BEGIN()
+
+namespace               configuration {
+  /**
+   *  @class object_file_cache object_file_cache.hh
+   *  @brief Objects read from object definition files.
+   *
+   *  Keep the objects of object definition files along with the
+   *  status of the files when they were read, so that a file which
+   *  did not change since does not need to be parsed again. Objects
+   *  are stored and returned as copies as the parser modifies them
+   *  when resolving templates.
+   */
+  class                 object_file_cache {
+  public:
+    /**
+     *  File status used to detect file changes.
+     */
+    struct              file_status {
+      time_t            ctime;
+      dev_t             dev;
+      ino_t             ino;
+      time_t            mtime;
+      off_t             size;
+    };
+    typedef std::vector<std::pair<object_ptr, unsigned int> >
+                        objects;
+
+                        object_file_cache();
+                        ~object_file_cache() throw ();
+    void                clear();
+    bool                find(
+                          std::string const& path,
+                          file_status const& status,
+                          unsigned int read_options,
+                          objects& objs) const;
+    void                insert(
+                          std::string const& path,
+                          file_status const& status,
+                          unsigned int read_options,
+                          objects const& objs);
+    void                retain(std::list<std::string> const& paths);
+    std::size_t         size() const throw ();
+    static bool         status(
+                          std::string const& path,
+                          file_status& status);
+
+  private:
+    struct              entry {
+      objects           objs;
+      unsigned int      read_options;
+      file_status       status;
+    };
+
+                        object_file_cache(object_file_cache const& right);
+    object_file_cache&  operator=(object_file_cache const& right);
+    static void         _copy(objects const& from, objects& to);
+
+    umap<std::string, entry>
+                        _files;
+  };
+}
+
+CCE_END()
+
+#endif // !CCE_CONFIGURATION_OBJECT_FILE_CACHE_HH
@@ -21,6 +21,7 @@
 #  define CCE_CONFIGURATION_PARSER_HH
 
 #  include <fstream>
+#  include <list>
 #  include <string>
 #  include "com/centreon/engine/configuration/command.hh"
 #  include "com/centreon/engine/configuration/connector.hh"
@@ -31,6 +32,7 @@
 #  include "com/centreon/engine/configuration/hostextinfo.hh"
 #  include "com/centreon/engine/configuration/host.hh"
 #  include "com/centreon/engine/configuration/object.hh"
+#  include "com/centreon/engine/configuration/object_file_cache.hh"
 #  include "com/centreon/engine/configuration/servicedependency.hh"
 #  include "com/centreon/engine/configuration/serviceescalation.hh"
 #  include "com/centreon/engine/configuration/serviceextinfo.hh"
@@ -65,7 +67,9 @@ namespace              configuration {
       read_all = (~0)
     };
 
-                       parser(unsigned int read_options = read_all);
+                       parser(
+                         unsigned int read_options = read_all,
+                         object_file_cache* cache = NULL);
                        ~parser() throw ();
     void               parse(std::string const& path, state& config);
 
@@ -98,27 +102,31 @@ namespace              configuration {
     template<typename T>
     static void        _insert(
                          list_object const& from,
-                         std::set<T>& to);
+                         T& to);
     template<typename T>
     static void        _insert(
                          map_object const& from,
-                         std::set<T>& to);
+                         T& to);
     std::string const& _map_object_type(
                          map_object const& objects) const throw ();
     void               _parse_directory_configuration(std::string const& path);
     void               _parse_global_configuration(std::string const& path);
     void               _parse_object_definitions(std::string const& path);
+    void               _parse_object_files();
     void               _parse_resource_file(std::string const& path);
     void               _resolve_template();
     void               _store_into_list(object_ptr obj);
     template<typename T, std::string const& (T::*ptr)() const throw ()>
     void               _store_into_map(object_ptr obj);
 
+    object_file_cache* _cache;
     state*             _config;
     unsigned int       _current_line;
     std::string        _current_path;
     list_object        _lst_objects[15];
     map_object         _map_objects[15];
+    std::list<std::string>
+                       _object_files;
     umap<object*, file_info>
                        _objects_info;
     unsigned int       _read_options;
@@ -22,6 +22,7 @@
 
 #  include "com/centreon/concurrency/mutex.hh"
 #  include "com/centreon/concurrency/thread.hh"
+#  include "com/centreon/engine/configuration/object_file_cache.hh"
 #  include "com/centreon/engine/namespace.hh"
 
 CCE_BEGIN()
@@ -33,7 +34,9 @@ namespace   configuration {
    *
    *  This class is used to reload a configuration state in a separate
    *  thread which reduce the time required to load the configuration on
-   *  a multiprocessor machine.
+   *  a multiprocessor machine. When incremental reload is enabled,
+   *  object definition files which did not change since the previous
+   *  reload are not parsed again.
    */
   class     reload : private concurrency::thread {
   public:
@@ -50,6 +53,8 @@ namespace   configuration {
     void    _run();
     void    _set_is_finished(bool value);
 
+    object_file_cache
+            _cache;
     bool    _is_finished;
     mutable concurrency::mutex
             _lock;
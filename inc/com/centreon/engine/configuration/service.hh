@@ -25,6 +25,7 @@
 #  include <utility>
 #  include "com/centreon/engine/common.hh"
 #  include "com/centreon/engine/configuration/group.hh"
+#  include "com/centreon/engine/configuration/indexed_set.hh"
 #  include "com/centreon/engine/configuration/object.hh"
 #  include "com/centreon/engine/objects/customvariable.hh"
 #  include "com/centreon/engine/opt.hh"
@@ -64,6 +65,7 @@ namespace                  configuration {
     void                   merge(configuration::serviceextinfo const& obj);
     void                   merge(object const& obj);
     bool                   parse(char const* key, char const* value);
+    static bool            sorted_setters() throw ();
 
     std::string const&     action_url() const throw ();
     bool                   checks_active() const throw ();
@@ -233,7 +235,7 @@ namespace                  configuration {
 
   typedef shared_ptr<service>    service_ptr;
   typedef std::list<service_ptr> list_service;
-  typedef std::set<service>      set_service;
+  typedef indexed_set<service>   set_service;
   typedef umap<std::pair<std::string, std::string>, service_ptr> map_service;
 }
 
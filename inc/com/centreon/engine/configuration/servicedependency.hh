@@ -62,6 +62,7 @@ namespace                  configuration {
     key_type const&        key() const throw ();
     void                   merge(object const& obj);
     bool                   parse(char const* key, char const* value);
+    static bool            sorted_setters() throw ();
 
     void                   dependency_period(std::string const& period);
     std::string const&     dependency_period() const throw ();
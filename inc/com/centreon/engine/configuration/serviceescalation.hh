@@ -57,6 +57,7 @@ namespace                  configuration {
     key_type const&        key() const throw ();
     void                   merge(object const& obj);
     bool                   parse(char const* key, char const* value);
+    static bool            sorted_setters() throw ();
 
     set_string&            contactgroups() throw ();
     set_string const&      contactgroups() const throw ();
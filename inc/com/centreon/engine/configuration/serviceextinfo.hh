@@ -46,6 +46,7 @@ namespace                  configuration {
     void                   check_validity() const;
     void                   merge(object const& obj);
     bool                   parse(char const* key, char const* value);
+    static bool            sorted_setters() throw ();
 
     std::string const&     action_url() const throw ();
     std::string const&     icon_image() const throw ();
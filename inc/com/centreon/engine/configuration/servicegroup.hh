@@ -23,6 +23,7 @@
 #  include <set>
 #  include <utility>
 #  include "com/centreon/engine/configuration/group.hh"
+#  include "com/centreon/engine/configuration/indexed_set.hh"
 #  include "com/centreon/engine/configuration/object.hh"
 #  include "com/centreon/engine/opt.hh"
 #  include "com/centreon/engine/namespace.hh"
@@ -50,6 +51,7 @@ namespace                   configuration {
     key_type const&         key() const throw ();
     void                    merge(object const& obj);
     bool                    parse(char const* key, char const* value);
+    static bool             sorted_setters() throw ();
 
     std::string const&      action_url() const throw ();
     std::string const&      alias() const throw ();
@@ -89,7 +91,7 @@ namespace                   configuration {
   };
 
   typedef shared_ptr<servicegroup>  servicegroup_ptr;
-  typedef std::set<servicegroup>    set_servicegroup;
+  typedef indexed_set<servicegroup> set_servicegroup;
 }
 
 CCE_END()
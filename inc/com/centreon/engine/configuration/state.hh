@@ -144,6 +144,8 @@ namespace               configuration {
     bool                check_orphaned_services() const throw ();
     unsigned int        check_reaper_interval() const throw ();
     void                check_reaper_interval(unsigned int value);
+    unsigned int        check_reaper_threads() const throw ();
+    void                check_reaper_threads(unsigned int value);
     std::string const&  check_result_path() const throw ();
     void                check_result_path(std::string const& value);
     bool                check_service_freshness() const throw ();
@@ -188,6 +190,8 @@ namespace               configuration {
     void                debug_level(unsigned long long value);
     unsigned int        debug_verbosity() const throw ();
     void                debug_verbosity(unsigned int value);
+    bool                enable_async_system_commands() const throw ();
+    void                enable_async_system_commands(bool value);
     bool                enable_environment_macros() const throw ();
     void                enable_environment_macros(bool value);
     bool                enable_event_handlers() const throw ();
@@ -284,6 +288,14 @@ namespace               configuration {
     void                max_check_reaper_time(unsigned int value);
     unsigned long       max_check_result_file_age() const throw ();
     void                max_check_result_file_age(unsigned long value);
+    unsigned int        max_concurrent_event_handlers() const throw ();
+    void                max_concurrent_event_handlers(unsigned int value);
+    unsigned int        max_concurrent_notifications() const throw ();
+    void                max_concurrent_notifications(unsigned int value);
+    unsigned int        max_concurrent_obsessive_commands() const throw ();
+    void                max_concurrent_obsessive_commands(unsigned int value);
+    unsigned int        max_concurrent_perfdata_commands() const throw ();
+    void                max_concurrent_perfdata_commands(unsigned int value);
     unsigned long       max_debug_file_size() const throw ();
     void                max_debug_file_size(unsigned long value);
     unsigned int        max_host_check_spread() const throw ();
@@ -310,6 +322,10 @@ namespace               configuration {
     void                ocsp_timeout(unsigned int value);
     bool                passive_host_checks_are_soft() const throw ();
     void                passive_host_checks_are_soft(bool value);
+    unsigned int        perfdata_file_flush_interval() const throw ();
+    void                perfdata_file_flush_interval(unsigned int value);
+    unsigned int        perfdata_file_flush_size() const throw ();
+    void                perfdata_file_flush_size(unsigned int value);
     int                 perfdata_timeout() const throw ();
     void                perfdata_timeout(int value);
     bool                process_performance_data() const throw ();
@@ -383,6 +399,7 @@ namespace               configuration {
     unsigned int        status_update_interval() const throw ();
     void                status_update_interval(unsigned int value);
     bool                set(char const* key, char const* value);
+    static bool         sorted_setters() throw ();
     set_timeperiod const&
                         timeperiods() const throw ();
     set_timeperiod&     timeperiods() throw ();
@@ -401,8 +418,12 @@ namespace               configuration {
     void                user(unsigned int key, std::string const& value);
     bool                use_aggressive_host_checking() const throw ();
     void                use_aggressive_host_checking(bool value);
+    bool                use_binary_state_retention() const throw ();
+    void                use_binary_state_retention(bool value);
     bool                use_check_result_path() const throw ();
     void                use_check_result_path(bool value);
+    bool                use_incremental_reload() const throw ();
+    void                use_incremental_reload(bool value);
     bool                use_large_installation_tweaks() const throw ();
     void                use_large_installation_tweaks(bool value);
     bool                use_regexp_matches() const throw ();
@@ -522,6 +543,7 @@ namespace               configuration {
     bool                _check_orphaned_hosts;
     bool                _check_orphaned_services;
     unsigned int        _check_reaper_interval;
+    unsigned int        _check_reaper_threads;
     std::string         _check_result_path;
     bool                _check_service_freshness;
     set_command         _commands;
@@ -535,6 +557,7 @@ namespace               configuration {
     std::string         _debug_file;
     unsigned long long  _debug_level;
     unsigned int        _debug_verbosity;
+    bool                _enable_async_system_commands;
     bool                _enable_environment_macros;
     bool                _enable_event_handlers;
     bool                _enable_flap_detection;
@@ -578,6 +601,10 @@ namespace               configuration {
     float               _low_service_flap_threshold;
     unsigned int        _max_check_reaper_time;
     unsigned long       _max_check_result_file_age;
+    unsigned int        _max_concurrent_event_handlers;
+    unsigned int        _max_concurrent_notifications;
+    unsigned int        _max_concurrent_obsessive_commands;
+    unsigned int        _max_concurrent_perfdata_commands;
     unsigned long       _max_debug_file_size;
     unsigned int        _max_host_check_spread;
     unsigned long       _max_log_file_size;
@@ -591,6 +618,8 @@ namespace               configuration {
     std::string         _ocsp_command;
     unsigned int        _ocsp_timeout;
     bool                _passive_host_checks_are_soft;
+    unsigned int        _perfdata_file_flush_interval;
+    unsigned int        _perfdata_file_flush_size;
     int                 _perfdata_timeout;
     bool                _process_performance_data;
     std::list<std::string>
@@ -631,7 +660,9 @@ namespace               configuration {
     umap<std::string, std::string>
                         _users;
     bool                _use_aggressive_host_checking;
+    bool                _use_binary_state_retention;
     bool                _use_check_result_path;
+    bool                _use_incremental_reload;
     bool                _use_large_installation_tweaks;
     bool                _use_regexp_matches;
     bool                _use_retained_program_state;
@@ -26,6 +26,7 @@
 #  include <vector>
 #  include "com/centreon/engine/configuration/daterange.hh"
 #  include "com/centreon/engine/configuration/group.hh"
+#  include "com/centreon/engine/configuration/indexed_set.hh"
 #  include "com/centreon/engine/configuration/object.hh"
 #  include "com/centreon/engine/opt.hh"
 #  include "com/centreon/engine/namespace.hh"
@@ -52,6 +53,7 @@ namespace                  configuration {
     void                   merge(object const& obj);
     bool                   parse(char const* key, char const* value);
     bool                   parse(std::string const& line);
+    static bool            sorted_setters() throw ();
 
     std::string const&     alias() const throw ();
     std::vector<std::list<daterange> > const&
@@ -101,8 +103,8 @@ namespace                  configuration {
                            _timeranges;
   };
 
-  typedef shared_ptr<timeperiod> timeperiod_ptr;
-  typedef std::set<timeperiod>   set_timeperiod;
+  typedef shared_ptr<timeperiod>  timeperiod_ptr;
+  typedef indexed_set<timeperiod> set_timeperiod;
 }
 
 CCE_END()
@@ -23,6 +23,8 @@
 #  define CCE_EVENTS_LOOP_HH
 
 #  include <ctime>
+#  include "com/centreon/concurrency/condvar.hh"
+#  include "com/centreon/concurrency/mutex.hh"
 #  include "com/centreon/engine/configuration/reload.hh"
 #  include "com/centreon/engine/events/timed_event.hh"
 #  include "com/centreon/engine/namespace.hh"
@@ -35,7 +37,9 @@ namespace             events {
    *  @brief Create Centreon Engine event loop on a new thread.
    *
    *  Events loop is a singleton to create a new thread
-   *  and dispatch the Centreon Engine events.
+   *  and dispatch the Centreon Engine events. Between events, the
+   *  loop waits until the next event is due or until another thread
+   *  wakes it up to handle new data (check results, commands, ...).
    */
   class               loop {
   public:
@@ -43,21 +47,33 @@ namespace             events {
     static void       load();
     void              run();
     static void       unload();
+    void              wake_up();
 
   private:
                       loop();
                       loop(loop const&);
                       ~loop() throw ();
     loop&             operator=(loop const&);
+    unsigned int      _count_due_events(time_t current_time);
+    bool              _dispatch_event(
+                        time_t current_time,
+                        bool& deferred);
     void              _dispatching();
+    void              _wait(unsigned long timeout);
 
+    concurrency::condvar
+                      _cv_wakeup;
     time_t            _last_status_update;
     time_t            _last_time;
+    concurrency::mutex
+                      _lock_wakeup;
     unsigned int      _need_reload;
     configuration::reload
                       _reload_configuration;
     bool              _reload_running;
     timed_event       _sleep_event;
+    int volatile      _waiting;
+    int volatile      _wakeup;
   };
 }
 
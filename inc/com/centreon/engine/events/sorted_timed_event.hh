@@ -0,0 +1,75 @@
+/*
+** Copyright 2017 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CCE_EVENTS_SORTED_TIMED_EVENT_HH
+#  define CCE_EVENTS_SORTED_TIMED_EVENT_HH
+
+#  include <cstddef>
+#  include <ctime>
+#  include <map>
+#  include "com/centreon/engine/events/hash_timed_event.hh"
+#  include "com/centreon/engine/namespace.hh"
+#  include "com/centreon/unordered_hash.hh"
+
+// Forward declaration.
+struct timed_event_struct;
+
+CCE_BEGIN()
+
+namespace               events {
+  /**
+   *  @class sorted_timed_event sorted_timed_event.hh
+   *  @brief Execution time index of the timed event lists.
+   *
+   *  Keep timed events sorted by execution time (events with the
+   *  same execution time being kept in insertion order) to find in
+   *  logarithmic time where an event must be linked in its event
+   *  list.
+   */
+  class                 sorted_timed_event {
+  public:
+    typedef hash_timed_event::priority
+                        priority;
+
+                        sorted_timed_event();
+                        sorted_timed_event(
+                          sorted_timed_event const& right);
+                        ~sorted_timed_event();
+    sorted_timed_event& operator=(sorted_timed_event const& right);
+    void                clear(priority p);
+    bool                empty(priority p) const;
+    void                erase(priority p, timed_event_struct* event);
+    timed_event_struct* insert(priority p, timed_event_struct* event);
+    std::size_t         size(priority p) const;
+
+  private:
+    typedef std::multimap<time_t, timed_event_struct*>
+                        event_map;
+
+    sorted_timed_event& _internal_copy(sorted_timed_event const& right);
+
+    event_map           _events[hash_timed_event::priority_num];
+    umap<timed_event_struct*, event_map::iterator>
+                        _position[hash_timed_event::priority_num];
+  };
+}
+
+CCE_END()
+
+#endif // !CCE_EVENTS_SORTED_TIMED_EVENT_HH
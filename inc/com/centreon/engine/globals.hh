@@ -30,6 +30,7 @@
 #  include "com/centreon/engine/configuration/state.hh"
 #  include "com/centreon/engine/events/hash_timed_event.hh"
 #  include "com/centreon/engine/events/sched_info.hh"
+#  include "com/centreon/engine/events/sorted_timed_event.hh"
 #  include "com/centreon/engine/events/timed_event.hh"
 #  include "com/centreon/engine/nebmods.hh"
 #  include "com/centreon/engine/notifications.hh"
@@ -61,6 +62,7 @@ extern unsigned long             logging_options;
 extern unsigned long             syslog_options;
 
 extern com::centreon::engine::events::hash_timed_event quick_timed_event;
+extern com::centreon::engine::events::sorted_timed_event sorted_timed_events;
 
 extern time_t                    last_command_check;
 extern time_t                    last_command_status_update;
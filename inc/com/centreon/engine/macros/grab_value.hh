@@ -51,6 +51,7 @@ int grab_macrox_value(
       char const* arg2,
       char** output,
       int* free_macro);
+int get_macrox_clean_options(int macro_type);
 
 #  ifdef __cplusplus
 }
@@ -0,0 +1,89 @@
+/*
+** Copyright 2017 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CCE_MACROS_PLAN_HH
+#  define CCE_MACROS_PLAN_HH
+
+#  include <string>
+#  include <vector>
+#  include "com/centreon/engine/macros/defines.hh"
+#  include "com/centreon/engine/namespace.hh"
+
+CCE_BEGIN()
+
+namespace               macros {
+  /**
+   *  @class plan plan.hh
+   *  @brief Text with macros compiled into a list of tokens.
+   *
+   *  The text is split once into plain text and macros. Standard (x),
+   *  argument and user macros are resolved to their index so processing
+   *  the plan only fetches the values of the macros it references, other
+   *  macros are looked up by name each time. Processing a plan gives the
+   *  same result as process_macros_r() on the original text.
+   */
+  class                 plan {
+  public:
+                        plan();
+                        plan(std::string const& text);
+                        plan(plan const& right);
+                        ~plan() throw ();
+    plan&               operator=(plan const& right);
+    void                compile(std::string const& text);
+    bool                empty() const throw ();
+    void                process(
+                          nagios_macros* mac,
+                          std::string& output,
+                          int options = 0) const;
+
+  private:
+    enum                token_type {
+      token_text = 0,
+      token_macrox,
+      token_argv,
+      token_user,
+      token_macro
+    };
+
+    struct              token {
+      std::string       arg1;
+      std::string       arg2;
+      int               clean_options;
+      bool              has_arg1;
+      bool              has_arg2;
+      int               index;
+      token_type        type;
+      std::string       value;
+    };
+
+    static void         _append(
+                          std::string& output,
+                          char* value,
+                          bool free_value,
+                          int options);
+    void                _internal_copy(plan const& right);
+
+    std::size_t         _text_size;
+    std::vector<token>  _tokens;
+  };
+}
+
+CCE_END()
+
+#endif // !CCE_MACROS_PLAN_HH
@@ -0,0 +1,119 @@
+/*
+** Copyright 2017 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CCE_MACROS_SUMMARY_HH
+#  define CCE_MACROS_SUMMARY_HH
+
+#  include <vector>
+#  include "com/centreon/engine/namespace.hh"
+#  include "com/centreon/engine/objects/contact.hh"
+#  include "com/centreon/engine/objects/host.hh"
+#  include "com/centreon/engine/objects/service.hh"
+#  include "com/centreon/unordered_hash.hh"
+
+CCE_BEGIN()
+
+namespace               macros {
+  /**
+   *  @class summary summary.hh
+   *  @brief Host and service totals used by summary macros.
+   *
+   *  Totals are kept globally and per contact. They are updated each
+   *  time the status of an object is updated and fully rebuilt after
+   *  a configuration change, so summary macros are resolved without
+   *  walking the object lists.
+   */
+  class                 summary {
+  public:
+    enum                counter {
+      hosts_up = 0,
+      hosts_down,
+      hosts_down_unhandled,
+      hosts_unreachable,
+      hosts_unreachable_unhandled,
+      services_ok,
+      services_warning,
+      services_warning_unhandled,
+      services_critical,
+      services_critical_unhandled,
+      services_unknown,
+      services_unknown_unhandled,
+      counter_num
+    };
+
+    struct              counters {
+                        counters();
+      unsigned int      value[counter_num];
+    };
+
+    counters const&     get(contact* cntct = NULL);
+    static summary&     instance();
+    static void         load();
+    static void         unload();
+    void                update(host* hst);
+    void                update(service* svc);
+
+  private:
+    // Totals an object is counted in.
+    enum                category {
+      none = 0,
+      host_up,
+      host_down,
+      host_down_unhandled,
+      host_unreachable,
+      host_unreachable_unhandled,
+      service_ok,
+      service_warning,
+      service_warning_unhandled,
+      service_critical,
+      service_critical_unhandled,
+      service_unknown,
+      service_unknown_unhandled
+    };
+
+                        summary();
+                        summary(summary const& right);
+                        ~summary() throw ();
+    summary&            operator=(summary const& right);
+    static void         _add(counters& c, category cat, int delta);
+    void                _count(
+                          category old_cat,
+                          category new_cat,
+                          contactsmember* contacts,
+                          contactgroupsmember* groups);
+    static category     _host_category(host const* hst);
+    void                _rebuild();
+    static category     _service_category(service const* svc);
+
+    std::vector<contact*>
+                        _contacts;
+    umap<contact*, counters>
+                        _contact_totals;
+    unsigned int        _generation;
+    umap<host*, category>
+                        _hosts;
+    umap<service*, category>
+                        _services;
+    counters            _totals;
+  };
+}
+
+CCE_END()
+
+#endif // !CCE_MACROS_SUMMARY_HH
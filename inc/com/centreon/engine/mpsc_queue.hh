@@ -0,0 +1,102 @@
+/*
+** Copyright 2017 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CCE_MPSC_QUEUE_HH
+#  define CCE_MPSC_QUEUE_HH
+
+#  include <cstddef>
+#  include "com/centreon/engine/namespace.hh"
+
+CCE_BEGIN()
+
+/**
+ *  @class mpsc_queue mpsc_queue.hh "com/centreon/engine/mpsc_queue.hh"
+ *  @brief Lock-free multiple producers single consumer queue.
+ *
+ *  Intrusive queue of heap allocated nodes linked through their next
+ *  member. Any thread can push a node, the consumer takes all the
+ *  pending nodes at once in their push order. Nodes are never copied,
+ *  the queue takes their ownership until they are popped.
+ */
+template                 <typename T>
+class                    mpsc_queue {
+public:
+                         mpsc_queue() : _head(NULL) {}
+                         ~mpsc_queue() throw () {}
+
+  /**
+   *  Check if the queue is empty.
+   *
+   *  @return True if no node is pending.
+   */
+  bool                   empty() const throw () {
+    return (!_head);
+  }
+
+  /**
+   *  Get all the pending nodes.
+   *
+   *  @return The first pushed node, other nodes are linked through
+   *          their next member. NULL if the queue is empty.
+   */
+  T*                     pop_all() throw () {
+    T* head;
+    do {
+      head = _head;
+    } while (head
+             && !__sync_bool_compare_and_swap(
+                   &_head,
+                   head,
+                   static_cast<T*>(NULL)));
+
+    // Nodes were stacked, reverse them to get the push order.
+    T* first(NULL);
+    while (head) {
+      T* next(head->next);
+      head->next = first;
+      first = head;
+      head = next;
+    }
+    return (first);
+  }
+
+  /**
+   *  Add a node.
+   *
+   *  @param[in] node  The node, owned by the queue until popped.
+   */
+  void                   push(T* node) throw () {
+    T* head;
+    do {
+      head = _head;
+      node->next = head;
+    } while (!__sync_bool_compare_and_swap(&_head, head, node));
+    return;
+  }
+
+private:
+                         mpsc_queue(mpsc_queue const& right);
+  mpsc_queue&            operator=(mpsc_queue const& right);
+
+  T* volatile            _head;
+};
+
+CCE_END()
+
+#endif // !CCE_MPSC_QUEUE_HH
@@ -81,6 +81,8 @@ std::ostream& operator<<(
 
 CCE_BEGIN()
 
+unsigned int  customvariables_generation() throw ();
+void          customvariables_modified() throw ();
 bool          update_customvariable(
                 customvariablesmember* lst,
                 std::string const& key,
@@ -30,6 +30,7 @@ struct contact_struct;
 struct contactgroupsmember_struct;
 struct contactsmember_struct;
 struct customvariablesmember_struct;
+struct host_other_properties;
 struct hostsmember_struct;
 struct objectlist_struct;
 struct servicesmember_struct;
@@ -155,6 +156,8 @@ typedef struct                  host_struct {
   objectlist_struct*            hostgroups_ptr;
   struct host_struct*           next;
   struct host_struct*           nexthash;
+  /* Engine only, last to keep the offsets seen by modules. */
+  host_other_properties*        other_props;
 }                               host;
 
 /* Other HOST structure. */
@@ -265,6 +268,7 @@ CCE_BEGIN()
 void          check_for_expired_acknowledgement(host* h);
 host&         find_host(std::string const& name);
 char const*   get_host_timezone(char const* name);
+char const*   get_host_timezone(host const* hst);
 bool          is_host_exist(std::string const& name) throw ();
 unsigned int  get_host_id(char const* name);
 void          schedule_acknowledgement_expiration(host* h);
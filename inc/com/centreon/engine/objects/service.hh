@@ -31,6 +31,7 @@ struct contactsmember_struct;
 struct customvariablesmember_struct;
 struct host_struct;
 struct objectlist_struct;
+struct service_other_properties;
 struct timeperiod_struct;
 
 typedef struct                  service_struct {
@@ -145,6 +146,7 @@ typedef struct                  service_struct {
   objectlist_struct*            servicegroups_ptr;
   struct service_struct*        next;
   struct service_struct*        nexthash;
+  service_other_properties*     other_props;
 }                               service;
 
 /* Other SERVICE structure. */
@@ -243,6 +245,7 @@ service&      find_service(
                 std::string const& host_name,
                 std::string const& service_description);
 char const*   get_service_timezone(char const* hst, char const* svc);
+char const*   get_service_timezone(service const* svc);
 bool          is_service_exist(
                 std::pair<std::string, std::string> const& id);
 std::pair<unsigned int, unsigned int>
@@ -0,0 +1,101 @@
+/*
+** Copyright 2017 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CCE_PERFDATA_WRITER_HH
+#  define CCE_PERFDATA_WRITER_HH
+
+#  include <cstdio>
+#  include <string>
+#  include "com/centreon/concurrency/condvar.hh"
+#  include "com/centreon/concurrency/mutex.hh"
+#  include "com/centreon/concurrency/thread.hh"
+#  include "com/centreon/engine/mpsc_queue.hh"
+#  include "com/centreon/engine/namespace.hh"
+#  include "com/centreon/timestamp.hh"
+
+CCE_BEGIN()
+
+/**
+ *  @class perfdata_writer perfdata_writer.hh
+ *  @brief Write performance data file lines from a background thread.
+ *
+ *  Lines are pushed to a lock-free queue and written in batches, with
+ *  one write per batch, when enough bytes are pending or when the
+ *  oldest pending line waited for the flush interval. With a flush
+ *  interval of 0, lines are written as soon as they are pushed.
+ *  Lines pushed while no file is attached are kept until one is, up
+ *  to a maximum size beyond which the oldest ones are dropped.
+ */
+class                   perfdata_writer : public concurrency::thread {
+public:
+  struct                stats {
+    unsigned long long  lines;
+    double              lines_per_second;
+    unsigned long long  write_time;
+    unsigned long long  writes;
+  };
+
+                        perfdata_writer(
+                          std::string const& name,
+                          unsigned int flush_interval,
+                          unsigned int flush_size,
+                          unsigned long max_held_size);
+                        ~perfdata_writer() throw ();
+  void                  attach(FILE* fp);
+  FILE*                 detach();
+  void                  flush();
+  stats                 get_stats();
+  void                  push(std::string& line);
+
+private:
+  struct                line {
+    std::string         data;
+    line*               next;
+  };
+
+                        perfdata_writer(perfdata_writer const& right);
+  perfdata_writer&      operator=(perfdata_writer const& right);
+  void                  _run();
+  void                  _update_rate(unsigned int lines);
+
+  concurrency::condvar  _cv;
+  concurrency::mutex    _file_lock;
+  FILE*                 _fp;
+  unsigned int          _flush_interval;
+  unsigned int          _flush_size;
+  line*                 _held_first;
+  line*                 _held_last;
+  unsigned long         _held_size;
+  concurrency::mutex    _lock;
+  unsigned long         _max_held_size;
+  std::string           _name;
+  unsigned long volatile
+                        _pending_size;
+  mpsc_queue<line>      _queue;
+  bool                  _quit;
+  unsigned long long    _rate_lines;
+  timestamp             _rate_start;
+  bool                  _running;
+  stats                 _stats;
+  bool                  _wakeup;
+};
+
+CCE_END()
+
+#endif // !CCE_PERFDATA_WRITER_HH
@@ -0,0 +1,138 @@
+/*
+** Copyright 2017 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CCE_RETENTION_BINARY_HH
+#  define CCE_RETENTION_BINARY_HH
+
+#  include <cstdio>
+#  include <ostream>
+#  include <streambuf>
+#  include <string>
+#  include <utility>
+#  include <vector>
+#  include "com/centreon/engine/namespace.hh"
+#  include "com/centreon/engine/retention/output.hh"
+
+CCE_BEGIN()
+
+namespace               retention {
+  /**
+   *  Binary retention file format.
+   *
+   *  The file starts with a header (magic, version, byte order mark
+   *  and number of records). Each record is its size followed by the
+   *  object type and by key/value pairs, all nul-terminated, so a
+   *  mapped file can be read without copying. Records hold the same
+   *  fields as the objects of a text retention file.
+   */
+  namespace             binary {
+    unsigned int const  version = 1;
+
+    bool                is_binary(std::string const& path);
+
+    /**
+     *  @class reader binary.hh
+     *  @brief Map a binary retention file in memory.
+     *
+     *  Records can be read concurrently once the reader is built.
+     */
+    class               reader {
+    public:
+      typedef std::vector<std::pair<char const*, char const*> >
+                        fields;
+
+                        reader(std::string const& path);
+                        ~reader() throw ();
+      char const*       get(std::size_t index, fields& f) const;
+      std::size_t       size() const throw ();
+
+    private:
+                        reader(reader const& right);
+      reader&           operator=(reader const& right);
+
+      char*             _data;
+      std::size_t       _length;
+      std::vector<std::pair<char const*, char const*> >
+                        _records;
+    };
+
+    /**
+     *  @class buffer binary.hh
+     *  @brief Build binary records in memory.
+     *
+     *  Values are written straight into the records, so objects are
+     *  never formatted as text to be parsed again.
+     */
+    class               buffer : public output, private std::streambuf {
+    public:
+                        buffer();
+                        ~buffer() throw ();
+      void              append(std::string const& records);
+      void              begin(char const* type);
+      unsigned int      count() const throw ();
+      std::string const&
+                        data() const throw ();
+      void              end();
+      std::ostream&     field(char const* key);
+
+    protected:
+      int_type          overflow(int_type c);
+      std::streamsize   xsputn(char const* s, std::streamsize n);
+
+      unsigned int      _count;
+      std::string       _data;
+      bool              _in_field;
+      std::size_t       _record;
+      std::ostream      _stream;
+
+    private:
+                        buffer(buffer const& right);
+      buffer&           operator=(buffer const& right);
+    };
+
+    /**
+     *  @class writer binary.hh
+     *  @brief Write binary records in a file.
+     *
+     *  Records are written in a temporary file as they are built, it
+     *  replaces the target file on commit().
+     */
+    class               writer : public buffer {
+    public:
+                        writer(std::string const& path);
+                        ~writer() throw ();
+      void              commit();
+      void              end();
+
+    private:
+                        writer(writer const& right);
+      writer&           operator=(writer const& right);
+      void              _flush();
+      void              _write(void const* data, std::size_t size);
+
+      FILE*             _file;
+      std::string       _path;
+      std::string       _tmp_path;
+    };
+  }
+}
+
+CCE_END()
+
+#endif // !CCE_RETENTION_BINARY_HH
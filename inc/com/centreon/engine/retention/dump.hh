@@ -21,6 +21,7 @@
 #  define CCE_RETENTION_DUMP_HH
 
 #  include <ostream>
+#  include <string>
 #  include "com/centreon/engine/namespace.hh"
 
 // Forward declaration.
@@ -33,23 +34,30 @@ struct service_struct;
 
 CCE_BEGIN()
 
+class             snapshot;
+
 namespace         retention {
+  class           output;
+
   namespace       dump {
-    std::ostream& comment(std::ostream& os, comment_struct const& obj);
-    std::ostream& comments(std::ostream& os);
-    std::ostream& contact(std::ostream& os, contact_struct const& obj);
-    std::ostream& contacts(std::ostream& os);
-    std::ostream& customvariables(std::ostream& os, customvariablesmember_struct const& obj);
-    std::ostream& downtime(std::ostream& os, scheduled_downtime_struct const& obj);
-    std::ostream& downtimes(std::ostream& os);
+    output&       all(output& out, snapshot const& snap);
+    output&       comment(output& out, comment_struct const& obj);
+    output&       comments(output& out);
+    output&       contact(output& out, contact_struct const& obj, unsigned long host_mask, unsigned long service_mask);
+    output&       contacts(output& out);
+    output&       customvariables(output& out, customvariablesmember_struct const& obj);
+    output&       downtime(output& out, scheduled_downtime_struct const& obj);
+    output&       downtimes(output& out);
     std::ostream& header(std::ostream& os);
-    std::ostream& host(std::ostream& os, host_struct const& obj);
-    std::ostream& hosts(std::ostream& os);
-    std::ostream& info(std::ostream& os);
-    std::ostream& program(std::ostream& os);
+    output&       host(output& out, host_struct const& obj, unsigned long mask);
+    output&       hosts(output& out);
+    output&       info(output& out);
+    output&       program(output& out);
     bool          save(std::string const& path);
-    std::ostream& service(std::ostream& os, service_struct const& obj);
-    std::ostream& services(std::ostream& os);
+    void          save_snapshot(std::string const& path);
+    output&       service(output& out, service_struct const& obj, unsigned long mask);
+    output&       services(output& out);
+    bool          write(snapshot const& snap, std::string const& path);
   }
 }
 CCE_END()
@@ -0,0 +1,69 @@
+/*
+** Copyright 2017 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CCE_RETENTION_OUTPUT_HH
+#  define CCE_RETENTION_OUTPUT_HH
+
+#  include <ostream>
+#  include "com/centreon/engine/namespace.hh"
+
+CCE_BEGIN()
+
+namespace               retention {
+  /**
+   *  @class output output.hh
+   *  @brief Destination of dumped retention objects.
+   *
+   *  An object is started with begin(), each of its fields is written
+   *  in the stream returned by field() and the object is terminated
+   *  by end(). The output format is left to subclasses.
+   */
+  class                 output {
+  public:
+    virtual             ~output() throw () {}
+    virtual void        begin(char const* type) = 0;
+    virtual void        end() = 0;
+    virtual std::ostream&
+                        field(char const* key) = 0;
+  };
+
+  /**
+   *  @class text_output output.hh
+   *  @brief Write retention objects in the text format.
+   */
+  class                 text_output : public output {
+  public:
+                        text_output(std::ostream& os);
+                        ~text_output() throw ();
+    void                begin(char const* type);
+    void                end();
+    std::ostream&       field(char const* key);
+
+  private:
+                        text_output(text_output const& right);
+    text_output&        operator=(text_output const& right);
+
+    bool                _in_field;
+    std::ostream&       _os;
+  };
+}
+
+CCE_END()
+
+#endif // !CCE_RETENTION_OUTPUT_HH
@@ -38,6 +38,8 @@ namespace        retention {
   private:
     typedef void (parser::*store)(state&, object_ptr obj);
 
+    void         _parse_binary(std::string const& path, state& retention);
+
     template<typename T, T& (state::*ptr)() throw ()>
     void         _store_into_list(state& retention, object_ptr obj);
     template<typename T, T& (state::*ptr)() throw ()>
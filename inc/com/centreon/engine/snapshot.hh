@@ -0,0 +1,105 @@
+/*
+** Copyright 2017 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CCE_SNAPSHOT_HH
+#  define CCE_SNAPSHOT_HH
+
+#  include <ctime>
+#  include <string>
+#  include <vector>
+#  include "com/centreon/engine/namespace.hh"
+#  include "com/centreon/engine/objects/comment.hh"
+#  include "com/centreon/engine/objects/contact.hh"
+#  include "com/centreon/engine/objects/downtime.hh"
+#  include "com/centreon/engine/objects/host.hh"
+#  include "com/centreon/engine/objects/service.hh"
+
+CCE_BEGIN()
+
+/**
+ *  @class snapshot snapshot.hh
+ *  @brief Copy of the mutable state of objects.
+ *
+ *  A snapshot is taken by the main thread and can then be read by
+ *  another thread while objects keep on changing. Object structures
+ *  are copied and the strings that change with every check (outputs,
+ *  performance data), comments and downtimes are duplicated. Other
+ *  pointers (names, commands, periods, custom variables, other
+ *  properties) are shared with objects : the main thread flushes the
+ *  snapshot writer before replacing them (configuration reload,
+ *  external commands). Settings needed to write the snapshot are
+ *  copied too, as the configuration can be reloaded while it is
+ *  written.
+ */
+class                   snapshot {
+public:
+                        snapshot(std::string const& head);
+                        ~snapshot() throw ();
+  std::vector<comment_struct> const&
+                        comments() const throw ();
+  std::vector<contact_struct> const&
+                        contacts() const throw ();
+  time_t                created() const throw ();
+  std::vector<scheduled_downtime_struct> const&
+                        downtimes() const throw ();
+  unsigned long long    duration() const throw ();
+  std::string const&    head() const throw ();
+  std::vector<host_struct> const&
+                        hosts() const throw ();
+  unsigned long         retained_contact_host_attribute_mask() const throw ();
+  unsigned long         retained_contact_service_attribute_mask() const throw ();
+  unsigned long         retained_host_attribute_mask() const throw ();
+  std::vector<service_struct> const&
+                        services() const throw ();
+  unsigned long         size() const throw ();
+  bool                  use_binary_state_retention() const throw ();
+
+private:
+                        snapshot(snapshot const& right);
+  snapshot&             operator=(snapshot const& right);
+  char*                 _dup(char const* str);
+
+  std::vector<comment_struct>
+                        _comments;
+  std::vector<contact_struct>
+                        _contacts;
+  time_t                _created;
+  std::vector<scheduled_downtime_struct>
+                        _downtimes;
+  unsigned long long    _duration;
+  std::string           _head;
+  std::vector<host_other_properties>
+                        _host_props;
+  std::vector<host_struct>
+                        _hosts;
+  unsigned long         _retained_contact_host_attribute_mask;
+  unsigned long         _retained_contact_service_attribute_mask;
+  unsigned long         _retained_host_attribute_mask;
+  std::vector<service_other_properties>
+                        _service_props;
+  std::vector<service_struct>
+                        _services;
+  unsigned long         _size;
+  std::vector<char*>    _strings;
+  bool                  _use_binary_state_retention;
+};
+
+CCE_END()
+
+#endif // !CCE_SNAPSHOT_HH
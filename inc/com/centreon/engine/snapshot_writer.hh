@@ -0,0 +1,96 @@
+/*
+** Copyright 2017 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CCE_SNAPSHOT_WRITER_HH
+#  define CCE_SNAPSHOT_WRITER_HH
+
+#  include <string>
+#  include "com/centreon/concurrency/condvar.hh"
+#  include "com/centreon/concurrency/mutex.hh"
+#  include "com/centreon/concurrency/thread.hh"
+#  include "com/centreon/engine/namespace.hh"
+#  include "com/centreon/engine/snapshot.hh"
+
+CCE_BEGIN()
+
+/**
+ *  @class snapshot_writer snapshot_writer.hh
+ *  @brief Write snapshots from a background thread.
+ *
+ *  The main loop only takes snapshots, serialization and file writes
+ *  are done by this thread. Each file has a snapshot being written and
+ *  at most one waiting: a newer snapshot replaces the waiting one,
+ *  that is dropped.
+ */
+class                   snapshot_writer : public concurrency::thread {
+public:
+  enum                  file {
+    retention_file = 0,
+    status_file,
+    file_num
+  };
+
+  struct                stats {
+    unsigned int        dropped;
+    unsigned long long  snapshot_time;
+    unsigned long       snapshot_size;
+    unsigned long long  write_time;
+  };
+
+  typedef bool          (*writer)(
+                          snapshot const& snap,
+                          std::string const& path);
+
+  void                  flush();
+  stats                 get_stats(file f) const;
+  static snapshot_writer&
+                        instance();
+  static void           load();
+  void                  push(
+                          file f,
+                          snapshot* snap,
+                          writer func,
+                          std::string const& path);
+  static void           unload();
+
+private:
+  struct                job {
+    writer              func;
+    std::string         path;
+    snapshot*           snap;
+  };
+
+                        snapshot_writer();
+                        snapshot_writer(snapshot_writer const& right);
+                        ~snapshot_writer() throw ();
+  snapshot_writer&      operator=(snapshot_writer const& right);
+  void                  _run();
+
+  bool                  _busy;
+  concurrency::condvar  _cv;
+  mutable concurrency::mutex
+                        _lock;
+  job                   _pending[file_num];
+  bool                  _quit;
+  stats                 _stats[file_num];
+};
+
+CCE_END()
+
+#endif // !CCE_SNAPSHOT_WRITER_HH
@@ -0,0 +1,134 @@
+/*
+** Copyright 2017 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CCE_SPSC_RING_HH
+#  define CCE_SPSC_RING_HH
+
+#  include <cstddef>
+#  include "com/centreon/engine/namespace.hh"
+
+CCE_BEGIN()
+
+/**
+ *  @class spsc_ring spsc_ring.hh "com/centreon/engine/spsc_ring.hh"
+ *  @brief Lock-free single producer single consumer ring.
+ *
+ *  Fixed capacity ring of slots allocated once. The producer fills the
+ *  slot returned by back() then publishes it with push(), the consumer
+ *  reads the slot returned by front() then releases it with pop().
+ *  Slots are reused, so objects they own (strings, buffers) keep their
+ *  memory from one use to the next.
+ */
+template                 <typename T>
+class                    spsc_ring {
+public:
+  /**
+   *  Constructor.
+   *
+   *  @param[in] capacity  Number of slots, at least 1.
+   */
+                         spsc_ring(std::size_t capacity)
+    : _capacity(capacity ? capacity : 1),
+      _head(0),
+      _slots(new T[_capacity]),
+      _tail(0) {}
+
+  /**
+   *  Destructor.
+   */
+                         ~spsc_ring() throw () {
+    delete[] _slots;
+  }
+
+  /**
+   *  Get the slot to fill, producer side.
+   *
+   *  @return The slot following the last pushed one, NULL if the ring
+   *          is full.
+   */
+  T*                     back() throw () {
+    if (_head - _tail >= _capacity)
+      return (NULL);
+    return (&_slots[_head % _capacity]);
+  }
+
+  /**
+   *  Get the number of slots.
+   *
+   *  @return Capacity of the ring.
+   */
+  std::size_t            capacity() const throw () {
+    return (_capacity);
+  }
+
+  /**
+   *  Get the oldest pushed slot, consumer side.
+   *
+   *  @return The oldest pushed slot, NULL if the ring is empty.
+   */
+  T*                     front() throw () {
+    if (_tail == _head)
+      return (NULL);
+    // Slot content must not be read before the head.
+    __sync_synchronize();
+    return (&_slots[_tail % _capacity]);
+  }
+
+  /**
+   *  Release the slot returned by front(), consumer side.
+   */
+  void                   pop() throw () {
+    // Slot content must be read before it is given back.
+    __sync_synchronize();
+    _tail = _tail + 1;
+    return ;
+  }
+
+  /**
+   *  Publish the slot returned by back(), producer side.
+   */
+  void                   push() throw () {
+    // Slot content must be written before it is published.
+    __sync_synchronize();
+    _head = _head + 1;
+    return ;
+  }
+
+  /**
+   *  Get the number of pushed slots not popped yet.
+   *
+   *  @return Number of used slots.
+   */
+  std::size_t            size() const throw () {
+    return (_head - _tail);
+  }
+
+private:
+                         spsc_ring(spsc_ring const& right);
+  spsc_ring&             operator=(spsc_ring const& right);
+
+  std::size_t const      _capacity;
+  std::size_t volatile   _head;
+  T*                     _slots;
+  std::size_t volatile   _tail;
+};
+
+CCE_END()
+
+#endif // !CCE_SPSC_RING_HH
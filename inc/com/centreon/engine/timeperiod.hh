@@ -28,10 +28,20 @@ extern "C" {
 int  check_time_against_period(
        time_t test_time,
        timeperiod* tperiod);
+int  check_time_against_period_for_timezone(
+       time_t test_time,
+       timeperiod* tperiod,
+       char const* tz);
+void clear_timeperiod_cache();
 void get_next_valid_time(
        time_t pref_time,
        time_t* valid_time,
        timeperiod* tperiod);
+void get_next_valid_time_for_timezone(
+       time_t pref_time,
+       time_t* valid_time,
+       timeperiod* tperiod,
+       char const* tz);
 
 #  ifdef __cplusplus
 }
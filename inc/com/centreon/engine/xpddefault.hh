@@ -61,6 +61,13 @@ int xpddefault_process_service_perfdata_file();
 
 #  ifdef __cplusplus
 }
+
+#    include "com/centreon/engine/perfdata_writer.hh"
+
+com::centreon::engine::perfdata_writer::stats
+    xpddefault_get_host_perfdata_file_stats();
+com::centreon::engine::perfdata_writer::stats
+    xpddefault_get_service_perfdata_file_stats();
 #  endif // C++
 
 #endif // !CCE_XPDDEFAULT_HH
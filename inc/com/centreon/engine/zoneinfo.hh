@@ -0,0 +1,91 @@
+/*
+** Copyright 2017 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CCE_ZONEINFO_HH
+#  define CCE_ZONEINFO_HH
+
+#  include <ctime>
+#  include <string>
+#  include <vector>
+#  include "com/centreon/engine/namespace.hh"
+
+CCE_BEGIN()
+
+/**
+ *  @class zoneinfo zoneinfo.hh "com/centreon/engine/zoneinfo.hh"
+ *  @brief Rules of a timezone.
+ *
+ *  Rules are loaded once from the zoneinfo database (or parsed from a
+ *  POSIX TZ string) and kept until program exit. Unlike localtime_r()
+ *  and mktime(), conversions neither read nor modify the TZ
+ *  environment variable and can be made from any thread.
+ */
+class                  zoneinfo {
+public:
+  static zoneinfo const&
+                       find(char const* tz);
+  void                 localtime(time_t t, struct tm* result) const;
+  time_t               mktime(struct tm* t) const;
+  std::string const&   name() const throw ();
+
+private:
+  struct               ttinfo {
+    std::string        abbr;
+    bool               isdst;
+    long               offset;
+  };
+
+  struct               rule {
+    int                day;
+    char               kind;
+    int                month;
+    long               time;
+    int                week;
+  };
+
+                       zoneinfo(std::string const& name);
+                       zoneinfo(zoneinfo const& right);
+  zoneinfo&            operator=(zoneinfo const& right);
+  ttinfo const&        _find(time_t t) const;
+  ttinfo const&        _find_posix(time_t t) const;
+  bool                 _load_file(std::string const& path);
+  bool                 _parse_posix(char const* str);
+  static char const*   _parse_posix_name(
+                         char const* str,
+                         std::string& name);
+  static char const*   _parse_posix_rule(char const* str, rule& r);
+  static char const*   _parse_posix_time(char const* str, long& t);
+  static long long     _rule_to_time(rule const& r, long long year);
+
+  rule                 _end;
+  bool                 _has_dst;
+  bool                 _has_posix;
+  std::string          _name;
+  ttinfo               _posix[2];
+  rule                 _start;
+  std::vector<long long>
+                       _transitions;
+  std::vector<unsigned char>
+                       _transition_types;
+  std::vector<ttinfo>  _types;
+};
+
+CCE_END()
+
+#endif // !CCE_ZONEINFO_HH
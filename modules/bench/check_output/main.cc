@@ -0,0 +1,196 @@
+/*
+** Copyright 2017 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstdlib>
+#include <cstring>
+#ifdef HAVE_GETOPT_H
+#  include <getopt.h>
+#endif // HAVE_GETOPT_H
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <unistd.h>
+#include "com/centreon/clib.hh"
+#include "com/centreon/engine/utils.hh"
+#include "com/centreon/timestamp.hh"
+
+using namespace com::centreon;
+
+// Number of allocations performed since the program started.
+static unsigned long long allocations(0);
+
+/**
+ *  Count allocations.
+ */
+void* operator new(std::size_t size) throw (std::bad_alloc) {
+  ++allocations;
+  void* ptr(malloc(size ? size : 1));
+  if (!ptr)
+    throw (std::bad_alloc());
+  return (ptr);
+}
+
+void* operator new[](std::size_t size) throw (std::bad_alloc) {
+  return (operator new(size));
+}
+
+void operator delete(void* ptr) throw () {
+  free(ptr);
+}
+
+void operator delete[](void* ptr) throw () {
+  free(ptr);
+}
+
+/**
+ *  Plugin outputs as received by the checker, with newlines escaped.
+ */
+static char const* const outputs[] = {
+  // check_ping.
+  "PING OK - Packet loss = 0%, RTA = 0.80 ms"
+  "|rta=0.800000ms;3000.000000;5000.000000;0.000000 pl=0%;80;100;0",
+  // check_disk, perf data on the long output.
+  "DISK OK - free space: / 3326 MB (56% inode=99%);\\n"
+  "/boot 70 MB (75% inode=99%);\\n"
+  "/home 12058 MB (82% inode=99%);"
+  "| /=2643MB;5948;5958;0;5968\\n"
+  "/boot=68MB;88;93;0;98\\n"
+  "/home=2728MB;14118;14128;0;14138",
+  // check_snmp_int, long output without perf data.
+  "OK: 4 interface(s) up\\n"
+  "eth0: up (in: 12.3Mbps, out: 1.2Mbps)\\n"
+  "eth1: up (in: 0.1Mbps, out: 0.0Mbps)\\n"
+  "eth2: up (in: 3.4Mbps, out: 7.8Mbps)\\n"
+  "lo: up (in: 0.0Mbps, out: 0.0Mbps)",
+  // check_multi, long output and perf data on several lines.
+  "OK - 8 plugins checked, 8 ok\\n"
+  "[ 1] load OK - load average: 0.12, 0.08, 0.05\\n"
+  "[ 2] procs PROCS OK: 112 processes\\n"
+  "[ 3] users USERS OK - 2 users currently logged in\\n"
+  "[ 4] swap SWAP OK - 100% free (2047 MB out of 2047 MB)\\n"
+  "[ 5] root DISK OK - free space: / 3326 MB (56%)\\n"
+  "[ 6] ntp NTP OK: Offset -0.0004 secs\\n"
+  "[ 7] ssh SSH OK - OpenSSH_7.4 (protocol 2.0)\\n"
+  "[ 8] http HTTP OK: HTTP/1.1 200 OK - 612 bytes in 0.001 second"
+  "|check_multi::check_multi::plugins=8 time=0.21\\n"
+  "load::check_load::load1=0.12;5;10;0 load5=0.08;4;6;0 load15=0.05;3;4;0\\n"
+  "procs::check_procs::procs=112;250;400;0\\n"
+  "users::check_users::users=2;5;10;0\\n"
+  "swap::check_swap::swap=2047MB;0;0;0;2047\\n"
+  "root::check_disk::/=2643MB;5948;5958;0;5968\\n"
+  "ntp::check_ntp::offset=-0.0004s;60;120;\\n"
+  "http::check_http::time=0.001s;;;0 size=612B;;;0"
+};
+
+/**
+ *  Bench how long Centreon Engine needs to split plugin outputs into
+ *  short output, long output and performance data.
+ *
+ *  @return EXIT_SUCCESS on success.
+ */
+int main(int argc, char* argv[]) {
+  // Initialization.
+  clib::load();
+
+  // Options.
+#ifdef HAVE_GETOPT_H
+  int option_index(0);
+  static struct option const long_options[] = {
+    { "help", no_argument, NULL, '?' },
+    { "count", required_argument, NULL, 'c' },
+    { NULL, no_argument, NULL, '\0' }
+  };
+#endif // HAVE_GETOPT_H
+  int count(1000000);
+  bool help(false);
+
+  // Process command line arguments.
+  int c;
+#ifdef HAVE_GETOPT_H
+  while ((c = getopt_long(
+                argc,
+                argv,
+                "+?c:",
+                long_options,
+                &option_index)) != -1) {
+#else
+  while ((c = getopt(argc, argv, "+?c:")) != -1) {
+#endif // HAVE_GETOPT_H
+    switch (c) {
+    case '?':
+      help = true;
+      break ;
+    case 'c':
+      count = strtol(optarg, NULL, 0);
+      break ;
+    }
+  }
+  if (help || (count <= 0)) {
+    std::cout
+      << "  -? --help   Print this help.\n"
+      << "  -c --count  Number of times each output is parsed (default is "
+      << count << ").\n"
+      << "\n"
+      << "This benchmarking tool aims to mesure the time and the number\n"
+      << "of allocations needed by Centreon Engine to split plugin\n"
+      << "outputs into short output, long output and performance data.\n";
+    clib::unload();
+    return (EXIT_FAILURE);
+  }
+
+  std::cout << "  Output  Length  Nanoseconds/result  Allocations/result\n";
+  for (unsigned int i(0); i < sizeof(outputs) / sizeof(*outputs); ++i) {
+    std::size_t len(strlen(outputs[i]));
+    char* buf(new char[len + 1]);
+    unsigned long long allocs_before(allocations);
+    timestamp start(timestamp::now());
+    for (int j(0); j < count; ++j) {
+      // Output is modified by parsing.
+      memcpy(buf, outputs[i], len + 1);
+      char* short_output;
+      char* long_output;
+      char* perf_data;
+      parse_check_output(
+        buf,
+        &short_output,
+        &long_output,
+        &perf_data,
+        true,
+        true);
+      delete[] short_output;
+      delete[] long_output;
+      delete[] perf_data;
+    }
+    unsigned long long duration(
+      (timestamp::now() - start).to_useconds());
+    unsigned long long allocs(allocations - allocs_before);
+    delete[] buf;
+    std::cout << "  " << std::setw(6) << i + 1
+              << "  " << std::setw(6) << len
+              << "  " << std::setw(18)
+              << duration * 1000 / count
+              << "  " << std::setw(18) << std::fixed << std::setprecision(2)
+              << static_cast<double>(allocs) / count << "\n";
+  }
+
+  // Unload Clib.
+  clib::unload();
+
+  return (EXIT_SUCCESS);
+}
@@ -0,0 +1,181 @@
+/*
+** Copyright 2017 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstdlib>
+#include <cstring>
+#ifdef HAVE_GETOPT_H
+#  include <getopt.h>
+#endif // HAVE_GETOPT_H
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <unistd.h>
+#include "com/centreon/clib.hh"
+#include "com/centreon/engine/commands/environment.hh"
+#include "com/centreon/engine/commands/raw.hh"
+#include "com/centreon/engine/configuration/applier/state.hh"
+#include "com/centreon/engine/configuration/state.hh"
+#include "com/centreon/engine/globals.hh"
+#include "com/centreon/engine/macros.hh"
+#include "com/centreon/engine/objects/customvariablesmember.hh"
+#include "com/centreon/engine/objects/host.hh"
+#include "com/centreon/engine/objects/service.hh"
+#include "com/centreon/timestamp.hh"
+
+using namespace com::centreon;
+using namespace com::centreon::engine;
+
+/**
+ *  Build the environment of a command count times.
+ *
+ *  @param[in] mac      Macros of the command.
+ *  @param[in] count    Number of environments to build.
+ *  @param[in] invalid  True to invalidate the cache before each build.
+ *
+ *  @return Duration in microseconds.
+ */
+static unsigned long long build(
+                            nagios_macros& mac,
+                            int count,
+                            bool invalid) {
+  timestamp start(timestamp::now());
+  for (int i(0); i < count; ++i) {
+    if (invalid)
+      customvariables_modified();
+    commands::environment env;
+    commands::raw::build_environment_macros(mac, env);
+  }
+  return ((timestamp::now() - start).to_useconds());
+}
+
+/**
+ *  Bench how long Centreon Engine needs to build the environment
+ *  macros of a command, with and without cached environments.
+ *
+ *  @return EXIT_SUCCESS on success.
+ */
+int main(int argc, char* argv[]) {
+  // Initialization.
+  clib::load();
+
+  // Options.
+#ifdef HAVE_GETOPT_H
+  int option_index(0);
+  static struct option const long_options[] = {
+    { "help", no_argument, NULL, '?' },
+    { "count", required_argument, NULL, 'c' },
+    { "customvars", required_argument, NULL, 'v' },
+    { NULL, no_argument, NULL, '\0' }
+  };
+#endif // HAVE_GETOPT_H
+  int count(100000);
+  int customvars(8);
+  bool help(false);
+
+  // Process command line arguments.
+  int c;
+#ifdef HAVE_GETOPT_H
+  while ((c = getopt_long(
+                argc,
+                argv,
+                "+?c:v:",
+                long_options,
+                &option_index)) != -1) {
+#else
+  while ((c = getopt(argc, argv, "+?c:v:")) != -1) {
+#endif // HAVE_GETOPT_H
+    switch (c) {
+    case '?':
+      help = true;
+      break ;
+    case 'c':
+      count = strtol(optarg, NULL, 0);
+      break ;
+    case 'v':
+      customvars = strtol(optarg, NULL, 0);
+      break ;
+    }
+  }
+  if (help || (count <= 0) || (customvars < 0)) {
+    std::cout
+      << "  -? --help        Print this help.\n"
+      << "  -c --count       Number of environments built (default is "
+      << count << ").\n"
+      << "  -v --customvars  Number of custom variables of the host and\n"
+      << "                   of the service (default is "
+      << customvars << ").\n"
+      << "\n"
+      << "This benchmarking tool aims to mesure the time needed by\n"
+      << "Centreon Engine to build the environment macros of a command,\n"
+      << "when cached environments are reused and when they are built\n"
+      << "again for each command.\n";
+    clib::unload();
+    return (EXIT_FAILURE);
+  }
+
+  config = new configuration::state;
+  config->enable_environment_macros(true);
+  configuration::applier::state::load();
+  init_macrox_names();
+
+  // Objects of the command.
+  host hst;
+  memset(&hst, 0, sizeof(hst));
+  hst.name = const_cast<char*>("host");
+  service svc;
+  memset(&svc, 0, sizeof(svc));
+  svc.host_name = hst.name;
+  svc.description = const_cast<char*>("service");
+  for (int i(0); i < customvars; ++i) {
+    std::ostringstream name;
+    name << "VAR" << i;
+    add_custom_variable_to_host(&hst, name.str().c_str(), "host value");
+    add_custom_variable_to_service(&svc, name.str().c_str(), "service value");
+  }
+
+  // Standard macros are set so that none of them are grabbed.
+  nagios_macros mac;
+  memset(&mac, 0, sizeof(mac));
+  for (unsigned int i(0); i < MACRO_X_COUNT; ++i)
+    mac.x[i] = const_cast<char*>("value");
+  mac.host_ptr = &hst;
+  mac.service_ptr = &svc;
+
+  std::cout << "  Environments  Nanoseconds/environment\n";
+  unsigned long long cached(build(mac, count, false));
+  std::cout << "  " << std::setw(12) << "cached"
+            << "  " << std::setw(23) << cached * 1000 / count << "\n";
+  unsigned long long uncached(build(mac, count, true));
+  std::cout << "  " << std::setw(12) << "rebuilt"
+            << "  " << std::setw(23) << uncached * 1000 / count << "\n";
+
+  // Cleanup.
+  remove_all_custom_variables_from_host(&hst);
+  remove_all_custom_variables_from_service(&svc);
+  free_macrox_names();
+  configuration::applier::state::unload();
+  delete config;
+  config = NULL;
+
+  // Unload Clib.
+  clib::unload();
+
+  return (EXIT_SUCCESS);
+}
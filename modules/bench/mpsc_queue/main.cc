@@ -0,0 +1,296 @@
+/*
+** Copyright 2017 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstdlib>
+#include <deque>
+#ifdef HAVE_GETOPT_H
+#  include <getopt.h>
+#endif // HAVE_GETOPT_H
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <unistd.h>
+#include <vector>
+#include "com/centreon/clib.hh"
+#include "com/centreon/concurrency/locker.hh"
+#include "com/centreon/concurrency/mutex.hh"
+#include "com/centreon/concurrency/thread.hh"
+#include "com/centreon/engine/mpsc_queue.hh"
+#include "com/centreon/timestamp.hh"
+
+using namespace com::centreon;
+using namespace com::centreon::engine;
+
+struct                  item {
+  unsigned int          producer;
+  unsigned int          seq;
+  item*                 next;
+};
+
+/**
+ *  Queue of items protected by a mutex, as check results were before
+ *  the lock-free queue.
+ */
+class                   locked_queue {
+public:
+  void                  push(item* node) {
+    concurrency::locker lock(&_mutex);
+    _items.push_back(node);
+  }
+
+  void                  pop_all(std::deque<item*>& items) {
+    concurrency::locker lock(&_mutex);
+    items.swap(_items);
+  }
+
+private:
+  std::deque<item*>     _items;
+  concurrency::mutex    _mutex;
+};
+
+static int volatile     started(0);
+
+/**
+ *  Thread pushing items into a queue.
+ */
+template                <typename Q>
+class                   producer : public concurrency::thread {
+public:
+                        producer(Q& queue, unsigned int id, int count)
+    : _count(count), _id(id), _queue(queue) {}
+
+private:
+  void                  _run() {
+    // All producers push at the same time.
+    while (!started)
+      concurrency::thread::yield();
+    for (int i(0); i < _count; ++i) {
+      item* node(new item);
+      node->producer = _id;
+      node->seq = i;
+      node->next = NULL;
+      _queue.push(node);
+    }
+  }
+
+  int                   _count;
+  unsigned int          _id;
+  Q&                    _queue;
+};
+
+/**
+ *  Check the order of a consumed item.
+ *
+ *  @param[in]     node  The item.
+ *  @param[in,out] next  Next expected sequence of each producer.
+ *
+ *  @return 1 if the item is out of order, 0 otherwise.
+ */
+static unsigned int check(item const* node, std::vector<unsigned int>& next) {
+  unsigned int retval(node->seq != next[node->producer]);
+  next[node->producer] = node->seq + 1;
+  return (retval);
+}
+
+/**
+ *  Get all items pushed by producers into a lock-free queue.
+ *
+ *  @param[in]  producers  Number of producers.
+ *  @param[in]  count      Items pushed by each producer.
+ *  @param[out] disorders  Items out of their producer order.
+ *
+ *  @return Duration in microseconds.
+ */
+static unsigned long long consume_mpsc_queue(
+                            int producers,
+                            int count,
+                            unsigned int& disorders) {
+  mpsc_queue<item> queue;
+  std::vector<producer<mpsc_queue<item> >*> threads;
+  for (int i(0); i < producers; ++i) {
+    threads.push_back(new producer<mpsc_queue<item> >(queue, i, count));
+    threads.back()->exec();
+  }
+
+  std::vector<unsigned int> next(producers, 0);
+  unsigned long long total(static_cast<unsigned long long>(producers) * count);
+  unsigned long long received(0);
+  disorders = 0;
+  timestamp start(timestamp::now());
+  __sync_lock_test_and_set(&started, 1);
+  while (received < total) {
+    item* node(queue.pop_all());
+    while (node) {
+      item* following(node->next);
+      disorders += check(node, next);
+      delete node;
+      node = following;
+      ++received;
+    }
+  }
+  unsigned long long duration((timestamp::now() - start).to_useconds());
+  __sync_lock_release(&started);
+
+  for (unsigned int i(0); i < threads.size(); ++i) {
+    threads[i]->wait();
+    delete threads[i];
+  }
+  return (duration);
+}
+
+/**
+ *  Get all items pushed by producers into a queue protected by a
+ *  mutex.
+ *
+ *  @param[in]  producers  Number of producers.
+ *  @param[in]  count      Items pushed by each producer.
+ *  @param[out] disorders  Items out of their producer order.
+ *
+ *  @return Duration in microseconds.
+ */
+static unsigned long long consume_locked_queue(
+                            int producers,
+                            int count,
+                            unsigned int& disorders) {
+  locked_queue queue;
+  std::vector<producer<locked_queue>*> threads;
+  for (int i(0); i < producers; ++i) {
+    threads.push_back(new producer<locked_queue>(queue, i, count));
+    threads.back()->exec();
+  }
+
+  std::vector<unsigned int> next(producers, 0);
+  unsigned long long total(static_cast<unsigned long long>(producers) * count);
+  unsigned long long received(0);
+  disorders = 0;
+  std::deque<item*> items;
+  timestamp start(timestamp::now());
+  __sync_lock_test_and_set(&started, 1);
+  while (received < total) {
+    queue.pop_all(items);
+    for (std::deque<item*>::const_iterator
+           it(items.begin()), end(items.end());
+         it != end;
+         ++it) {
+      disorders += check(*it, next);
+      delete *it;
+      ++received;
+    }
+    items.clear();
+  }
+  unsigned long long duration((timestamp::now() - start).to_useconds());
+  __sync_lock_release(&started);
+
+  for (unsigned int i(0); i < threads.size(); ++i) {
+    threads[i]->wait();
+    delete threads[i];
+  }
+  return (duration);
+}
+
+/**
+ *  Bench how many results per second Centreon Engine can move from
+ *  many producer threads to a consumer thread, with the lock-free queue
+ *  used for check results and with a queue protected by a mutex.
+ *
+ *  @return EXIT_SUCCESS on success.
+ */
+int main(int argc, char* argv[]) {
+  // Initialization.
+  clib::load();
+
+  // Options.
+#ifdef HAVE_GETOPT_H
+  int option_index(0);
+  static struct option const long_options[] = {
+    { "help", no_argument, NULL, '?' },
+    { "count", required_argument, NULL, 'c' },
+    { "producers", required_argument, NULL, 'p' },
+    { NULL, no_argument, NULL, '\0' }
+  };
+#endif // HAVE_GETOPT_H
+  int count(100000);
+  int producers(8);
+  bool help(false);
+
+  // Process command line arguments.
+  int c;
+#ifdef HAVE_GETOPT_H
+  while ((c = getopt_long(
+                argc,
+                argv,
+                "+?c:p:",
+                long_options,
+                &option_index)) != -1) {
+#else
+  while ((c = getopt(argc, argv, "+?c:p:")) != -1) {
+#endif // HAVE_GETOPT_H
+    switch (c) {
+    case '?':
+      help = true;
+      break ;
+    case 'c':
+      count = strtol(optarg, NULL, 0);
+      break ;
+    case 'p':
+      producers = strtol(optarg, NULL, 0);
+      break ;
+    }
+  }
+  if (help || (count <= 0) || (producers <= 0)) {
+    std::cout
+      << "  -? --help       Print this help.\n"
+      << "  -c --count      Number of items pushed by each producer\n"
+      << "                  (default is " << count << ").\n"
+      << "  -p --producers  Number of producer threads (default is "
+      << producers << ").\n"
+      << "\n"
+      << "This benchmarking tool aims to mesure the number of check\n"
+      << "results per second Centreon Engine can move from many\n"
+      << "producer threads to a consumer thread, with the lock-free\n"
+      << "queue used for check results and with a queue protected by a\n"
+      << "mutex. Results must be received in the order each producer\n"
+      << "pushed them.\n";
+    clib::unload();
+    return (EXIT_FAILURE);
+  }
+
+  unsigned long long total(static_cast<unsigned long long>(producers) * count);
+  std::cout << "  Queue        Producers  Results/second  Disorders\n";
+  unsigned int mpsc_disorders;
+  unsigned long long mpsc(consume_mpsc_queue(producers, count, mpsc_disorders));
+  std::cout << "  " << std::setw(11) << "lock-free"
+            << "  " << std::setw(9) << producers
+            << "  " << std::setw(14) << total * 1000000 / (mpsc ? mpsc : 1)
+            << "  " << std::setw(9) << mpsc_disorders << "\n";
+  unsigned int locked_disorders;
+  unsigned long long locked(
+                       consume_locked_queue(producers, count, locked_disorders));
+  std::cout << "  " << std::setw(11) << "mutex"
+            << "  " << std::setw(9) << producers
+            << "  " << std::setw(14) << total * 1000000 / (locked ? locked : 1)
+            << "  " << std::setw(9) << locked_disorders << "\n";
+
+  // Unload Clib.
+  clib::unload();
+
+  return ((mpsc_disorders || locked_disorders)
+          ? EXIT_FAILURE
+          : EXIT_SUCCESS);
+}
@@ -0,0 +1,153 @@
+/*
+** Copyright 2017 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstdlib>
+#include <exception>
+#ifdef HAVE_GETOPT_H
+#  include <getopt.h>
+#endif // HAVE_GETOPT_H
+#include <iostream>
+#include <unistd.h>
+#include "com/centreon/clib.hh"
+#include "com/centreon/engine/configuration/parser.hh"
+#include "com/centreon/engine/configuration/state.hh"
+#include "com/centreon/timestamp.hh"
+#include "engine_cfg.hh"
+
+using namespace com::centreon;
+using namespace com::centreon::engine;
+
+/**
+ *  Bench how long Centreon Engine needs to parse a configuration.
+ *
+ *  @return EXIT_SUCCESS on success.
+ */
+int main(int argc, char* argv[]) {
+  // Initialization.
+  clib::load();
+
+  // Options.
+#ifdef HAVE_GETOPT_H
+  int option_index(0);
+  static struct option const long_options[] = {
+    { "help", no_argument, NULL, '?' },
+    { "hosts", required_argument, NULL, 'H' },
+    { "services", required_argument, NULL, 'S' },
+    { "count", required_argument, NULL, 'c' },
+    { NULL, no_argument, NULL, '\0' }
+  };
+#endif // HAVE_GETOPT_H
+  int hosts(1000);
+  int services(20000);
+  int count(5);
+  bool help(false);
+
+  // Process command line arguments.
+  int c;
+#ifdef HAVE_GETOPT_H
+  while ((c = getopt_long(
+                argc,
+                argv,
+                "+?H:S:c:",
+                long_options,
+                &option_index)) != -1) {
+#else
+  while ((c = getopt(argc, argv, "+?H:S:c:")) != -1) {
+#endif // HAVE_GETOPT_H
+    switch (c) {
+    case '?':
+      help = true;
+      break ;
+    case 'H':
+      hosts = strtol(optarg, NULL, 0);
+      break ;
+    case 'S':
+      services = strtol(optarg, NULL, 0);
+      break ;
+    case 'c':
+      count = strtol(optarg, NULL, 0);
+      break ;
+    }
+  }
+  if (help || (hosts <= 0) || (services < hosts) || (count <= 0)) {
+    std::cout
+      << "  -? --help      Print this help.\n"
+      << "  -H --hosts     Number of hosts in the configuration (default is "
+      << hosts << ").\n"
+      << "  -S --services  Number of services in the configuration (default is "
+      << services << ").\n"
+      << "  -c --count     Number of times the configuration is parsed (default is "
+      << count << ").\n"
+      << "\n"
+      << "This benchmarking tool aims to mesure the time needed by\n"
+      << "Centreon Engine to parse its configuration files. They are\n"
+      << "generated like the passive checks benchmark tool does.\n";
+    clib::unload();
+    return (EXIT_FAILURE);
+  }
+
+  int retval(EXIT_SUCCESS);
+  try {
+    // Generate configuration files.
+    std::cout << "Generating configuration files...               ";
+    std::cout.flush();
+    engine_cfg cfg_files("", 0, 0, 0, hosts, services);
+    std::cout << "Done\n";
+
+    // Parse them.
+    unsigned long long best(0);
+    unsigned long long total(0);
+    for (int i(0); i < count; ++i) {
+      std::cout << "\rParsing configuration files...                  "
+                << i << "/" << count;
+      std::cout.flush();
+      configuration::state config;
+      configuration::parser p;
+      timestamp start(timestamp::now());
+      p.parse(cfg_files.main_file(), config);
+      unsigned long long duration(
+        (timestamp::now() - start).to_useconds());
+      if (!i || (duration < best))
+        best = duration;
+      total += duration;
+    }
+    std::cout << "\rParsing configuration files...                  Done               \n";
+
+    // Print results.
+    std::cout << "\n"
+              << "  Total objects                                 "
+              << 1 + hosts + services << "\n"
+              << "  Best parsing time in microseconds             "
+              << best << "\n"
+              << "  Average parsing time in microseconds          "
+              << total / count << "\n"
+              << "  Average objects parsed per second             "
+              << static_cast<double>(1 + hosts + services) * count
+                 * 1000000 / (total ? total : 1) << "\n";
+  }
+  catch (std::exception const& e) {
+    std::cerr << "\nerror: " << e.what() << std::endl;
+    retval = EXIT_FAILURE;
+  }
+
+  // Unload Clib.
+  clib::unload();
+
+  return (retval);
+}
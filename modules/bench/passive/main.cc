@@ -29,8 +29,11 @@
 #include <unistd.h>
 #include "com/centreon/clib.hh"
 #include "com/centreon/process.hh"
+#include "com/centreon/timestamp.hh"
 #include "engine_cfg.hh"
 
+using namespace com::centreon;
+
 /**
  *  Bench how long Centreon Engine needs to process some passive check
  *  results.
@@ -151,28 +154,26 @@ int main(int argc, char* argv[]) {
     centengine.exec(cmdline);
     while (access(cfg_files.command_file().c_str(), F_OK))
       sleep(1);
-    time_t start_time(time(NULL));  // Perform benchmark.
+    timestamp start_time(timestamp::now());  // Perform benchmark.
     std::cout << "Done\n";
 
     // Send external commands.
     {
       time_t now(time(NULL));
       // Send a little bit more external commands as writing and reading
-      // to the same pipe is not thread safe.
+      // to the same pipe is not thread safe. Commands are sent as fast
+      // as possible, Centreon Engine blocks the writes while it is busy.
       std::ofstream ofs;
       ofs.open(cfg_files.command_file().c_str());
       if (ofs.good()) {
-        int slice(count / 100 + 1);
         for (int i(0), limit(count * 105 / 100); i < limit; ++i) {
           if (!(i % 10000)) {
             std::cout << "\rSending passive check results...                "
                       << i << "/" << count;
             std::cout.flush();
+            if (centengine.wait(0))
+              break ;
           }
-          if (!(i % slice))
-            sleep(1);
-          if (centengine.wait(0))
-            break ;
           int service_id(random() % passiveservices + 1);
           ofs << "[" << now << "] PROCESS_SERVICE_CHECK_RESULT;"
               << (service_id - 1) / (passiveservices / passivehosts) + 1 << ";"
@@ -181,33 +182,35 @@ int main(int argc, char* argv[]) {
         ofs.close();
       }
     }
-    time_t send_time(time(NULL));
+    timestamp send_time(timestamp::now());
     std::cout << "\rSending passive check results...                Done               \n";
 
     // Wait for Centreon Engine.
     std::cout << "Waiting for Centreon Engine...                  ";
     std::cout.flush();
     centengine.wait();
-    time_t end_time(time(NULL));
+    timestamp end_time(timestamp::now());
     std::cout << "Done\n";
 
     // Print results.
+    unsigned long long send_duration(
+      (send_time - start_time).to_mseconds());
+    unsigned long long processing_duration(
+      (end_time - start_time).to_mseconds());
     std::cout << "\n"
               << "  Total passive check results                   "
               << count << "\n"
-	      << "  Total send time in seconds                    "
-	      << send_time - start_time << "\n"
+              << "  Total send time in seconds                    "
+              << send_duration / 1000.0 << "\n"
               << "  Total processing time in seconds              "
-              << end_time - start_time << "\n"
-	      << "  Average check results sent per second         "
-	      << static_cast<double>(count) / ((send_time != start_time)
-					       ? (send_time - start_time)
-					       : 1)
-	      << "\n"
+              << processing_duration / 1000.0 << "\n"
+              << "  Average check results sent per second         "
+              << count * 1000.0 / (send_duration ? send_duration : 1)
+              << "\n"
               << "  Average check results processed per second    "
-              << static_cast<double>(count) / ((end_time != start_time)
-                                               ? (end_time - start_time)
-                                               : 1)
+              << count * 1000.0 / (processing_duration
+                                   ? processing_duration
+                                   : 1)
               << "\n";
   }
   // Generate configuration files.
@@ -0,0 +1,172 @@
+/*
+** Copyright 2017 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#ifdef HAVE_GETOPT_H
+#  include <getopt.h>
+#endif // HAVE_GETOPT_H
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <unistd.h>
+#include "com/centreon/clib.hh"
+#include "com/centreon/engine/perfdata_writer.hh"
+#include "com/centreon/timestamp.hh"
+
+using namespace com::centreon;
+using namespace com::centreon::engine;
+
+/**
+ *  Service performance data line, as produced by the default template.
+ */
+static char const* const perfdata_line =
+  "[SERVICEPERFDATA]\t1500000000\tsrv-web-042\tDisk-/var\t0.012\t0.251\t"
+  "DISK OK - free space: /var 3326 MB (56% inode=99%);\t"
+  "/var=2643MB;5948;5958;0;5968";
+
+/**
+ *  Write lines to a file through a writer.
+ *
+ *  @param[in] path            The file path.
+ *  @param[in] count           Number of lines.
+ *  @param[in] flush_interval  Writer flush interval.
+ *  @param[in] flush_size      Writer flush size.
+ */
+static void bench(
+              std::string const& path,
+              int count,
+              unsigned int flush_interval,
+              unsigned int flush_size) {
+  FILE* fp(fopen(path.c_str(), "w"));
+  if (!fp) {
+    std::cerr << "cannot open '" << path << "'\n";
+    return ;
+  }
+
+  perfdata_writer::stats s;
+  unsigned long long push_duration;
+  unsigned long long total_duration;
+  {
+    perfdata_writer w("bench", flush_interval, flush_size);
+    w.attach(fp);
+    timestamp start(timestamp::now());
+    for (int i(0); i < count; ++i) {
+      std::string line(perfdata_line);
+      w.push(line);
+    }
+    push_duration = (timestamp::now() - start).to_useconds();
+    w.detach();
+    total_duration = (timestamp::now() - start).to_useconds();
+    s = w.get_stats();
+  }
+  fclose(fp);
+
+  if (!push_duration)
+    push_duration = 1;
+  if (!total_duration)
+    total_duration = 1;
+  std::cout << "  " << std::setw(8) << flush_interval
+            << "  " << std::setw(10) << flush_size
+            << "  " << std::setw(14)
+            << static_cast<unsigned long long>(
+                 count * 1000000.0 / push_duration)
+            << "  " << std::setw(14)
+            << static_cast<unsigned long long>(
+                 count * 1000000.0 / total_duration)
+            << "  " << std::setw(10) << s.writes << "\n";
+  return ;
+}
+
+/**
+ *  Bench how many performance data lines per second Centreon Engine
+ *  can write to a performance data file.
+ *
+ *  @return EXIT_SUCCESS on success.
+ */
+int main(int argc, char* argv[]) {
+  // Initialization.
+  clib::load();
+
+  // Options.
+#ifdef HAVE_GETOPT_H
+  int option_index(0);
+  static struct option const long_options[] = {
+    { "help", no_argument, NULL, '?' },
+    { "count", required_argument, NULL, 'c' },
+    { "file", required_argument, NULL, 'f' },
+    { NULL, no_argument, NULL, '\0' }
+  };
+#endif // HAVE_GETOPT_H
+  int count(1000000);
+  std::string path("/tmp/centengine_bench_perfdata");
+  bool help(false);
+
+  // Process command line arguments.
+  int c;
+#ifdef HAVE_GETOPT_H
+  while ((c = getopt_long(
+                argc,
+                argv,
+                "+?c:f:",
+                long_options,
+                &option_index)) != -1) {
+#else
+  while ((c = getopt(argc, argv, "+?c:f:")) != -1) {
+#endif // HAVE_GETOPT_H
+    switch (c) {
+    case '?':
+      help = true;
+      break ;
+    case 'c':
+      count = strtol(optarg, NULL, 0);
+      break ;
+    case 'f':
+      path = optarg;
+      break ;
+    }
+  }
+  if (help || (count <= 0)) {
+    std::cout
+      << "  -? --help   Print this help.\n"
+      << "  -c --count  Number of lines written (default is "
+      << count << ").\n"
+      << "  -f --file   Performance data file (default is "
+      << path << ").\n"
+      << "\n"
+      << "This benchmarking tool aims to mesure how many lines per second\n"
+      << "Centreon Engine can write to a performance data file, with each\n"
+      << "line written immediately or buffered by the writer thread.\n";
+    clib::unload();
+    return (EXIT_FAILURE);
+  }
+
+  std::cout << "  Interval  Flush size  Pushed lines/s  Written lines/s"
+               "      Writes\n";
+  bench(path, count, 0, 0);
+  bench(path, count, 1000, 4096);
+  bench(path, count, 1000, 65536);
+  bench(path, count, 1000, 1048576);
+  unlink(path.c_str());
+
+  // Unload Clib.
+  clib::unload();
+
+  return (EXIT_SUCCESS);
+}
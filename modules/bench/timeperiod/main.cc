@@ -0,0 +1,207 @@
+/*
+** Copyright 2017 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstdlib>
+#include <ctime>
+#ifdef HAVE_GETOPT_H
+#  include <getopt.h>
+#endif // HAVE_GETOPT_H
+#include <iomanip>
+#include <iostream>
+#include <unistd.h>
+#include <vector>
+#include "com/centreon/clib.hh"
+#include "com/centreon/engine/common.hh"
+#include "com/centreon/engine/configuration/applier/state.hh"
+#include "com/centreon/engine/configuration/state.hh"
+#include "com/centreon/engine/globals.hh"
+#include "com/centreon/engine/objects/daterange.hh"
+#include "com/centreon/engine/objects/timeperiod.hh"
+#include "com/centreon/engine/objects/timeperiodexclusion.hh"
+#include "com/centreon/engine/objects/timerange.hh"
+#include "com/centreon/engine/timeperiod.hh"
+#include "com/centreon/timestamp.hh"
+
+using namespace com::centreon;
+using namespace com::centreon::engine;
+
+/**
+ *  Create office hours with some holidays excluded.
+ *
+ *  @return The office hours timeperiod.
+ */
+static timeperiod* create_office_hours() {
+  timeperiod* holidays(add_timeperiod("holidays", "Holidays"));
+  time_t now(time(NULL));
+  tm t;
+  localtime_r(&now, &t);
+  static int const days[][2] = {
+    { 0, 1 }, { 4, 14 }, { 6, 14 }, { 7, 15 }, { 10, 11 }, { 11, 25 }
+  };
+  for (unsigned int i(0); i < sizeof(days) / sizeof(*days); ++i)
+    for (int year(t.tm_year + 1900); year <= t.tm_year + 1901; ++year) {
+      daterange* dr(add_exception_to_timeperiod(
+                      holidays,
+                      DATERANGE_CALENDAR_DATE,
+                      year, days[i][0], days[i][1], 0, 0,
+                      year, days[i][0], days[i][1], 0, 0,
+                      0));
+      add_timerange_to_daterange(dr, 0, 24 * 60 * 60);
+    }
+
+  timeperiod* office(add_timeperiod("office", "Office hours"));
+  for (int day(1); day < 6; ++day) {
+    add_timerange_to_timeperiod(office, day, 8 * 60 * 60, 12 * 60 * 60);
+    add_timerange_to_timeperiod(office, day, 14 * 60 * 60, 18 * 60 * 60);
+  }
+  add_exclusion_to_timeperiod(office, "holidays")->timeperiod_ptr = holidays;
+  return (office);
+}
+
+/**
+ *  Get next valid times of times going on.
+ *
+ *  @param[in]  tp      Timeperiod.
+ *  @param[in]  times   Preferred times.
+ *  @param[out] valid   Next valid times.
+ *
+ *  @return Duration in microseconds.
+ */
+static unsigned long long next_valid_times(
+                            timeperiod* tp,
+                            std::vector<time_t> const& times,
+                            std::vector<time_t>& valid) {
+  valid.resize(times.size());
+  timestamp start(timestamp::now());
+  for (unsigned int i(0); i < times.size(); ++i)
+    get_next_valid_time(times[i], &valid[i], tp);
+  return ((timestamp::now() - start).to_useconds());
+}
+
+/**
+ *  Bench how long Centreon Engine needs to get the next valid time of
+ *  a timeperiod, from cached valid intervals and computed.
+ *
+ *  @return EXIT_SUCCESS on success.
+ */
+int main(int argc, char* argv[]) {
+  // Initialization.
+  clib::load();
+
+  // Options.
+#ifdef HAVE_GETOPT_H
+  int option_index(0);
+  static struct option const long_options[] = {
+    { "help", no_argument, NULL, '?' },
+    { "days", required_argument, NULL, 'd' },
+    { "step", required_argument, NULL, 's' },
+    { NULL, no_argument, NULL, '\0' }
+  };
+#endif // HAVE_GETOPT_H
+  int days(200);
+  int step(60);
+  bool help(false);
+
+  // Process command line arguments.
+  int c;
+#ifdef HAVE_GETOPT_H
+  while ((c = getopt_long(
+                argc,
+                argv,
+                "+?d:s:",
+                long_options,
+                &option_index)) != -1) {
+#else
+  while ((c = getopt(argc, argv, "+?d:s:")) != -1) {
+#endif // HAVE_GETOPT_H
+    switch (c) {
+    case '?':
+      help = true;
+      break ;
+    case 'd':
+      days = strtol(optarg, NULL, 0);
+      break ;
+    case 's':
+      step = strtol(optarg, NULL, 0);
+      break ;
+    }
+  }
+  if (help || (days <= 0) || (step <= 0)) {
+    std::cout
+      << "  -? --help  Print this help.\n"
+      << "  -d --days  Number of days covered by preferred times (default\n"
+      << "             is " << days << ").\n"
+      << "  -s --step  Seconds between two preferred times (default is "
+      << step << ").\n"
+      << "\n"
+      << "This benchmarking tool aims to mesure the time needed by\n"
+      << "Centreon Engine to get the next valid time of office hours\n"
+      << "with holidays excluded, from cached valid intervals and\n"
+      << "computed. Results of both are compared.\n";
+    clib::unload();
+    return (EXIT_FAILURE);
+  }
+
+  config = new configuration::state;
+  configuration::applier::state::load();
+  timeperiod* office(create_office_hours());
+
+  // Preferred times start in a minute so that they are not in the past.
+  std::vector<time_t> times;
+  time_t from(time(NULL) + 60);
+  for (time_t t(from); t < from + days * 24 * 60 * 60; t += step)
+    times.push_back(t);
+
+  // The cache only answers from its first day, times before are
+  // computed.
+  std::vector<time_t> computed;
+  time_t later;
+  get_next_valid_time(from + (days + 30) * 24 * 60 * 60, &later, office);
+  unsigned long long computed_duration(
+    next_valid_times(office, times, computed));
+  clear_timeperiod_cache();
+  std::vector<time_t> cached;
+  unsigned long long cached_duration(
+    next_valid_times(office, times, cached));
+
+  unsigned int mismatches(0);
+  for (unsigned int i(0); i < times.size(); ++i)
+    if (cached[i] != computed[i])
+      ++mismatches;
+
+  std::cout << "  Next valid times  Nanoseconds/time  Mismatches\n"
+            << "  " << std::setw(16) << "computed"
+            << "  " << std::setw(16)
+            << computed_duration * 1000 / times.size()
+            << "  " << std::setw(10) << "-" << "\n"
+            << "  " << std::setw(16) << "cached"
+            << "  " << std::setw(16)
+            << cached_duration * 1000 / times.size()
+            << "  " << std::setw(10) << mismatches << "\n";
+
+  // Cleanup.
+  configuration::applier::state::unload();
+  delete config;
+  config = NULL;
+
+  // Unload Clib.
+  clib::unload();
+
+  return (mismatches ? EXIT_FAILURE : EXIT_SUCCESS);
+}
@@ -23,6 +23,7 @@
 #  include <cstring>
 #  include <map>
 #  include <string>
+#  include <vector>
 #  include "com/centreon/concurrency/mutex.hh"
 #  include "com/centreon/engine/namespace.hh"
 #  include "com/centreon/engine/objects/contact.hh"
@@ -43,10 +44,30 @@ namespace         modules {
   namespace       external_commands {
     class         processing {
     public:
+      /**
+       *  Command line split and looked up, ready to be executed. Its
+       *  members keep their memory when it is parsed again.
+       */
+      struct      parsed_command {
+        std::vector<char>
+                  args;
+        time_t    entry_time;
+        void (*   func)(int id, time_t entry_time, char* args);
+        int       id;
+        std::string
+                  name;
+        bool      thread_safe;
+      };
+
                   processing();
                   ~processing() throw ();
       bool        execute(char const* cmd) const;
+      void        execute(parsed_command& cmd) const;
       bool        is_thread_safe(char const* cmd) const;
+      bool        parse(
+                    char const* cmd,
+                    std::size_t len,
+                    parsed_command& parsed) const;
 
     private:
       struct      command_info {
@@ -33,6 +33,7 @@ int shutdown_command_file_worker_thread(void);
 void cleanup_command_file_worker_thread(void* arg);
 void* command_file_worker_thread(void* arg);
 int submit_external_command(char const* cmd, int* buffer_items);
+int process_external_command_buffer(void);
 
 #  ifdef __cplusplus
 }
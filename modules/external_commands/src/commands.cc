@@ -25,6 +25,7 @@
 #include <sys/time.h>
 #include "com/centreon/engine/broker.hh"
 #include "com/centreon/engine/checks/checker.hh"
+#include "com/centreon/engine/configuration/applier/state.hh"
 #include "com/centreon/engine/downtime_finder.hh"
 #include "com/centreon/engine/events/defines.hh"
 #include "com/centreon/engine/flapping.hh"
@@ -36,7 +37,9 @@
 #include "com/centreon/engine/modules/external_commands/utils.hh"
 #include "com/centreon/engine/notifications.hh"
 #include "com/centreon/engine/objects/comment.hh"
+#include "com/centreon/engine/objects/customvariablesmember.hh"
 #include "com/centreon/engine/objects/downtime.hh"
+#include "com/centreon/engine/snapshot_writer.hh"
 #include "com/centreon/engine/statusdata.hh"
 #include "com/centreon/engine/string.hh"
 #include "com/centreon/engine/timeperiod.hh"
@@ -68,35 +71,7 @@ int check_for_external_commands() {
   }
 
   /* process all commands found in the buffer */
-  char* buffer(NULL);
-  while (1) {
-
-    /* get a lock on the buffer */
-    pthread_mutex_lock(&external_command_buffer.buffer_lock);
-
-    /* if no items present, bail out */
-    if (external_command_buffer.items <= 0) {
-      pthread_mutex_unlock(&external_command_buffer.buffer_lock);
-      break;
-    }
-
-    buffer = ((char**)external_command_buffer.buffer)[external_command_buffer.tail];
-    ((char**)external_command_buffer.buffer)[external_command_buffer.tail] = NULL;
-
-    /* adjust tail counter and number of items */
-    external_command_buffer.tail = (external_command_buffer.tail + 1)
-      % config->external_command_buffer_slots();
-    external_command_buffer.items--;
-
-    /* release the lock on the buffer */
-    pthread_mutex_unlock(&external_command_buffer.buffer_lock);
-
-    /* process the command */
-    process_external_command(buffer);
-
-    /* free memory */
-    delete[] buffer;
-  }
+  process_external_command_buffer();
 
   return (OK);
 }
@@ -545,14 +520,9 @@ int process_passive_service_check(
   /* find the host by its name or address */
   if (find_host(host_name) != NULL)
     real_host_name = host_name;
-  else {
-    for (temp_host = host_list; temp_host != NULL; temp_host = temp_host->next) {
-      if (!strcmp(host_name, temp_host->address)) {
-        real_host_name = temp_host->name;
-        break ;
-      }
-    }
-  }
+  else if ((temp_host = configuration::applier::state::instance()
+                          .hosts_find_by_address(host_name)) != NULL)
+    real_host_name = temp_host->name;
 
   /* we couldn't find the host */
   if (real_host_name == NULL) {
@@ -579,37 +549,39 @@ int process_passive_service_check(
   timeval tv;
   gettimeofday(&tv, NULL);
 
-  check_result result;
-  result.object_check_type = SERVICE_CHECK;
-  result.host_name = string::dup(real_host_name);
-  result.service_description = string::dup(svc_description);
-  result.check_type = SERVICE_CHECK_PASSIVE;
-  result.check_options = CHECK_OPTION_NONE;
-  result.scheduled_check = false;
-  result.reschedule_check = false;
-  result.output_file = NULL;
-  result.output_file_fp = NULL;
-  result.output_file_fd = -1;
-  result.latency = (double)((double)(tv.tv_sec - check_time)
+  checks::queued_result* result(new checks::queued_result);
+  result->cr.object_check_type = SERVICE_CHECK;
+  result->cr.host_name = string::dup(real_host_name);
+  result->cr.service_description = string::dup(svc_description);
+  result->cr.check_type = SERVICE_CHECK_PASSIVE;
+  result->cr.check_options = CHECK_OPTION_NONE;
+  result->cr.scheduled_check = false;
+  result->cr.reschedule_check = false;
+  result->cr.output_file = NULL;
+  result->cr.output_file_fp = NULL;
+  result->cr.output_file_fd = -1;
+  result->cr.latency = (double)((double)(tv.tv_sec - check_time)
 			    + (double)(tv.tv_usec / 1000.0) / 1000.0);
-  result.start_time.tv_sec = check_time;
-  result.start_time.tv_usec = 0;
-  result.finish_time.tv_sec = check_time;
-  result.finish_time.tv_usec = 0;
-  result.early_timeout = false;
-  result.exited_ok = true;
-  result.return_code = return_code;
-  result.output = string::dup(output);
-  result.next = NULL;
+  result->cr.start_time.tv_sec = check_time;
+  result->cr.start_time.tv_usec = 0;
+  result->cr.finish_time.tv_sec = check_time;
+  result->cr.finish_time.tv_usec = 0;
+  result->cr.early_timeout = false;
+  result->cr.exited_ok = true;
+  result->cr.return_code = return_code;
+  result->cr.output = string::dup(output);
+  result->service_ptr = temp_service;
+  result->object_generation
+    = configuration::applier::state::instance().generation();
   // result.check_time = check_time;
 
   /* make sure the return code is within bounds */
-  if (result.return_code < 0 || result.return_code > 3) {
-    result.return_code = STATE_UNKNOWN;
+  if (result->cr.return_code < 0 || result->cr.return_code > 3) {
+    result->cr.return_code = STATE_UNKNOWN;
   }
 
-  if (result.latency < 0.0) {
-    result.latency = 0.0;
+  if (result->cr.latency < 0.0) {
+    result->cr.latency = 0.0;
   }
 
   checks::checker::instance().push_check_result(result);
@@ -685,14 +657,9 @@ int process_passive_host_check(
   /* find the host by its name or address */
   if ((temp_host = find_host(host_name)) != NULL)
     real_host_name = host_name;
-  else {
-    for (temp_host = host_list; temp_host != NULL; temp_host = temp_host->next) {
-      if (!strcmp(host_name, temp_host->address)) {
-        real_host_name = temp_host->name;
-        break;
-      }
-    }
-  }
+  else if ((temp_host = configuration::applier::state::instance()
+                          .hosts_find_by_address(host_name)) != NULL)
+    real_host_name = temp_host->name;
 
   /* we couldn't find the host */
   if (temp_host == NULL) {
@@ -709,37 +676,39 @@ int process_passive_host_check(
   timeval tv;
   gettimeofday(&tv, NULL);
 
-  check_result result;
-  result.object_check_type = HOST_CHECK;
-  result.host_name = string::dup(real_host_name);
-  result.service_description = NULL;
-  result.check_type = HOST_CHECK_PASSIVE;
-  result.check_options = CHECK_OPTION_NONE;
-  result.scheduled_check = false;
-  result.reschedule_check = false;
-  result.output_file = NULL;
-  result.output_file_fp = NULL;
-  result.output_file_fd = -1;
-  result.latency = (double)((double)(tv.tv_sec - check_time)
+  checks::queued_result* result(new checks::queued_result);
+  result->cr.object_check_type = HOST_CHECK;
+  result->cr.host_name = string::dup(real_host_name);
+  result->cr.service_description = NULL;
+  result->cr.check_type = HOST_CHECK_PASSIVE;
+  result->cr.check_options = CHECK_OPTION_NONE;
+  result->cr.scheduled_check = false;
+  result->cr.reschedule_check = false;
+  result->cr.output_file = NULL;
+  result->cr.output_file_fp = NULL;
+  result->cr.output_file_fd = -1;
+  result->cr.latency = (double)((double)(tv.tv_sec - check_time)
 			    + (double)(tv.tv_usec / 1000.0) / 1000.0);
-  result.start_time.tv_sec = check_time;
-  result.start_time.tv_usec = 0;
-  result.finish_time.tv_sec = check_time;
-  result.finish_time.tv_usec = 0;
-  result.early_timeout = false;
-  result.exited_ok = true;
-  result.return_code = return_code;
-  result.output = string::dup(output);
-  result.next = NULL;
+  result->cr.start_time.tv_sec = check_time;
+  result->cr.start_time.tv_usec = 0;
+  result->cr.finish_time.tv_sec = check_time;
+  result->cr.finish_time.tv_usec = 0;
+  result->cr.early_timeout = false;
+  result->cr.exited_ok = true;
+  result->cr.return_code = return_code;
+  result->cr.output = string::dup(output);
+  result->host_ptr = const_cast<host*>(temp_host);
+  result->object_generation
+    = configuration::applier::state::instance().generation();
   // result.check_time = check_time;
 
   /* make sure the return code is within bounds */
-  if (result.return_code < 0 || result.return_code > 3) {
-    result.return_code = STATE_UNKNOWN;
+  if (result->cr.return_code < 0 || result->cr.return_code > 3) {
+    result->cr.return_code = STATE_UNKNOWN;
   }
 
-  if (result.latency < 0.0) {
-    result.latency = 0.0;
+  if (result->cr.latency < 0.0) {
+    result->cr.latency = 0.0;
   }
 
   checks::checker::instance().push_check_result(result);
@@ -1562,6 +1531,7 @@ int cmd_change_object_int_var(int cmd, char* args) {
     /* modify the check interval */
     temp_host->check_interval = dval;
     attr = MODATTR_NORMAL_CHECK_INTERVAL;
+    update_host_check_deadlines(temp_host);
 
     /* schedule a host check if previous interval was 0 (checks were not regularly scheduled) */
     if (old_dval == 0 && temp_host->checks_enabled) {
@@ -1592,6 +1562,7 @@ int cmd_change_object_int_var(int cmd, char* args) {
   case CMD_CHANGE_RETRY_HOST_CHECK_INTERVAL:
     temp_host->retry_interval = dval;
     attr = MODATTR_RETRY_CHECK_INTERVAL;
+    update_host_check_deadlines(temp_host);
     break;
 
   case CMD_CHANGE_MAX_HOST_CHECK_ATTEMPTS:
@@ -1612,6 +1583,7 @@ int cmd_change_object_int_var(int cmd, char* args) {
     /* modify the check interval */
     temp_service->check_interval = dval;
     attr = MODATTR_NORMAL_CHECK_INTERVAL;
+    update_service_check_deadlines(temp_service);
 
     /* schedule a service check if previous interval was 0 (checks were not regularly scheduled) */
     if (old_dval == 0 && temp_service->checks_enabled
@@ -1643,6 +1615,7 @@ int cmd_change_object_int_var(int cmd, char* args) {
   case CMD_CHANGE_RETRY_SVC_CHECK_INTERVAL:
     temp_service->retry_interval = dval;
     attr = MODATTR_RETRY_CHECK_INTERVAL;
+    update_service_check_deadlines(temp_service);
     break;
 
   case CMD_CHANGE_MAX_SVC_CHECK_ATTEMPTS:
@@ -1905,6 +1878,9 @@ int cmd_change_object_char_var(int cmd, char* args) {
     break;
   }
 
+  /* snapshots being written share the strings replaced below */
+  snapshot_writer::instance().flush();
+
   /* update the variable */
   switch (cmd) {
 
@@ -2179,6 +2155,9 @@ int cmd_change_object_custom_var(int cmd, char* args) {
     break;
   }
 
+  /* snapshots being written share custom variables */
+  snapshot_writer::instance().flush();
+
   /* capitalize the custom variable name */
   for (x = 0; varname[x] != '\x0'; x++)
     varname[x] = toupper(varname[x]);
@@ -2196,6 +2175,7 @@ int cmd_change_object_custom_var(int cmd, char* args) {
 
       /* mark the variable value as having been changed */
       temp_customvariablesmember->has_been_modified = true;
+      customvariables_modified();
 
       break;
     }
@@ -2282,6 +2262,7 @@ void disable_service_checks(service* svc) {
   /* disable the service check... */
   svc->checks_enabled = false;
   svc->should_be_scheduled = false;
+  update_service_check_deadlines(svc);
 
   /* send data to event broker */
   broker_adaptive_service_data(
@@ -2314,6 +2295,7 @@ void enable_service_checks(service* svc) {
   /* enable the service check... */
   svc->checks_enabled = true;
   svc->should_be_scheduled = true;
+  update_service_check_deadlines(svc);
 
   /* services with no check intervals don't get checked */
   if (svc->check_interval == 0)
@@ -3102,6 +3084,7 @@ void enable_passive_service_checks(service* svc) {
 
   /* set the passive check flag */
   svc->accept_passive_service_checks = true;
+  update_service_check_deadlines(svc);
 
   /* send data to event broker */
   broker_adaptive_service_data(
@@ -3131,6 +3114,7 @@ void disable_passive_service_checks(service* svc) {
 
   /* set the passive check flag */
   svc->accept_passive_service_checks = false;
+  update_service_check_deadlines(svc);
 
   /* send data to event broker */
   broker_adaptive_service_data(
@@ -3279,6 +3263,7 @@ void enable_passive_host_checks(host* hst) {
 
   /* set the passive check flag */
   hst->accept_passive_host_checks = true;
+  update_host_check_deadlines(hst);
 
   /* send data to event broker */
   broker_adaptive_host_data(
@@ -3308,6 +3293,7 @@ void disable_passive_host_checks(host* hst) {
 
   /* set the passive check flag */
   hst->accept_passive_host_checks = false;
+  update_host_check_deadlines(hst);
 
   /* send data to event broker */
   broker_adaptive_host_data(
@@ -3516,6 +3502,7 @@ void disable_host_checks(host* hst) {
   /* set the host check flag */
   hst->checks_enabled = false;
   hst->should_be_scheduled = false;
+  update_host_check_deadlines(hst);
 
   /* send data to event broker */
   broker_adaptive_host_data(
@@ -3548,6 +3535,7 @@ void enable_host_checks(host* hst) {
   /* set the host check flag */
   hst->checks_enabled = true;
   hst->should_be_scheduled = true;
+  update_host_check_deadlines(hst);
 
   /* hosts with no check intervals don't get checked */
   if (hst->check_interval == 0)
@@ -560,69 +560,45 @@ processing::processing() {
 
 processing::~processing() throw () {}
 
+/**
+ *  Parse and execute an external command.
+ *
+ *  @param[in] cmd  Command line.
+ *
+ *  @return True if the command was executed.
+ */
 bool processing::execute(char const* cmd) const {
-  logger(dbg_functions, basic) << "processing external command";
-
   if (!cmd)
     return (false);
 
-  // Trim command
-  while (*cmd && isspace(*cmd))
-    ++cmd;
-  unsigned int len(strlen(cmd));
-  unsigned int end(len);
-  while (end && isspace(cmd[end - 1]))
-    --end;
-  char* command(new char[end + 1]);
-  memcpy(command, cmd, end);
-  command[end] = 0;
-
-  logger(dbg_external_command, most) << "raw command: " << command;
-
-  if (end < 15
-      || command[0] != '['
-      || command[11] != ']'
-      || command[12] != ' ') {
-    delete[] command;
+  parsed_command parsed;
+  if (!parse(cmd, strlen(cmd), parsed))
     return (false);
-  }
-
-  unsigned int start(13);
-  while (command[start]) {
-    if (command[start] == ';') {
-      command[start] = 0;
-      ++start;
-      break;
-    }
-    ++start;
-  }
+  execute(parsed);
+  return (true);
+}
 
-  time_t entry_time(static_cast<time_t>(strtoul(command + 1, NULL, 10)));
-  char* command_name(command + 13);
-  char* args(command + start);
-  int command_id(CMD_CUSTOM_COMMAND);
+/**
+ *  Execute a parsed external command.
+ *
+ *  @param[in,out] cmd  Command returned by parse(), its arguments can be
+ *                      modified by the command.
+ */
+void processing::execute(parsed_command& cmd) const {
+  logger(dbg_functions, basic) << "processing external command";
 
-  umap<std::string, command_info>::const_iterator it;
+  // Update statistics for external commands.
   {
     concurrency::locker lock(&_mutex);
-    it = _lst_command.find(command_name);
-    if (it != _lst_command.end())
-      command_id = it->second.id;
-    else if (command_name[0] != '_') {
-      lock.unlock();
-      logger(log_external_command | log_runtime_warning, basic)
-        << "Warning: Unrecognized external command -> " << command_name;
-      delete[] command;
-      return (false);
-    }
-
-    // Update statistics for external commands.
     update_check_stats(EXTERNAL_COMMAND_STATS, time(NULL));
   }
 
+  char* command_name(const_cast<char*>(cmd.name.c_str()));
+  char* args(&cmd.args[0]);
+
   // Log the external command.
-  if (command_id == CMD_PROCESS_SERVICE_CHECK_RESULT
-      || command_id == CMD_PROCESS_HOST_CHECK_RESULT) {
+  if (cmd.id == CMD_PROCESS_SERVICE_CHECK_RESULT
+      || cmd.id == CMD_PROCESS_HOST_CHECK_RESULT) {
     // Passive checks are logged in checks.c.
     if (config->log_passive_checks())
       logger(log_passive_check, basic)
@@ -633,8 +609,8 @@ bool processing::execute(char const* cmd) const {
       << "EXTERNAL COMMAND: " << command_name << ';' << args;
 
   logger(dbg_external_command, more)
-    << "External command id: " << command_id
-    << "\nCommand entry time: " << entry_time
+    << "External command id: " << cmd.id
+    << "\nCommand entry time: " << cmd.entry_time
     << "\nCommand arguments: " << args;
 
   // Send data to event broker.
@@ -642,16 +618,15 @@ bool processing::execute(char const* cmd) const {
     NEBTYPE_EXTERNALCOMMAND_START,
     NEBFLAG_NONE,
     NEBATTR_NONE,
-    command_id,
-    entry_time,
+    cmd.id,
+    cmd.entry_time,
     command_name,
     args,
     NULL);
 
-  {
+  if (cmd.func) {
     concurrency::locker lock(&_mutex);
-    if (it != _lst_command.end())
-      (*it->second.func)(command_id, entry_time, args);
+    (*cmd.func)(cmd.id, cmd.entry_time, args);
   }
 
   // Send data to event broker.
@@ -659,14 +634,12 @@ bool processing::execute(char const* cmd) const {
     NEBTYPE_EXTERNALCOMMAND_END,
     NEBFLAG_NONE,
     NEBATTR_NONE,
-    command_id,
-    entry_time,
+    cmd.id,
+    cmd.entry_time,
     command_name,
     args,
     NULL);
-
-  delete[] command;
-  return (true);
+  return ;
 }
 
 /**
@@ -686,6 +659,72 @@ bool processing::is_thread_safe(char const* cmd) const {
           && (it->second.thread_safe));
 }
 
+/**
+ *  Parse an external command line.
+ *
+ *  @param[in]  cmd     Command line, does not need to be null
+ *                      terminated.
+ *  @param[in]  len     Length of the command line.
+ *  @param[out] parsed  Parsed command, reusing its memory.
+ *
+ *  @return True if the line is a known or custom command.
+ */
+bool processing::parse(
+                   char const* cmd,
+                   std::size_t len,
+                   parsed_command& parsed) const {
+  // Trim command.
+  char const* end(static_cast<char const*>(memchr(cmd, 0, len)));
+  if (!end)
+    end = cmd + len;
+  while ((cmd != end) && isspace(*cmd))
+    ++cmd;
+  while ((end != cmd) && isspace(end[-1]))
+    --end;
+
+  logger(dbg_external_command, most)
+    << "raw command: " << std::string(cmd, end - cmd);
+
+  if (end - cmd < 15
+      || cmd[0] != '['
+      || cmd[11] != ']'
+      || cmd[12] != ' ')
+    return (false);
+
+  char const* name(cmd + 13);
+  char const* name_end(name);
+  while ((name_end != end) && (*name_end != ';'))
+    ++name_end;
+  char const* args(name_end);
+  if (args != end)
+    ++args;
+
+  parsed.entry_time = static_cast<time_t>(strtoul(cmd + 1, NULL, 10));
+  parsed.name.assign(name, name_end - name);
+  parsed.args.assign(args, end);
+  parsed.args.push_back('\0');
+
+  // The command table is not modified after construction.
+  umap<std::string, command_info>::const_iterator
+    it(_lst_command.find(parsed.name));
+  if (it != _lst_command.end()) {
+    parsed.func = it->second.func;
+    parsed.id = it->second.id;
+    parsed.thread_safe = it->second.thread_safe;
+  }
+  else if (!parsed.name.empty() && (parsed.name[0] == '_')) {
+    parsed.func = NULL;
+    parsed.id = CMD_CUSTOM_COMMAND;
+    parsed.thread_safe = false;
+  }
+  else {
+    logger(log_external_command | log_runtime_warning, basic)
+      << "Warning: Unrecognized external command -> " << parsed.name;
+    return (false);
+  }
+  return (true);
+}
+
 void processing::_wrapper_read_state_information() {
   try {
     retention::state state;
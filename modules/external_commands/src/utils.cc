@@ -22,6 +22,7 @@
 #include <cstdio>
 #include <cstring>
 #include <fcntl.h>
+#include <list>
 #include <poll.h>
 #include <pthread.h>
 #include <sstream>
@@ -29,19 +30,34 @@
 #include <sys/types.h>
 #include <unistd.h>
 #include "com/centreon/engine/common.hh"
+#include "com/centreon/engine/events/loop.hh"
 #include "com/centreon/engine/globals.hh"
 #include "com/centreon/engine/logging/logger.hh"
 #include "com/centreon/engine/modules/external_commands/internal.hh"
 #include "com/centreon/engine/modules/external_commands/utils.hh"
-#include "com/centreon/engine/string.hh"
+#include "com/centreon/engine/spsc_ring.hh"
 #include "nagios.h"
 
 using namespace com::centreon::engine;
 using namespace com::centreon::engine::logging;
+using namespace com::centreon::engine::modules::external_commands;
+
+// Size of the blocks read from the command file.
+static std::size_t const command_file_read_size(65536);
 
 static int   command_file_fd = -1;
 static int   command_file_created = false;
-static FILE* command_file_fp = NULL;
+
+// Commands submitted by the worker thread to the main thread.
+static spsc_ring<processing::parsed_command>* command_ring = NULL;
+static pthread_cond_t  command_ring_cond = PTHREAD_COND_INITIALIZER;
+static pthread_mutex_t command_ring_lock = PTHREAD_MUTEX_INITIALIZER;
+static int volatile    command_ring_waiting = false;
+
+// Commands submitted by other threads through submit_external_command(),
+// the command ring only has one producer.
+static std::list<processing::parsed_command> submitted_commands;
+static pthread_mutex_t submitted_commands_lock = PTHREAD_MUTEX_INITIALIZER;
 
 /* creates external command file as a named pipe (FIFO) and opens it for reading (non-blocked mode) */
 int open_command_file(void) {
@@ -104,21 +120,14 @@ int open_command_file(void) {
     }
   }
 
-  /* re-open the FIFO for use with fgets() */
-  if ((command_file_fp = (FILE*)fdopen(command_file_fd, "r")) == NULL) {
-    logger(log_runtime_error, basic)
-      << "Error: Could not open external command file for "
-      "reading via fdopen(): (" << errno << ") -> " << strerror(errno);
-    return (ERROR);
-  }
-
   /* initialize worker thread */
   if (init_command_file_worker_thread() == ERROR) {
     logger(log_runtime_error, basic)
       << "Error: Could not initialize command file worker thread.";
 
     /* close the command file */
-    fclose(command_file_fp);
+    close(command_file_fd);
+    command_file_fd = -1;
 
     /* delete the named pipe */
     unlink(config->command_file().c_str());
@@ -146,7 +155,8 @@ int close_command_file(void) {
   command_file_created = false;
 
   /* close the command file */
-  fclose(command_file_fp);
+  close(command_file_fd);
+  command_file_fd = -1;
 
   return (OK);
 }
@@ -162,9 +172,11 @@ int init_command_file_worker_thread(void) {
   external_command_buffer.items = 0;
   external_command_buffer.high = 0;
   external_command_buffer.overflow = 0L;
-  external_command_buffer.buffer = new void*[config->external_command_buffer_slots()];
-  if (external_command_buffer.buffer == NULL)
-    return (ERROR);
+  external_command_buffer.buffer = NULL;
+
+  /* initialize command ring */
+  command_ring = new spsc_ring<processing::parsed_command>(
+                       config->external_command_buffer_slots());
 
   /* initialize mutex (only on cold startup) */
   if (sigrestart == false)
@@ -220,29 +232,85 @@ int shutdown_command_file_worker_thread(void) {
 
 /* clean up resources used by command file worker thread */
 void cleanup_command_file_worker_thread(void* arg) {
-  int x = 0;
+  (void)arg;
 
+  /* release memory allocated to the command ring */
+  pthread_mutex_lock(&submitted_commands_lock);
+  delete command_ring;
+  command_ring = NULL;
+  submitted_commands.clear();
+  external_command_buffer.items = 0;
+  pthread_mutex_unlock(&submitted_commands_lock);
+}
+
+/* releases the command ring lock if the worker thread is canceled while waiting */
+static void unlock_command_ring(void* arg) {
   (void)arg;
+  pthread_mutex_unlock(&command_ring_lock);
+}
 
-  /* release memory allocated to circular buffer */
-  for (x = external_command_buffer.tail;
-       x != external_command_buffer.head;
-       x = (x + 1) % config->external_command_buffer_slots()) {
-    delete[] ((char**)external_command_buffer.buffer)[x];
-    ((char**)external_command_buffer.buffer)[x] = NULL;
+/* waits for a free slot in the command ring, blocking the worker thread while the main thread has not processed older commands */
+static processing::parsed_command* wait_for_command_slot() {
+  processing::parsed_command* slot(command_ring->back());
+  if (!slot) {
+    pthread_mutex_lock(&command_ring_lock);
+    pthread_cleanup_push(unlock_command_ring, NULL);
+    // The main thread checks the flag after releasing a slot.
+    command_ring_waiting = true;
+    __sync_synchronize();
+    while (!(slot = command_ring->back()))
+      pthread_cond_wait(&command_ring_cond, &command_ring_lock);
+    command_ring_waiting = false;
+    pthread_cleanup_pop(1);
+  }
+  return (slot);
+}
+
+/* submits the command ring slot filled by the worker thread to the main thread and wakes it up */
+static void push_command_slot() {
+  command_ring->push();
+  int items(__sync_add_and_fetch(&external_command_buffer.items, 1));
+  if (items > external_command_buffer.high)
+    external_command_buffer.high = items;
+  events::loop::instance().wake_up();
+}
+
+/* executes a thread-safe command line or submits it to the main thread */
+static void process_command_line(
+              char const* line,
+              std::size_t len,
+              processing::parsed_command& spare) {
+  // Parse the line directly in the next ring slot if one is free.
+  processing::parsed_command* slot(command_ring->back());
+  processing::parsed_command* cmd(slot ? slot : &spare);
+  if (!gl_processor.parse(line, len, *cmd))
+    return ;
+
+  // Thread-safe commands are executed immediately.
+  if (cmd->thread_safe)
+    gl_processor.execute(*cmd);
+  else {
+    if (!slot) {
+      slot = wait_for_command_slot();
+      slot->args.swap(spare.args);
+      slot->entry_time = spare.entry_time;
+      slot->func = spare.func;
+      slot->id = spare.id;
+      slot->name.swap(spare.name);
+      slot->thread_safe = spare.thread_safe;
+    }
+    push_command_slot();
   }
-  delete[] external_command_buffer.buffer;
-  external_command_buffer.buffer = NULL;
 }
 
 /* worker thread - artificially increases buffer of named pipe */
 void* command_file_worker_thread(void* arg) {
-  char input_buffer[MAX_EXTERNAL_COMMAND_LENGTH];
+  char input_buffer[command_file_read_size];
+  std::size_t input_size(0);
+  processing::parsed_command spare;
   struct pollfd pfd;
   int pollval;
-  struct timeval tv;
-  int buffer_items = 0;
-  int result = 0;
+  ssize_t rb;
 
   (void)arg;
 
@@ -260,8 +328,6 @@ void* command_file_worker_thread(void* arg) {
 
     /* wait for data to arrive */
     /* select seems to not work, so we have to use poll instead */
-    /* 10-15-08 EG check into implementing William's patch @ http://blog.netways.de/2008/08/15/nagios-unter-mac-os-x-installieren/ */
-    /* 10-15-08 EG poll() seems broken on OSX - see Jonathan's patch a few lines down */
     pfd.fd = command_file_fd;
     pfd.events = POLLIN;
     pollval = poll(&pfd, 1, 500);
@@ -308,63 +374,32 @@ void* command_file_worker_thread(void* arg) {
     /* should we shutdown? */
     pthread_testcancel();
 
-    /* get number of items in the buffer */
-    pthread_mutex_lock(&external_command_buffer.buffer_lock);
-    buffer_items = external_command_buffer.items;
-    pthread_mutex_unlock(&external_command_buffer.buffer_lock);
-
-    /* 10-15-08 Fix for OS X by Jonathan Saggau - see http://www.jonathansaggau.com/blog/2008/09/using_shark_and_custom_dtrace.html */
-    /* Not sure if this would have negative effects on other OSes... */
-    if (buffer_items == 0) {
-      /* pause a bit so OS X doesn't go nuts with CPU overload */
-      tv.tv_sec = 0;
-      tv.tv_usec = 500;
-      select(0, NULL, NULL, NULL, &tv);
-    }
+    /* read the file (named pipe) by blocks and process all the complete commands */
+    while ((rb = read(
+                   command_file_fd,
+                   input_buffer + input_size,
+                   sizeof(input_buffer) - input_size)) > 0) {
+      input_size += rb;
+      char* line(input_buffer);
+      char* end(input_buffer + input_size);
+      char* eol;
+      while ((eol = static_cast<char*>(memchr(line, '\n', end - line)))) {
+        process_command_line(line, eol - line, spare);
+        line = eol + 1;
+      }
 
-    /* process all commands in the file (named pipe) if there's some space in the buffer */
-    if (buffer_items < config->external_command_buffer_slots()) {
-
-      /* clear EOF condition from prior run (FreeBSD fix) */
-      /* FIXME: use_poll_on_cmd_pipe: Still needed? */
-      clearerr(command_file_fp);
-
-      /* read and process the next command in the file */
-      while (fgets(
-               input_buffer,
-               (int)(sizeof(input_buffer) - 1),
-               command_file_fp)
-             != NULL) {
-        // Check if command is thread-safe (for immediate execution).
-        if (modules::external_commands::gl_processor.is_thread_safe(
-                                                       input_buffer))
-          modules::external_commands::gl_processor.execute(
-                                                     input_buffer);
-        // Submit the external command for processing
-        // (retry if buffer is full).
-        else {
-          while ((result = submit_external_command(
-                             input_buffer,
-                             &buffer_items))
-                 == ERROR
-                 && buffer_items == config->external_command_buffer_slots()) {
-            // Wait a bit.
-            tv.tv_sec = 0;
-            tv.tv_usec = 250000;
-            select(0, NULL, NULL, NULL, &tv);
-
-            // Should we shutdown?
-            pthread_testcancel();
-          }
-
-          // Bail if the circular buffer is full.
-          if (buffer_items == config->external_command_buffer_slots())
-            break ;
-
-          // Should we shutdown?
-          pthread_testcancel();
-        }
+      // A line longer than the buffer is processed truncated.
+      if (line == input_buffer && input_size == sizeof(input_buffer)) {
+        process_command_line(line, input_size, spare);
+        line = end;
       }
+
+      // Keep the beginning of the last line for the next read.
+      input_size = end - line;
+      memmove(input_buffer, line, input_size);
+
+      /* should we shutdown? */
+      pthread_testcancel();
     }
   }
 
@@ -374,41 +409,80 @@ void* command_file_worker_thread(void* arg) {
   return (NULL);
 }
 
-/* submits an external command for processing */
+/* submits an external command for processing, any thread can submit commands */
 int submit_external_command(char const* cmd, int* buffer_items) {
   int result = OK;
 
-  if (cmd == NULL || external_command_buffer.buffer == NULL) {
+  /* parse the line outside of the lock */
+  std::list<processing::parsed_command> parsed(1);
+  bool valid(cmd != NULL
+             && gl_processor.parse(cmd, strlen(cmd), parsed.front()));
+
+  pthread_mutex_lock(&submitted_commands_lock);
+  if (cmd == NULL || command_ring == NULL) {
+    pthread_mutex_unlock(&submitted_commands_lock);
     if (buffer_items != NULL)
       *buffer_items = -1;
     return (ERROR);
   }
 
-  /* obtain a lock for writing to the buffer */
-  pthread_mutex_lock(&external_command_buffer.buffer_lock);
-
-  if (external_command_buffer.items < config->external_command_buffer_slots()) {
-
-    /* save the line in the buffer */
-    ((char**)external_command_buffer.buffer)[external_command_buffer.head] = string::dup(cmd);
+  /* buffer is full */
+  std::size_t items(command_ring->size() + submitted_commands.size());
+  if (items >= command_ring->capacity())
+    result = ERROR;
+  /* queue the command for the main thread */
+  else if (valid) {
+    submitted_commands.splice(submitted_commands.end(), parsed);
+    ++items;
+  }
+  pthread_mutex_unlock(&submitted_commands_lock);
 
-    /* increment the head counter and items */
-    external_command_buffer.head = (external_command_buffer.head + 1)
-      % config->external_command_buffer_slots();
-    external_command_buffer.items++;
-    if (external_command_buffer.items > external_command_buffer.high)
-      external_command_buffer.high = external_command_buffer.items;
+  if (valid && result == OK) {
+    int total(__sync_add_and_fetch(&external_command_buffer.items, 1));
+    if (total > external_command_buffer.high)
+      external_command_buffer.high = total;
+    events::loop::instance().wake_up();
   }
-  /* buffer was full */
-  else
-    result = ERROR;
 
   /* return number of items now in buffer */
   if (buffer_items != NULL)
-    *buffer_items = external_command_buffer.items;
-
-  /* release lock on buffer */
-  pthread_mutex_unlock(&external_command_buffer.buffer_lock);
+    *buffer_items = items;
 
   return (result);
 }
+
+/* processes all the commands submitted by the worker thread and the other threads */
+int process_external_command_buffer(void) {
+  if (command_ring == NULL)
+    return (ERROR);
+
+  /* take the commands submitted by other threads */
+  std::list<processing::parsed_command> submitted;
+  pthread_mutex_lock(&submitted_commands_lock);
+  submitted.swap(submitted_commands);
+  pthread_mutex_unlock(&submitted_commands_lock);
+  for (std::list<processing::parsed_command>::iterator
+         it(submitted.begin()), end(submitted.end());
+       it != end;
+       ++it) {
+    gl_processor.execute(*it);
+    __sync_sub_and_fetch(&external_command_buffer.items, 1);
+  }
+
+  processing::parsed_command* cmd;
+  while ((cmd = command_ring->front()) != NULL) {
+    gl_processor.execute(*cmd);
+    command_ring->pop();
+    __sync_sub_and_fetch(&external_command_buffer.items, 1);
+
+    /* wake the worker thread up if it waits for a free slot */
+    __sync_synchronize();
+    if (command_ring_waiting) {
+      pthread_mutex_lock(&command_ring_lock);
+      pthread_cond_signal(&command_ring_cond);
+      pthread_mutex_unlock(&command_ring_lock);
+    }
+  }
+
+  return (OK);
+}
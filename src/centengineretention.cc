@@ -0,0 +1,142 @@
+/*
+** Copyright 2017 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstdlib>
+#include <cstdio>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include "com/centreon/engine/error.hh"
+#include "com/centreon/engine/retention/binary.hh"
+#include "com/centreon/engine/string.hh"
+
+using namespace com::centreon::engine;
+using namespace com::centreon::engine::retention;
+
+/**
+ *  Convert a binary retention file to text.
+ *
+ *  @param[in] input   The binary retention file.
+ *  @param[in] output  The text retention file.
+ */
+static void to_text(char const* input, char const* output) {
+  binary::reader reader(input);
+  std::string tmp(output);
+  tmp.append(".tmp");
+  std::ofstream stream(
+                  tmp.c_str(),
+                  std::ios::binary | std::ios::trunc);
+  if (!stream.is_open())
+    throw (engine_error() << "Cannot open retention file '"
+           << tmp << "'");
+  binary::reader::fields f;
+  for (std::size_t i(0); i < reader.size(); ++i) {
+    stream << reader.get(i, f) << " {\n";
+    for (binary::reader::fields::const_iterator
+           it(f.begin()), end(f.end());
+         it != end;
+         ++it)
+      stream << it->first << "=" << it->second << "\n";
+    stream << "}\n";
+  }
+  stream.close();
+  if (!stream || rename(tmp.c_str(), output)) {
+    remove(tmp.c_str());
+    throw (engine_error() << "Cannot write retention file '"
+           << output << "'");
+  }
+  return;
+}
+
+/**
+ *  Convert a text retention file to binary. Lines are read the same
+ *  way the text retention parser reads them.
+ *
+ *  @param[in] input   The text retention file.
+ *  @param[in] output  The binary retention file.
+ */
+static void to_binary(char const* input, char const* output) {
+  std::ifstream stream(input, std::ios::binary);
+  if (!stream.is_open())
+    throw (engine_error() << "Cannot open retention file '"
+           << input << "'");
+  binary::writer writer(output);
+  bool in_object(false);
+  std::string line;
+  while (std::getline(stream, line)) {
+    string::trim(line);
+    if (line.empty() || (line[0] == '#') || (line[0] == ';'))
+      continue;
+    if (!in_object) {
+      std::size_t pos(line.find_first_of(" \t"));
+      if (pos != std::string::npos) {
+        writer.begin(line.substr(0, pos).c_str());
+        in_object = true;
+      }
+    }
+    else if (line != "}") {
+      char const* key;
+      char const* value;
+      if (string::split(line, &key, &value, '=') && key)
+        writer.field(key) << (value ? value : "");
+    }
+    else {
+      writer.end();
+      in_object = false;
+    }
+  }
+  if (stream.bad())
+    throw (engine_error() << "Cannot convert retention file '"
+           << input << "'");
+  writer.commit();
+  return;
+}
+
+/**
+ *  Convert a retention file between text and binary formats. The
+ *  input format is detected and the output uses the other one.
+ *
+ *  @param[in] argc  Argument count.
+ *  @param[in] argv  Argument values.
+ *
+ *  @return EXIT_SUCCESS on success.
+ */
+int main(int argc, char* argv[]) {
+  if (argc != 3) {
+    std::cerr << "Usage: " << argv[0] << " <input> <output>\n\n"
+      "Convert a Centreon Engine retention file from text to binary\n"
+      "format or from binary to text format, depending on the format\n"
+      "of the input file." << std::endl;
+    return (EXIT_FAILURE);
+  }
+
+  int retval(EXIT_FAILURE);
+  try {
+    if (binary::is_binary(argv[1]))
+      to_text(argv[1], argv[2]);
+    else
+      to_binary(argv[1], argv[2]);
+    retval = EXIT_SUCCESS;
+  }
+  catch (std::exception const& e) {
+    std::cerr << "Error: " << e.what() << std::endl;
+  }
+  return (retval);
+}
@@ -193,6 +193,13 @@ int external_commands_last_1min = 0;
 int external_commands_last_5min = 0;
 int external_commands_last_15min = 0;
 
+int reaped_check_results_last_1min = 0;
+int reaped_check_results_last_5min = 0;
+int reaped_check_results_last_15min = 0;
+
+double host_perfdata_file_lines_per_second = 0.0;
+double service_perfdata_file_lines_per_second = 0.0;
+
 int total_external_command_buffer_slots = 0;
 int used_external_command_buffer_slots = 0;
 int high_external_command_buffer_slots = 0;
@@ -527,6 +534,13 @@ int display_stats() {
          external_commands_last_1min,
 	 external_commands_last_5min,
          external_commands_last_15min);
+  printf("Reaped Check Results Last 1/5/15 min:   %d / %d / %d\n",
+         reaped_check_results_last_1min,
+         reaped_check_results_last_5min,
+         reaped_check_results_last_15min);
+  printf("Perfdata File Lines/Sec (Host/Svc):     %.2f / %.2f\n",
+         host_perfdata_file_lines_per_second,
+         service_perfdata_file_lines_per_second);
   printf("\n");
   printf("\n");
 
@@ -1026,6 +1040,24 @@ int read_status_file() {
           if ((temp_ptr = strtok(NULL, ",")))
             serial_host_checks_last_15min = atoi(temp_ptr);
         }
+        else if (!strcmp(var, "reaped_check_result_stats")) {
+          if ((temp_ptr = strtok(val, ",")))
+            reaped_check_results_last_1min = atoi(temp_ptr);
+          if ((temp_ptr = strtok(NULL, ",")))
+            reaped_check_results_last_5min = atoi(temp_ptr);
+          if ((temp_ptr = strtok(NULL, ",")))
+            reaped_check_results_last_15min = atoi(temp_ptr);
+        }
+        else if (!strcmp(var, "host_perfdata_file_stats")) {
+          if ((temp_ptr = strtok(val, ","))
+              && (temp_ptr = strtok(NULL, ",")))
+            host_perfdata_file_lines_per_second = strtod(temp_ptr, NULL);
+        }
+        else if (!strcmp(var, "service_perfdata_file_stats")) {
+          if ((temp_ptr = strtok(val, ","))
+              && (temp_ptr = strtok(NULL, ",")))
+            service_perfdata_file_lines_per_second = strtod(temp_ptr, NULL);
+        }
         break;
 
       case STATUS_HOST_DATA:
@@ -1217,6 +1249,24 @@ int read_stats_file() {
       if ((temp_ptr = strtok(NULL, ",")))
         serial_host_checks_last_15min = atoi(temp_ptr);
     }
+    else if (!strcmp(var, "reaped_check_result_stats")) {
+      if ((temp_ptr = strtok(val, ",")))
+        reaped_check_results_last_1min = atoi(temp_ptr);
+      if ((temp_ptr = strtok(NULL, ",")))
+        reaped_check_results_last_5min = atoi(temp_ptr);
+      if ((temp_ptr = strtok(NULL, ",")))
+        reaped_check_results_last_15min = atoi(temp_ptr);
+    }
+    else if (!strcmp(var, "host_perfdata_file_stats")) {
+      if ((temp_ptr = strtok(val, ","))
+          && (temp_ptr = strtok(NULL, ",")))
+        host_perfdata_file_lines_per_second = strtod(temp_ptr, NULL);
+    }
+    else if (!strcmp(var, "service_perfdata_file_stats")) {
+      if ((temp_ptr = strtok(val, ","))
+          && (temp_ptr = strtok(NULL, ",")))
+        service_perfdata_file_lines_per_second = strtod(temp_ptr, NULL);
+    }
 
     /***** HOST INFO *****/
     else if (!strcmp(var, "total_hosts"))
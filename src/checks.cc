@@ -30,6 +30,8 @@
 #include "com/centreon/engine/broker.hh"
 #include "com/centreon/engine/checks.hh"
 #include "com/centreon/engine/checks/checker.hh"
+#include "com/centreon/engine/checks/deadline_index.hh"
+#include "com/centreon/engine/checks/queued_result.hh"
 #include "com/centreon/engine/checks/viability_failure.hh"
 #include "com/centreon/engine/configuration/applier/state.hh"
 #include "com/centreon/engine/events/defines.hh"
@@ -46,7 +48,6 @@
 #include "com/centreon/engine/statusdata.hh"
 #include "com/centreon/engine/string.hh"
 #include "com/centreon/engine/timeperiod.hh"
-#include "com/centreon/engine/timezone_locker.hh"
 #include "com/centreon/engine/utils.hh"
 
 #define MAX_CMD_ARGS 4096
@@ -57,10 +58,43 @@ using namespace com::centreon::engine::events;
 using namespace com::centreon::engine::configuration::applier;
 using namespace com::centreon::engine::logging;
 
+/* objects sorted by the time their freshness or orphan check is due */
+static checks::deadline_index<host> host_freshness_deadlines;
+static checks::deadline_index<host> host_orphan_deadlines;
+static checks::deadline_index<service> service_freshness_deadlines;
+static checks::deadline_index<service> service_orphan_deadlines;
+static unsigned int check_deadlines_generation = 0;
+
 /******************************************************************/
 /********************** CHECK REAPER FUNCTIONS ********************/
 /******************************************************************/
 
+/* gets short output, long output and perf data of a check result, parsed by the reaper if possible */
+static void get_check_result_output(
+              check_result* cr,
+              checks::queued_result* queued,
+              char** short_output,
+              char** long_output,
+              char** perf_data) {
+  if (queued && queued->output_parsed) {
+    *short_output = queued->short_output;
+    *long_output = queued->long_output;
+    *perf_data = queued->perf_data;
+    queued->short_output = NULL;
+    queued->long_output = NULL;
+    queued->perf_data = NULL;
+  }
+  else
+    parse_check_output(
+      cr->output,
+      short_output,
+      long_output,
+      perf_data,
+      true,
+      true);
+  return;
+}
+
 /* reaps host and service check results */
 int reap_check_results() {
   try {
@@ -127,18 +161,19 @@ int run_scheduled_service_check(
 
       // Make sure we rescheduled the next service check at a valid time.
       {
-        timezone_locker
-          lock(get_service_timezone(svc->host_name, svc->description));
-        get_next_valid_time(
+        char const* tz(get_service_timezone(svc));
+        get_next_valid_time_for_timezone(
           preferred_time,
           &next_valid_time,
-          svc->check_period_ptr);
+          svc->check_period_ptr,
+          tz);
 
         // The service could not be rescheduled properly.
         // Set the next check time for next week.
-        if (!time_is_valid && check_time_against_period(
+        if (!time_is_valid && check_time_against_period_for_timezone(
                                 next_valid_time,
-                                svc->check_period_ptr) == ERROR) {
+                                svc->check_period_ptr,
+                                tz) == ERROR) {
           svc->next_check = (time_t)(next_valid_time + (60 * 60 * 24 * 7));
           logger(log_runtime_warning, basic)
             << "Warning: Check of service '" << svc->description
@@ -207,6 +242,17 @@ int run_async_service_check(
 int handle_async_service_check_result(
       service* temp_service,
       check_result* queued_check_result) {
+  return (handle_async_service_check_result(
+            temp_service,
+            queued_check_result,
+            NULL));
+}
+
+/* handles asynchronous service check results, with the engine data of results queued by the checker */
+int handle_async_service_check_result(
+      service* temp_service,
+      check_result* queued_check_result,
+      checks::queued_result* queued) {
   host* temp_host = NULL;
   time_t next_service_check = 0L;
   time_t preferred_time = 0L;
@@ -388,13 +434,12 @@ int handle_async_service_check_result(
   else {
 
     /* parse check output to get: (1) short output, (2) long output, (3) perf data */
-    parse_check_output(
-      queued_check_result->output,
+    get_check_result_output(
+      queued_check_result,
+      queued,
       &temp_service->plugin_output,
       &temp_service->long_plugin_output,
-      &temp_service->perf_data,
-      true,
-      true);
+      &temp_service->perf_data);
 
     /* make sure the plugin output isn't null */
     if (temp_service->plugin_output == NULL)
@@ -676,12 +721,8 @@ int handle_async_service_check_result(
       state_was_logged = true;
 
       /* Set the recovery been sent parameter. */
-      service_other_props[std::make_pair(
-            temp_service->host_ptr->name,
-            temp_service->description)].recovery_been_sent = false;
-      service_other_props[std::make_pair(
-            temp_service->host_ptr->name,
-            temp_service->description)].initial_notif_time = 0;
+      temp_service->other_props->recovery_been_sent = false;
+      temp_service->other_props->initial_notif_time = 0;
 
       /* 10/04/07 check to see if the service and/or associate host is flapping */
       /* this should be done before a notification is sent out to ensure the host didn't just start flapping */
@@ -723,9 +764,7 @@ int handle_async_service_check_result(
         << "Service did not change state.";
 
     /* Check if we need to send a recovery notification */
-    if(!service_other_props[std::make_pair(
-               temp_service->host_ptr->name,
-               temp_service->description)].recovery_been_sent && !hard_state_change) {
+    if(!temp_service->other_props->recovery_been_sent && !hard_state_change) {
       service_notification(
         temp_service,
         NOTIFICATION_NORMAL,
@@ -745,16 +784,12 @@ int handle_async_service_check_result(
     temp_service->last_hard_state = STATE_OK;
     temp_service->last_notification = (time_t)0;
     temp_service->next_notification = (time_t)0;
-    if (service_other_props[std::make_pair(
-          temp_service->host_ptr->name,
-          temp_service->description)].recovery_been_sent) {
+    if (temp_service->other_props->recovery_been_sent) {
       temp_service->current_notification_number = 0;
       temp_service->notified_on_unknown = false;
       temp_service->notified_on_warning = false;
       temp_service->notified_on_critical = false;
-      service_other_props[std::make_pair(
-            temp_service->host_ptr->name,
-            temp_service->description)].initial_notif_time = 0;
+      temp_service->other_props->initial_notif_time = 0;
     }
     temp_service->problem_has_been_acknowledged = false;
     temp_service->acknowledgement_type = ACKNOWLEDGEMENT_NONE;
@@ -1115,17 +1150,13 @@ int handle_async_service_check_result(
       temp_service->next_check = current_time;
 
     // Make sure we rescheduled the next service check at a valid time.
-    {
-      timezone_locker lock(get_service_timezone(
-                             temp_service->host_name,
-                             temp_service->description));
-      preferred_time = temp_service->next_check;
-      get_next_valid_time(
-        preferred_time,
-        &next_valid_time,
-        temp_service->check_period_ptr);
-      temp_service->next_check = next_valid_time;
-    }
+    preferred_time = temp_service->next_check;
+    get_next_valid_time_for_timezone(
+      preferred_time,
+      &next_valid_time,
+      temp_service->check_period_ptr,
+      get_service_timezone(temp_service));
+    temp_service->next_check = next_valid_time;
 
     /* services with non-recurring intervals do not get rescheduled */
     if (temp_service->check_interval == 0)
@@ -1426,21 +1457,18 @@ int check_service_check_viability(
     }
 
     // Make sure this is a valid time to check the service.
-    {
-      timezone_locker lock(get_service_timezone(
-                             svc->host_name,
-                             svc->description));
-      if (check_time_against_period(
-            (unsigned long)current_time,
-            svc->check_period_ptr) == ERROR) {
-        preferred_time = current_time;
-        if (time_is_valid)
-          *time_is_valid = false;
-        perform_check = false;
-        logger(dbg_checks, most)
-          << "This is not a valid time for this service to be actively "
-             "checked.";
-      }
+    if (check_time_against_period_for_timezone(
+          (unsigned long)current_time,
+          svc->check_period_ptr,
+          get_service_timezone(svc))
+        == ERROR) {
+      preferred_time = current_time;
+      if (time_is_valid)
+        *time_is_valid = false;
+      perform_check = false;
+      logger(dbg_checks, most)
+        << "This is not a valid time for this service to be actively "
+           "checked.";
     }
 
     /* check service dependencies for execution */
@@ -1534,6 +1562,129 @@ unsigned int check_service_dependencies(
   return (DEPENDENCIES_OK);
 }
 
+/* rebuilds the freshness and orphan deadlines of all objects after a configuration change */
+static void rebuild_check_deadlines() {
+  unsigned int generation
+    = configuration::applier::state::instance().generation();
+  if (generation == check_deadlines_generation)
+    return;
+  check_deadlines_generation = generation;
+
+  host_freshness_deadlines.clear();
+  host_orphan_deadlines.clear();
+  service_freshness_deadlines.clear();
+  service_orphan_deadlines.clear();
+  for (host* temp_host = host_list;
+       temp_host != NULL;
+       temp_host = temp_host->next)
+    update_host_check_deadlines(temp_host);
+  for (service* temp_service = service_list;
+       temp_service != NULL;
+       temp_service = temp_service->next)
+    update_service_check_deadlines(temp_service);
+  return;
+}
+
+/* determines the time at which the check results of a service should have come in (allow 10 minutes slack time) */
+static time_t get_service_orphan_time(service* temp_service) {
+  return ((time_t)(temp_service->next_check + temp_service->latency
+                   + config->service_check_timeout()
+                   + config->check_reaper_interval() + 600));
+}
+
+/* determines if the freshness of a service must be checked, whatever its check period */
+static bool service_needs_freshness_check(service* temp_service) {
+  /* skip services we shouldn't be checking for freshness */
+  if (temp_service->check_freshness == false)
+    return (false);
+
+  /* skip services that are currently executing (problems here will be caught by orphaned service check) */
+  if (temp_service->is_executing == true)
+    return (false);
+
+  /* skip services that have both active and passive checks disabled */
+  if (temp_service->checks_enabled == false
+      && temp_service->accept_passive_service_checks == false)
+    return (false);
+
+  /* skip services that are already being freshened */
+  if (temp_service->is_being_freshened == true)
+    return (false);
+
+  /* EXCEPTION */
+  /* don't check freshness of services without regular check intervals if we're using auto-freshness threshold */
+  if (temp_service->check_interval == 0
+      && temp_service->freshness_threshold == 0)
+    return (false);
+
+  return (true);
+}
+
+/* determines the time after which the check results of a service are stale */
+static time_t get_service_result_expiration(
+                service* temp_service,
+                int* freshness_threshold) {
+  time_t expiration_time = 0L;
+
+  /* use user-supplied freshness threshold or auto-calculate a freshness threshold to use? */
+  if (temp_service->freshness_threshold == 0) {
+    if (temp_service->state_type == HARD_STATE
+        || temp_service->current_state == STATE_OK)
+      *freshness_threshold = static_cast<int>((temp_service->check_interval * config->interval_length())
+					     + temp_service->latency + config->additional_freshness_latency());
+    else
+      *freshness_threshold = static_cast<int>((temp_service->retry_interval * config->interval_length())
+					     + temp_service->latency + config->additional_freshness_latency());
+  }
+  else
+    *freshness_threshold = temp_service->freshness_threshold;
+
+  logger(dbg_checks, most)
+    << "Freshness thresholds: service="
+    << temp_service->freshness_threshold
+    << ", use=" << *freshness_threshold;
+
+  /* calculate expiration time */
+  /* CHANGED 11/10/05 EG - program start is only used in expiration time calculation if > last check AND active checks are enabled, so active checks can become stale immediately upon program startup */
+  /* CHANGED 02/25/06 SG - passive checks also become stale, so remove dependence on active check logic */
+  if (temp_service->has_been_checked == false)
+    expiration_time = (time_t)(event_start + *freshness_threshold);
+  /* CHANGED 06/19/07 EG - Per Ton's suggestion (and user requests), only use program start time over last check if no specific threshold has been set by user.  Otheriwse use it.  Problems can occur if Engine is restarted more frequently that freshness threshold intervals (services never go stale). */
+  /* CHANGED 10/07/07 EG - Only match next condition for services that have active checks enabled... */
+  /* CHANGED 10/07/07 EG - Added max_service_check_spread to expiration time as suggested by Altinity */
+  else if (temp_service->checks_enabled == true
+           && event_start > temp_service->last_check
+           && temp_service->freshness_threshold == 0)
+    expiration_time
+      = (time_t)(event_start + *freshness_threshold
+                 + (config->max_service_check_spread()
+                    * config->interval_length()));
+  else
+    expiration_time
+      = (time_t)(temp_service->last_check + *freshness_threshold);
+  return (expiration_time);
+}
+
+/* updates the freshness and orphan deadlines of a service, after its check started or its result was processed */
+void update_service_check_deadlines(service* svc) {
+  int freshness_threshold = 0;
+
+  /* the results become stale once their expiration time has passed */
+  if (service_needs_freshness_check(svc) == true)
+    service_freshness_deadlines.set(
+      svc,
+      get_service_result_expiration(svc, &freshness_threshold) + 1);
+  else
+    service_freshness_deadlines.erase(svc);
+
+  /* the check is orphaned once its results should have come in */
+  if (svc->is_executing == true)
+    service_orphan_deadlines.set(svc, get_service_orphan_time(svc) + 1);
+  else
+    service_orphan_deadlines.erase(svc);
+  return;
+}
+
 /* check for services that never returned from a check... */
 void check_for_orphaned_services() {
   service* temp_service = NULL;
@@ -1546,23 +1697,23 @@ void check_for_orphaned_services() {
   /* get the current time */
   time(&current_time);
 
-  /* check all services... */
-  for (temp_service = service_list;
-       temp_service != NULL;
-       temp_service = temp_service->next) {
+  /* check the services whose results should have come in... */
+  rebuild_check_deadlines();
+  while (service_orphan_deadlines.pop(current_time, temp_service)) {
 
     /* skip services that are not currently executing */
     if (temp_service->is_executing == false)
       continue;
 
-    /* determine the time at which the check results should have come in (allow 10 minutes slack time) */
-    expected_time
-      = (time_t)(temp_service->next_check + temp_service->latency
-                 + config->service_check_timeout()
-                 + config->check_reaper_interval() + 600);
+    /* determine the time at which the check results should have come in */
+    expected_time = get_service_orphan_time(temp_service);
+
+    /* the check was rescheduled, wait for its new expected time */
+    if (expected_time >= current_time)
+      service_orphan_deadlines.set(temp_service, expected_time + 1);
 
     /* this service was supposed to have executed a while ago, but for some reason the results haven't come back in... */
-    if (expected_time < current_time) {
+    else {
 
       /* log a warning */
       logger(log_runtime_warning, basic)
@@ -1583,6 +1734,7 @@ void check_for_orphaned_services() {
 
       /* disable the executing flag */
       temp_service->is_executing = false;
+      update_service_check_deadlines(temp_service);
 
       /* schedule an immediate check of the service */
       schedule_service_check(
@@ -1598,6 +1750,8 @@ void check_for_orphaned_services() {
 void check_service_result_freshness() {
   service* temp_service = NULL;
   time_t current_time = 0L;
+  time_t expiration_time = 0L;
+  int freshness_threshold = 0;
 
   logger(dbg_functions, basic)
     << "check_service_result_freshness()";
@@ -1613,44 +1767,30 @@ void check_service_result_freshness() {
   /* get the current time */
   time(&current_time);
 
-  /* check all services... */
-  for (temp_service = service_list;
-       temp_service != NULL;
-       temp_service = temp_service->next) {
-
-    /* skip services we shouldn't be checking for freshness */
-    if (temp_service->check_freshness == false)
-      continue;
-
-    /* skip services that are currently executing (problems here will be caught by orphaned service check) */
-    if (temp_service->is_executing == true)
-      continue;
+  /* check the services whose results may have expired... */
+  rebuild_check_deadlines();
+  while (service_freshness_deadlines.pop(current_time, temp_service)) {
 
-    /* skip services that have both active and passive checks disabled */
-    if (temp_service->checks_enabled == false
-        && temp_service->accept_passive_service_checks == false)
+    /* skip services we shouldn't be checking for freshness (they are indexed again when this changes) */
+    if (service_needs_freshness_check(temp_service) == false)
       continue;
 
-    /* skip services that are already being freshened */
-    if (temp_service->is_being_freshened == true)
+    /* the results are fresh until their expiration time */
+    expiration_time
+      = get_service_result_expiration(temp_service, &freshness_threshold);
+    if (expiration_time >= current_time) {
+      service_freshness_deadlines.set(temp_service, expiration_time + 1);
       continue;
-
-    // See if the time is right...
-    {
-      timezone_locker lock(get_service_timezone(
-                             temp_service->host_name,
-                             temp_service->description));
-      if (check_time_against_period(
-            current_time,
-            temp_service->check_period_ptr) == ERROR)
-        continue ;
     }
 
-    /* EXCEPTION */
-    /* don't check freshness of services without regular check intervals if we're using auto-freshness threshold */
-    if (temp_service->check_interval == 0
-        && temp_service->freshness_threshold == 0)
-      continue;
+    // See if the time is right, check again on next run otherwise.
+    if (check_time_against_period_for_timezone(
+          current_time,
+          temp_service->check_period_ptr,
+          get_service_timezone(temp_service)) == ERROR) {
+      service_freshness_deadlines.set(temp_service, current_time + 1);
+      continue ;
+    }
 
     /* the results for the last check of this service are stale! */
     if (is_service_result_fresh(
@@ -1690,42 +1830,9 @@ int is_service_result_fresh(
     << "Checking freshness of service '" << temp_service->description
     << "' on host '" << temp_service->host_name << "'...";
 
-  /* use user-supplied freshness threshold or auto-calculate a freshness threshold to use? */
-  if (temp_service->freshness_threshold == 0) {
-    if (temp_service->state_type == HARD_STATE
-        || temp_service->current_state == STATE_OK)
-      freshness_threshold = static_cast<int>((temp_service->check_interval * config->interval_length())
-					     + temp_service->latency + config->additional_freshness_latency());
-    else
-      freshness_threshold = static_cast<int>((temp_service->retry_interval * config->interval_length())
-					     + temp_service->latency + config->additional_freshness_latency());
-  }
-  else
-    freshness_threshold = temp_service->freshness_threshold;
-
-  logger(dbg_checks, most)
-    << "Freshness thresholds: service="
-    << temp_service->freshness_threshold
-    << ", use=" << freshness_threshold;
-
   /* calculate expiration time */
-  /* CHANGED 11/10/05 EG - program start is only used in expiration time calculation if > last check AND active checks are enabled, so active checks can become stale immediately upon program startup */
-  /* CHANGED 02/25/06 SG - passive checks also become stale, so remove dependence on active check logic */
-  if (temp_service->has_been_checked == false)
-    expiration_time = (time_t)(event_start + freshness_threshold);
-  /* CHANGED 06/19/07 EG - Per Ton's suggestion (and user requests), only use program start time over last check if no specific threshold has been set by user.  Otheriwse use it.  Problems can occur if Engine is restarted more frequently that freshness threshold intervals (services never go stale). */
-  /* CHANGED 10/07/07 EG - Only match next condition for services that have active checks enabled... */
-  /* CHANGED 10/07/07 EG - Added max_service_check_spread to expiration time as suggested by Altinity */
-  else if (temp_service->checks_enabled == true
-           && event_start > temp_service->last_check
-           && temp_service->freshness_threshold == 0)
-    expiration_time
-      = (time_t)(event_start + freshness_threshold
-                 + (config->max_service_check_spread()
-                    * config->interval_length()));
-  else
-    expiration_time
-      = (time_t)(temp_service->last_check + freshness_threshold);
+  expiration_time
+    = get_service_result_expiration(temp_service, &freshness_threshold);
 
   logger(dbg_checks, most)
     << "HBC: " << temp_service->has_been_checked
@@ -2021,6 +2128,107 @@ unsigned int check_host_dependencies(host* hst, int dependency_type) {
   return (DEPENDENCIES_OK);
 }
 
+/* runs the continuations waiting for the state of a host when no check result of the host is pending anymore */
+static void release_host_continuations(host* hst) {
+  if (hst->is_executing == false)
+    checks::checker::instance().run_host_continuations(hst);
+  return;
+}
+
+/* determines the time at which the check results of a host should have come in (allow 10 minutes slack time) */
+static time_t get_host_orphan_time(host* temp_host) {
+  return ((time_t)(temp_host->next_check + temp_host->latency
+                   + config->host_check_timeout()
+                   + config->check_reaper_interval() + 600));
+}
+
+/* determines if the freshness of a host must be checked, whatever its check period */
+static bool host_needs_freshness_check(host* temp_host) {
+  /* skip hosts we shouldn't be checking for freshness */
+  if (temp_host->check_freshness == false)
+    return (false);
+
+  /* skip hosts that have both active and passive checks disabled */
+  if (temp_host->checks_enabled == false
+      && temp_host->accept_passive_host_checks == false)
+    return (false);
+
+  /* skip hosts that are currently executing (problems here will be caught by orphaned host check) */
+  if (temp_host->is_executing == true)
+    return (false);
+
+  /* skip hosts that are already being freshened */
+  if (temp_host->is_being_freshened == true)
+    return (false);
+
+  return (true);
+}
+
+/* determines the time after which the check results of a host are stale */
+static time_t get_host_result_expiration(
+                host* temp_host,
+                int* freshness_threshold) {
+  time_t expiration_time = 0L;
+
+  /* use user-supplied freshness threshold or auto-calculate a freshness threshold to use? */
+  if (temp_host->freshness_threshold == 0) {
+    double interval;
+    if ((HARD_STATE == temp_host->state_type)
+        || (STATE_OK == temp_host->current_state))
+      interval = temp_host->check_interval;
+    else
+      interval = temp_host->retry_interval;
+    *freshness_threshold
+      = static_cast<int>((interval * config->interval_length())
+                         + temp_host->latency
+                         + config->additional_freshness_latency());
+  }
+  else
+    *freshness_threshold = temp_host->freshness_threshold;
+
+  logger(dbg_checks, most)
+    << "Freshness thresholds: host=" << temp_host->freshness_threshold
+    << ", use=" << *freshness_threshold;
+
+  /* calculate expiration time */
+  /* CHANGED 11/10/05 EG - program start is only used in expiration time calculation if > last check AND active checks are enabled, so active checks can become stale immediately upon program startup */
+  if (temp_host->has_been_checked == false)
+    expiration_time = (time_t)(event_start + *freshness_threshold);
+  /* CHANGED 06/19/07 EG - Per Ton's suggestion (and user requests), only use program start time over last check if no specific threshold has been set by user.  Otheriwse use it.  Problems can occur if Engine is restarted more frequently that freshness threshold intervals (hosts never go stale). */
+  /* CHANGED 10/07/07 EG - Added max_host_check_spread to expiration time as suggested by Altinity */
+  else if (temp_host->checks_enabled == true
+           && event_start > temp_host->last_check
+           && temp_host->freshness_threshold == 0)
+    expiration_time
+      = (time_t)(event_start + *freshness_threshold
+                 + (config->max_host_check_spread()
+                    * config->interval_length()));
+  else
+    expiration_time
+      = (time_t)(temp_host->last_check + *freshness_threshold);
+  return (expiration_time);
+}
+
+/* updates the freshness and orphan deadlines of a host, after its check started or its result was processed */
+void update_host_check_deadlines(host* hst) {
+  int freshness_threshold = 0;
+
+  /* the results become stale once their expiration time has passed */
+  if (host_needs_freshness_check(hst) == true)
+    host_freshness_deadlines.set(
+      hst,
+      get_host_result_expiration(hst, &freshness_threshold) + 1);
+  else
+    host_freshness_deadlines.erase(hst);
+
+  /* the check is orphaned once its results should have come in */
+  if (hst->is_executing == true)
+    host_orphan_deadlines.set(hst, get_host_orphan_time(hst) + 1);
+  else
+    host_orphan_deadlines.erase(hst);
+  return;
+}
+
 /* check for hosts that never returned from a check... */
 void check_for_orphaned_hosts() {
   host* temp_host = NULL;
@@ -2033,10 +2241,9 @@ void check_for_orphaned_hosts() {
   /* get the current time */
   time(&current_time);
 
-  /* check all hosts... */
-  for (temp_host = host_list;
-       temp_host != NULL;
-       temp_host = temp_host->next) {
+  /* check the hosts whose results should have come in... */
+  rebuild_check_deadlines();
+  while (host_orphan_deadlines.pop(current_time, temp_host)) {
 
     /* skip hosts that don't have a set check interval (on-demand checks are missed by the orphan logic) */
     if (temp_host->next_check == (time_t)0L)
@@ -2046,14 +2253,15 @@ void check_for_orphaned_hosts() {
     if (temp_host->is_executing == false)
       continue;
 
-    /* determine the time at which the check results should have come in (allow 10 minutes slack time) */
-    expected_time
-      = (time_t)(temp_host->next_check + temp_host->latency
-                 + config->host_check_timeout()
-                 + config->check_reaper_interval() + 600);
+    /* determine the time at which the check results should have come in */
+    expected_time = get_host_orphan_time(temp_host);
+
+    /* the check was rescheduled, wait for its new expected time */
+    if (expected_time >= current_time)
+      host_orphan_deadlines.set(temp_host, expected_time + 1);
 
     /* this host was supposed to have executed a while ago, but for some reason the results haven't come back in... */
-    if (expected_time < current_time) {
+    else {
 
       /* log a warning */
       logger(log_runtime_warning, basic)
@@ -2071,6 +2279,10 @@ void check_for_orphaned_hosts() {
 
       /* disable the executing flag */
       temp_host->is_executing = false;
+      update_host_check_deadlines(temp_host);
+
+      /* the hosts waiting for this one go on with its last known state */
+      release_host_continuations(temp_host);
 
       /* schedule an immediate check of the host */
       schedule_host_check(
@@ -2086,6 +2298,8 @@ void check_for_orphaned_hosts() {
 void check_host_result_freshness() {
   host* temp_host = NULL;
   time_t current_time = 0L;
+  time_t expiration_time = 0L;
+  int freshness_threshold = 0;
 
   logger(dbg_functions, basic)
     << "check_host_result_freshness()";
@@ -2102,35 +2316,29 @@ void check_host_result_freshness() {
   /* get the current time */
   time(&current_time);
 
-  /* check all hosts... */
-  for (temp_host = host_list;
-       temp_host != NULL;
-       temp_host = temp_host->next) {
-
-    /* skip hosts we shouldn't be checking for freshness */
-    if (temp_host->check_freshness == false)
-      continue;
-
-    /* skip hosts that have both active and passive checks disabled */
-    if (temp_host->checks_enabled == false
-        && temp_host->accept_passive_host_checks == false)
-      continue;
+  /* check the hosts whose results may have expired... */
+  rebuild_check_deadlines();
+  while (host_freshness_deadlines.pop(current_time, temp_host)) {
 
-    /* skip hosts that are currently executing (problems here will be caught by orphaned host check) */
-    if (temp_host->is_executing == true)
+    /* skip hosts we shouldn't be checking for freshness (they are indexed again when this changes) */
+    if (host_needs_freshness_check(temp_host) == false)
       continue;
 
-    /* skip hosts that are already being freshened */
-    if (temp_host->is_being_freshened == true)
+    /* the results are fresh until their expiration time */
+    expiration_time
+      = get_host_result_expiration(temp_host, &freshness_threshold);
+    if (expiration_time >= current_time) {
+      host_freshness_deadlines.set(temp_host, expiration_time + 1);
       continue;
+    }
 
-    // See if the time is right...
-    {
-      timezone_locker lock(get_host_timezone(temp_host->name));
-      if (check_time_against_period(
-            current_time,
-            temp_host->check_period_ptr) == ERROR)
-        continue ;
+    // See if the time is right, check again on next run otherwise.
+    if (check_time_against_period_for_timezone(
+          current_time,
+          temp_host->check_period_ptr,
+          get_host_timezone(temp_host)) == ERROR) {
+      host_freshness_deadlines.set(temp_host, current_time + 1);
+      continue ;
     }
 
     /* the results for the last check of this host are stale */
@@ -2168,42 +2376,9 @@ int is_host_result_fresh(
   logger(dbg_checks, most)
     << "Checking freshness of host '" << temp_host->name << "'...";
 
-  /* use user-supplied freshness threshold or auto-calculate a freshness threshold to use? */
-  if (temp_host->freshness_threshold == 0) {
-    double interval;
-    if ((HARD_STATE == temp_host->state_type)
-        || (STATE_OK == temp_host->current_state))
-      interval = temp_host->check_interval;
-    else
-      interval = temp_host->retry_interval;
-    freshness_threshold
-      = static_cast<int>((interval * config->interval_length())
-                         + temp_host->latency
-                         + config->additional_freshness_latency());
-  }
-  else
-    freshness_threshold = temp_host->freshness_threshold;
-
-  logger(dbg_checks, most)
-    << "Freshness thresholds: host=" << temp_host->freshness_threshold
-    << ", use=" << freshness_threshold;
-
   /* calculate expiration time */
-  /* CHANGED 11/10/05 EG - program start is only used in expiration time calculation if > last check AND active checks are enabled, so active checks can become stale immediately upon program startup */
-  if (temp_host->has_been_checked == false)
-    expiration_time = (time_t)(event_start + freshness_threshold);
-  /* CHANGED 06/19/07 EG - Per Ton's suggestion (and user requests), only use program start time over last check if no specific threshold has been set by user.  Otheriwse use it.  Problems can occur if Engine is restarted more frequently that freshness threshold intervals (hosts never go stale). */
-  /* CHANGED 10/07/07 EG - Added max_host_check_spread to expiration time as suggested by Altinity */
-  else if (temp_host->checks_enabled == true
-           && event_start > temp_host->last_check
-           && temp_host->freshness_threshold == 0)
-    expiration_time
-      = (time_t)(event_start + freshness_threshold
-                 + (config->max_host_check_spread()
-                    * config->interval_length()));
-  else
-    expiration_time
-      = (time_t)(temp_host->last_check + freshness_threshold);
+  expiration_time
+    = get_host_result_expiration(temp_host, &freshness_threshold);
 
   logger(dbg_checks, most)
     << "HBC: " << temp_host->has_been_checked
@@ -2259,8 +2434,42 @@ int is_host_result_fresh(
 /************* NAGIOS 3.X ROUTE/HOST CHECK FUNCTIONS **************/
 /******************************************************************/
 
+/* runs an on-demand check of a host without waiting for its result, returns true if check_result_code is already the result of the check */
+static bool run_on_demand_host_check(
+              host* hst,
+              int* check_result_code,
+              int check_options,
+              int use_cached_result,
+              unsigned long check_timestamp_horizon) {
+  logger(dbg_functions, basic)
+    << "run_on_demand_host_check: hst=" << hst
+    << ", check_options=" << check_options
+    << ", use_cached_result=" << use_cached_result
+    << ", check_timestamp_horizon=" << check_timestamp_horizon;
+
+  try {
+    return (checks::checker::instance().run_on_demand(
+                                          hst,
+                                          check_result_code,
+                                          check_options,
+                                          use_cached_result,
+                                          check_timestamp_horizon));
+  }
+  catch (checks::viability_failure const& e) {
+    // Do not log viability failures.
+    (void)e;
+  }
+  catch (std::exception const& e) {
+    logger(log_runtime_error, basic)
+      << "Error: " << e.what();
+  }
+  if (check_result_code)
+    *check_result_code = hst->current_state;
+  return (true);
+}
+
 /*** ON-DEMAND HOST CHECKS USE THIS FUNCTION ***/
-/* check to see if we can reach the host */
+/* check to see if we can reach the host, only used by aggressive host checking so the check is waited for */
 int perform_on_demand_host_check_3x(
       host* hst,
       int* check_result_code,
@@ -2379,13 +2588,11 @@ int run_scheduled_host_check_3x(
                                                : (hst->check_interval * config->interval_length()));
 
       // Make sure we rescheduled the next host check at a valid time.
-      {
-        timezone_locker lock(get_host_timezone(hst->name));
-        get_next_valid_time(
-          preferred_time,
-          &next_valid_time,
-          hst->check_period_ptr);
-      }
+      get_next_valid_time_for_timezone(
+        preferred_time,
+        &next_valid_time,
+        hst->check_period_ptr,
+        get_host_timezone(hst));
 
       /* the host could not be rescheduled properly - set the next check time for next week */
       if (time_is_valid == false && next_valid_time == preferred_time) {
@@ -2465,7 +2672,18 @@ int run_async_host_check_3x(
 int handle_async_host_check_result_3x(
       host* temp_host,
       check_result* queued_check_result) {
-  time_t current_time;
+  return (handle_async_host_check_result_3x(
+            temp_host,
+            queued_check_result,
+            NULL));
+}
+
+/* process results of an asynchronous host check, with the engine data of results queued by the checker */
+int handle_async_host_check_result_3x(
+      host* temp_host,
+      check_result* queued_check_result,
+      checks::queued_result* queued) {
+  time_t current_time;
   int result = STATE_OK;
   int reschedule_check = false;
   char* old_plugin_output = NULL;
@@ -2506,7 +2724,7 @@ int handle_async_host_check_result_3x(
     << "\tReschedule Check?:  "
     << (queued_check_result->reschedule_check == true ? "Yes" : "No") << "\n"
     << "\tShould Reschedule Current Host Check?:"
-    << host_other_props[temp_host->name].should_reschedule_current_check
+    << temp_host->other_props->should_reschedule_current_check
     << "\tExited OK?:         "
     << (queued_check_result->exited_ok == true ? "Yes" : "No") << "\n"
     << com::centreon::logging::setprecision(3)
@@ -2526,12 +2744,14 @@ int handle_async_host_check_result_3x(
       logger(dbg_checks, basic)
         << "Discarding passive host check result because passive host "
         "checks are disabled globally.";
+      release_host_continuations(temp_host);
       return (ERROR);
     }
     if (temp_host->accept_passive_host_checks == false) {
       logger(dbg_checks, basic)
         << "Discarding passive host check result because passive checks "
         "are disabled for this host.";
+      release_host_continuations(temp_host);
       return (ERROR);
     }
   }
@@ -2540,6 +2760,10 @@ int handle_async_host_check_result_3x(
   if (queued_check_result->check_options & CHECK_OPTION_FRESHNESS_CHECK)
     temp_host->is_being_freshened = false;
 
+  /* clear the execution flag if this was an active check */
+  if (queued_check_result->check_type == HOST_CHECK_ACTIVE)
+    temp_host->is_executing = false;
+
   /* DISCARD INVALID FRESHNESS CHECK RESULTS */
   /* If a host goes stale, Engine will initiate a forced check in order
   ** to freshen it. There is a race condition whereby a passive check
@@ -2553,6 +2777,7 @@ int handle_async_host_check_result_3x(
     logger(dbg_checks, basic)
       << "Discarding host freshness check result because the host is "
       "currently fresh (race condition avoided).";
+    release_host_continuations(temp_host);
     return (OK);
   }
 
@@ -2574,12 +2799,12 @@ int handle_async_host_check_result_3x(
   // on the same host at the same time. The flag is then set in the host
   // and this check should be rescheduled regardless of what it was meant
   // to initially.
-  if (host_other_props[temp_host->name].should_reschedule_current_check &&
+  if (temp_host->other_props->should_reschedule_current_check &&
       !queued_check_result->reschedule_check)
     reschedule_check = true;
 
   // Clear the should reschedule flag.
-  host_other_props[temp_host->name].should_reschedule_current_check = false;
+  temp_host->other_props->should_reschedule_current_check = false;
 
   /* check latency is passed to us for both active and passive checks */
   temp_host->latency = queued_check_result->latency;
@@ -2590,10 +2815,6 @@ int handle_async_host_check_result_3x(
   /* set the checked flag */
   temp_host->has_been_checked = true;
 
-  /* clear the execution flag if this was an active check */
-  if (queued_check_result->check_type == HOST_CHECK_ACTIVE)
-    temp_host->is_executing = false;
-
   /* get the last check time */
   temp_host->last_check = queued_check_result->start_time.tv_sec;
 
@@ -2619,13 +2840,12 @@ int handle_async_host_check_result_3x(
   temp_host->perf_data = NULL;
 
   /* parse check output to get: (1) short output, (2) long output, (3) perf data */
-  parse_check_output(
-    queued_check_result->output,
+  get_check_result_output(
+    queued_check_result,
+    queued,
     &temp_host->plugin_output,
     &temp_host->long_plugin_output,
-    &temp_host->perf_data,
-    true,
-    true);
+    &temp_host->perf_data);
 
   /* make sure we have some data */
   if (temp_host->plugin_output == NULL
@@ -2739,8 +2959,10 @@ int handle_async_host_check_result_3x(
     old_plugin_output,
     CHECK_OPTION_NONE,
     reschedule_check,
-    true,
-    config->cached_host_check_horizon());
+    queued ? queued->use_cached_result : true,
+    queued
+    ? queued->check_timestamp_horizon
+    : config->cached_host_check_horizon());
 
   /* free memory */
   delete[] old_plugin_output;
@@ -2780,7 +3002,226 @@ int handle_async_host_check_result_3x(
   return (OK);
 }
 
-/* processes the result of a synchronous or asynchronous host check */
+/* finishes the processing of a host check result once the state of the host is known */
+static int finish_host_check_result_3x(
+             host* hst,
+             char* old_plugin_output,
+             int reschedule_check,
+             time_t next_check,
+             objectlist* check_hostlist,
+             int use_cached_result,
+             unsigned long check_timestamp_horizon) {
+  host* temp_host = NULL;
+  objectlist* hostlist_item = NULL;
+  time_t current_time = 0L;
+  time_t preferred_time = 0L;
+  time_t next_valid_time = 0L;
+  int run_async_check = true;
+
+  /* get the current time */
+  time(&current_time);
+
+  logger(dbg_checks, more)
+    << "Pre-handle_host_state() Host: " << hst->name
+    << ", Attempt=" << hst->current_attempt << "/" << hst->max_attempts
+    << ", Type=" << (hst->state_type == HARD_STATE ? "HARD" : "SOFT")
+    << ", Final State=" << hst->current_state;
+
+  /* handle the host state */
+  handle_host_state(hst);
+
+  logger(dbg_checks, more)
+    << "Post-handle_host_state() Host: " << hst->name
+    << ", Attempt=" << hst->current_attempt << "/" << hst->max_attempts
+    << ", Type=" << (hst->state_type == HARD_STATE ? "HARD" : "SOFT")
+    << ", Final State=" << hst->current_state;
+
+  /******************** POST-PROCESSING STUFF *********************/
+
+  /* if the plugin output differs from previous check and no state change, log the current state/output if state stalking is enabled */
+  if (hst->last_state == hst->current_state
+      && compare_strings(old_plugin_output, hst->plugin_output)) {
+
+    if (hst->current_state == HOST_UP && hst->stalk_on_up == true)
+      log_host_event(hst);
+
+    else if (hst->current_state == HOST_DOWN
+             && hst->stalk_on_down == true)
+      log_host_event(hst);
+
+    else if (hst->current_state == HOST_UNREACHABLE
+             && hst->stalk_on_unreachable == true)
+      log_host_event(hst);
+  }
+
+  /* check to see if the associated host is flapping */
+  check_for_host_flapping(hst, true, true, true);
+
+  /* reschedule the next check of the host (usually ONLY for scheduled, active checks, unless overridden above) */
+  if (reschedule_check == true) {
+    logger(dbg_checks, more)
+      << "Rescheduling next check of host at " << my_ctime(&next_check);
+
+    /* default is to reschedule host check unless a test below fails... */
+    hst->should_be_scheduled = true;
+
+    /* get the new current time */
+    time(&current_time);
+
+    /* make sure we don't get ourselves into too much trouble... */
+    if (current_time > next_check)
+      hst->next_check = current_time;
+    else
+      hst->next_check = next_check;
+
+    // Make sure we rescheduled the next host check at a valid time.
+    preferred_time = hst->next_check;
+    get_next_valid_time_for_timezone(
+      preferred_time,
+      &next_valid_time,
+      hst->check_period_ptr,
+      get_host_timezone(hst));
+    hst->next_check = next_valid_time;
+
+    /* hosts with non-recurring intervals do not get rescheduled if we're in a HARD or UP state */
+    if (hst->check_interval == 0
+        && (hst->state_type == HARD_STATE
+            || hst->current_state == HOST_UP))
+      hst->should_be_scheduled = false;
+
+    /* host with active checks disabled do not get rescheduled */
+    if (hst->checks_enabled == false)
+      hst->should_be_scheduled = false;
+
+    /* schedule a non-forced check if we can */
+    if (hst->should_be_scheduled == true) {
+      schedule_host_check(hst, hst->next_check, CHECK_OPTION_NONE);
+    }
+  }
+
+  /* update host status - for both active (scheduled) and passive (non-scheduled) hosts */
+  update_host_status(hst, false);
+
+  /* the results of the host can go stale again, even if their processing waited for its parents */
+  update_host_check_deadlines(hst);
+
+  /* run async checks of all hosts we added above */
+  /* don't run a check if one is already executing or we can get by with a cached state */
+  for (hostlist_item = check_hostlist;
+       hostlist_item != NULL;
+       hostlist_item = hostlist_item->next) {
+    run_async_check = true;
+    temp_host = (host*)hostlist_item->object_ptr;
+
+    logger(dbg_checks, most)
+      << "ASYNC CHECK OF HOST: " << temp_host->name
+      << ", CURRENTTIME: " << current_time
+      << ", LASTHOSTCHECK: " << temp_host->last_check
+      << ", CACHEDTIMEHORIZON: " << check_timestamp_horizon
+      << ", USECACHEDRESULT: " << use_cached_result
+      << ", ISEXECUTING: " << temp_host->is_executing;
+
+    if (use_cached_result == true
+        && (static_cast<unsigned long>(current_time - temp_host->last_check) <= check_timestamp_horizon))
+      run_async_check = false;
+    if (temp_host->is_executing == true)
+      run_async_check = false;
+    if (run_async_check == true)
+      run_async_host_check_3x(
+        temp_host,
+        CHECK_OPTION_NONE,
+        0.0,
+        false,
+        false,
+        NULL,
+        NULL);
+  }
+  free_objectlist(&check_hostlist);
+
+  /* continue the processing of the results waiting for this host */
+  checks::checker::instance().run_host_continuations(hst);
+  return (OK);
+}
+
+/* host check result waiting for the on-demand checks of the parent hosts */
+struct pending_host_result {
+  objectlist*   check_hostlist;
+  unsigned long check_timestamp_horizon;
+  host*         hst;
+  time_t        last_check;
+  time_t        next_check;
+  std::string   host_name;
+  char*         old_plugin_output;
+  unsigned int  parents;
+  int           reschedule_check;
+  int           use_cached_result;
+};
+
+/* continues the processing of a host check result when the result of one of its parent hosts is processed */
+static void process_host_parent_result(host* parent_host, void* arg) {
+  pending_host_result* pending(static_cast<pending_host_result*>(arg));
+  --pending->parents;
+
+  /* NULL parent means the configuration was reloaded, a newer check result of the host makes this one obsolete */
+  host* hst(pending->hst);
+  if (parent_host != NULL
+      && hst != NULL
+      && hst->last_check == pending->last_check
+      && (parent_host->current_state == HOST_UP
+          || pending->parents == 0)) {
+    if (parent_host->current_state == HOST_UP) {
+      logger(dbg_checks, more)
+        << "Parent host '" << parent_host->name << "' is UP, so host '"
+        << hst->name << "' is DOWN.";
+      hst->current_state = HOST_DOWN;
+    }
+    else
+      logger(dbg_checks, more)
+        << "No parents were UP, so host '" << hst->name
+        << "' is UNREACHABLE.";
+
+    /* the host state is known */
+    pending->hst = NULL;
+    finish_host_check_result_3x(
+      hst,
+      pending->old_plugin_output,
+      pending->reschedule_check,
+      pending->next_check,
+      pending->check_hostlist,
+      pending->use_cached_result,
+      pending->check_timestamp_horizon);
+    pending->check_hostlist = NULL;
+  }
+  /* the host object may have been replaced by the reload, make sure it is still scheduled */
+  else if (parent_host == NULL && hst != NULL) {
+    pending->hst = NULL;
+    umap<std::string, shared_ptr<host_struct> > const&
+      hosts(configuration::applier::state::instance().hosts());
+    umap<std::string, shared_ptr<host_struct> >::const_iterator
+      it(hosts.find(pending->host_name));
+    if (it != hosts.end()
+        && pending->reschedule_check == true
+        && it->second->checks_enabled == true) {
+      time_t current_time(time(NULL));
+      schedule_host_check(
+        it->second.get(),
+        (current_time > pending->next_check)
+        ? current_time
+        : pending->next_check,
+        CHECK_OPTION_NONE);
+    }
+  }
+
+  /* all the parent results were received */
+  if (pending->parents == 0) {
+    free_objectlist(&pending->check_hostlist);
+    delete[] pending->old_plugin_output;
+    delete pending;
+  }
+  return;
+}
+
+/* processes the result of an on-demand or scheduled host check */
 int process_host_check_result_3x(
       host* hst,
       int new_state,
@@ -2793,15 +3234,13 @@ int process_host_check_result_3x(
   host* child_host = NULL;
   host* parent_host = NULL;
   host* master_host = NULL;
-  host* temp_host = NULL;
   objectlist* check_hostlist = NULL;
   objectlist* hostlist_item = NULL;
+  objectlist* running_parents = NULL;
+  pending_host_result* pending = NULL;
   int parent_state = HOST_UP;
   time_t current_time = 0L;
   time_t next_check = 0L;
-  time_t preferred_time = 0L;
-  time_t next_valid_time = 0L;
-  int run_async_check = true;
 
   logger(dbg_functions, basic)
     << "process_host_check_result_3x()";
@@ -3012,15 +3451,15 @@ int process_host_check_result_3x(
                             + (hst->check_interval
                                * config->interval_length()));
 
-        /* we need to run SYNCHRONOUS checks of all parent hosts to accurately determine the state of this host */
-        /* this is extremely inefficient (reminiscent of Nagios 2.x logic), but there's no other good way around it */
+        /* we need to run on-demand checks of all parent hosts to accurately determine the state of this host */
+        /* parent checks run in parallel unless aggressive host checking is enabled, the processing of this result is finished once their results are processed */
         /* check all parent hosts to see if we're DOWN or UNREACHABLE */
         /* only do this for ACTIVE checks, as PASSIVE checks contain a pre-determined state */
         if (hst->check_type == HOST_CHECK_ACTIVE) {
 
           logger(dbg_checks, more)
-            << "** WARNING: Max attempts = 1, so we have to run serial "
-            "checks of all parent hosts!";
+            << "** WARNING: Max attempts = 1, so we have to check all "
+            "parent hosts!";
 
           for (temp_hostsmember = hst->parent_hosts;
                temp_hostsmember != NULL;
@@ -3030,14 +3469,25 @@ int process_host_check_result_3x(
               continue;
 
             logger(dbg_checks, more)
-              << "Running serial check parent host '"
+              << "Running on-demand check of parent host '"
               << parent_host->name << "'...";
 
-            /* run an immediate check of the parent host */
-            run_sync_host_check_3x(
-              parent_host, &parent_state,
-              check_options, use_cached_result,
-              check_timestamp_horizon);
+            /* run an immediate check of the parent host, remember it if its result is not known yet */
+            /* aggressive host checking waits for the result of the parent host */
+            if (config->use_aggressive_host_checking() == true)
+              run_sync_host_check_3x(
+                parent_host, &parent_state,
+                check_options, use_cached_result,
+                check_timestamp_horizon);
+            else if (run_on_demand_host_check(
+                       parent_host, &parent_state,
+                       check_options, use_cached_result,
+                       check_timestamp_horizon) == false) {
+              add_object_to_objectlist(
+                &running_parents,
+                (void*)parent_host);
+              continue;
+            }
 
             /* bail out as soon as we find one parent host that is UP */
             if (parent_state == HOST_UP) {
@@ -3057,6 +3507,29 @@ int process_host_check_result_3x(
                 << "Host has no parents, so it's DOWN.";
               hst->current_state = HOST_DOWN;
             }
+            /* wait for the results of the parent hosts still being checked */
+            else if (running_parents != NULL) {
+              logger(dbg_checks, more)
+                << "No parents were UP yet, so this host is UNREACHABLE "
+                "until the checks of its other parents are processed.";
+              hst->current_state = HOST_UNREACHABLE;
+              pending = new pending_host_result;
+              pending->check_hostlist = NULL;
+              pending->hst = hst;
+              pending->host_name = hst->name;
+              pending->last_check = hst->last_check;
+              pending->old_plugin_output = string::dup(old_plugin_output);
+              pending->parents = 0;
+              for (hostlist_item = running_parents;
+                   hostlist_item != NULL;
+                   hostlist_item = hostlist_item->next) {
+                checks::checker::instance().add_host_continuation(
+                  (host*)hostlist_item->object_ptr,
+                  &process_host_parent_result,
+                  pending);
+                ++pending->parents;
+              }
+            }
             else {
               /* no parents were up, so this host is UNREACHABLE */
               logger(dbg_checks, more)
@@ -3064,6 +3537,7 @@ int process_host_check_result_3x(
               hst->current_state = HOST_UNREACHABLE;
             }
           }
+          free_objectlist(&running_parents);
         }
 
         /* set the host state for passive checks */
@@ -3221,122 +3695,24 @@ int process_host_check_result_3x(
     }
   }
 
-  logger(dbg_checks, more)
-    << "Pre-handle_host_state() Host: " << hst->name
-    << ", Attempt=" << hst->current_attempt << "/" << hst->max_attempts
-    << ", Type=" << (hst->state_type == HARD_STATE ? "HARD" : "SOFT")
-    << ", Final State=" << hst->current_state;
-
-  /* handle the host state */
-  handle_host_state(hst);
-
-  logger(dbg_checks, more)
-    << "Post-handle_host_state() Host: " << hst->name
-    << ", Attempt=" << hst->current_attempt << "/" << hst->max_attempts
-    << ", Type=" << (hst->state_type == HARD_STATE ? "HARD" : "SOFT")
-    << ", Final State=" << hst->current_state;
-
-  /******************** POST-PROCESSING STUFF *********************/
-
-  /* if the plugin output differs from previous check and no state change, log the current state/output if state stalking is enabled */
-  if (hst->last_state == hst->current_state
-      && compare_strings(old_plugin_output, hst->plugin_output)) {
-
-    if (hst->current_state == HOST_UP && hst->stalk_on_up == true)
-      log_host_event(hst);
-
-    else if (hst->current_state == HOST_DOWN
-             && hst->stalk_on_down == true)
-      log_host_event(hst);
-
-    else if (hst->current_state == HOST_UNREACHABLE
-             && hst->stalk_on_unreachable == true)
-      log_host_event(hst);
-  }
-
-  /* check to see if the associated host is flapping */
-  check_for_host_flapping(hst, true, true, true);
-
-  /* reschedule the next check of the host (usually ONLY for scheduled, active checks, unless overridden above) */
-  if (reschedule_check == true) {
-    logger(dbg_checks, more)
-      << "Rescheduling next check of host at " << my_ctime(&next_check);
-
-    /* default is to reschedule host check unless a test below fails... */
-    hst->should_be_scheduled = true;
-
-    /* get the new current time */
-    time(&current_time);
-
-    /* make sure we don't get ourselves into too much trouble... */
-    if (current_time > next_check)
-      hst->next_check = current_time;
-    else
-      hst->next_check = next_check;
-
-    // Make sure we rescheduled the next host check at a valid time.
-    {
-      timezone_locker lock(get_host_timezone(hst->name));
-      preferred_time = hst->next_check;
-      get_next_valid_time(
-        preferred_time,
-        &next_valid_time,
-        hst->check_period_ptr);
-      hst->next_check = next_valid_time;
-    }
-
-    /* hosts with non-recurring intervals do not get rescheduled if we're in a HARD or UP state */
-    if (hst->check_interval == 0
-        && (hst->state_type == HARD_STATE
-            || hst->current_state == HOST_UP))
-      hst->should_be_scheduled = false;
-
-    /* host with active checks disabled do not get rescheduled */
-    if (hst->checks_enabled == false)
-      hst->should_be_scheduled = false;
-
-    /* schedule a non-forced check if we can */
-    if (hst->should_be_scheduled == true) {
-      schedule_host_check(hst, hst->next_check, CHECK_OPTION_NONE);
-    }
+  /* the processing is finished once the results of the parent hosts are processed */
+  if (pending != NULL) {
+    pending->check_hostlist = check_hostlist;
+    pending->check_timestamp_horizon = check_timestamp_horizon;
+    pending->next_check = next_check;
+    pending->reschedule_check = reschedule_check;
+    pending->use_cached_result = use_cached_result;
+    return (OK);
   }
 
-  /* update host status - for both active (scheduled) and passive (non-scheduled) hosts */
-  update_host_status(hst, false);
-
-  /* run async checks of all hosts we added above */
-  /* don't run a check if one is already executing or we can get by with a cached state */
-  for (hostlist_item = check_hostlist;
-       hostlist_item != NULL;
-       hostlist_item = hostlist_item->next) {
-    run_async_check = true;
-    temp_host = (host*)hostlist_item->object_ptr;
-
-    logger(dbg_checks, most)
-      << "ASYNC CHECK OF HOST: " << temp_host->name
-      << ", CURRENTTIME: " << current_time
-      << ", LASTHOSTCHECK: " << temp_host->last_check
-      << ", CACHEDTIMEHORIZON: " << check_timestamp_horizon
-      << ", USECACHEDRESULT: " << use_cached_result
-      << ", ISEXECUTING: " << temp_host->is_executing;
-
-    if (use_cached_result == true
-        && (static_cast<unsigned long>(current_time - temp_host->last_check) <= check_timestamp_horizon))
-      run_async_check = false;
-    if (temp_host->is_executing == true)
-      run_async_check = false;
-    if (run_async_check == true)
-      run_async_host_check_3x(
-        temp_host,
-        CHECK_OPTION_NONE,
-        0.0,
-        false,
-        false,
-        NULL,
-        NULL);
-  }
-  free_objectlist(&check_hostlist);
-  return (OK);
+  return (finish_host_check_result_3x(
+            hst,
+            old_plugin_output,
+            reschedule_check,
+            next_check,
+            check_hostlist,
+            use_cached_result,
+            check_timestamp_horizon));
 }
 
 /* checks viability of performing a host check */
@@ -3386,16 +3762,14 @@ int check_host_check_viability_3x(
     }
 
     // Make sure this is a valid time to check the host.
-    {
-      timezone_locker lock(get_host_timezone(hst->name));
-      if (check_time_against_period(
-            static_cast<unsigned long>(current_time),
-            hst->check_period_ptr) == ERROR) {
-        preferred_time = current_time;
-        if (time_is_valid)
-          *time_is_valid = false;
-        perform_check = false;
-      }
+    if (check_time_against_period_for_timezone(
+          static_cast<unsigned long>(current_time),
+          hst->check_period_ptr,
+          get_host_timezone(hst)) == ERROR) {
+      preferred_time = current_time;
+      if (time_is_valid)
+        *time_is_valid = false;
+      perform_check = false;
     }
 
     /* check host dependencies for execution */
@@ -30,7 +30,9 @@
 #include "com/centreon/engine/checks/viability_failure.hh"
 #include "com/centreon/engine/commands/command.hh"
 #include "com/centreon/engine/commands/set.hh"
+#include "com/centreon/engine/configuration/applier/state.hh"
 #include "com/centreon/engine/error.hh"
+#include "com/centreon/engine/events/loop.hh"
 #include "com/centreon/engine/globals.hh"
 #include "com/centreon/engine/logging/logger.hh"
 #include "com/centreon/engine/neberrors.hh"
@@ -54,6 +56,33 @@ static checker* _instance = NULL;
 *                                     *
 **************************************/
 
+/**
+ *  Register a continuation, run once the state of a host has been
+ *  processed.
+ *
+ *  @param[in] hst       Host whose state is waited for.
+ *  @param[in] callback  Function called with the host, or with NULL if
+ *                       the continuation was cancelled by a
+ *                       configuration reload.
+ *  @param[in] arg       Argument of the callback.
+ */
+void checker::add_host_continuation(
+                host* hst,
+                host_callback callback,
+                void* arg) {
+  unsigned int generation(
+                 configuration::applier::state::instance().generation());
+  if (_host_continuations_generation != generation) {
+    _cancel_host_continuations();
+    _host_continuations_generation = generation;
+  }
+  host_continuation c;
+  c.arg = arg;
+  c.callback = callback;
+  _host_continuations.insert(std::make_pair(hst, c));
+  return;
+}
+
 /**
  *  Get instance of the checker singleton.
  *
@@ -73,13 +102,31 @@ void checker::load() {
 }
 
 /**
- *  Add into the queue a result to reap later.
+ *  Add into the queue a result to reap later. Can be called from any
+ *  thread, the result is moved into the queue without locking and the
+ *  events loop is woken up to reap it.
  *
  *  @param[in] result The check_result to process later.
  */
 void checker::push_check_result(check_result const& result) {
-  concurrency::locker lock(&_mut_reap);
-  _to_reap.push(result);
+  queued_result* queued(new queued_result);
+  queued->cr = result;
+  queued->cr.next = NULL;
+  push_check_result(queued);
+  return;
+}
+
+/**
+ *  Add into the queue a result to reap later, with the engine data
+ *  already set (checked object, cached host states to use, ...).
+ *
+ *  @param[in] result The result to process later, the checker takes
+ *                    its ownership.
+ */
+void checker::push_check_result(queued_result* result) {
+  result->next = NULL;
+  _results.push(result);
+  events::loop::instance().wake_up();
   return;
 }
 
@@ -103,81 +150,130 @@ void checker::reap() {
 
   // Keep compatibility with old check result list.
   if (check_result_list) {
-    concurrency::locker lock(&_mut_reap);
     check_result* cr(NULL);
     while ((cr = read_check_result())) {
-      _to_reap.push(*cr);
+      queued_result* queued(new queued_result);
+      queued->cr = *cr;
+      queued->cr.next = NULL;
       delete cr;
+      _to_reap.push(queued);
     }
   }
 
+  // Adjust the number of output parsers.
+  if (_parsers.size() != config->check_reaper_threads())
+    _start_parsers(config->check_reaper_threads());
+
+  // Get results pushed by other threads.
+  for (queued_result* result(_results.pop_all()); result;) {
+    queued_result* next(result->next);
+    result->next = NULL;
+    _to_reap.push(result);
+    result = next;
+  }
+
+  // Merge partial check results.
+  for (partial_result* pr(_partials.pop_all()); pr;) {
+    // Find the base part.
+    umap<unsigned long, queued_result*>::iterator
+      it_id(_list_id.find(pr->command_id));
+    if (_list_id.end() == it_id) {
+      logger(log_runtime_warning, basic)
+        << "command ID '" << pr->command_id << "' not found";
+      delete[] pr->output;
+    }
+    else {
+      logger(dbg_checks, basic)
+        << "command ID (" << pr->command_id << ") executed";
+      queued_result* result(it_id->second);
+
+      // Merge check result.
+      result->cr.finish_time = pr->finish_time;
+      result->cr.early_timeout = pr->early_timeout;
+      result->cr.return_code = pr->return_code;
+      result->cr.exited_ok = pr->exited_ok;
+      result->cr.output = pr->output;
+
+      // Push back in reap list.
+      _to_reap.push(result);
+      _list_id.erase(it_id);
+    }
+    partial_result* next(pr->next);
+    delete pr;
+    pr = next;
+  }
+
   // Reap check results.
+  unsigned int generation(
+                 configuration::applier::state::instance().generation());
   unsigned int reaped_checks(0);
   { // Scope to release mutex in all termination cases.
     concurrency::locker lock(&_mut_reap);
 
-    // Merge partial check results.
-    while (!_to_reap_partial.empty()) {
-      // Find the two parts.
-      umap<unsigned long, check_result>::iterator
-        it_partial(_to_reap_partial.begin());
-      umap<unsigned long, check_result>::iterator
-        it_id(_list_id.find(it_partial->first));
-      if (_list_id.end() == it_id) {
-        logger(log_runtime_warning, basic)
-          << "command ID '" << it_partial->first << "' not found";
-      }
-      else {
-        // Extract base part.
-        logger(dbg_checks, basic)
-          << "command ID (" << it_partial->first << ") executed";
-        check_result result;
-        result = it_id->second;
-        _list_id.erase(it_id);
-
-        // Merge check result.
-        result.finish_time.tv_sec = it_partial->second.finish_time.tv_sec;
-        result.finish_time.tv_usec = it_partial->second.finish_time.tv_usec;
-        result.early_timeout = it_partial->second.early_timeout;
-        result.return_code = it_partial->second.return_code;
-        result.exited_ok = it_partial->second.exited_ok;
-        result.output = it_partial->second.output;
-
-        // Push back in reap list.
-        _to_reap.push(result);
+    // Parse check results output in parsers. Results of a same host
+    // are handled by the same parser to keep their order.
+    if (!_parsers.empty())
+      while (!_to_reap.empty()) {
+        queued_result* result(_to_reap.front());
+        unsigned int hash(0);
+        for (char const* ptr(result->cr.host_name); ptr && *ptr; ++ptr)
+          hash = hash * 31 + *ptr;
+        _parsers[hash % _parsers.size()]->push(result);
+        ++_parsing;
+        _to_reap.pop();
       }
-      _to_reap_partial.erase(it_partial);
-    }
 
     // Process check results.
-    while (!_to_reap.empty()) {
+    while (true) {
+      std::queue<queued_result*>* ready(NULL);
+      if (!_parsed.empty())
+        ready = &_parsed;
+      else if (!_to_reap.empty())
+        ready = &_to_reap;
+      else if (_parsing) {
+        _cv_parsed.wait(&_mut_reap);
+        continue;
+      }
+      else
+        break;
+
       // Get result host or service check.
       logger(dbg_checks, basic)
         << "Found a check result (#" << ++reaped_checks
         << ") to handle...";
-      check_result result(_to_reap.front());
-      _to_reap.pop();
+      queued_result* result(ready->front());
+      ready->pop();
       lock.unlock();
 
+      // Object pointers are only valid in the configuration
+      // generation they were resolved in.
+      if (result->object_generation != generation) {
+        result->host_ptr = NULL;
+        result->service_ptr = NULL;
+      }
+
       // Service check result.
-      if (SERVICE_CHECK == result.object_check_type) {
+      if (SERVICE_CHECK == result->cr.object_check_type) {
         try {
           // Check if the service exists.
-          service& svc(find_service(
-                         result.host_name,
-                         result.service_description));
+          service& svc(result->service_ptr
+                       ? *result->service_ptr
+                       : find_service(
+                           result->cr.host_name,
+                           result->cr.service_description));
           // Process the check result.
           logger(dbg_checks, more)
             << "Handling check result for service '"
-            << result.service_description << "' on host '"
-            << result.host_name << "'...";
-          handle_async_service_check_result(&svc, &result);
+            << result->cr.service_description << "' on host '"
+            << result->cr.host_name << "'...";
+          handle_async_service_check_result(&svc, &result->cr, result);
+          update_service_check_deadlines(&svc);
         }
         catch (std::exception const& e) {
           logger(log_runtime_warning, basic)
             << "Warning: Check result queue contained results for "
-            << "service '" << result.service_description << "' on "
-            << "host '" << result.host_name << "', but the service "
+            << "service '" << result->cr.service_description << "' on "
+            << "host '" << result->cr.host_name << "', but the service "
             << "could not be found! Perhaps you forgot to define the "
             << "service in your config files ?";
         }
@@ -185,29 +281,33 @@ void checker::reap() {
       // Host check result.
       else {
         try {
-          host& hst(find_host(result.host_name));
+          host& hst(result->host_ptr
+                    ? *result->host_ptr
+                    : find_host(result->cr.host_name));
           // Process the check result.
           logger(dbg_checks, more)
             << "Handling check result for host '"
-            << result.host_name << "'...";
-          handle_async_host_check_result_3x(&hst, &result);
+            << result->cr.host_name << "'...";
+          handle_async_host_check_result_3x(&hst, &result->cr, result);
+          update_host_check_deadlines(&hst);
         }
         catch (std::exception const& e) {
           // Check if the host exists.
           logger(log_runtime_warning, basic)
             << "Warning: Check result queue contained results for "
-            << "host '" << result.host_name << "', but the host could "
+            << "host '" << result->cr.host_name << "', but the host could "
             << "not be found! Perhaps you forgot to define the host in "
             << "your config files ?";
         }
       }
 
       // Cleanup.
-      free_check_result(&result);
+      delete result;
 
       // Check if reaping has timed out.
       time_t current_time;
       time(&current_time);
+      update_check_stats(REAPED_CHECK_RESULT_STATS, current_time);
       if ((current_time - reaper_start_time)
           > static_cast<time_t>(config->max_check_reaper_time())) {
         logger(dbg_checks, basic)
@@ -240,8 +340,10 @@ void checker::reap() {
  *  @return True if the reper queue is empty, otherwise false.
  */
 bool checker::reaper_is_empty() {
+  if (!_to_reap.empty() || !_results.empty() || !_partials.empty())
+    return (false);
   concurrency::locker lock(&_mut_reap);
-  return (_to_reap.empty());
+  return (_parsed.empty() && !_parsing);
 }
 
 /**
@@ -254,8 +356,6 @@ bool checker::reaper_is_empty() {
  *  @param[in]  reschedule_check If the check are reschedule.
  *  @param[out] time_is_valid    Host check viable at this time.
  *  @param[out] preferred_time   The next preferred check time.
- *
- *  @return True is the check start correctly.
  */
 void checker::run(
                 host* hst,
@@ -265,232 +365,16 @@ void checker::run(
                 bool reschedule_check,
                 int* time_is_valid,
                 time_t* preferred_time) {
-  logger(dbg_functions, basic)
-    << "checker::run: hst=" << hst
-    << ", check_options=" << check_options
-    << ", latency=" << latency
-    << ", scheduled_check=" << scheduled_check
-    << ", reschedule_check=" << reschedule_check;
-
-  // Preamble.
-  if (!hst)
-    throw (engine_error() << "Attempt to run check on invalid host");
-  if (!hst->check_command_ptr)
-    throw (engine_error() << "Attempt to run active check on host '"
-           << hst->name << "' with no check command");
-
-  logger(dbg_checks, basic)
-    << "** Running async check of host '" << hst->name << "'...";
-
-  // Check if the host is viable now.
-  if (check_host_check_viability_3x(
-        hst,
-        check_options,
-        time_is_valid,
-        preferred_time) == ERROR)
-    throw (checks_viability_failure() << "Check of host '" << hst->name
-           << "' is not viable");
-
-  // If this check is a rescheduled check, propagate the rescheduled check flag
-  // to the host. This solves the problem when a new host check is
-  // bound to be rescheduled but would be discarded because a host check
-  // is already running.
-  if (reschedule_check)
-    host_other_props[hst->name].should_reschedule_current_check = true;
-
-  // Don't execute a new host check if one is already running.
-  if (hst->is_executing
-        && !(check_options & CHECK_OPTION_FORCE_EXECUTION)) {
-    logger(dbg_checks, basic)
-      << "A check of this host (" << hst->name
-      << ") is already being executed, so we'll pass for the moment...";
-    return ;
-  }
-
-  // Send broker event.
-  timeval start_time;
-  timeval end_time;
-  memset(&start_time, 0, sizeof(start_time));
-  memset(&end_time, 0, sizeof(end_time));
-  int res(broker_host_check(
-            NEBTYPE_HOSTCHECK_ASYNC_PRECHECK,
-            NEBFLAG_NONE,
-            NEBATTR_NONE,
-            hst,
-            HOST_CHECK_ACTIVE,
-            hst->current_state,
-            hst->state_type,
-            start_time,
-            end_time,
-            hst->host_check_command,
-            hst->latency,
-            0.0,
-            config->host_check_timeout(),
-            false,
-            0,
-            NULL,
-            NULL,
-            NULL,
-            NULL,
-            NULL));
-
-  // Host check was cancel by NEB module. Reschedule check later.
-  if (NEBERROR_CALLBACKCANCEL == res)
-    throw (engine_error()
-           << "Some broker module cancelled check of host '"
-           << hst->name << "'");
-  // Host check was overriden by NEB module.
-  else if (NEBERROR_CALLBACKOVERRIDE == res) {
-    logger(dbg_functions, basic)
-           << "Some broker module overrode check of host '"
-           << hst->name << "' so we'll bail out";
-    return ;
-  }
-
-  // Checking starts.
-  logger(dbg_functions, basic)
-    << "Checking host '" << hst->name << "'...";
-
-  // Clear check options.
-  if (scheduled_check)
-    hst->check_options = CHECK_OPTION_NONE;
-
-  // Adjust check attempts.
-  adjust_host_check_attempt_3x(hst, true);
-
-  // Update latency for event broker and macros.
-  double old_latency(hst->latency);
-  hst->latency = latency;
-
-  // Get current host macros.
-  nagios_macros macros;
-  memset(&macros, 0, sizeof(macros));
-  grab_host_macros_r(&macros, hst);
-  get_raw_command_line_r(
-    &macros,
-    hst->check_command_ptr,
-    hst->host_check_command,
-    NULL,
-    0);
-
-  // Time to start command.
-  gettimeofday(&start_time, NULL);
-
-  // Set check time for on-demand checks, so they're
-  // not incorrectly detected as being orphaned.
-  if (!scheduled_check)
-    hst->next_check = start_time.tv_sec;
-
-  // Update the number of running host checks.
-  ++currently_running_host_checks;
-
-  // Set the execution flag.
-  hst->is_executing = true;
-
-  // Init check result info.
-  check_result check_result_info;
-  check_result_info.object_check_type = HOST_CHECK;
-  check_result_info.check_type = HOST_CHECK_ACTIVE;
-  check_result_info.check_options = check_options;
-  check_result_info.scheduled_check = scheduled_check;
-  check_result_info.reschedule_check = reschedule_check;
-  check_result_info.start_time = start_time;
-  check_result_info.finish_time = start_time;
-  check_result_info.early_timeout = false;
-  check_result_info.exited_ok = true;
-  check_result_info.return_code = STATE_OK;
-  check_result_info.output = NULL;
-  check_result_info.output_file_fd = -1;
-  check_result_info.output_file_fp = NULL;
-  check_result_info.output_file = NULL;
-  check_result_info.host_name = string::dup(hst->name);
-  check_result_info.service_description = NULL;
-  check_result_info.latency = latency;
-  check_result_info.next = NULL;
-
-  // Get command object.
-  commands::set& cmd_set(commands::set::instance());
-  shared_ptr<commands::command>
-    cmd(cmd_set.get_command(hst->check_command_ptr->name));
-  std::string processed_cmd(cmd->process_cmd(&macros));
-  char* processed_cmd_ptr(string::dup(processed_cmd));
-
-  // Send event broker.
-  broker_host_check(
-    NEBTYPE_HOSTCHECK_INITIATE,
-    NEBFLAG_NONE,
-    NEBATTR_NONE,
+  _run(
     hst,
-    HOST_CHECK_ACTIVE,
-    hst->current_state,
-    hst->state_type,
-    start_time,
-    end_time,
-    hst->host_check_command,
-    hst->latency,
-    0.0,
-    config->host_check_timeout(),
-    false,
-    0,
-    processed_cmd_ptr,
-    NULL,
-    NULL,
-    NULL,
-    NULL);
-
-  delete[] processed_cmd_ptr;
-
-  // Restore latency.
-  hst->latency = old_latency;
-
-  // Update statistics.
-  update_check_stats(
-    (scheduled_check == true)
-    ? ACTIVE_SCHEDULED_HOST_CHECK_STATS
-    : ACTIVE_ONDEMAND_HOST_CHECK_STATS,
-    start_time.tv_sec);
-  update_check_stats(PARALLEL_HOST_CHECK_STATS, start_time.tv_sec);
-
-  // Run command.
-  bool retry;
-  do {
-    retry = false;
-    try {
-      // Run command.
-      unsigned long id(cmd->run(
-                              processed_cmd,
-                              macros,
-                              config->host_check_timeout()));
-      if (id != 0)
-        _list_id[id] = check_result_info;
-    }
-    catch (com::centreon::exceptions::interruption const& e) {
-      (void)e;
-      retry = true;
-    }
-    catch (std::exception const& e) {
-      timestamp now(timestamp::now());
-
-      // Update check result.
-      check_result_info.finish_time.tv_sec = now.to_seconds();
-      check_result_info.finish_time.tv_usec = now.to_useconds()
-        - check_result_info.finish_time.tv_sec * 1000000ull;
-      check_result_info.early_timeout = false;
-      check_result_info.return_code = STATE_UNKNOWN;
-      check_result_info.exited_ok = true;
-      check_result_info.output = string::dup("(Execute command failed)");
-
-      // Queue check result.
-      concurrency::locker lock(&_mut_reap);
-      _to_reap.push(check_result_info);
-
-      logger(log_runtime_warning, basic)
-        << "Error: Host check command execution failed: " << e.what();
-    }
-  } while (retry);
-
-  // Cleanup.
-  clear_volatile_macros_r(&macros);
+    check_options,
+    latency,
+    scheduled_check,
+    reschedule_check,
+    time_is_valid,
+    preferred_time,
+    true,
+    config->cached_host_check_horizon());
   return;
 }
 
@@ -621,27 +505,30 @@ void checker::run(
 
   // Set the execution flag.
   svc->is_executing = true;
+  update_service_check_deadlines(svc);
 
   // Init check result info.
-  check_result check_result_info;
-  check_result_info.object_check_type = SERVICE_CHECK;
-  check_result_info.check_type = SERVICE_CHECK_ACTIVE;
-  check_result_info.check_options = check_options;
-  check_result_info.scheduled_check = scheduled_check;
-  check_result_info.reschedule_check = reschedule_check;
-  check_result_info.start_time = start_time;
-  check_result_info.finish_time = start_time;
-  check_result_info.early_timeout = false;
-  check_result_info.exited_ok = true;
-  check_result_info.return_code = STATE_OK;
-  check_result_info.output = NULL;
-  check_result_info.output_file_fd = -1;
-  check_result_info.output_file_fp = NULL;
-  check_result_info.output_file = NULL;
-  check_result_info.host_name = string::dup(svc->host_name);
-  check_result_info.service_description = string::dup(svc->description);
-  check_result_info.latency = latency;
-  check_result_info.next = NULL;
+  queued_result* result(new queued_result);
+  result->cr.object_check_type = SERVICE_CHECK;
+  result->cr.check_type = SERVICE_CHECK_ACTIVE;
+  result->cr.check_options = check_options;
+  result->cr.scheduled_check = scheduled_check;
+  result->cr.reschedule_check = reschedule_check;
+  result->cr.start_time = start_time;
+  result->cr.finish_time = start_time;
+  result->cr.early_timeout = false;
+  result->cr.exited_ok = true;
+  result->cr.return_code = STATE_OK;
+  result->cr.output = NULL;
+  result->cr.output_file_fd = -1;
+  result->cr.output_file_fp = NULL;
+  result->cr.output_file = NULL;
+  result->cr.host_name = string::dup(svc->host_name);
+  result->cr.service_description = string::dup(svc->description);
+  result->cr.latency = latency;
+  result->service_ptr = svc;
+  result->object_generation
+    = configuration::applier::state::instance().generation();
 
   // Get command object.
   commands::set& cmd_set(commands::set::instance());
@@ -674,6 +561,7 @@ void checker::run(
 
   // Service check was override by neb_module.
   if (NEBERROR_CALLBACKOVERRIDE == res) {
+    delete result;
     clear_volatile_macros_r(&macros);
     return;
   }
@@ -695,7 +583,7 @@ void checker::run(
                               macros,
                               config->service_check_timeout()));
       if (id != 0)
-        _list_id[id] = check_result_info;
+        _list_id[id] = result;
     }
     catch (com::centreon::exceptions::interruption const& e) {
       (void)e;
@@ -705,17 +593,16 @@ void checker::run(
       timestamp now(timestamp::now());
 
       // Update check result.
-      check_result_info.finish_time.tv_sec = now.to_seconds();
-      check_result_info.finish_time.tv_usec = now.to_useconds()
-        - check_result_info.finish_time.tv_sec * 1000000ull;
-      check_result_info.early_timeout = false;
-      check_result_info.return_code = STATE_UNKNOWN;
-      check_result_info.exited_ok = true;
-      check_result_info.output = string::dup("(Execute command failed)");
+      result->cr.finish_time.tv_sec = now.to_seconds();
+      result->cr.finish_time.tv_usec = now.to_useconds()
+        - result->cr.finish_time.tv_sec * 1000000ull;
+      result->cr.early_timeout = false;
+      result->cr.return_code = STATE_UNKNOWN;
+      result->cr.exited_ok = true;
+      result->cr.output = string::dup("(Execute command failed)");
 
       // Queue check result.
-      concurrency::locker lock(&_mut_reap);
-      _to_reap.push(check_result_info);
+      _to_reap.push(result);
 
       logger(log_runtime_warning, basic)
         << "Error: Service check command execution failed: " << e.what();
@@ -727,23 +614,63 @@ void checker::run(
   return;
 }
 
+
 /**
- *  Run an host check and wait check result.
+ *  Run the continuations registered on a host whose state has just
+ *  been processed.
+ *
+ *  @param[in] hst  The host.
+ */
+void checker::run_host_continuations(host* hst) {
+  if (_host_continuations.empty())
+    return;
+
+  // Pointers of a previous configuration are not valid anymore.
+  if (_host_continuations_generation
+      != configuration::applier::state::instance().generation()) {
+    _cancel_host_continuations();
+    return;
+  }
+
+  // Continuations can register new ones, so they are removed first.
+  std::pair<umultimap<host*, host_continuation>::iterator,
+            umultimap<host*, host_continuation>::iterator>
+    range(_host_continuations.equal_range(hst));
+  std::vector<host_continuation> continuations;
+  for (umultimap<host*, host_continuation>::iterator it(range.first);
+       it != range.second;
+       ++it)
+    continuations.push_back(it->second);
+  _host_continuations.erase(range.first, range.second);
+  for (std::vector<host_continuation>::const_iterator
+         it(continuations.begin()), end(continuations.end());
+       it != end;
+       ++it)
+    (*it->callback)(hst, it->arg);
+  return;
+}
+
+/**
+ *  Run an on-demand host check without waiting check result.
  *
  *  @param[in]  hst                     Host to check.
- *  @param[out] check_result_code       The return value of the execution.
+ *  @param[out] check_result_code       Cached or current host state.
  *  @param[in]  check_options           Event options.
  *  @param[in]  use_cached_result       Used the last result.
- *  @param[in]  check_timestamp_horizon XXX
+ *  @param[in]  check_timestamp_horizon Maximum age of the last result.
+ *
+ *  @return True if check_result_code is the result of the check, false
+ *          if the check is running and its result will be processed
+ *          by the reaper.
  */
-void checker::run_sync(
+bool checker::run_on_demand(
                 host* hst,
                 int* check_result_code,
                 int check_options,
                 int use_cached_result,
                 unsigned long check_timestamp_horizon) {
   logger(dbg_functions, basic)
-    << "checker::run: hst=" << hst
+    << "checker::run_on_demand: hst=" << hst
     << ", check_options=" << check_options
     << ", use_cached_result=" << use_cached_result
     << ", check_timestamp_horizon=" << check_timestamp_horizon;
@@ -751,16 +678,95 @@ void checker::run_sync(
   // Preamble.
   if (!hst)
     throw (engine_error()
-           << "Attempt to run synchronous check on invalid host");
+           << "Attempt to run on-demand check on invalid host");
   if (!hst->check_command_ptr)
     throw (engine_error()
-           << "Attempt to run synchronous active check on host '"
+           << "Attempt to run on-demand active check on host '"
            << hst->name << "' with no check command");
 
   logger(dbg_checks, basic)
-    << "** Run sync check of host '" << hst->name << "'...";
+    << "** Run on-demand check of host '" << hst->name << "'...";
 
-  // Check if the host is viable now.
+  // The current state is used until the result is processed.
+  if (check_result_code)
+    *check_result_code = hst->current_state;
+
+  // Check if the host is viable now.
+  if (check_host_check_viability_3x(hst, check_options, NULL, NULL)
+      == ERROR) {
+    logger(dbg_checks, basic)
+      << "Host check is not viable at this time";
+    return (true);
+  }
+
+  // Can we use the last cached host state?
+  time_t now(time(NULL));
+  if (use_cached_result
+      && !(check_options & CHECK_OPTION_FORCE_EXECUTION)
+      && hst->has_been_checked
+      && (static_cast<unsigned long>(now - hst->last_check)
+          <= check_timestamp_horizon)) {
+    logger(dbg_checks, more)
+      << "* Using cached host state: " << hst->current_state;
+
+    // Update statistics.
+    update_check_stats(ACTIVE_ONDEMAND_HOST_CHECK_STATS, now);
+    update_check_stats(ACTIVE_CACHED_HOST_CHECK_STATS, now);
+    return (true);
+  }
+
+  // Checking starts.
+  logger(dbg_checks, more)
+    << "* Running actual host check: old state=" << hst->current_state;
+  _run(
+    hst,
+    check_options,
+    0.0,
+    false,
+    false,
+    NULL,
+    NULL,
+    use_cached_result,
+    check_timestamp_horizon);
+
+  // No result will come if a module overrode the check.
+  return (!hst->is_executing);
+}
+
+/**
+ *  Run an host check and wait check result.
+ *
+ *  @param[in]  hst                     Host to check.
+ *  @param[out] check_result_code       The return value of the execution.
+ *  @param[in]  check_options           Event options.
+ *  @param[in]  use_cached_result       Used the last result.
+ *  @param[in]  check_timestamp_horizon Maximum age of the last result.
+ */
+void checker::run_sync(
+                host* hst,
+                int* check_result_code,
+                int check_options,
+                int use_cached_result,
+                unsigned long check_timestamp_horizon) {
+  logger(dbg_functions, basic)
+    << "checker::run: hst=" << hst
+    << ", check_options=" << check_options
+    << ", use_cached_result=" << use_cached_result
+    << ", check_timestamp_horizon=" << check_timestamp_horizon;
+
+  // Preamble.
+  if (!hst)
+    throw (engine_error()
+           << "Attempt to run synchronous check on invalid host");
+  if (!hst->check_command_ptr)
+    throw (engine_error()
+           << "Attempt to run synchronous active check on host '"
+           << hst->name << "' with no check command");
+
+  logger(dbg_checks, basic)
+    << "** Run sync check of host '" << hst->name << "'...";
+
+  // Check if the host is viable now.
   if (check_host_check_viability_3x(hst, check_options, NULL, NULL)
       == ERROR) {
     if (check_result_code)
@@ -932,7 +938,9 @@ void checker::unload() {
  *  Default constructor.
  */
 checker::checker()
-  : commands::command_listener() {
+  : commands::command_listener(),
+    _host_continuations_generation(0),
+    _parsing(0) {
 
 }
 
@@ -941,11 +949,34 @@ checker::checker()
  */
 checker::~checker() throw () {
   try {
+    _cancel_host_continuations();
+    _stop_parsers();
     concurrency::locker lock(&_mut_reap);
+    while (!_parsed.empty()) {
+      delete _parsed.front();
+      _parsed.pop();
+    }
     while (!_to_reap.empty()) {
-      free_check_result(&_to_reap.front());
+      delete _to_reap.front();
       _to_reap.pop();
     }
+    for (umap<unsigned long, queued_result*>::iterator
+           it(_list_id.begin()), end(_list_id.end());
+         it != end;
+         ++it)
+      delete it->second;
+    _list_id.clear();
+    for (queued_result* result(_results.pop_all()); result;) {
+      queued_result* next(result->next);
+      delete result;
+      result = next;
+    }
+    for (partial_result* pr(_partials.pop_all()); pr;) {
+      partial_result* next(pr->next);
+      delete[] pr->output;
+      delete pr;
+      pr = next;
+    }
   }
   catch (...) {}
 }
@@ -960,22 +991,43 @@ void checker::finished(commands::result const& res) throw () {
   logger(dbg_functions, basic)
     << "checker::finished: res=" << &res;
 
-  // Find check result.
-  check_result result;
-
-  // Update check result.
-  result.finish_time.tv_sec = res.end_time.to_seconds();
-  result.finish_time.tv_usec = res.end_time.to_useconds()
-                               - result.finish_time.tv_sec * 1000000ull;
-  result.early_timeout = (res.exit_status == process::timeout);
-  result.return_code = res.exit_code;
-  result.exited_ok = ((res.exit_status == process::normal)
-                      || (res.exit_status == process::timeout));
-  result.output = string::dup(res.output);
+  try {
+    // Build partial check result.
+    partial_result* pr(new partial_result);
+    pr->command_id = res.command_id;
+    pr->finish_time.tv_sec = res.end_time.to_seconds();
+    pr->finish_time.tv_usec = res.end_time.to_useconds()
+                              - pr->finish_time.tv_sec * 1000000ull;
+    pr->early_timeout = (res.exit_status == process::timeout);
+    pr->return_code = res.exit_code;
+    pr->exited_ok = ((res.exit_status == process::normal)
+                     || (res.exit_status == process::timeout));
+    pr->output = string::dup(res.output);
+    pr->next = NULL;
+
+    // Queue check result, it will be merged by the reaper.
+    _partials.push(pr);
+    events::loop::instance().wake_up();
+  }
+  catch (std::exception const& e) {
+    logger(log_runtime_error, basic)
+      << "Error: can't store check result of command ID '"
+      << res.command_id << "': " << e.what();
+  }
+  return;
+}
 
-  // Queue check result.
-  concurrency::locker lock(&_mut_reap);
-  _to_reap_partial[res.command_id] = result;
+/**
+ *  Cancel all the host continuations.
+ */
+void checker::_cancel_host_continuations() {
+  umultimap<host*, host_continuation> continuations;
+  continuations.swap(_host_continuations);
+  for (umultimap<host*, host_continuation>::iterator
+         it(continuations.begin()), end(continuations.end());
+       it != end;
+       ++it)
+    (*it->second.callback)(NULL, it->second.arg);
   return;
 }
 
@@ -1266,3 +1318,367 @@ int checker::_execute_sync(host* hst) {
     << "** Sync host check done: state=" << return_result;
   return (return_result);
 }
+
+/**
+ *  Run an host check without waiting check result.
+ *
+ *  @param[in]  hst              Host to check.
+ *  @param[in]  check_options    Event options.
+ *  @param[in]  latency          Host latency.
+ *  @param[in]  scheduled_check  If the check are schedule.
+ *  @param[in]  reschedule_check If the check are reschedule.
+ *  @param[out] time_is_valid    Host check viable at this time.
+ *  @param[out] preferred_time   The next preferred check time.
+ *  @param[in]  use_cached_result       Can host checks propagated by
+ *                                      the result use cached states.
+ *  @param[in]  check_timestamp_horizon Age of the cached states.
+ */
+void checker::_run(
+                host* hst,
+                int check_options,
+                double latency,
+                bool scheduled_check,
+                bool reschedule_check,
+                int* time_is_valid,
+                time_t* preferred_time,
+                int use_cached_result,
+                unsigned long check_timestamp_horizon) {
+  logger(dbg_functions, basic)
+    << "checker::run: hst=" << hst
+    << ", check_options=" << check_options
+    << ", latency=" << latency
+    << ", scheduled_check=" << scheduled_check
+    << ", reschedule_check=" << reschedule_check;
+
+  // Preamble.
+  if (!hst)
+    throw (engine_error() << "Attempt to run check on invalid host");
+  if (!hst->check_command_ptr)
+    throw (engine_error() << "Attempt to run active check on host '"
+           << hst->name << "' with no check command");
+
+  logger(dbg_checks, basic)
+    << "** Running async check of host '" << hst->name << "'...";
+
+  // Check if the host is viable now.
+  if (check_host_check_viability_3x(
+        hst,
+        check_options,
+        time_is_valid,
+        preferred_time) == ERROR)
+    throw (checks_viability_failure() << "Check of host '" << hst->name
+           << "' is not viable");
+
+  // If this check is a rescheduled check, propagate the rescheduled check flag
+  // to the host. This solves the problem when a new host check is
+  // bound to be rescheduled but would be discarded because a host check
+  // is already running.
+  if (reschedule_check)
+    hst->other_props->should_reschedule_current_check = true;
+
+  // Don't execute a new host check if one is already running.
+  if (hst->is_executing
+        && !(check_options & CHECK_OPTION_FORCE_EXECUTION)) {
+    logger(dbg_checks, basic)
+      << "A check of this host (" << hst->name
+      << ") is already being executed, so we'll pass for the moment...";
+    return ;
+  }
+
+  // Send broker event.
+  timeval start_time;
+  timeval end_time;
+  memset(&start_time, 0, sizeof(start_time));
+  memset(&end_time, 0, sizeof(end_time));
+  int res(broker_host_check(
+            NEBTYPE_HOSTCHECK_ASYNC_PRECHECK,
+            NEBFLAG_NONE,
+            NEBATTR_NONE,
+            hst,
+            HOST_CHECK_ACTIVE,
+            hst->current_state,
+            hst->state_type,
+            start_time,
+            end_time,
+            hst->host_check_command,
+            hst->latency,
+            0.0,
+            config->host_check_timeout(),
+            false,
+            0,
+            NULL,
+            NULL,
+            NULL,
+            NULL,
+            NULL));
+
+  // Host check was cancel by NEB module. Reschedule check later.
+  if (NEBERROR_CALLBACKCANCEL == res)
+    throw (engine_error()
+           << "Some broker module cancelled check of host '"
+           << hst->name << "'");
+  // Host check was overriden by NEB module.
+  else if (NEBERROR_CALLBACKOVERRIDE == res) {
+    logger(dbg_functions, basic)
+           << "Some broker module overrode check of host '"
+           << hst->name << "' so we'll bail out";
+    return ;
+  }
+
+  // Checking starts.
+  logger(dbg_functions, basic)
+    << "Checking host '" << hst->name << "'...";
+
+  // Clear check options.
+  if (scheduled_check)
+    hst->check_options = CHECK_OPTION_NONE;
+
+  // Adjust check attempts.
+  adjust_host_check_attempt_3x(hst, true);
+
+  // Update latency for event broker and macros.
+  double old_latency(hst->latency);
+  hst->latency = latency;
+
+  // Get current host macros.
+  nagios_macros macros;
+  memset(&macros, 0, sizeof(macros));
+  grab_host_macros_r(&macros, hst);
+  get_raw_command_line_r(
+    &macros,
+    hst->check_command_ptr,
+    hst->host_check_command,
+    NULL,
+    0);
+
+  // Time to start command.
+  gettimeofday(&start_time, NULL);
+
+  // Set check time for on-demand checks, so they're
+  // not incorrectly detected as being orphaned.
+  if (!scheduled_check)
+    hst->next_check = start_time.tv_sec;
+
+  // Update the number of running host checks.
+  ++currently_running_host_checks;
+
+  // Set the execution flag.
+  hst->is_executing = true;
+  update_host_check_deadlines(hst);
+
+  // Init check result info.
+  queued_result* result(new queued_result);
+  result->cr.object_check_type = HOST_CHECK;
+  result->cr.check_type = HOST_CHECK_ACTIVE;
+  result->cr.check_options = check_options;
+  result->cr.scheduled_check = scheduled_check;
+  result->cr.reschedule_check = reschedule_check;
+  result->cr.start_time = start_time;
+  result->cr.finish_time = start_time;
+  result->cr.early_timeout = false;
+  result->cr.exited_ok = true;
+  result->cr.return_code = STATE_OK;
+  result->cr.output = NULL;
+  result->cr.output_file_fd = -1;
+  result->cr.output_file_fp = NULL;
+  result->cr.output_file = NULL;
+  result->cr.host_name = string::dup(hst->name);
+  result->cr.service_description = NULL;
+  result->cr.latency = latency;
+  result->host_ptr = hst;
+  result->object_generation
+    = configuration::applier::state::instance().generation();
+  result->use_cached_result = use_cached_result;
+  result->check_timestamp_horizon = check_timestamp_horizon;
+
+  // Get command object.
+  commands::set& cmd_set(commands::set::instance());
+  shared_ptr<commands::command>
+    cmd(cmd_set.get_command(hst->check_command_ptr->name));
+  std::string processed_cmd(cmd->process_cmd(&macros));
+  char* processed_cmd_ptr(string::dup(processed_cmd));
+
+  // Send event broker.
+  broker_host_check(
+    NEBTYPE_HOSTCHECK_INITIATE,
+    NEBFLAG_NONE,
+    NEBATTR_NONE,
+    hst,
+    HOST_CHECK_ACTIVE,
+    hst->current_state,
+    hst->state_type,
+    start_time,
+    end_time,
+    hst->host_check_command,
+    hst->latency,
+    0.0,
+    config->host_check_timeout(),
+    false,
+    0,
+    processed_cmd_ptr,
+    NULL,
+    NULL,
+    NULL,
+    NULL);
+
+  delete[] processed_cmd_ptr;
+
+  // Restore latency.
+  hst->latency = old_latency;
+
+  // Update statistics.
+  update_check_stats(
+    (scheduled_check == true)
+    ? ACTIVE_SCHEDULED_HOST_CHECK_STATS
+    : ACTIVE_ONDEMAND_HOST_CHECK_STATS,
+    start_time.tv_sec);
+  update_check_stats(PARALLEL_HOST_CHECK_STATS, start_time.tv_sec);
+
+  // Run command.
+  bool retry;
+  do {
+    retry = false;
+    try {
+      // Run command.
+      unsigned long id(cmd->run(
+                              processed_cmd,
+                              macros,
+                              config->host_check_timeout()));
+      if (id != 0)
+        _list_id[id] = result;
+    }
+    catch (com::centreon::exceptions::interruption const& e) {
+      (void)e;
+      retry = true;
+    }
+    catch (std::exception const& e) {
+      timestamp now(timestamp::now());
+
+      // Update check result.
+      result->cr.finish_time.tv_sec = now.to_seconds();
+      result->cr.finish_time.tv_usec = now.to_useconds()
+        - result->cr.finish_time.tv_sec * 1000000ull;
+      result->cr.early_timeout = false;
+      result->cr.return_code = STATE_UNKNOWN;
+      result->cr.exited_ok = true;
+      result->cr.output = string::dup("(Execute command failed)");
+
+      // Queue check result.
+      _to_reap.push(result);
+
+      logger(log_runtime_warning, basic)
+        << "Error: Host check command execution failed: " << e.what();
+    }
+  } while (retry);
+
+  // Cleanup.
+  clear_volatile_macros_r(&macros);
+  return;
+}
+
+/**
+ *  Start check result output parsers.
+ *
+ *  @param[in] count  Number of parsers, 0 to parse output in the main
+ *                    thread.
+ */
+void checker::_start_parsers(unsigned int count) {
+  _stop_parsers();
+  logger(dbg_checks, basic)
+    << "Starting " << count << " check result output parsers";
+  for (unsigned int i(0); i < count; ++i) {
+    _parsers.push_back(new parser(this));
+    _parsers.back()->exec();
+  }
+  return;
+}
+
+/**
+ *  Stop check result output parsers. Parsers handle their pending
+ *  check results before exiting.
+ */
+void checker::_stop_parsers() {
+  for (std::vector<parser*>::iterator
+         it(_parsers.begin()), end(_parsers.end());
+       it != end;
+       ++it) {
+    (*it)->quit();
+    (*it)->wait();
+    delete *it;
+  }
+  _parsers.clear();
+  return;
+}
+
+/**
+ *  Parser constructor.
+ *
+ *  @param[in] c  The checker that owns the parser.
+ */
+checker::parser::parser(checker* c) : _c(c), _quit(false) {}
+
+/**
+ *  Parser destructor.
+ */
+checker::parser::~parser() throw () {}
+
+/**
+ *  Add a check result to parse.
+ *
+ *  @param[in] result  The check result.
+ */
+void checker::parser::push(queued_result* result) {
+  concurrency::locker lock(&_lock);
+  _queue.push(result);
+  _cv.wake_one();
+  return;
+}
+
+/**
+ *  Ask the parser to exit once its pending check results are parsed.
+ */
+void checker::parser::quit() {
+  concurrency::locker lock(&_lock);
+  _quit = true;
+  _cv.wake_one();
+  return;
+}
+
+/**
+ *  Parse check results output and forward them to the checker.
+ */
+void checker::parser::_run() {
+  concurrency::locker lock(&_lock);
+  while (true) {
+    if (_queue.empty()) {
+      if (_quit)
+        break;
+      _cv.wait(&_lock);
+      continue;
+    }
+    queued_result* result(_queue.front());
+    _queue.pop();
+    lock.unlock();
+
+    // Parse output, original output is kept for logging.
+    char* output(string::dup(static_cast<char const*>(result->cr.output)));
+    parse_check_output(
+      output,
+      &result->short_output,
+      &result->long_output,
+      &result->perf_data,
+      true,
+      true);
+    delete[] output;
+    result->output_parsed = true;
+
+    {
+      concurrency::locker lock_reap(&_c->_mut_reap);
+      _c->_parsed.push(result);
+      --_c->_parsing;
+      _c->_cv_parsed.wake_one();
+    }
+    lock.relock();
+  }
+  return;
+}
@@ -0,0 +1,54 @@
+/*
+** Copyright 2017 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include "com/centreon/engine/checks/queued_result.hh"
+#include "com/centreon/engine/globals.hh"
+#include "com/centreon/engine/utils.hh"
+#include "compatibility/check_result.h"
+
+using namespace com::centreon::engine::checks;
+
+/**
+ *  Default constructor. Host checks propagated by the result can use
+ *  cached host states, as for results read from the check result path.
+ */
+queued_result::queued_result()
+  : check_timestamp_horizon(config->cached_host_check_horizon()),
+    host_ptr(NULL),
+    long_output(NULL),
+    next(NULL),
+    object_generation(0),
+    output_parsed(false),
+    perf_data(NULL),
+    service_ptr(NULL),
+    short_output(NULL),
+    use_cached_result(true) {
+  init_check_result(&cr);
+  cr.output_file = NULL;
+}
+
+/**
+ *  Destructor, release the check result and its parsed output.
+ */
+queued_result::~queued_result() throw () {
+  free_check_result(&cr);
+  delete[] long_output;
+  delete[] perf_data;
+  delete[] short_output;
+}
@@ -40,7 +40,8 @@ commands::command::command(
                      command_listener* listener)
   : _command_line(command_line),
     _listener(listener),
-    _name(name) {
+    _name(name),
+    _plan(command_line) {
 
 }
 
@@ -108,6 +109,7 @@ std::string const& commands::command::get_name() const throw() {
 void commands::command::set_command_line(
                           std::string const& command_line) {
   _command_line = command_line;
+  _plan.compile(command_line);
   return;
 }
 
@@ -143,6 +145,7 @@ commands::command& commands::command::operator=(commands::command const& right)
     _command_line = right._command_line;
     _listener = right._listener;
     _name = right._name;
+    _plan = right._plan;
   }
   return (*this);
 }
@@ -155,10 +158,8 @@ commands::command& commands::command::operator=(commands::command const& right)
  *  @return The processed command line.
  */
 std::string commands::command::process_cmd(nagios_macros* macros) const {
-  char* command_line = NULL;
-  process_macros_r(macros, _command_line.c_str(), &command_line, 0);
-  std::string processed_cmd(command_line);
-  delete[] command_line;
+  std::string processed_cmd;
+  _plan.process(macros, processed_cmd);
   return (processed_cmd);
 }
 
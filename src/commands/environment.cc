@@ -48,7 +48,13 @@ environment::environment(char** env)
  *
  *  @param[in] right  The object to copy.
  */
-environment::environment(environment const& right) {
+environment::environment(environment const& right)
+  : _buffer(NULL),
+    _env(NULL),
+    _pos_buffer(0),
+    _pos_env(0),
+    _size_buffer(0),
+    _size_env(0) {
   _internal_copy(right);
 }
 
@@ -206,6 +212,32 @@ void environment::add(
   return;
 }
 
+/**
+ *  Add all the environement variables of another environment.
+ *
+ *  @param[in] right  The environment to add.
+ */
+void environment::add(environment const& right) {
+  if (!right._pos_env || (this == &right))
+    return;
+  unsigned int new_pos(_pos_buffer + right._pos_buffer);
+  if (new_pos > _size_buffer) {
+    if (new_pos < _size_buffer + EXTRA_SIZE_BUFFER)
+      _realoc_buffer(_size_buffer + EXTRA_SIZE_BUFFER);
+    else
+      _realoc_buffer(new_pos + EXTRA_SIZE_BUFFER);
+  }
+  memcpy(_buffer + _pos_buffer, right._buffer, right._pos_buffer);
+  if (_pos_env + right._pos_env >= _size_env)
+    _realoc_env(_pos_env + right._pos_env + EXTRA_SIZE_ENV);
+  for (unsigned int i(0); i < right._pos_env; ++i)
+    _env[_pos_env++]
+      = _buffer + _pos_buffer + (right._env[i] - right._buffer);
+  _env[_pos_env] = NULL;
+  _pos_buffer = new_pos;
+  return;
+}
+
 /**
  *  Get environement.
  */
@@ -222,14 +254,20 @@ void environment::_internal_copy(environment const& right) {
   if (this != &right) {
     delete[] _buffer;
     delete[] _env;
-     _pos_buffer = right._pos_buffer;
-     _pos_env = right._pos_env;
-     _size_buffer = right._size_buffer;
-     _size_env = right._size_env;
-     _buffer = new char[_size_buffer];
-     _env = new char*[_size_env];
-     memcpy(_buffer, right._buffer, _pos_buffer);
-     _rebuild_env();
+    _buffer = NULL;
+    _env = NULL;
+    _pos_buffer = right._pos_buffer;
+    _pos_env = right._pos_env;
+    _size_buffer = right._size_buffer;
+    _size_env = right._size_env;
+    if (_size_buffer) {
+      _buffer = new char[_size_buffer];
+      memcpy(_buffer, right._buffer, _pos_buffer);
+    }
+    if (_size_env) {
+      _env = new char*[_size_env];
+      _rebuild_env();
+    }
   }
   return;
 }
@@ -17,19 +17,61 @@
 ** <http://www.gnu.org/licenses/>.
 */
 
+#include <cstring>
+#include <sstream>
+#include <vector>
 #include "com/centreon/concurrency/locker.hh"
 #include "com/centreon/engine/commands/raw.hh"
 #include "com/centreon/engine/commands/environment.hh"
+#include "com/centreon/engine/configuration/applier/state.hh"
 #include "com/centreon/engine/error.hh"
 #include "com/centreon/engine/globals.hh"
 #include "com/centreon/engine/logging/logger.hh"
 #include "com/centreon/engine/macros.hh"
+#include "com/centreon/engine/objects/customvariablesmember.hh"
 
 using namespace com::centreon;
 using namespace com::centreon::engine;
 using namespace com::centreon::engine::logging;
 using namespace com::centreon::engine::commands;
 
+// Macros that do not change during the course of monitoring.
+static int const               _env_constant_macros[] = {
+  MACRO_ADMINEMAIL,
+  MACRO_ADMINPAGER,
+  MACRO_MAINCONFIGFILE,
+  MACRO_STATUSDATAFILE,
+  MACRO_RETENTIONDATAFILE,
+  MACRO_OBJECTCACHEFILE,
+  MACRO_TEMPFILE,
+  MACRO_LOGFILE,
+  MACRO_RESOURCEFILE,
+  MACRO_COMMANDFILE,
+  MACRO_HOSTPERFDATAFILE,
+  MACRO_SERVICEPERFDATAFILE,
+  MACRO_PROCESSSTARTTIME,
+  MACRO_TEMPPATH,
+  MACRO_EVENTSTARTTIME
+};
+static unsigned int const      _env_constant_count(
+  sizeof(_env_constant_macros) / sizeof(*_env_constant_macros));
+
+// Cached environment macros.
+static std::vector<std::string>
+                               _env_argv_names;
+static environment             _env_constant;
+static std::vector<std::string>
+                               _env_constant_values;
+static unsigned int            _env_config_generation(0);
+static unsigned int            _env_customvar_generation(0);
+static bool                    _env_is_constant[MACRO_X_COUNT];
+static concurrency::mutex      _env_lock;
+static std::vector<std::string>
+                               _env_macrox_names;
+static umap<void const*, environment>
+                               _env_objects;
+static bool                    _env_valid(false);
+
 /**************************************
 *                                     *
 *           Public Methods            *
@@ -93,6 +135,32 @@ raw& raw::operator=(raw const& right) {
   return (*this);
 }
 
+/**
+ *  Build all macro environemnt variable. Constant macros and object
+ *  custom macros are cached until they change.
+ *
+ *  @param[in,out] macros  The macros data struct.
+ *  @param[out]    env     The environment to fill.
+ */
+void raw::build_environment_macros(
+            nagios_macros& macros,
+            environment& env) {
+  if (config->enable_environment_macros()) {
+    concurrency::locker lock(&_env_lock);
+    _update_environment_cache();
+    env.add(_env_constant);
+    _build_macrosx_environment(macros, env);
+    _build_argv_macro_environment(macros, env);
+    if (macros.host_ptr)
+      env.add(_get_object_environment(*macros.host_ptr));
+    if (macros.service_ptr)
+      env.add(_get_object_environment(*macros.service_ptr));
+    if (macros.contact_ptr)
+      env.add(_get_object_environment(*macros.contact_ptr));
+  }
+  return;
+}
+
 /**
  *  Get a pointer on a copy of the same object.
  *
@@ -115,6 +183,25 @@ unsigned long raw::run(
                      std::string const& processed_cmd,
                      nagios_macros& macros,
                      unsigned int timeout) {
+  // Setup environement macros if is necessary.
+  environment env;
+  build_environment_macros(macros, env);
+  return (run(processed_cmd, env, timeout));
+}
+
+/**
+ *  Run a command with an already built environment.
+ *
+ *  @param[in] args    The command arguments.
+ *  @param[in] env     The command environment.
+ *  @param[in] timeout The command timeout.
+ *
+ *  @return The command id.
+ */
+unsigned long raw::run(
+                     std::string const& processed_cmd,
+                     environment& env,
+                     unsigned int timeout) {
   logger(dbg_commands, basic)
     << "raw::run: cmd='" << processed_cmd << "', timeout=" << timeout;
 
@@ -130,10 +217,6 @@ unsigned long raw::run(
   logger(dbg_commands, basic)
     << "raw::run: id=" << command_id << ", process=" << p;
 
-  // Setup environement macros if is necessary.
-  environment env;
-  _build_environment_macros(macros, env);
-
   try {
     // Start process.
     p->exec(processed_cmd.c_str(), env.data(), timeout);
@@ -176,7 +259,7 @@ void raw::run(
 
   // Setup environement macros if is necessary.
   environment env;
-  _build_environment_macros(macros, env);
+  build_environment_macros(macros, env);
 
   // Start process.
   try {
@@ -346,200 +429,89 @@ void raw::finished(process& p) throw () {
 void raw::_build_argv_macro_environment(
             nagios_macros const& macros,
             environment& env) {
-  for (unsigned int i(0); i < MAX_COMMAND_ARGUMENTS; ++i) {
-    char const* value(macros.argv[i] ? macros.argv[i] : "");
-    std::ostringstream oss;
-    oss << MACRO_ENV_VAR_PREFIX "ARG" << (i + 1) << "=" << value;
-    env.add(oss.str());
-  }
-  return;
-}
-
-/**
- *  Build contact address environment variables.
- *
- *  @param[in]  macros  The macros data struct.
- *  @param[out] env     The environment to fill.
- */
-void raw::_build_contact_address_environment(
-            nagios_macros const& macros,
-            environment& env) {
-  if (!macros.contact_ptr)
-    return;
-  for (unsigned int i(0); i < MAX_CONTACT_ADDRESSES; ++i) {
-    char const* value(macros.contact_ptr->address[i]);
-    if (!value)
-      value = "";
-    std::ostringstream oss;
-    oss << MACRO_ENV_VAR_PREFIX "CONTACTADDRESS" << i << "=" << value;
-    env.add(oss.str());
-  }
+  for (unsigned int i(0); i < MAX_COMMAND_ARGUMENTS; ++i)
+    env.add(
+      _env_argv_names[i].c_str(),
+      macros.argv[i] ? macros.argv[i] : "");
   return;
 }
 
 /**
- *  Build custom contact macro environment variables.
+ *  Build macrox environment variables that do not change during the
+ *  course of monitoring.
  *
- *  @param[in,out] macros  The macros data struct.
- *  @param[out]    env     The environment to fill.
+ *  @param[out] env  The environment to fill.
  */
-void raw::_build_custom_contact_macro_environment(
-            nagios_macros& macros,
-            environment& env) {
-  // Build custom contact variable.
-  contact* hst(macros.contact_ptr);
-  if (hst) {
-    for (customvariablesmember* customvar(hst->custom_variables);
-         customvar;
-         customvar = customvar->next)
-      if (customvar->variable_name) {
-        char const* value(customvar->variable_value);
-        if (!value)
-          value = "";
-        std::string name("_CONTACT");
-        name.append(customvar->variable_name);
-        add_custom_variable_to_object(
-          &macros.custom_contact_vars,
-          name.c_str(),
-          value);
-      }
+void raw::_build_constant_macrosx_environment(environment& env) {
+  nagios_macros const* mac(get_global_macros());
+  for (unsigned int i(0); i < _env_constant_count; ++i) {
+    int index(_env_constant_macros[i]);
+    if (macro_x_names[index])
+      env.add(
+        _env_macrox_names[index].c_str(),
+        mac->x[index] ? mac->x[index] : "");
   }
-  // Set custom contact variable into the environement
-  for (customvariablesmember* customvar(macros.custom_contact_vars);
-       customvar;
-       customvar = customvar->next)
-    if (customvar->variable_name) {
-      char const* value("");
-      if (customvar->variable_value)
-        value = clean_macro_chars(
-                  customvar->variable_value,
-                  STRIP_ILLEGAL_MACRO_CHARS | ESCAPE_MACRO_CHARS);
-      std::string line;
-      line.append(MACRO_ENV_VAR_PREFIX);
-      line.append(customvar->variable_name);
-      line.append("=");
-      line.append(value);
-      env.add(line);
-    }
   return;
 }
 
 /**
- *  Build custom host macro environment variables.
+ *  Build contact address and custom contact macro environment
+ *  variables.
  *
- *  @param[in,out] macros  The macros data struct.
- *  @param[out]    env     The environment to fill.
+ *  @param[in]  cntct  The contact.
+ *  @param[out] env    The environment to fill.
  */
-void raw::_build_custom_host_macro_environment(
-            nagios_macros& macros,
+void raw::_build_contact_environment(
+            contact const& cntct,
             environment& env) {
-  // Build custom host variable.
-  host* hst(macros.host_ptr);
-  if (hst) {
-    for (customvariablesmember* customvar(hst->custom_variables);
-         customvar;
-         customvar = customvar->next)
-      if (customvar->variable_name) {
-        char const* value("");
-        if (customvar->variable_value)
-          value = customvar->variable_value;
-        std::string name("_HOST");
-        name.append(customvar->variable_name);
-        add_custom_variable_to_object(
-          &macros.custom_host_vars,
-          name.c_str(),
-          value);
-      }
+  _build_custom_macro_environment(
+    MACRO_ENV_VAR_PREFIX "_CONTACT",
+    cntct.custom_variables,
+    env);
+  for (unsigned int i(0); i < MAX_CONTACT_ADDRESSES; ++i) {
+    std::ostringstream oss;
+    oss << MACRO_ENV_VAR_PREFIX "CONTACTADDRESS" << i;
+    env.add(
+      oss.str().c_str(),
+      cntct.address[i] ? cntct.address[i] : "");
   }
-  // Set custom host variable into the environement
-  for (customvariablesmember* customvar(macros.custom_host_vars);
-       customvar;
-       customvar = customvar->next)
-    if (customvar->variable_name) {
-      char const* value("");
-      if (customvar->variable_value)
-        value = clean_macro_chars(
-                  customvar->variable_value,
-                  STRIP_ILLEGAL_MACRO_CHARS | ESCAPE_MACRO_CHARS);
-      std::string line;
-      line.append(MACRO_ENV_VAR_PREFIX);
-      line.append(customvar->variable_name);
-      line.append("=");
-      line.append(value);
-      env.add(line);
-    }
   return;
 }
 
 /**
- *  Build custom service macro environment variables.
+ *  Build custom macro environment variables of an object.
  *
- *  @param[in,out] macros  The macros data struct.
- *  @param[out]    env     The environment to fill.
+ *  @param[in]  prefix  Prefix of the variable names.
+ *  @param[in]  vars    Custom variables of the object.
+ *  @param[out] env     The environment to fill.
  */
-void raw::_build_custom_service_macro_environment(
-            nagios_macros& macros,
+void raw::_build_custom_macro_environment(
+            char const* prefix,
+            customvariablesmember const* vars,
             environment& env) {
-  // Build custom service variable.
-  service* hst(macros.service_ptr);
-  if (hst) {
-    for (customvariablesmember* customvar(hst->custom_variables);
-         customvar;
-         customvar = customvar->next)
-      if (customvar->variable_name) {
-        char const* value(customvar->variable_value);
-        if (!value)
-          value = "";
-        std::string name("_SERVICE");
-        name.append(customvar->variable_name);
-        add_custom_variable_to_object(
-          &macros.custom_service_vars,
-          name.c_str(),
-          value);
-      }
-  }
-  // Set custom service variable into the environement
-  for (customvariablesmember* customvar(macros.custom_service_vars);
+  for (customvariablesmember const* customvar(vars);
        customvar;
        customvar = customvar->next)
     if (customvar->variable_name) {
-      char const* value("");
-      if (customvar->variable_value)
-        value = clean_macro_chars(
-                  customvar->variable_value,
-                  STRIP_ILLEGAL_MACRO_CHARS | ESCAPE_MACRO_CHARS);
-      std::string line;
-      line.append(MACRO_ENV_VAR_PREFIX);
-      line.append(customvar->variable_name);
-      line.append("=");
-      line.append(value);
-      env.add(line);
+      std::string name(prefix);
+      name.append(customvar->variable_name);
+      // Values are cleaned in place.
+      char const* value(
+                    customvar->variable_value
+                    ? customvar->variable_value
+                    : "");
+      std::vector<char> cleaned(value, value + strlen(value) + 1);
+      env.add(
+        name.c_str(),
+        clean_macro_chars(
+          &cleaned[0],
+          STRIP_ILLEGAL_MACRO_CHARS | ESCAPE_MACRO_CHARS));
     }
   return;
 }
 
 /**
- *  Build all macro environemnt variable.
- *
- *  @param[in,out] macros  The macros data struct.
- *  @param[out]    env     The environment to fill.
- */
-void raw::_build_environment_macros(
-            nagios_macros& macros,
-            environment& env) {
-  if (config->enable_environment_macros()) {
-    _build_macrosx_environment(macros, env);
-    _build_argv_macro_environment(macros, env);
-    _build_custom_host_macro_environment(macros, env);
-    _build_custom_service_macro_environment(macros, env);
-    _build_custom_contact_macro_environment(macros, env);
-    _build_contact_address_environment(macros, env);
-  }
-  return;
-}
-
-/**
- *  Build macrox environment variables.
+ *  Build macrox environment variables that depend on the object.
  *
  *  @param[in,out] macros  The macros data struct.
  *  @param[out]    env     The environment to fill.
@@ -548,6 +520,9 @@ void raw::_build_macrosx_environment(
             nagios_macros& macros,
             environment& env) {
   for (unsigned int i(0); i < MACRO_X_COUNT; ++i) {
+    if (_env_is_constant[i])
+      continue;
+
     int release_memory(0);
 
     // Need to grab macros?
@@ -567,14 +542,10 @@ void raw::_build_macrosx_environment(
     }
 
     // Add into the environment.
-    if (macro_x_names[i]) {
-      std::string line;
-      line.append(MACRO_ENV_VAR_PREFIX);
-      line.append(macro_x_names[i]);
-      line.append("=");
-      line.append(macros.x[i] ? macros.x[i] : "");
-      env.add(line);
-    }
+    if (macro_x_names[i])
+      env.add(
+        _env_macrox_names[i].c_str(),
+        macros.x[i] ? macros.x[i] : "");
 
     // Release memory if necessary.
     if (release_memory) {
@@ -585,6 +556,129 @@ void raw::_build_macrosx_environment(
   return;
 }
 
+/**
+ *  Get the cached environment of a host, built if necessary.
+ *  _env_lock must be held.
+ *
+ *  @param[in] hst  The host.
+ *
+ *  @return The custom host macro environment variables.
+ */
+environment const& raw::_get_object_environment(host const& hst) {
+  umap<void const*, environment>::iterator it(_env_objects.find(&hst));
+  if (it != _env_objects.end())
+    return (it->second);
+  environment& env(_env_objects[&hst]);
+  _build_custom_macro_environment(
+    MACRO_ENV_VAR_PREFIX "_HOST",
+    hst.custom_variables,
+    env);
+  return (env);
+}
+
+/**
+ *  Get the cached environment of a service, built if necessary.
+ *  _env_lock must be held.
+ *
+ *  @param[in] svc  The service.
+ *
+ *  @return The custom service macro environment variables.
+ */
+environment const& raw::_get_object_environment(service const& svc) {
+  umap<void const*, environment>::iterator it(_env_objects.find(&svc));
+  if (it != _env_objects.end())
+    return (it->second);
+  environment& env(_env_objects[&svc]);
+  _build_custom_macro_environment(
+    MACRO_ENV_VAR_PREFIX "_SERVICE",
+    svc.custom_variables,
+    env);
+  return (env);
+}
+
+/**
+ *  Get the cached environment of a contact, built if necessary.
+ *  _env_lock must be held.
+ *
+ *  @param[in] cntct  The contact.
+ *
+ *  @return The contact address and custom contact macro environment
+ *          variables.
+ */
+environment const& raw::_get_object_environment(contact const& cntct) {
+  umap<void const*, environment>::iterator it(_env_objects.find(&cntct));
+  if (it != _env_objects.end())
+    return (it->second);
+  environment& env(_env_objects[&cntct]);
+  _build_contact_environment(cntct, env);
+  return (env);
+}
+
+/**
+ *  Drop cached environments if the configuration, custom variables or
+ *  constant macros changed. _env_lock must be held.
+ */
+void raw::_update_environment_cache() {
+  unsigned int config_generation(
+    configuration::applier::state::instance().generation());
+  unsigned int customvar_generation(customvariables_generation());
+  if (_env_valid
+      && (_env_config_generation == config_generation)
+      && (_env_customvar_generation == customvar_generation)) {
+    // Constant macros are also set outside of configuration loading.
+    nagios_macros const* mac(get_global_macros());
+    unsigned int i(0);
+    while ((i < _env_constant_count)
+           && (_env_constant_values[i]
+               == (mac->x[_env_constant_macros[i]]
+                   ? mac->x[_env_constant_macros[i]]
+                   : "")))
+      ++i;
+    if (i == _env_constant_count)
+      return;
+  }
+
+  logger(dbg_commands, most)
+    << "raw: rebuild cached environment macros";
+
+  // Variable names.
+  if (_env_argv_names.empty()) {
+    for (unsigned int i(0); i < MAX_COMMAND_ARGUMENTS; ++i) {
+      std::ostringstream oss;
+      oss << MACRO_ENV_VAR_PREFIX "ARG" << (i + 1);
+      _env_argv_names.push_back(oss.str());
+    }
+    for (unsigned int i(0); i < MACRO_X_COUNT; ++i)
+      _env_is_constant[i] = false;
+    for (unsigned int i(0); i < _env_constant_count; ++i)
+      _env_is_constant[_env_constant_macros[i]] = true;
+  }
+  _env_macrox_names.clear();
+  for (unsigned int i(0); i < MACRO_X_COUNT; ++i)
+    _env_macrox_names.push_back(
+      macro_x_names[i]
+      ? std::string(MACRO_ENV_VAR_PREFIX) + macro_x_names[i]
+      : std::string());
+
+  // Constant macros.
+  nagios_macros const* mac(get_global_macros());
+  _env_constant_values.clear();
+  for (unsigned int i(0); i < _env_constant_count; ++i) {
+    int index(_env_constant_macros[i]);
+    _env_constant_values.push_back(mac->x[index] ? mac->x[index] : "");
+  }
+  _env_constant = environment();
+  _build_constant_macrosx_environment(_env_constant);
+
+  // Objects are built again when used.
+  _env_objects.clear();
+
+  _env_config_generation = config_generation;
+  _env_customvar_generation = customvar_generation;
+  _env_valid = true;
+  return;
+}
+
 /**
  *  Get one process to execute command.
  *
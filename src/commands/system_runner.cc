@@ -0,0 +1,403 @@
+/*
+** Copyright 2017 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include "com/centreon/concurrency/locker.hh"
+#include "com/centreon/engine/broker.hh"
+#include "com/centreon/engine/commands/system_runner.hh"
+#include "com/centreon/engine/events/loop.hh"
+#include "com/centreon/engine/globals.hh"
+#include "com/centreon/engine/logging/logger.hh"
+
+using namespace com::centreon;
+using namespace com::centreon::engine;
+using namespace com::centreon::engine::commands;
+using namespace com::centreon::engine::logging;
+
+// Class instance.
+static system_runner* _instance = NULL;
+
+// Category names, used in log messages.
+static char const* const category_name[] = {
+  "notification",
+  "event handler",
+  "obsessive compulsive processor",
+  "performance data"
+};
+
+/**************************************
+*                                     *
+*           Public Methods            *
+*                                     *
+**************************************/
+
+/**
+ *  Constructor.
+ *
+ *  @param[in] message  Warning logged if the command timed out.
+ */
+system_runner::timeout_warning::timeout_warning(
+                                  std::string const& message)
+  : _message(message) {}
+
+/**
+ *  Destructor.
+ */
+system_runner::timeout_warning::~timeout_warning() throw () {}
+
+/**
+ *  Log the warning if the command timed out.
+ *
+ *  @param[in] res  The command result.
+ */
+void system_runner::timeout_warning::finished(
+                                       result const& res) throw () {
+  if (res.exit_status == process::timeout)
+    logger(log_runtime_warning, basic) << _message;
+  return;
+}
+
+/**
+ *  Get instance of the system runner singleton.
+ *
+ *  @return This singleton.
+ */
+system_runner& system_runner::instance() {
+  return (*_instance);
+}
+
+/**
+ *  Load singleton.
+ */
+void system_runner::load() {
+  if (!_instance)
+    _instance = new system_runner;
+  return;
+}
+
+/**
+ *  Start the waiting commands and execute the callbacks of the
+ *  commands that are over. Must be called from the main thread.
+ */
+void system_runner::reap() {
+  _collect();
+  for (unsigned int c(0); c < category_num; ++c) {
+    // Start waiting commands.
+    unsigned int limit(_limit(static_cast<category>(c)));
+    while (!_waiting[c].empty() && (!limit || (_running[c] < limit))) {
+      job* j(_waiting[c].front());
+      _waiting[c].pop_front();
+      _start(j);
+    }
+
+    // Dispatch results in submission order.
+    while (!_jobs[c].empty() && _jobs[c].front()->done) {
+      job* j(_jobs[c].front());
+      _jobs[c].pop_front();
+      _dispatch(j);
+    }
+  }
+  return;
+}
+
+/**
+ *  Run a command. The callback is owned by the runner and is
+ *  executed once the command is over.
+ *
+ *  @param[in] c              The command category.
+ *  @param[in] processed_cmd  The command line to execute.
+ *  @param[in] macros         The macros data struct.
+ *  @param[in] timeout        The command timeout.
+ *  @param[in] cb             The callback to execute.
+ */
+void system_runner::run(
+                      category c,
+                      std::string const& processed_cmd,
+                      nagios_macros& macros,
+                      unsigned int timeout,
+                      callback* cb) {
+  logger(dbg_commands, more)
+    << "Running command '" << processed_cmd << "'...";
+
+  job* j(new job);
+  j->cat = c;
+  j->cb = cb;
+  j->cmd = processed_cmd;
+  j->command_id = 0;
+  j->done = false;
+  j->start_time = timeval();
+  j->timeout = timeout;
+
+  // Synchronous execution.
+  if (!config->enable_async_system_commands()) {
+    gettimeofday(&j->start_time, NULL);
+    _broker_start(*j);
+    try {
+      _raw.run(j->cmd, macros, j->timeout, j->res);
+    }
+    catch (std::exception const& e) {
+      logger(log_runtime_error, basic)
+        << "Error: can't execute " << category_name[c]
+        << " command line '" << j->cmd << "' : " << e.what();
+      j->res.start_time = timestamp::now();
+      j->res.end_time = j->res.start_time;
+    }
+    _dispatch(j);
+    return;
+  }
+
+  // Macros are volatile, environment must be built now.
+  raw::build_environment_macros(macros, j->env);
+  _jobs[c].push_back(j);
+  unsigned int limit(_limit(c));
+  if (_waiting[c].empty() && (!limit || (_running[c] < limit)))
+    _start(j);
+  else {
+    logger(dbg_commands, basic)
+      << "system_runner::run: too many " << category_name[c]
+      << " commands running, command delayed";
+    _waiting[c].push_back(j);
+  }
+  return;
+}
+
+/**
+ *  Unload singleton.
+ */
+void system_runner::unload() {
+  delete _instance;
+  _instance = NULL;
+  return;
+}
+
+/**************************************
+*                                     *
+*           Private Methods           *
+*                                     *
+**************************************/
+
+/**
+ *  Default constructor.
+ */
+system_runner::system_runner()
+  : command_listener(),
+    _raw("system", "", this) {
+  for (unsigned int c(0); c < category_num; ++c)
+    _running[c] = 0;
+}
+
+/**
+ *  Destructor. Callbacks of the commands that are over are executed
+ *  with their result, the others with an error result. Waiting
+ *  commands are not started.
+ */
+system_runner::~system_runner() throw () {
+  try {
+    _collect();
+  }
+  catch (std::exception const& e) {
+    logger(log_runtime_error, basic)
+      << "Error: can't get system command results: " << e.what();
+  }
+  for (unsigned int c(0); c < category_num; ++c) {
+    unsigned int cancelled(0);
+    while (!_jobs[c].empty()) {
+      job* j(_jobs[c].front());
+      _jobs[c].pop_front();
+      if (!j->done) {
+        j->res.command_id = j->command_id;
+        j->res.end_time = timestamp::now();
+        j->res.exit_code = STATE_UNKNOWN;
+        j->res.exit_status = process::normal;
+        j->res.output = "(Command cancelled on shutdown)";
+        j->res.start_time = j->res.end_time;
+        ++cancelled;
+      }
+      try {
+        _dispatch(j);
+      }
+      catch (std::exception const& e) {
+        logger(log_runtime_error, basic)
+          << "Error: can't dispatch " << category_name[c]
+          << " command result: " << e.what();
+      }
+    }
+    if (cancelled)
+      logger(dbg_commands, basic)
+        << "system_runner: " << cancelled << " "
+        << category_name[c] << " commands cancelled";
+  }
+}
+
+/**
+ *  Slot to catch the result of an asynchronous execution. Called
+ *  from the process thread.
+ *
+ *  @param[in] res The result of the execution.
+ */
+void system_runner::finished(result const& res) throw () {
+  logger(dbg_functions, basic)
+    << "system_runner::finished: id=" << res.command_id;
+  try {
+    {
+      concurrency::locker lock(&_lock);
+      _finished[res.command_id] = res;
+    }
+    events::loop::instance().wake_up();
+  }
+  catch (std::exception const& e) {
+    logger(log_runtime_error, basic)
+      << "Error: can't store system command result: " << e.what();
+  }
+  return;
+}
+
+/**
+ *  Send the system command start event to the broker.
+ *
+ *  @param[in] j  The starting job.
+ */
+void system_runner::_broker_start(job const& j) {
+  broker_system_command(
+    NEBTYPE_SYSTEM_COMMAND_START,
+    NEBFLAG_NONE,
+    NEBATTR_NONE,
+    j.start_time,
+    timeval(),
+    0.0,
+    j.timeout,
+    false,
+    STATE_OK,
+    const_cast<char*>(j.cmd.c_str()),
+    NULL,
+    NULL);
+  return;
+}
+
+/**
+ *  Get the results of the finished processes.
+ */
+void system_runner::_collect() {
+  umap<unsigned long, result> finished;
+  {
+    concurrency::locker lock(&_lock);
+    finished.swap(_finished);
+  }
+  for (umap<unsigned long, result>::iterator
+         it(finished.begin()), end(finished.end());
+       it != end;
+       ++it) {
+    umap<unsigned long, job*>::iterator j(_started.find(it->first));
+    if (j == _started.end())
+      continue;
+    j->second->res = it->second;
+    j->second->done = true;
+    --_running[j->second->cat];
+    _started.erase(j);
+  }
+  return;
+}
+
+/**
+ *  Send the system command end event to the broker, execute and
+ *  release the job callback.
+ *
+ *  @param[in] j  The job to dispatch, released by this method.
+ */
+void system_runner::_dispatch(job* j) {
+  timeval end_time;
+  end_time.tv_sec = j->res.end_time.to_seconds();
+  end_time.tv_usec
+    = j->res.end_time.to_useconds() - end_time.tv_sec * 1000000ull;
+  double exectime((j->res.end_time - j->res.start_time).to_seconds());
+  int early_timeout(j->res.exit_status == process::timeout);
+
+  logger(dbg_commands, more)
+    << com::centreon::logging::setprecision(3)
+    << "Execution time=" << exectime
+    << " sec, early timeout=" << early_timeout
+    << ", result=" << j->res.exit_code << ", output="
+    << j->res.output;
+
+  broker_system_command(
+    NEBTYPE_SYSTEM_COMMAND_END,
+    NEBFLAG_NONE,
+    NEBATTR_NONE,
+    j->start_time,
+    end_time,
+    exectime,
+    j->timeout,
+    early_timeout,
+    j->res.exit_code,
+    const_cast<char*>(j->cmd.c_str()),
+    const_cast<char*>(j->res.output.c_str()),
+    NULL);
+
+  if (j->cb) {
+    j->cb->finished(j->res);
+    delete j->cb;
+  }
+  delete j;
+  return;
+}
+
+/**
+ *  Get the maximum number of running commands of a category.
+ *
+ *  @param[in] c  The command category.
+ *
+ *  @return The limit, 0 if unlimited.
+ */
+unsigned int system_runner::_limit(category c) {
+  switch (c) {
+  case notification:
+    return (config->max_concurrent_notifications());
+  case event_handler:
+    return (config->max_concurrent_event_handlers());
+  case obsessive_command:
+    return (config->max_concurrent_obsessive_commands());
+  case perfdata_command:
+    return (config->max_concurrent_perfdata_commands());
+  default:
+    return (0);
+  }
+}
+
+/**
+ *  Start an asynchronous job.
+ *
+ *  @param[in] j  The job to start.
+ */
+void system_runner::_start(job* j) {
+  gettimeofday(&j->start_time, NULL);
+  _broker_start(*j);
+  try {
+    j->command_id = _raw.run(j->cmd, j->env, j->timeout);
+    _started[j->command_id] = j;
+    ++_running[j->cat];
+  }
+  catch (std::exception const& e) {
+    logger(log_runtime_error, basic)
+      << "Error: can't execute " << category_name[j->cat]
+      << " command line '" << j->cmd << "' : " << e.what();
+    j->res.start_time = timestamp::now();
+    j->res.end_time = j->res.start_time;
+    j->done = true;
+  }
+  return;
+}
@@ -156,6 +156,7 @@ void applier::host::add_object(
   if (!h)
     throw (engine_error() << "Could not register host '"
            << obj.host_name() << "'");
+  _add_address(h);
   host_other_props[obj.host_name()].initial_notif_time = 0;
   host_other_props[obj.host_name()].should_reschedule_current_check = false;
   host_other_props[obj.host_name()].timezone = obj.timezone();
@@ -306,7 +307,9 @@ void applier::host::modify_object(
   modify_if_different(
     h->alias,
     (obj.alias().empty() ? obj.host_name() : obj. alias()).c_str());
+  _remove_address(h);
   modify_if_different(h->address, NULL_IF_EMPTY(obj.address()));
+  _add_address(h);
   modify_if_different(
     h->check_period,
     NULL_IF_EMPTY(obj.check_period()));
@@ -579,8 +582,9 @@ void applier::host::remove_object(
     // Remove events related to this host.
     applier::scheduler::instance().remove_host(obj);
 
-    // Remove host from its list.
+    // Remove host from its list and from the address index.
     unregister_object<host_struct>(&host_list, hst);
+    _remove_address(hst);
 
     // Notify event broker.
     timeval tv(get_broker_timestamp(NULL));
@@ -651,3 +655,40 @@ void applier::host::resolve_object(
 
   return ;
 }
+
+/**
+ *  Index a host by its address.
+ *
+ *  @param[in] h  Host, not indexed if it has no address.
+ */
+void applier::host::_add_address(host_struct* h) {
+  if (h->address)
+    applier::state::instance().hosts_by_address().insert(
+      std::make_pair(std::string(h->address), h));
+  return ;
+}
+
+/**
+ *  Remove a host from the address index.
+ *
+ *  @param[in] h  Host, indexed by its current address.
+ */
+void applier::host::_remove_address(host_struct* h) {
+  if (h->address) {
+    umultimap<std::string, host_struct*>&
+      index(applier::state::instance().hosts_by_address());
+    std::pair<
+      umultimap<std::string, host_struct*>::iterator,
+      umultimap<std::string, host_struct*>::iterator>
+      range(index.equal_range(h->address));
+    for (umultimap<std::string, host_struct*>::iterator
+           it(range.first);
+         it != range.second;
+         ++it)
+      if (it->second == h) {
+        index.erase(it);
+        break ;
+      }
+  }
+  return ;
+}
@@ -32,7 +32,6 @@
 #include "com/centreon/engine/logging/logger.hh"
 #include "com/centreon/engine/statusdata.hh"
 #include "com/centreon/engine/timeperiod.hh"
-#include "com/centreon/engine/timezone_locker.hh"
 #include "com/centreon/engine/xpddefault.hh"
 #include "com/centreon/logging/logger.hh"
 
@@ -553,15 +552,17 @@ void applier::scheduler::_calculate_host_scheduling_params() {
     if (!hst.check_interval || !hst.checks_enabled)
       schedule_check = false;
     else {
-      timezone_locker lock(get_host_timezone(hst.name));
-      if (check_time_against_period(
+      char const* tz(get_host_timezone(hst.name));
+      if (check_time_against_period_for_timezone(
             now,
-            hst.check_period_ptr) == ERROR) {
+            hst.check_period_ptr,
+            tz) == ERROR) {
         time_t next_valid_time(0);
-        get_next_valid_time(
+        get_next_valid_time_for_timezone(
           now,
           &next_valid_time,
-          hst.check_period_ptr);
+          hst.check_period_ptr,
+          tz);
         if (now == next_valid_time)
           schedule_check = false;
       }
@@ -710,15 +711,19 @@ void applier::scheduler::_calculate_service_scheduling_params() {
       schedule_check = false;
 
     {
-      timezone_locker
-        lock(get_service_timezone(svc.host_name, svc.description));
-      if (check_time_against_period(now, svc.check_period_ptr)
-          == ERROR) {
+      char const* tz(get_service_timezone(
+                       svc.host_name,
+                       svc.description));
+      if (check_time_against_period_for_timezone(
+            now,
+            svc.check_period_ptr,
+            tz) == ERROR) {
         time_t next_valid_time(0);
-        get_next_valid_time(
+        get_next_valid_time_for_timezone(
           now,
           &next_valid_time,
-          svc.check_period_ptr);
+          svc.check_period_ptr,
+          tz);
         if (now == next_valid_time)
           schedule_check = false;
       }
@@ -919,15 +924,17 @@ void applier::scheduler::_schedule_host_events(
 
     // Make sure the host can actually be scheduled at this time.
     {
-      timezone_locker lock(get_host_timezone(hst.name));
-      if (check_time_against_period(
+      char const* tz(get_host_timezone(hst.name));
+      if (check_time_against_period_for_timezone(
             hst.next_check,
-            hst.check_period_ptr) == ERROR) {
+            hst.check_period_ptr,
+            tz) == ERROR) {
         time_t next_valid_time(0);
-        get_next_valid_time(
+        get_next_valid_time_for_timezone(
           hst.next_check,
           &next_valid_time,
-          hst.check_period_ptr);
+          hst.check_period_ptr,
+          tz);
         hst.next_check = next_valid_time;
       }
     }
@@ -1048,16 +1055,19 @@ void applier::scheduler::_schedule_service_events(
 
       // Make sure the service can actually be scheduled when we want.
       {
-        timezone_locker
-          lock(get_service_timezone(svc.host_name, svc.description));
-        if (check_time_against_period(
+        char const* tz(get_service_timezone(
+                         svc.host_name,
+                         svc.description));
+        if (check_time_against_period_for_timezone(
               svc.next_check,
-              svc.check_period_ptr) == ERROR) {
+              svc.check_period_ptr,
+              tz) == ERROR) {
           time_t next_valid_time(0);
-          get_next_valid_time(
+          get_next_valid_time_for_timezone(
             svc.next_check,
             &next_valid_time,
-            svc.check_period_ptr);
+            svc.check_period_ptr,
+            tz);
           svc.next_check = next_valid_time;
         }
       }
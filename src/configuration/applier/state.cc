@@ -42,12 +42,14 @@
 #include "com/centreon/engine/configuration/applier/timeperiod.hh"
 #include "com/centreon/engine/configuration/command.hh"
 #include "com/centreon/engine/error.hh"
+#include "com/centreon/engine/events/loop.hh"
 #include "com/centreon/engine/globals.hh"
 #include "com/centreon/engine/logging.hh"
 #include "com/centreon/engine/logging/logger.hh"
 #include "com/centreon/engine/objects.hh"
 #include "com/centreon/engine/retention/applier/state.hh"
 #include "com/centreon/engine/retention/state.hh"
+#include "com/centreon/engine/snapshot_writer.hh"
 #include "com/centreon/engine/version.hh"
 #include "com/centreon/engine/xpddefault.hh"
 #include "com/centreon/engine/xsddefault.hh"
@@ -140,6 +142,17 @@ void applier::state::apply(
   return ;
 }
 
+/**
+ *  Get the configuration generation. It changes each time a
+ *  configuration is applied, object pointers kept with a previous
+ *  generation must be resolved again.
+ *
+ *  @return The configuration generation.
+ */
+unsigned int applier::state::generation() const throw () {
+  return (_generation);
+}
+
 /**
  *  Get the singleton instance of state applier.
  *
@@ -173,6 +186,7 @@ void applier::state::unload() {
  */
 applier::state::state()
   : _config(NULL),
+    _generation(0),
     _processing_state(state_ready) {
   applier::logging::load();
   applier::globals::load();
@@ -401,6 +415,37 @@ umap<std::string, shared_ptr<host_struct> >::iterator applier::state::hosts_find
   return (_hosts.find(k));
 }
 
+/**
+ *  Get the current hosts indexed by address.
+ *
+ *  @return The current hosts, several hosts can share an address.
+ */
+umultimap<std::string, host_struct*> const& applier::state::hosts_by_address() const throw () {
+  return (_hosts_by_address);
+}
+
+/**
+ *  Get the current hosts indexed by address.
+ *
+ *  @return The current hosts, several hosts can share an address.
+ */
+umultimap<std::string, host_struct*>& applier::state::hosts_by_address() throw () {
+  return (_hosts_by_address);
+}
+
+/**
+ *  Find a host from its address.
+ *
+ *  @param[in] address  Host address.
+ *
+ *  @return One of the hosts with this address, NULL if there is none.
+ */
+host_struct* applier::state::hosts_find_by_address(std::string const& address) const {
+  umultimap<std::string, host_struct*>::const_iterator
+    it(_hosts_by_address.find(address));
+  return ((it != _hosts_by_address.end()) ? it->second : NULL);
+}
+
 /**
  *  Get the current hostdependencies.
  *
@@ -1008,6 +1053,8 @@ void applier::state::_apply(configuration::state const& new_cfg) {
       || config->host_perfdata_file_processing_command() != new_cfg.host_perfdata_file_processing_command()
       || config->host_perfdata_file_processing_interval() != new_cfg.host_perfdata_file_processing_interval()
       || config->host_perfdata_file_template() != new_cfg.host_perfdata_file_template()
+      || config->perfdata_file_flush_interval() != new_cfg.perfdata_file_flush_interval()
+      || config->perfdata_file_flush_size() != new_cfg.perfdata_file_flush_size()
       || config->service_perfdata_command() != new_cfg.service_perfdata_command()
       || config->service_perfdata_file() != new_cfg.service_perfdata_file()
       || config->service_perfdata_file_mode() != new_cfg.service_perfdata_file_mode()
@@ -1046,6 +1093,7 @@ void applier::state::_apply(configuration::state const& new_cfg) {
   config->check_orphaned_hosts(new_cfg.check_orphaned_hosts());
   config->check_orphaned_services(new_cfg.check_orphaned_services());
   config->check_reaper_interval(new_cfg.check_reaper_interval());
+  config->check_reaper_threads(new_cfg.check_reaper_threads());
   if (config->check_result_path() != new_cfg.check_result_path())
     config->check_result_path(new_cfg.check_result_path());
   config->check_service_freshness(new_cfg.check_service_freshness());
@@ -1055,6 +1103,7 @@ void applier::state::_apply(configuration::state const& new_cfg) {
   config->debug_file(new_cfg.debug_file());
   config->debug_level(new_cfg.debug_level());
   config->debug_verbosity(new_cfg.debug_verbosity());
+  config->enable_async_system_commands(new_cfg.enable_async_system_commands());
   config->enable_environment_macros(new_cfg.enable_environment_macros());
   config->enable_event_handlers(new_cfg.enable_event_handlers());
   config->enable_flap_detection(new_cfg.enable_flap_detection());
@@ -1093,6 +1142,10 @@ void applier::state::_apply(configuration::state const& new_cfg) {
   config->max_check_reaper_time(new_cfg.max_check_reaper_time());
   if (config->max_check_result_file_age() != new_cfg.max_check_result_file_age())
     config->max_check_result_file_age(new_cfg.max_check_result_file_age());
+  config->max_concurrent_event_handlers(new_cfg.max_concurrent_event_handlers());
+  config->max_concurrent_notifications(new_cfg.max_concurrent_notifications());
+  config->max_concurrent_obsessive_commands(new_cfg.max_concurrent_obsessive_commands());
+  config->max_concurrent_perfdata_commands(new_cfg.max_concurrent_perfdata_commands());
   config->max_debug_file_size(new_cfg.max_debug_file_size());
   config->max_host_check_spread(new_cfg.max_host_check_spread());
   config->max_log_file_size(new_cfg.max_log_file_size());
@@ -1106,6 +1159,8 @@ void applier::state::_apply(configuration::state const& new_cfg) {
   config->ocsp_command(new_cfg.ocsp_command());
   config->ocsp_timeout(new_cfg.ocsp_timeout());
   config->passive_host_checks_are_soft(new_cfg.passive_host_checks_are_soft());
+  config->perfdata_file_flush_interval(new_cfg.perfdata_file_flush_interval());
+  config->perfdata_file_flush_size(new_cfg.perfdata_file_flush_size());
   config->perfdata_timeout(new_cfg.perfdata_timeout());
   config->process_performance_data(new_cfg.process_performance_data());
   config->resource_file(new_cfg.resource_file());
@@ -1134,7 +1189,9 @@ void applier::state::_apply(configuration::state const& new_cfg) {
   config->time_change_threshold(new_cfg.time_change_threshold());
   config->translate_passive_host_checks(new_cfg.translate_passive_host_checks());
   config->use_aggressive_host_checking(new_cfg.use_aggressive_host_checking());
+  config->use_binary_state_retention(new_cfg.use_binary_state_retention());
   config->use_check_result_path(new_cfg.use_check_result_path());
+  config->use_incremental_reload(new_cfg.use_incremental_reload());
   config->use_large_installation_tweaks(new_cfg.use_large_installation_tweaks());
   config->use_regexp_matches(new_cfg.use_regexp_matches());
   config->use_retained_program_state(new_cfg.use_retained_program_state());
@@ -1243,11 +1300,13 @@ void applier::state::_apply(configuration::state const& new_cfg) {
  *  @param[in] cur_cfg Current configuration set.
  *  @param[in] new_cfg New configuration set.
  */
-template <typename ConfigurationType, typename ApplierType>
+template <typename ConfigurationType,
+          typename ApplierType,
+          typename ConfigurationSet>
 void applier::state::_apply(
-       difference<std::set<ConfigurationType> > const& diff) {
+       difference<ConfigurationSet> const& diff) {
   // Type alias.
-  typedef std::set<ConfigurationType> cfg_set;
+  typedef ConfigurationSet cfg_set;
 
   /*
   ** Configuration application.
@@ -1534,10 +1593,16 @@ void applier::state::_processing(
     concurrency::locker lock(&_lock);
     _processing_state = state_waiting;
     // Wait to stop engine before apply configuration.
+    events::loop::instance().wake_up();
     _cv_lock.wait(&_lock);
     _processing_state = state_apply;
   }
 
+  // Objects pointers of the previous configuration are not valid
+  // anymore.
+  ++_generation;
+  snapshot_writer::instance().flush();
+
   try {
     // Apply logging configurations.
     applier::logging::instance().apply(new_cfg);
@@ -1755,11 +1820,12 @@ void applier::state::_processing(
  *
  *  @param[in] cfg Configuration objects.
  */
-template <typename ConfigurationType, typename ApplierType>
-void applier::state::_resolve(
-       std::set<ConfigurationType>& cfg) {
+template <typename ConfigurationType,
+          typename ApplierType,
+          typename SetType>
+void applier::state::_resolve(SetType& cfg) {
   ApplierType aplyr;
-  for (typename std::set<ConfigurationType>::const_iterator
+  for (typename SetType::const_iterator
          it(cfg.begin()),
          end(cfg.end());
        it != end;
@@ -28,6 +28,7 @@
 #include "com/centreon/engine/deleter/timerange.hh"
 #include "com/centreon/engine/error.hh"
 #include "com/centreon/engine/globals.hh"
+#include "com/centreon/engine/timeperiod.hh"
 
 using namespace com::centreon::engine::configuration;
 
@@ -170,6 +171,9 @@ void applier::timeperiod::modify_object(
     _add_exclusions(obj.exclude(), tp);
   }
 
+  // Resolved valid intervals are out of date.
+  clear_timeperiod_cache();
+
   // Notify event broker.
   timeval tv(get_broker_timestamp(NULL));
   broker_adaptive_timeperiod_data(
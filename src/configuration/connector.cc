@@ -19,6 +19,7 @@
 
 #include "com/centreon/engine/checks/checker.hh"
 #include "com/centreon/engine/configuration/connector.hh"
+#include "com/centreon/engine/configuration/find_setter.hh"
 #include "com/centreon/engine/error.hh"
 
 using namespace com::centreon;
@@ -156,14 +157,22 @@ void connector::merge(object const& obj) {
  *  @return True on success, otherwise false.
  */
 bool connector::parse(char const* key, char const* value) {
-  for (unsigned int i(0);
-       i < sizeof(_setters) / sizeof(_setters[0]);
-       ++i)
-    if (!strcmp(_setters[i].name, key))
-      return ((_setters[i].func)(*this, value));
+  setters const* s(find_setter(_setters, key));
+  if (s)
+    return ((s->func)(*this, value));
   return (false);
 }
 
+/**
+ *  Check that the setter table is sorted, as properties are looked up
+ *  with a binary search.
+ *
+ *  @return True if the setter table is sorted.
+ */
+bool connector::sorted_setters() throw () {
+  return (setters_are_sorted(_setters));
+}
+
 /**
  *  Get connector_line.
  *
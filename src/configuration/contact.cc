@@ -18,6 +18,7 @@
 */
 
 #include "com/centreon/engine/configuration/contact.hh"
+#include "com/centreon/engine/configuration/find_setter.hh"
 #include "com/centreon/engine/configuration/host.hh"
 #include "com/centreon/engine/configuration/service.hh"
 #include "com/centreon/engine/error.hh"
@@ -32,23 +33,23 @@ using namespace com::centreon::engine::configuration;
 #define ADDRESS_PROPERTY "address"
 
 contact::setters const contact::_setters[] = {
-  { "contact_name",                  SETTER(std::string const&, _set_contact_name) },
   { "alias",                         SETTER(std::string const&, _set_alias) },
+  { "can_submit_commands",           SETTER(bool, _set_can_submit_commands) },
   { "contact_groups",                SETTER(std::string const&, _set_contactgroups) },
+  { "contact_name",                  SETTER(std::string const&, _set_contact_name) },
   { "contactgroups",                 SETTER(std::string const&, _set_contactgroups) },
   { "email",                         SETTER(std::string const&, _set_email) },
-  { "pager",                         SETTER(std::string const&, _set_pager) },
-  { "host_notification_period",      SETTER(std::string const&, _set_host_notification_period) },
   { "host_notification_commands",    SETTER(std::string const&, _set_host_notification_commands) },
-  { "service_notification_period",   SETTER(std::string const&, _set_service_notification_period) },
-  { "service_notification_commands", SETTER(std::string const&, _set_service_notification_commands) },
   { "host_notification_options",     SETTER(std::string const&, _set_host_notification_options) },
-  { "service_notification_options",  SETTER(std::string const&, _set_service_notification_options) },
+  { "host_notification_period",      SETTER(std::string const&, _set_host_notification_period) },
   { "host_notifications_enabled",    SETTER(bool, _set_host_notifications_enabled) },
-  { "service_notifications_enabled", SETTER(bool, _set_service_notifications_enabled) },
-  { "can_submit_commands",           SETTER(bool, _set_can_submit_commands) },
-  { "retain_status_information",     SETTER(bool, _set_retain_status_information) },
+  { "pager",                         SETTER(std::string const&, _set_pager) },
   { "retain_nonstatus_information",  SETTER(bool, _set_retain_nonstatus_information) },
+  { "retain_status_information",     SETTER(bool, _set_retain_status_information) },
+  { "service_notification_commands", SETTER(std::string const&, _set_service_notification_commands) },
+  { "service_notification_options",  SETTER(std::string const&, _set_service_notification_options) },
+  { "service_notification_period",   SETTER(std::string const&, _set_service_notification_period) },
+  { "service_notifications_enabled", SETTER(bool, _set_service_notifications_enabled) },
   { "timezone",                      SETTER(std::string const&, _set_timezone) }
 };
 
@@ -298,11 +299,9 @@ void contact::merge(object const& obj) {
  *  @return True on success, otherwise false.
  */
 bool contact::parse(char const* key, char const* value) {
-  for (unsigned int i(0);
-       i < sizeof(_setters) / sizeof(_setters[0]);
-       ++i)
-    if (!strcmp(_setters[i].name, key))
-      return ((_setters[i].func)(*this, value));
+  setters const* s(find_setter(_setters, key));
+  if (s)
+    return ((s->func)(*this, value));
   if (!strncmp(key, ADDRESS_PROPERTY, sizeof(ADDRESS_PROPERTY) - 1))
     return (_set_address(key + sizeof(ADDRESS_PROPERTY) - 1, value));
   else if (key[0] == '_') {
@@ -312,6 +311,16 @@ bool contact::parse(char const* key, char const* value) {
   return (false);
 }
 
+/**
+ *  Check that the setter table is sorted, as properties are looked up
+ *  with a binary search.
+ *
+ *  @return True if the setter table is sorted.
+ */
+bool contact::sorted_setters() throw () {
+  return (setters_are_sorted(_setters));
+}
+
 /**
  *  Get address.
  *
@@ -18,6 +18,7 @@
 */
 
 #include "com/centreon/engine/configuration/contactgroup.hh"
+#include "com/centreon/engine/configuration/find_setter.hh"
 #include "com/centreon/engine/error.hh"
 
 using namespace com::centreon;
@@ -27,10 +28,10 @@ using namespace com::centreon::engine::configuration;
   &object::setter<contactgroup, type, &contactgroup::method>::generic
 
 contactgroup::setters const contactgroup::_setters[] = {
-  { "contactgroup_name",    SETTER(std::string const&, _set_contactgroup_name) },
   { "alias",                SETTER(std::string const&, _set_alias) },
-  { "members",              SETTER(std::string const&, _set_members) },
-  { "contactgroup_members", SETTER(std::string const&, _set_contactgroup_members) }
+  { "contactgroup_members", SETTER(std::string const&, _set_contactgroup_members) },
+  { "contactgroup_name",    SETTER(std::string const&, _set_contactgroup_name) },
+  { "members",              SETTER(std::string const&, _set_members) }
 };
 
 /**
@@ -165,14 +166,22 @@ void contactgroup::merge(object const& obj) {
  *  @return True on success, otherwise false.
  */
 bool contactgroup::parse(char const* key, char const* value) {
-  for (unsigned int i(0);
-       i < sizeof(_setters) / sizeof(_setters[0]);
-       ++i)
-    if (!strcmp(_setters[i].name, key))
-      return ((_setters[i].func)(*this, value));
+  setters const* s(find_setter(_setters, key));
+  if (s)
+    return ((s->func)(*this, value));
   return (false);
 }
 
+/**
+ *  Check that the setter table is sorted, as properties are looked up
+ *  with a binary search.
+ *
+ *  @return True if the setter table is sorted.
+ */
+bool contactgroup::sorted_setters() throw () {
+  return (setters_are_sorted(_setters));
+}
+
 /**
  *  Get alias.
  *
@@ -17,6 +17,7 @@
 ** <http://www.gnu.org/licenses/>.
 */
 
+#include "com/centreon/engine/configuration/find_setter.hh"
 #include "com/centreon/engine/configuration/host.hh"
 #include "com/centreon/engine/configuration/hostextinfo.hh"
 #include "com/centreon/engine/error.hh"
@@ -35,61 +36,61 @@ using namespace com::centreon::engine::logging;
   &object::setter<host, type, &host::method>::generic
 
 host::setters const host::_setters[] = {
-  { "host_name",                    SETTER(std::string const&, _set_host_name) },
-  { "host_id",                      SETTER(unsigned int, _set_host_id)},
+  { "2d_coords",                    SETTER(std::string const&, _set_coords_2d) },
+  { "3d_coords",                    SETTER(std::string const&, _set_coords_3d) },
   { "_HOST_ID",                     SETTER(unsigned int, _set_host_id)},
-  { "display_name",                 SETTER(std::string const&, _set_display_name) },
-  { "alias",                        SETTER(std::string const&, _set_alias) },
   { "acknowledgement_timeout",      SETTER(int, set_acknowledgement_timeout) },
+  { "action_url",                   SETTER(std::string const&, _set_action_url) },
+  { "active_checks_enabled",        SETTER(bool, _set_checks_active) },
   { "address",                      SETTER(std::string const&, _set_address) },
-  { "parents",                      SETTER(std::string const&, _set_parents) },
-  { "host_groups",                  SETTER(std::string const&, _set_hostgroups) },
-  { "hostgroups",                   SETTER(std::string const&, _set_hostgroups) },
-  { "contact_groups",               SETTER(std::string const&, _set_contactgroups) },
-  { "contacts",                     SETTER(std::string const&, _set_contacts) },
-  { "notification_period",          SETTER(std::string const&, _set_notification_period) },
+  { "alias",                        SETTER(std::string const&, _set_alias) },
   { "check_command",                SETTER(std::string const&, _set_check_command) },
+  { "check_freshness",              SETTER(bool, _set_check_freshness) },
+  { "check_interval",               SETTER(unsigned int, _set_check_interval) },
   { "check_period",                 SETTER(std::string const&, _set_check_period) },
+  { "checks_enabled",               SETTER(bool, _set_checks_active) },
+  { "contact_groups",               SETTER(std::string const&, _set_contactgroups) },
+  { "contacts",                     SETTER(std::string const&, _set_contacts) },
+  { "display_name",                 SETTER(std::string const&, _set_display_name) },
   { "event_handler",                SETTER(std::string const&, _set_event_handler) },
+  { "event_handler_enabled",        SETTER(bool, _set_event_handler_enabled) },
+  { "failure_prediction_enabled",   SETTER(bool, _set_failure_prediction_enabled) },
   { "failure_prediction_options",   SETTER(std::string const&, _set_failure_prediction_options) },
-  { "notes",                        SETTER(std::string const&, _set_notes) },
-  { "notes_url",                    SETTER(std::string const&, _set_notes_url) },
-  { "action_url",                   SETTER(std::string const&, _set_action_url) },
+  { "first_notification_delay",     SETTER(unsigned int, _set_first_notification_delay) },
+  { "flap_detection_enabled",       SETTER(bool, _set_flap_detection_enabled) },
+  { "flap_detection_options",       SETTER(std::string const&, _set_flap_detection_options) },
+  { "freshness_threshold",          SETTER(unsigned int, _set_freshness_threshold) },
+  { "gd2_image",                    SETTER(std::string const&, _set_statusmap_image) },
+  { "high_flap_threshold",          SETTER(unsigned int, _set_high_flap_threshold) },
+  { "host_groups",                  SETTER(std::string const&, _set_hostgroups) },
+  { "host_id",                      SETTER(unsigned int, _set_host_id)},
+  { "host_name",                    SETTER(std::string const&, _set_host_name) },
+  { "hostgroups",                   SETTER(std::string const&, _set_hostgroups) },
   { "icon_image",                   SETTER(std::string const&, _set_icon_image) },
   { "icon_image_alt",               SETTER(std::string const&, _set_icon_image_alt) },
-  { "vrml_image",                   SETTER(std::string const&, _set_vrml_image) },
-  { "gd2_image",                    SETTER(std::string const&, _set_statusmap_image) },
-  { "statusmap_image",              SETTER(std::string const&, _set_statusmap_image) },
   { "initial_state",                SETTER(std::string const&, _set_initial_state) },
-  { "check_interval",               SETTER(unsigned int, _set_check_interval) },
-  { "normal_check_interval",        SETTER(unsigned int, _set_check_interval) },
-  { "retry_interval",               SETTER(unsigned int, _set_retry_interval) },
-  { "retry_check_interval",         SETTER(unsigned int, _set_retry_interval) },
-  { "recovery_notification_delay",  SETTER(unsigned int, _set_recovery_notification_delay) },
-  { "max_check_attempts",           SETTER(unsigned int, _set_max_check_attempts) },
-  { "checks_enabled",               SETTER(bool, _set_checks_active) },
-  { "active_checks_enabled",        SETTER(bool, _set_checks_active) },
-  { "passive_checks_enabled",       SETTER(bool, _set_checks_passive) },
-  { "event_handler_enabled",        SETTER(bool, _set_event_handler_enabled) },
-  { "check_freshness",              SETTER(bool, _set_check_freshness) },
-  { "freshness_threshold",          SETTER(unsigned int, _set_freshness_threshold) },
   { "low_flap_threshold",           SETTER(unsigned int, _set_low_flap_threshold) },
-  { "high_flap_threshold",          SETTER(unsigned int, _set_high_flap_threshold) },
-  { "flap_detection_enabled",       SETTER(bool, _set_flap_detection_enabled) },
-  { "flap_detection_options",       SETTER(std::string const&, _set_flap_detection_options) },
+  { "max_check_attempts",           SETTER(unsigned int, _set_max_check_attempts) },
+  { "normal_check_interval",        SETTER(unsigned int, _set_check_interval) },
+  { "notes",                        SETTER(std::string const&, _set_notes) },
+  { "notes_url",                    SETTER(std::string const&, _set_notes_url) },
+  { "notification_interval",        SETTER(unsigned int, _set_notification_interval) },
   { "notification_options",         SETTER(std::string const&, _set_notification_options) },
+  { "notification_period",          SETTER(std::string const&, _set_notification_period) },
   { "notifications_enabled",        SETTER(bool, _set_notifications_enabled) },
-  { "notification_interval",        SETTER(unsigned int, _set_notification_interval) },
-  { "first_notification_delay",     SETTER(unsigned int, _set_first_notification_delay) },
-  { "stalking_options",             SETTER(std::string const&, _set_stalking_options) },
-  { "process_perf_data",            SETTER(bool, _set_process_perf_data) },
-  { "failure_prediction_enabled",   SETTER(bool, _set_failure_prediction_enabled) },
-  { "2d_coords",                    SETTER(std::string const&, _set_coords_2d) },
-  { "3d_coords",                    SETTER(std::string const&, _set_coords_3d) },
   { "obsess_over_host",             SETTER(bool, _set_obsess_over_host) },
-  { "retain_status_information",    SETTER(bool, _set_retain_status_information) },
+  { "parents",                      SETTER(std::string const&, _set_parents) },
+  { "passive_checks_enabled",       SETTER(bool, _set_checks_passive) },
+  { "process_perf_data",            SETTER(bool, _set_process_perf_data) },
+  { "recovery_notification_delay",  SETTER(unsigned int, _set_recovery_notification_delay) },
   { "retain_nonstatus_information", SETTER(bool, _set_retain_nonstatus_information) },
-  { "timezone",                     SETTER(std::string const&, _set_timezone) }
+  { "retain_status_information",    SETTER(bool, _set_retain_status_information) },
+  { "retry_check_interval",         SETTER(unsigned int, _set_retry_interval) },
+  { "retry_interval",               SETTER(unsigned int, _set_retry_interval) },
+  { "stalking_options",             SETTER(std::string const&, _set_stalking_options) },
+  { "statusmap_image",              SETTER(std::string const&, _set_statusmap_image) },
+  { "timezone",                     SETTER(std::string const&, _set_timezone) },
+  { "vrml_image",                   SETTER(std::string const&, _set_vrml_image) }
 };
 
 // Default values.
@@ -522,11 +523,9 @@ void host::merge(object const& obj) {
  *  @return True on success, otherwise false.
  */
 bool host::parse(char const* key, char const* value) {
-  for (unsigned int i(0);
-       i < sizeof(_setters) / sizeof(_setters[0]);
-       ++i)
-    if (!strcmp(_setters[i].name, key))
-      return ((_setters[i].func)(*this, value));
+  setters const* s(find_setter(_setters, key));
+  if (s)
+    return ((s->func)(*this, value));
   if (key[0] == '_') {
     _customvariables[key + 1] = value;
     return (true);
@@ -534,6 +533,16 @@ bool host::parse(char const* key, char const* value) {
   return (false);
 }
 
+/**
+ *  Check that the setter table is sorted, as properties are looked up
+ *  with a binary search.
+ *
+ *  @return True if the setter table is sorted.
+ */
+bool host::sorted_setters() throw () {
+  return (setters_are_sorted(_setters));
+}
+
 /**
  *  Get action_url.
  *
@@ -1252,7 +1261,7 @@ bool host::_set_failure_prediction_enabled(bool value) {
   (void)value;
   logger(log_config_warning, basic)
     << "Warning: host failure_prediction_enabled was ignored";
-  ++config_warnings;
+  __sync_add_and_fetch(&config_warnings, 1);
   return (true);
 }
 
@@ -1268,7 +1277,7 @@ bool host::_set_failure_prediction_options(
   (void)value;
   logger(log_config_warning, basic)
     << "Warning: service failure_prediction_options was ignored";
-  ++config_warnings;
+  __sync_add_and_fetch(&config_warnings, 1);
   return (true);
 }
 
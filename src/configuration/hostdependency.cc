@@ -17,6 +17,7 @@
 ** <http://www.gnu.org/licenses/>.
 */
 
+#include "com/centreon/engine/configuration/find_setter.hh"
 #include "com/centreon/engine/configuration/hostdependency.hh"
 #include "com/centreon/engine/error.hh"
 #include "com/centreon/engine/logging/logger.hh"
@@ -33,24 +34,24 @@ using namespace com::centreon::engine::logging;
   &object::setter<hostdependency, type, &hostdependency::method>::generic
 
 hostdependency::setters const hostdependency::_setters[] = {
-  { "hostgroup",                     SETTER(std::string const&, _set_hostgroups) },
-  { "hostgroups",                    SETTER(std::string const&, _set_hostgroups) },
-  { "hostgroup_name",                SETTER(std::string const&, _set_hostgroups) },
+  { "dependency_period",             SETTER(std::string const&, _set_dependency_period) },
+  { "dependent_host",                SETTER(std::string const&, _set_dependent_hosts) },
+  { "dependent_host_name",           SETTER(std::string const&, _set_dependent_hosts) },
+  { "dependent_hostgroup",           SETTER(std::string const&, _set_dependent_hostgroups) },
+  { "dependent_hostgroup_name",      SETTER(std::string const&, _set_dependent_hostgroups) },
+  { "dependent_hostgroups",          SETTER(std::string const&, _set_dependent_hostgroups) },
+  { "execution_failure_criteria",    SETTER(std::string const&, _set_execution_failure_options) },
+  { "execution_failure_options",     SETTER(std::string const&, _set_execution_failure_options) },
   { "host",                          SETTER(std::string const&, _set_hosts) },
   { "host_name",                     SETTER(std::string const&, _set_hosts) },
+  { "hostgroup",                     SETTER(std::string const&, _set_hostgroups) },
+  { "hostgroup_name",                SETTER(std::string const&, _set_hostgroups) },
+  { "hostgroups",                    SETTER(std::string const&, _set_hostgroups) },
+  { "inherits_parent",               SETTER(bool, _set_inherits_parent) },
   { "master_host",                   SETTER(std::string const&, _set_hosts) },
   { "master_host_name",              SETTER(std::string const&, _set_hosts) },
-  { "dependent_hostgroup",           SETTER(std::string const&, _set_dependent_hostgroups) },
-  { "dependent_hostgroups",          SETTER(std::string const&, _set_dependent_hostgroups) },
-  { "dependent_hostgroup_name",      SETTER(std::string const&, _set_dependent_hostgroups) },
-  { "dependent_host",                SETTER(std::string const&, _set_dependent_hosts) },
-  { "dependent_host_name",           SETTER(std::string const&, _set_dependent_hosts) },
-  { "dependency_period",             SETTER(std::string const&, _set_dependency_period) },
-  { "inherits_parent",               SETTER(bool, _set_inherits_parent) },
-  { "notification_failure_options",  SETTER(std::string const&, _set_notification_failure_options) },
   { "notification_failure_criteria", SETTER(std::string const&, _set_notification_failure_options) },
-  { "execution_failure_options",     SETTER(std::string const&, _set_execution_failure_options) },
-  { "execution_failure_criteria",    SETTER(std::string const&, _set_execution_failure_options) }
+  { "notification_failure_options",  SETTER(std::string const&, _set_notification_failure_options) }
 };
 
 // Default values.
@@ -239,14 +240,22 @@ void hostdependency::merge(object const& obj) {
  *  @return True on success, otherwise false.
  */
 bool hostdependency::parse(char const* key, char const* value) {
-  for (unsigned int i(0);
-       i < sizeof(_setters) / sizeof(_setters[0]);
-       ++i)
-    if (!strcmp(_setters[i].name, key))
-      return ((_setters[i].func)(*this, value));
+  setters const* s(find_setter(_setters, key));
+  if (s)
+    return ((s->func)(*this, value));
   return (false);
 }
 
+/**
+ *  Check that the setter table is sorted, as properties are looked up
+ *  with a binary search.
+ *
+ *  @return True if the setter table is sorted.
+ */
+bool hostdependency::sorted_setters() throw () {
+  return (setters_are_sorted(_setters));
+}
+
 /**
  *  Set the dependency period.
  *
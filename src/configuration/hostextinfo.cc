@@ -17,6 +17,7 @@
 ** <http://www.gnu.org/licenses/>.
 */
 
+#include "com/centreon/engine/configuration/find_setter.hh"
 #include "com/centreon/engine/configuration/hostextinfo.hh"
 #include "com/centreon/engine/error.hh"
 #include "com/centreon/engine/string.hh"
@@ -28,19 +29,19 @@ using namespace com::centreon::engine::configuration;
   &object::setter<hostextinfo, type, &hostextinfo::method>::generic
 
 hostextinfo::setters const hostextinfo::_setters[] = {
+  { "2d_coords",       SETTER(std::string const&, _set_coords_2d) },
+  { "3d_coords",       SETTER(std::string const&, _set_coords_3d) },
+  { "action_url",      SETTER(std::string const&, _set_action_url) },
+  { "gd2_image",       SETTER(std::string const&, _set_statusmap_image) },
   { "host_name",       SETTER(std::string const&, _set_hosts) },
   { "hostgroup",       SETTER(std::string const&, _set_hostgroups) },
   { "hostgroup_name",  SETTER(std::string const&, _set_hostgroups) },
-  { "notes",           SETTER(std::string const&, _set_notes) },
-  { "notes_url",       SETTER(std::string const&, _set_notes_url) },
-  { "action_url",      SETTER(std::string const&, _set_action_url) },
   { "icon_image",      SETTER(std::string const&, _set_icon_image) },
   { "icon_image_alt",  SETTER(std::string const&, _set_icon_image_alt) },
-  { "vrml_image",      SETTER(std::string const&, _set_vrml_image) },
-  { "gd2_image",       SETTER(std::string const&, _set_statusmap_image) },
+  { "notes",           SETTER(std::string const&, _set_notes) },
+  { "notes_url",       SETTER(std::string const&, _set_notes_url) },
   { "statusmap_image", SETTER(std::string const&, _set_statusmap_image) },
-  { "2d_coords",       SETTER(std::string const&, _set_coords_2d) },
-  { "3d_coords",       SETTER(std::string const&, _set_coords_3d) }
+  { "vrml_image",      SETTER(std::string const&, _set_vrml_image) }
 };
 
 // Default values.
@@ -175,14 +176,22 @@ void hostextinfo::merge(object const& obj) {
  *  @return True on success, otherwise false.
  */
 bool hostextinfo::parse(char const* key, char const* value) {
-  for (unsigned int i(0);
-       i < sizeof(_setters) / sizeof(_setters[0]);
-       ++i)
-    if (!strcmp(_setters[i].name, key))
-      return ((_setters[i].func)(*this, value));
+  setters const* s(find_setter(_setters, key));
+  if (s)
+    return ((s->func)(*this, value));
   return (false);
 }
 
+/**
+ *  Check that the setter table is sorted, as properties are looked up
+ *  with a binary search.
+ *
+ *  @return True if the setter table is sorted.
+ */
+bool hostextinfo::sorted_setters() throw () {
+  return (setters_are_sorted(_setters));
+}
+
 /**
  *  Get action_url.
  *
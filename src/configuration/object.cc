@@ -21,6 +21,7 @@
 #include "com/centreon/engine/configuration/connector.hh"
 #include "com/centreon/engine/configuration/contactgroup.hh"
 #include "com/centreon/engine/configuration/contact.hh"
+#include "com/centreon/engine/configuration/find_setter.hh"
 #include "com/centreon/engine/configuration/hostdependency.hh"
 #include "com/centreon/engine/configuration/hostescalation.hh"
 #include "com/centreon/engine/configuration/hostextinfo.hh"
@@ -43,9 +44,9 @@ using namespace com::centreon::engine::configuration;
   &object::setter<object, type, &object::method>::generic
 
 object::setters const object::_setters[] = {
-  { "use",      SETTER(std::string const&, _set_templates) },
   { "name",     SETTER(std::string const&, _set_name) },
-  { "register", SETTER(bool, _set_should_register) }
+  { "register", SETTER(bool, _set_should_register) },
+  { "use",      SETTER(std::string const&, _set_templates) }
 };
 
 /**
@@ -114,6 +115,80 @@ bool object::operator!=(object const& right) const throw () {
   return (!operator==(right));
 }
 
+/**
+ *  Copy an object of any type.
+ *
+ *  @param[in] obj The object to copy.
+ *
+ *  @return New object.
+ */
+object_ptr object::clone(object const& obj) {
+  object_ptr copy;
+  switch (obj.type()) {
+  case command:
+    copy = object_ptr(new configuration::command(
+             static_cast<configuration::command const&>(obj)));
+    break ;
+  case connector:
+    copy = object_ptr(new configuration::connector(
+             static_cast<configuration::connector const&>(obj)));
+    break ;
+  case contact:
+    copy = object_ptr(new configuration::contact(
+             static_cast<configuration::contact const&>(obj)));
+    break ;
+  case contactgroup:
+    copy = object_ptr(new configuration::contactgroup(
+             static_cast<configuration::contactgroup const&>(obj)));
+    break ;
+  case host:
+    copy = object_ptr(new configuration::host(
+             static_cast<configuration::host const&>(obj)));
+    break ;
+  case hostdependency:
+    copy = object_ptr(new configuration::hostdependency(
+             static_cast<configuration::hostdependency const&>(obj)));
+    break ;
+  case hostescalation:
+    copy = object_ptr(new configuration::hostescalation(
+             static_cast<configuration::hostescalation const&>(obj)));
+    break ;
+  case hostextinfo:
+    copy = object_ptr(new configuration::hostextinfo(
+             static_cast<configuration::hostextinfo const&>(obj)));
+    break ;
+  case hostgroup:
+    copy = object_ptr(new configuration::hostgroup(
+             static_cast<configuration::hostgroup const&>(obj)));
+    break ;
+  case service:
+    copy = object_ptr(new configuration::service(
+             static_cast<configuration::service const&>(obj)));
+    break ;
+  case servicedependency:
+    copy = object_ptr(new configuration::servicedependency(
+             static_cast<configuration::servicedependency const&>(obj)));
+    break ;
+  case serviceescalation:
+    copy = object_ptr(new configuration::serviceescalation(
+             static_cast<configuration::serviceescalation const&>(obj)));
+    break ;
+  case serviceextinfo:
+    copy = object_ptr(new configuration::serviceextinfo(
+             static_cast<configuration::serviceextinfo const&>(obj)));
+    break ;
+  case servicegroup:
+    copy = object_ptr(new configuration::servicegroup(
+             static_cast<configuration::servicegroup const&>(obj)));
+    break ;
+  case timeperiod:
+    copy = object_ptr(new configuration::timeperiod(
+             static_cast<configuration::timeperiod const&>(obj)));
+    break ;
+  }
+  return (copy);
+}
+
 /**
  *  Create object with object type.
  *
@@ -174,14 +249,22 @@ std::string const& object::name() const throw () {
  *  @return True on success, otherwise false.
  */
 bool object::parse(char const* key, char const* value) {
-  for (unsigned int i(0);
-       i < sizeof(_setters) / sizeof(_setters[0]);
-       ++i)
-    if (!strcmp(_setters[i].name, key))
-      return ((_setters[i].func)(*this, value));
+  setters const* s(find_setter(_setters, key));
+  if (s)
+    return ((s->func)(*this, value));
   return (false);
 }
 
+/**
+ *  Check that the setter table is sorted, as properties are looked up
+ *  with a binary search.
+ *
+ *  @return True if the setter table is sorted.
+ */
+bool object::sorted_setters() throw () {
+  return (setters_are_sorted(_setters));
+}
+
 /**
  *  Parse and set the object property.
  *
@@ -0,0 +1,155 @@
+/*
+** Copyright 2017 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <set>
+#include <sys/stat.h>
+#include "com/centreon/engine/configuration/object_file_cache.hh"
+
+using namespace com::centreon::engine::configuration;
+
+/**
+ *  Default constructor.
+ */
+object_file_cache::object_file_cache() {}
+
+/**
+ *  Destructor.
+ */
+object_file_cache::~object_file_cache() throw () {}
+
+/**
+ *  Remove all files from the cache.
+ */
+void object_file_cache::clear() {
+  _files.clear();
+  return ;
+}
+
+/**
+ *  Get the objects of a file if it did not change.
+ *
+ *  @param[in]  path          The file path.
+ *  @param[in]  status        The current file status.
+ *  @param[in]  read_options  Object types read by the parser.
+ *  @param[out] objs          Copies of the file objects.
+ *
+ *  @return True if the file objects were found, false if the file
+ *          is not in the cache or changed since it was read.
+ */
+bool object_file_cache::find(
+       std::string const& path,
+       file_status const& status,
+       unsigned int read_options,
+       objects& objs) const {
+  umap<std::string, entry>::const_iterator it(_files.find(path));
+  if ((it == _files.end())
+      || (it->second.read_options != read_options)
+      || (it->second.status.ctime != status.ctime)
+      || (it->second.status.dev != status.dev)
+      || (it->second.status.ino != status.ino)
+      || (it->second.status.mtime != status.mtime)
+      || (it->second.status.size != status.size))
+    return (false);
+  _copy(it->second.objs, objs);
+  return (true);
+}
+
+/**
+ *  Store the objects of a file.
+ *
+ *  @param[in] path          The file path.
+ *  @param[in] status        The file status before it was read.
+ *  @param[in] read_options  Object types read by the parser.
+ *  @param[in] objs          The file objects, with their line.
+ */
+void object_file_cache::insert(
+       std::string const& path,
+       file_status const& status,
+       unsigned int read_options,
+       objects const& objs) {
+  entry& e(_files[path]);
+  e.objs.clear();
+  _copy(objs, e.objs);
+  e.read_options = read_options;
+  e.status = status;
+  return ;
+}
+
+/**
+ *  Remove the files which are not in a list.
+ *
+ *  @param[in] paths  The files to keep.
+ */
+void object_file_cache::retain(std::list<std::string> const& paths) {
+  std::set<std::string> keep(paths.begin(), paths.end());
+  for (umap<std::string, entry>::iterator it(_files.begin());
+       it != _files.end();) {
+    if (keep.find(it->first) == keep.end())
+      _files.erase(it++);
+    else
+      ++it;
+  }
+  return ;
+}
+
+/**
+ *  Get the number of files in the cache.
+ *
+ *  @return The number of files.
+ */
+std::size_t object_file_cache::size() const throw () {
+  return (_files.size());
+}
+
+/**
+ *  Get the status of a file.
+ *
+ *  @param[in]  path    The file path.
+ *  @param[out] status  The file status.
+ *
+ *  @return True on success, false if the file cannot be stat'ed.
+ */
+bool object_file_cache::status(
+       std::string const& path,
+       file_status& status) {
+  struct stat st;
+  if (::stat(path.c_str(), &st))
+    return (false);
+  status.ctime = st.st_ctime;
+  status.dev = st.st_dev;
+  status.ino = st.st_ino;
+  status.mtime = st.st_mtime;
+  status.size = st.st_size;
+  return (true);
+}
+
+/**
+ *  Copy objects.
+ *
+ *  @param[in]  from  The objects to copy.
+ *  @param[out] to    The list to append copies to.
+ */
+void object_file_cache::_copy(objects const& from, objects& to) {
+  to.reserve(to.size() + from.size());
+  for (objects::const_iterator it(from.begin()), end(from.end());
+       it != end;
+       ++it)
+    to.push_back(std::make_pair(object::clone(*it->first), it->second));
+  return ;
+}
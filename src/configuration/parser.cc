@@ -17,15 +17,145 @@
 ** <http://www.gnu.org/licenses/>.
 */
 
+#include <ctime>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+#include "com/centreon/concurrency/thread.hh"
 #include "com/centreon/engine/configuration/parser.hh"
 #include "com/centreon/engine/error.hh"
 #include "com/centreon/engine/string.hh"
 #include "com/centreon/io/directory_entry.hh"
 
 using namespace com::centreon;
+using namespace com::centreon::engine;
 using namespace com::centreon::engine::configuration;
 using namespace com::centreon::io;
 
+/**
+ *  Objects of a configuration file.
+ */
+struct                   object_file {
+                         object_file() : has_status(false) {}
+
+  std::string            error;
+  bool                   has_status;
+  object_file_cache::objects
+                         objects;
+  std::string            path;
+  object_file_cache::file_status
+                         status;
+};
+
+/**
+ *  Parse an object definition file.
+ *
+ *  @param[in,out] file          The file path, filled with its
+ *                               objects or the parsing error.
+ *  @param[in]     read_options  Object types to read.
+ */
+static void parse_object_file(
+              object_file& file,
+              unsigned int read_options) {
+  try {
+    std::ifstream stream(file.path.c_str(), std::ios::binary);
+    if (!stream.is_open())
+      throw (engine_error() << "Parsing of object definition failed: "
+             << "Can't open file '" << file.path << "'");
+
+    unsigned int current_line(0);
+    unsigned int object_line(0);
+    bool parse_object(false);
+    object_ptr obj;
+    std::string input;
+    while (string::get_next_line(stream, input, current_line)) {
+      // Multi-line.
+      while ('\\' == input[input.size() - 1]) {
+        input.resize(input.size() - 1);
+        std::string addendum;
+        if (!string::get_next_line(stream, addendum, current_line))
+          break ;
+        input.append(addendum);
+      }
+
+      // Check if is a valid object.
+      if (obj.is_null()) {
+        if (input.find("define") || !std::isspace(input[6]))
+          throw (engine_error() << "Parsing of object definition failed "
+                 << "in file '" << file.path << "' on line "
+                 << current_line << ": Unexpected start definition");
+        string::trim_left(input.erase(0, 6));
+        std::size_t last(input.size() - 1);
+        if (input.empty() || input[last] != '{')
+          throw (engine_error() << "Parsing of object definition failed "
+                 << "in file '" << file.path << "' on line "
+                 << current_line << ": Unexpected start definition");
+        std::string const& type(string::trim_right(input.erase(last)));
+        obj = object::create(type);
+        if (obj.is_null())
+          throw (engine_error() << "Parsing of object definition failed "
+                 << "in file '" << file.path << "' on line "
+                 << current_line << ": Unknown object type name '"
+                 << type << "'");
+        parse_object = (read_options & (1 << obj->type()));
+        object_line = current_line;
+      }
+      // Check if is the not the end of the current object.
+      else if (input != "}") {
+        if (parse_object) {
+          if (!obj->parse(input))
+            throw (engine_error() << "Parsing of object definition "
+                   << "failed in file '" << file.path << "' on line "
+                   << current_line << ": Invalid line '"
+                   << input << "'");
+        }
+      }
+      // End of the current object.
+      else {
+        if (parse_object)
+          file.objects.push_back(std::make_pair(obj, object_line));
+        obj.clear();
+      }
+    }
+  }
+  catch (std::exception const& e) {
+    file.error = e.what();
+  }
+  return ;
+}
+
+/**
+ *  Parse every step-th configuration file, starting from the
+ *  first-th one.
+ */
+class                      object_file_parser
+  : public concurrency::thread {
+public:
+                           object_file_parser(
+                             std::vector<object_file*>& files,
+                             std::size_t first,
+                             std::size_t step,
+                             unsigned int read_options)
+    : _files(files),
+      _first(first),
+      _read_options(read_options),
+      _step(step) {}
+                           ~object_file_parser() throw () {}
+
+private:
+  void                     _run() {
+    for (std::size_t i(_first); i < _files.size(); i += _step)
+      parse_object_file(*_files[i], _read_options);
+    return;
+  }
+
+  std::vector<object_file*>&
+                           _files;
+  std::size_t              _first;
+  unsigned int             _read_options;
+  std::size_t              _step;
+};
+
 parser::store parser::_store[] = {
   &parser::_store_into_map<command, &command::command_name>,
   &parser::_store_into_map<connector, &connector::connector_name>,
@@ -49,9 +179,15 @@ parser::store parser::_store[] = {
  *
  *  @param[in] read_options Configuration file reading options
  *             (use to skip some object type).
+ *  @param[in] cache        Objects of previously parsed object
+ *                          definition files, used and updated when
+ *                          incremental reload is enabled.
  */
-parser::parser(unsigned int read_options)
-  : _config(NULL),
+parser::parser(
+          unsigned int read_options,
+          object_file_cache* cache)
+  : _cache(cache),
+    _config(NULL),
     _read_options(read_options) {}
 
 /**
@@ -77,6 +213,8 @@ void parser::parse(std::string const& path, state& config) {
   _apply(config.resource_file(), &parser::_parse_resource_file);
   // parse configuration directories.
   _apply(config.cfg_dir(), &parser::_parse_directory_configuration);
+  // parse object definitions of configuration files and directories.
+  _parse_object_files();
 
   // Apply template.
   _resolve_template();
@@ -329,11 +467,11 @@ void parser::_get_objects_by_list_name(
 template<typename T>
 void parser::_insert(
        list_object const& from,
-       std::set<T>& to) {
+       T& to) {
   for (list_object::const_iterator it(from.begin()), end(from.end());
        it != end;
        ++it)
-    to.insert(*static_cast<T const*>(it->get()));
+    to.insert(*static_cast<typename T::value_type const*>(it->get()));
   return ;
 }
 
@@ -346,11 +484,11 @@ void parser::_insert(
 template<typename T>
 void parser::_insert(
        map_object const& from,
-       std::set<T>& to) {
+       T& to) {
   for (map_object::const_iterator it(from.begin()), end(from.end());
        it != end;
        ++it)
-    to.insert(*static_cast<T*>(it->second.get()));
+    to.insert(*static_cast<typename T::value_type*>(it->second.get()));
   return ;
 }
 
@@ -417,78 +555,137 @@ void parser::_parse_global_configuration(std::string const& path) {
 }
 
 /**
- *  Parse the object definition file.
+ *  Queue an object definition file, parsed later by
+ *  _parse_object_files().
  *
  *  @param[in] path The object definitions path.
  */
 void parser::_parse_object_definitions(std::string const& path) {
   logger(logging::log_info_message, logging::basic)
     << "Processing object config file '" << path << "'";
+  _object_files.push_back(path);
+}
 
-  std::ifstream stream(path.c_str(), std::ios::binary);
-  if (!stream.is_open())
-    throw (engine_error() << "Parsing of object definition failed: "
-           << "Can't open file '" << path << "'");
-
-  _current_line = 0;
-  _current_path = path;
-
-  bool parse_object(false);
-  object_ptr obj;
-  std::string input;
-  while (string::get_next_line(stream, input, _current_line)) {
-    // Multi-line.
-    while ('\\' == input[input.size() - 1]) {
-      input.resize(input.size() - 1);
-      std::string addendum;
-      if (!string::get_next_line(stream, addendum, _current_line))
-        break ;
-      input.append(addendum);
+/**
+ *  Parse queued object definition files.
+ *
+ *  Files are parsed concurrently, then their objects are added in
+ *  the order in which files were queued, as if they were parsed one
+ *  after the other.
+ */
+void parser::_parse_object_files() {
+  std::vector<object_file> files(_object_files.size());
+  std::size_t i(0);
+  for (std::list<std::string>::const_iterator
+         it(_object_files.begin()), end(_object_files.end());
+       it != end;
+       ++it, ++i)
+    files[i].path = *it;
+
+  // Files which did not change since the last parsing are not
+  // parsed again.
+  object_file_cache* cache(NULL);
+  if (_cache) {
+    if (_config->use_incremental_reload())
+      cache = _cache;
+    else
+      _cache->clear();
+  }
+  time_t start(time(NULL));
+  std::vector<object_file*> pending;
+  for (std::vector<object_file>::iterator
+         it(files.begin()), end(files.end());
+       it != end;
+       ++it) {
+    if (cache) {
+      it->has_status = object_file_cache::status(it->path, it->status);
+      if (it->has_status
+          && cache->find(it->path, it->status, _read_options, it->objects))
+        continue ;
     }
-
-    // Check if is a valid object.
-    if (obj.is_null()) {
-      if (input.find("define") || !std::isspace(input[6]))
-        throw (engine_error() << "Parsing of object definition failed "
-               << "in file '" << _current_path << "' on line "
-               << _current_line << ": Unexpected start definition");
-      string::trim_left(input.erase(0, 6));
-      std::size_t last(input.size() - 1);
-      if (input.empty() || input[last] != '{')
-        throw (engine_error() << "Parsing of object definition failed "
-               << "in file '" << _current_path << "' on line "
-               << _current_line << ": Unexpected start definition");
-      std::string const& type(string::trim_right(input.erase(last)));
-      obj = object::create(type);
-      if (obj.is_null())
-        throw (engine_error() << "Parsing of object definition failed "
-               << "in file '" << _current_path << "' on line "
-               << _current_line << ": Unknown object type name '"
-               << type << "'");
-      parse_object = (_read_options & (1 << obj->type()));
-      _objects_info[obj.get()] = file_info(path, _current_line);
+    pending.push_back(&*it);
+  }
+  if (cache)
+    logger(logging::log_info_message, logging::most)
+      << "Reusing objects of " << files.size() - pending.size()
+      << " unchanged object config file(s)";
+
+  long cpus(sysconf(_SC_NPROCESSORS_ONLN));
+  std::size_t threads(pending.size());
+  if ((cpus > 0) && (threads > static_cast<std::size_t>(cpus)))
+    threads = cpus;
+
+  if (threads <= 1) {
+    for (std::size_t i(0); i < pending.size(); ++i)
+      parse_object_file(*pending[i], _read_options);
+  }
+  else {
+    std::vector<object_file_parser*> parsers;
+    std::size_t running(0);
+    try {
+      for (std::size_t i(0); i < threads; ++i)
+        parsers.push_back(new object_file_parser(
+                                pending,
+                                i,
+                                threads,
+                                _read_options));
+      for (; running < threads; ++running)
+        parsers[running]->exec();
     }
-    // Check if is the not the end of the current object.
-    else if (input != "}") {
-      if (parse_object) {
-        if (!obj->parse(input))
-          throw (engine_error() << "Parsing of object definition "
-                 << "failed in file '" << _current_path << "' on line "
-                 << _current_line << ": Invalid line '"
-                 << input << "'");
+    catch (...) {
+      for (std::size_t i(0); i < parsers.size(); ++i) {
+        if (i < running)
+          parsers[i]->wait();
+        delete parsers[i];
       }
+      throw;
     }
-    // End of the current object.
-    else {
-      if (parse_object) {
-        if (!obj->name().empty())
-          _add_template(obj);
-        if (obj->should_register())
-          _add_object(obj);
-      }
-      obj.clear();
+    for (std::size_t i(0); i < threads; ++i) {
+      parsers[i]->wait();
+      delete parsers[i];
+    }
+  }
+
+  // Store objects before they get modified by template resolution.
+  // Files modified during the current second may change again
+  // without their status changing, they will be parsed next time.
+  if (cache) {
+    for (std::vector<object_file*>::const_iterator
+           it(pending.begin()), end(pending.end());
+         it != end;
+         ++it)
+      if ((*it)->has_status
+          && (*it)->error.empty()
+          && ((*it)->status.mtime < start)
+          && ((*it)->status.ctime < start))
+        cache->insert(
+                 (*it)->path,
+                 (*it)->status,
+                 _read_options,
+                 (*it)->objects);
+    cache->retain(_object_files);
+  }
+  _object_files.clear();
+
+  for (std::vector<object_file>::const_iterator
+         it(files.begin()), end(files.end());
+       it != end;
+       ++it) {
+    for (object_file_cache::objects::const_iterator
+           obj(it->objects.begin()), obj_end(it->objects.end());
+         obj != obj_end;
+         ++obj) {
+      _objects_info[obj->first.get()] = file_info(it->path, obj->second);
+      if (!obj->first->name().empty())
+        _add_template(obj->first);
+      if (obj->first->should_register())
+        _add_object(obj->first);
     }
+    // Error message already holds its location.
+    if (!it->error.empty())
+      throw (engine::error() << it->error);
   }
+  return ;
 }
 
 /**
@@ -23,6 +23,7 @@
 #include "com/centreon/engine/configuration/reload.hh"
 #include "com/centreon/engine/configuration/state.hh"
 #include "com/centreon/engine/error.hh"
+#include "com/centreon/engine/events/loop.hh"
 #include "com/centreon/engine/globals.hh"
 #include "com/centreon/engine/logging/logger.hh"
 
@@ -82,7 +83,7 @@ void reload::_run() {
   try {
     configuration::state config;
     {
-      configuration::parser p;
+      configuration::parser p(configuration::parser::read_all, &_cache);
       std::string path(::config->cfg_main());
       p.parse(path, config);
     }
@@ -93,6 +94,7 @@ void reload::_run() {
       << "Error: " << e.what();
   }
   _set_is_finished(true);
+  events::loop::instance().wake_up();
 }
 
 /**
@@ -17,6 +17,7 @@
 ** <http://www.gnu.org/licenses/>.
 */
 
+#include "com/centreon/engine/configuration/find_setter.hh"
 #include "com/centreon/engine/configuration/service.hh"
 #include "com/centreon/engine/configuration/serviceextinfo.hh"
 #include "com/centreon/engine/error.hh"
@@ -35,60 +36,60 @@ using namespace com::centreon::engine::logging;
   &object::setter<service, type, &service::method>::generic
 
 service::setters const service::_setters[] = {
-  { "host",                         SETTER(std::string const&, _set_hosts) },
-  { "hosts",                        SETTER(std::string const&, _set_hosts) },
-  { "host_name",                    SETTER(std::string const&, _set_hosts) },
-  { "service_description",          SETTER(std::string const&, _set_service_description) },
-  { "service_id",                   SETTER(unsigned int, _set_service_id) },
   { "_SERVICE_ID",                  SETTER(unsigned int, _set_service_id) },
   { "acknowledgement_timeout",      SETTER(int, set_acknowledgement_timeout) },
-  { "description",                  SETTER(std::string const&, _set_service_description) },
-  { "display_name",                 SETTER(std::string const&, _set_display_name) },
-  { "hostgroup",                    SETTER(std::string const&, _set_hostgroups) },
-  { "hostgroups",                   SETTER(std::string const&, _set_hostgroups) },
-  { "hostgroup_name",               SETTER(std::string const&, _set_hostgroups) },
-  { "service_groups",               SETTER(std::string const&, _set_servicegroups) },
-  { "servicegroups",                SETTER(std::string const&, _set_servicegroups) },
+  { "action_url",                   SETTER(std::string const&, _set_action_url) },
+  { "active_checks_enabled",        SETTER(bool, _set_checks_active) },
   { "check_command",                SETTER(std::string const&, _set_check_command) },
+  { "check_freshness",              SETTER(bool, _set_check_freshness) },
+  { "check_interval",               SETTER(unsigned int, _set_check_interval) },
   { "check_period",                 SETTER(std::string const&, _set_check_period) },
-  { "event_handler",                SETTER(std::string const&, _set_event_handler) },
-  { "notification_period",          SETTER(std::string const&, _set_notification_period) },
   { "contact_groups",               SETTER(std::string const&, _set_contactgroups) },
   { "contacts",                     SETTER(std::string const&, _set_contacts) },
+  { "description",                  SETTER(std::string const&, _set_service_description) },
+  { "display_name",                 SETTER(std::string const&, _set_display_name) },
+  { "event_handler",                SETTER(std::string const&, _set_event_handler) },
+  { "event_handler_enabled",        SETTER(bool, _set_event_handler_enabled) },
+  { "failure_prediction_enabled",   SETTER(bool, _set_failure_prediction_enabled) },
   { "failure_prediction_options",   SETTER(std::string const&, _set_failure_prediction_options) },
-  { "notes",                        SETTER(std::string const&, _set_notes) },
-  { "notes_url",                    SETTER(std::string const&, _set_notes_url) },
-  { "action_url",                   SETTER(std::string const&, _set_action_url) },
+  { "first_notification_delay",     SETTER(unsigned int, _set_first_notification_delay) },
+  { "flap_detection_enabled",       SETTER(bool, _set_flap_detection_enabled) },
+  { "flap_detection_options",       SETTER(std::string const&, _set_flap_detection_options) },
+  { "freshness_threshold",          SETTER(unsigned int, _set_freshness_threshold) },
+  { "high_flap_threshold",          SETTER(unsigned int, _set_high_flap_threshold) },
+  { "host",                         SETTER(std::string const&, _set_hosts) },
+  { "host_name",                    SETTER(std::string const&, _set_hosts) },
+  { "hostgroup",                    SETTER(std::string const&, _set_hostgroups) },
+  { "hostgroup_name",               SETTER(std::string const&, _set_hostgroups) },
+  { "hostgroups",                   SETTER(std::string const&, _set_hostgroups) },
+  { "hosts",                        SETTER(std::string const&, _set_hosts) },
   { "icon_image",                   SETTER(std::string const&, _set_icon_image) },
   { "icon_image_alt",               SETTER(std::string const&, _set_icon_image_alt) },
   { "initial_state",                SETTER(std::string const&, _set_initial_state) },
-  { "max_check_attempts",           SETTER(unsigned int, _set_max_check_attempts) },
-  { "check_interval",               SETTER(unsigned int, _set_check_interval) },
-  { "normal_check_interval",        SETTER(unsigned int, _set_check_interval) },
-  { "retry_interval",               SETTER(unsigned int, _set_retry_interval) },
-  { "retry_check_interval",         SETTER(unsigned int, _set_retry_interval) },
-  { "recovery_notification_delay",  SETTER(unsigned int, _set_recovery_notification_delay) },
-  { "active_checks_enabled",        SETTER(bool, _set_checks_active) },
-  { "passive_checks_enabled",       SETTER(bool, _set_checks_passive) },
-  { "parallelize_check",            SETTER(bool, _set_parallelize_check) },
   { "is_volatile",                  SETTER(bool, _set_is_volatile) },
-  { "obsess_over_service",          SETTER(bool, _set_obsess_over_service) },
-  { "event_handler_enabled",        SETTER(bool, _set_event_handler_enabled) },
-  { "check_freshness",              SETTER(bool, _set_check_freshness) },
-  { "freshness_threshold",          SETTER(unsigned int, _set_freshness_threshold) },
   { "low_flap_threshold",           SETTER(unsigned int, _set_low_flap_threshold) },
-  { "high_flap_threshold",          SETTER(unsigned int, _set_high_flap_threshold) },
-  { "flap_detection_enabled",       SETTER(bool, _set_flap_detection_enabled) },
-  { "flap_detection_options",       SETTER(std::string const&, _set_flap_detection_options) },
+  { "max_check_attempts",           SETTER(unsigned int, _set_max_check_attempts) },
+  { "normal_check_interval",        SETTER(unsigned int, _set_check_interval) },
+  { "notes",                        SETTER(std::string const&, _set_notes) },
+  { "notes_url",                    SETTER(std::string const&, _set_notes_url) },
+  { "notification_interval",        SETTER(unsigned int, _set_notification_interval) },
   { "notification_options",         SETTER(std::string const&, _set_notification_options) },
+  { "notification_period",          SETTER(std::string const&, _set_notification_period) },
   { "notifications_enabled",        SETTER(bool, _set_notifications_enabled) },
-  { "notification_interval",        SETTER(unsigned int, _set_notification_interval) },
-  { "first_notification_delay",     SETTER(unsigned int, _set_first_notification_delay) },
-  { "stalking_options",             SETTER(std::string const&, _set_stalking_options) },
+  { "obsess_over_service",          SETTER(bool, _set_obsess_over_service) },
+  { "parallelize_check",            SETTER(bool, _set_parallelize_check) },
+  { "passive_checks_enabled",       SETTER(bool, _set_checks_passive) },
   { "process_perf_data",            SETTER(bool, _set_process_perf_data) },
-  { "failure_prediction_enabled",   SETTER(bool, _set_failure_prediction_enabled) },
-  { "retain_status_information",    SETTER(bool, _set_retain_status_information) },
+  { "recovery_notification_delay",  SETTER(unsigned int, _set_recovery_notification_delay) },
   { "retain_nonstatus_information", SETTER(bool, _set_retain_nonstatus_information) },
+  { "retain_status_information",    SETTER(bool, _set_retain_status_information) },
+  { "retry_check_interval",         SETTER(unsigned int, _set_retry_interval) },
+  { "retry_interval",               SETTER(unsigned int, _set_retry_interval) },
+  { "service_description",          SETTER(std::string const&, _set_service_description) },
+  { "service_groups",               SETTER(std::string const&, _set_servicegroups) },
+  { "service_id",                   SETTER(unsigned int, _set_service_id) },
+  { "servicegroups",                SETTER(std::string const&, _set_servicegroups) },
+  { "stalking_options",             SETTER(std::string const&, _set_stalking_options) },
   { "timezone",                     SETTER(std::string const&, _set_timezone) }
 };
 
@@ -527,11 +528,9 @@ void service::merge(object const& obj) {
  *  @return True on success, otherwise false.
  */
 bool service::parse(char const* key, char const* value) {
-  for (unsigned int i(0);
-       i < sizeof(_setters) / sizeof(_setters[0]);
-       ++i)
-    if (!strcmp(_setters[i].name, key))
-      return ((_setters[i].func)(*this, value));
+  setters const* s(find_setter(_setters, key));
+  if (s)
+    return ((s->func)(*this, value));
   if (key[0] == '_') {
     _customvariables[key + 1] = value;
     return (true);
@@ -539,6 +538,16 @@ bool service::parse(char const* key, char const* value) {
   return (false);
 }
 
+/**
+ *  Check that the setter table is sorted, as properties are looked up
+ *  with a binary search.
+ *
+ *  @return True if the setter table is sorted.
+ */
+bool service::sorted_setters() throw () {
+  return (setters_are_sorted(_setters));
+}
+
 /**
  *  Get action_url.
  *
@@ -1268,7 +1277,7 @@ bool service::_set_failure_prediction_enabled(bool value) {
   (void)value;
   logger(log_config_warning, basic)
     << "Warning: service failure_prediction_enabled was ignored";
-  ++config_warnings;
+  __sync_add_and_fetch(&config_warnings, 1);
   return (true);
 }
 
@@ -1283,7 +1292,7 @@ bool service::_set_failure_prediction_options(std::string const& value) {
   (void)value;
   logger(log_config_warning, basic)
     << "Warning: service failure_prediction_options was ignored";
-  ++config_warnings;
+  __sync_add_and_fetch(&config_warnings, 1);
   return (true);
 }
 
@@ -1601,7 +1610,7 @@ bool service::_set_parallelize_check(bool value) {
   (void)value;
   logger(log_config_warning, basic)
     << "Warning: service parallelize_check was ignored";
-  ++config_warnings;
+  __sync_add_and_fetch(&config_warnings, 1);
   return (true);
 }
 
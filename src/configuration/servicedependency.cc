@@ -17,6 +17,7 @@
 ** <http://www.gnu.org/licenses/>.
 */
 
+#include "com/centreon/engine/configuration/find_setter.hh"
 #include "com/centreon/engine/configuration/servicedependency.hh"
 #include "com/centreon/engine/error.hh"
 #include "com/centreon/engine/logging/logger.hh"
@@ -33,36 +34,36 @@ using namespace com::centreon::engine::logging;
   &object::setter<servicedependency, type, &servicedependency::method>::generic
 
 servicedependency::setters const servicedependency::_setters[] = {
-  { "servicegroup",                  SETTER(std::string const&, _set_servicegroups) },
-  { "servicegroups",                 SETTER(std::string const&, _set_servicegroups) },
-  { "servicegroup_name",             SETTER(std::string const&, _set_servicegroups) },
-  { "hostgroup",                     SETTER(std::string const&, _set_hostgroups) },
-  { "hostgroups",                    SETTER(std::string const&, _set_hostgroups) },
-  { "hostgroup_name",                SETTER(std::string const&, _set_hostgroups) },
+  { "dependency_period",             SETTER(std::string const&, _set_dependency_period) },
+  { "dependent_description",         SETTER(std::string const&, _set_dependent_service_description) },
+  { "dependent_host",                SETTER(std::string const&, _set_dependent_hosts) },
+  { "dependent_host_name",           SETTER(std::string const&, _set_dependent_hosts) },
+  { "dependent_hostgroup",           SETTER(std::string const&, _set_dependent_hostgroups) },
+  { "dependent_hostgroup_name",      SETTER(std::string const&, _set_dependent_hostgroups) },
+  { "dependent_hostgroups",          SETTER(std::string const&, _set_dependent_hostgroups) },
+  { "dependent_service_description", SETTER(std::string const&, _set_dependent_service_description) },
+  { "dependent_servicegroup",        SETTER(std::string const&, _set_dependent_servicegroups) },
+  { "dependent_servicegroup_name",   SETTER(std::string const&, _set_dependent_servicegroups) },
+  { "dependent_servicegroups",       SETTER(std::string const&, _set_dependent_servicegroups) },
+  { "description",                   SETTER(std::string const&, _set_service_description) },
+  { "execution_failure_criteria",    SETTER(std::string const&, _set_execution_failure_options) },
+  { "execution_failure_options",     SETTER(std::string const&, _set_execution_failure_options) },
   { "host",                          SETTER(std::string const&, _set_hosts) },
   { "host_name",                     SETTER(std::string const&, _set_hosts) },
+  { "hostgroup",                     SETTER(std::string const&, _set_hostgroups) },
+  { "hostgroup_name",                SETTER(std::string const&, _set_hostgroups) },
+  { "hostgroups",                    SETTER(std::string const&, _set_hostgroups) },
+  { "inherits_parent",               SETTER(bool, _set_inherits_parent) },
+  { "master_description",            SETTER(std::string const&, _set_service_description) },
   { "master_host",                   SETTER(std::string const&, _set_hosts) },
   { "master_host_name",              SETTER(std::string const&, _set_hosts) },
-  { "description",                   SETTER(std::string const&, _set_service_description) },
-  { "service_description",           SETTER(std::string const&, _set_service_description) },
-  { "master_description",            SETTER(std::string const&, _set_service_description) },
   { "master_service_description",    SETTER(std::string const&, _set_service_description) },
-  { "dependent_servicegroup",        SETTER(std::string const&, _set_dependent_servicegroups) },
-  { "dependent_servicegroups",       SETTER(std::string const&, _set_dependent_servicegroups) },
-  { "dependent_servicegroup_name",   SETTER(std::string const&, _set_dependent_servicegroups) },
-  { "dependent_hostgroup",           SETTER(std::string const&, _set_dependent_hostgroups) },
-  { "dependent_hostgroups",          SETTER(std::string const&, _set_dependent_hostgroups) },
-  { "dependent_hostgroup_name",      SETTER(std::string const&, _set_dependent_hostgroups) },
-  { "dependent_host",                SETTER(std::string const&, _set_dependent_hosts) },
-  { "dependent_host_name",           SETTER(std::string const&, _set_dependent_hosts) },
-  { "dependent_description",         SETTER(std::string const&, _set_dependent_service_description) },
-  { "dependent_service_description", SETTER(std::string const&, _set_dependent_service_description) },
-  { "dependency_period",             SETTER(std::string const&, _set_dependency_period) },
-  { "inherits_parent",               SETTER(bool, _set_inherits_parent) },
-  { "execution_failure_options",     SETTER(std::string const&, _set_execution_failure_options) },
-  { "execution_failure_criteria",    SETTER(std::string const&, _set_execution_failure_options) },
+  { "notification_failure_criteria", SETTER(std::string const&, _set_notification_failure_options) },
   { "notification_failure_options",  SETTER(std::string const&, _set_notification_failure_options) },
-  { "notification_failure_criteria", SETTER(std::string const&, _set_notification_failure_options) }
+  { "service_description",           SETTER(std::string const&, _set_service_description) },
+  { "servicegroup",                  SETTER(std::string const&, _set_servicegroups) },
+  { "servicegroup_name",             SETTER(std::string const&, _set_servicegroups) },
+  { "servicegroups",                 SETTER(std::string const&, _set_servicegroups) }
 };
 
 // Default values.
@@ -305,14 +306,22 @@ void servicedependency::merge(object const& obj) {
  *  @return True on success, otherwise false.
  */
 bool servicedependency::parse(char const* key, char const* value) {
-  for (unsigned int i(0);
-       i < sizeof(_setters) / sizeof(_setters[0]);
-       ++i)
-    if (!strcmp(_setters[i].name, key))
-      return ((_setters[i].func)(*this, value));
+  setters const* s(find_setter(_setters, key));
+  if (s)
+    return ((s->func)(*this, value));
   return (false);
 }
 
+/**
+ *  Check that the setter table is sorted, as properties are looked up
+ *  with a binary search.
+ *
+ *  @return True if the setter table is sorted.
+ */
+bool servicedependency::sorted_setters() throw () {
+  return (setters_are_sorted(_setters));
+}
+
 /**
  *  Set the dependency period.
  *
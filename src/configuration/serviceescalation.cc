@@ -17,6 +17,7 @@
 ** <http://www.gnu.org/licenses/>.
 */
 
+#include "com/centreon/engine/configuration/find_setter.hh"
 #include "com/centreon/engine/configuration/serviceescalation.hh"
 #include "com/centreon/engine/error.hh"
 #include "com/centreon/engine/string.hh"
@@ -28,23 +29,23 @@ using namespace com::centreon::engine::configuration;
   &object::setter<serviceescalation, type, &serviceescalation::method>::generic
 
 serviceescalation::setters const serviceescalation::_setters[] = {
-  { "host",                  SETTER(std::string const&, _set_hosts) },
-  { "host_name",             SETTER(std::string const&, _set_hosts) },
-  { "description",           SETTER(std::string const&, _set_service_description) },
-  { "service_description",   SETTER(std::string const&, _set_service_description) },
-  { "servicegroup",          SETTER(std::string const&, _set_servicegroups) },
-  { "servicegroups",         SETTER(std::string const&, _set_servicegroups) },
-  { "servicegroup_name",     SETTER(std::string const&, _set_servicegroups) },
-  { "hostgroup",             SETTER(std::string const&, _set_hostgroups) },
-  { "hostgroups",            SETTER(std::string const&, _set_hostgroups) },
-  { "hostgroup_name",        SETTER(std::string const&, _set_hostgroups) },
   { "contact_groups",        SETTER(std::string const&, _set_contactgroups) },
   { "contacts",              SETTER(std::string const&, _set_contacts) },
+  { "description",           SETTER(std::string const&, _set_service_description) },
   { "escalation_options",    SETTER(std::string const&, _set_escalation_options) },
   { "escalation_period",     SETTER(std::string const&, _set_escalation_period) },
   { "first_notification",    SETTER(unsigned int, _set_first_notification) },
+  { "host",                  SETTER(std::string const&, _set_hosts) },
+  { "host_name",             SETTER(std::string const&, _set_hosts) },
+  { "hostgroup",             SETTER(std::string const&, _set_hostgroups) },
+  { "hostgroup_name",        SETTER(std::string const&, _set_hostgroups) },
+  { "hostgroups",            SETTER(std::string const&, _set_hostgroups) },
   { "last_notification",     SETTER(unsigned int, _set_last_notification) },
-  { "notification_interval", SETTER(unsigned int, _set_notification_interval) }
+  { "notification_interval", SETTER(unsigned int, _set_notification_interval) },
+  { "service_description",   SETTER(std::string const&, _set_service_description) },
+  { "servicegroup",          SETTER(std::string const&, _set_servicegroups) },
+  { "servicegroup_name",     SETTER(std::string const&, _set_servicegroups) },
+  { "servicegroups",         SETTER(std::string const&, _set_servicegroups) }
 };
 
 // Default values.
@@ -229,14 +230,22 @@ void serviceescalation::merge(object const& obj) {
  *  @return True on success, otherwise false.
  */
 bool serviceescalation::parse(char const* key, char const* value) {
-  for (unsigned int i(0);
-       i < sizeof(_setters) / sizeof(_setters[0]);
-       ++i)
-    if (!strcmp(_setters[i].name, key))
-      return ((_setters[i].func)(*this, value));
+  setters const* s(find_setter(_setters, key));
+  if (s)
+    return ((s->func)(*this, value));
   return (false);
 }
 
+/**
+ *  Check that the setter table is sorted, as properties are looked up
+ *  with a binary search.
+ *
+ *  @return True if the setter table is sorted.
+ */
+bool serviceescalation::sorted_setters() throw () {
+  return (setters_are_sorted(_setters));
+}
+
 /**
  *  Get contact groups.
  *
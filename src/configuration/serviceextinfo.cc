@@ -17,6 +17,7 @@
 ** <http://www.gnu.org/licenses/>.
 */
 
+#include "com/centreon/engine/configuration/find_setter.hh"
 #include "com/centreon/engine/configuration/serviceextinfo.hh"
 #include "com/centreon/engine/error.hh"
 
@@ -27,15 +28,15 @@ using namespace com::centreon::engine::configuration;
   &object::setter<serviceextinfo, type, &serviceextinfo::method>::generic
 
 serviceextinfo::setters const serviceextinfo::_setters[] = {
+  { "action_url",          SETTER(std::string const&, _set_action_url) },
   { "host_name",           SETTER(std::string const&, _set_hosts) },
   { "hostgroup",           SETTER(std::string const&, _set_hostgroups) },
   { "hostgroup_name",      SETTER(std::string const&, _set_hostgroups) },
-  { "service_description", SETTER(std::string const&, _set_service_description) },
+  { "icon_image",          SETTER(std::string const&, _set_icon_image) },
+  { "icon_image_alt",      SETTER(std::string const&, _set_icon_image_alt) },
   { "notes",               SETTER(std::string const&, _set_notes) },
   { "notes_url",           SETTER(std::string const&, _set_notes_url) },
-  { "action_url",          SETTER(std::string const&, _set_action_url) },
-  { "icon_image",          SETTER(std::string const&, _set_icon_image) },
-  { "icon_image_alt",      SETTER(std::string const&, _set_icon_image_alt) }
+  { "service_description", SETTER(std::string const&, _set_service_description) }
 };
 
 /**
@@ -158,14 +159,22 @@ void serviceextinfo::merge(object const& obj) {
  *  @return True on success, otherwise false.
  */
 bool serviceextinfo::parse(char const* key, char const* value) {
-  for (unsigned int i(0);
-       i < sizeof(_setters) / sizeof(_setters[0]);
-       ++i)
-    if (!strcmp(_setters[i].name, key))
-      return ((_setters[i].func)(*this, value));
+  setters const* s(find_setter(_setters, key));
+  if (s)
+    return ((s->func)(*this, value));
   return (false);
 }
 
+/**
+ *  Check that the setter table is sorted, as properties are looked up
+ *  with a binary search.
+ *
+ *  @return True if the setter table is sorted.
+ */
+bool serviceextinfo::sorted_setters() throw () {
+  return (setters_are_sorted(_setters));
+}
+
 /**
  *  Get action_url.
  *
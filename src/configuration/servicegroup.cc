@@ -17,6 +17,7 @@
 ** <http://www.gnu.org/licenses/>.
 */
 
+#include "com/centreon/engine/configuration/find_setter.hh"
 #include "com/centreon/engine/configuration/servicegroup.hh"
 #include "com/centreon/engine/error.hh"
 
@@ -27,14 +28,14 @@ using namespace com::centreon::engine::configuration;
   &object::setter<servicegroup, type, &servicegroup::method>::generic
 
 servicegroup::setters const servicegroup::_setters[] = {
-  { "servicegroup_id",      SETTER(unsigned int, _set_servicegroup_id) },
-  { "servicegroup_name",    SETTER(std::string const&, _set_servicegroup_name) },
+  { "action_url",           SETTER(std::string const&, _set_action_url) },
   { "alias",                SETTER(std::string const&, _set_alias) },
   { "members",              SETTER(std::string const&, _set_members) },
-  { "servicegroup_members", SETTER(std::string const&, _set_servicegroup_members) },
   { "notes",                SETTER(std::string const&, _set_notes) },
   { "notes_url",            SETTER(std::string const&, _set_notes_url) },
-  { "action_url",           SETTER(std::string const&, _set_action_url) }
+  { "servicegroup_id",      SETTER(unsigned int, _set_servicegroup_id) },
+  { "servicegroup_members", SETTER(std::string const&, _set_servicegroup_members) },
+  { "servicegroup_name",    SETTER(std::string const&, _set_servicegroup_name) }
 };
 
 
@@ -190,14 +191,22 @@ void servicegroup::merge(object const& obj) {
  *  @return True on success, otherwise false.
  */
 bool servicegroup::parse(char const* key, char const* value) {
-  for (unsigned int i(0);
-       i < sizeof(_setters) / sizeof(_setters[0]);
-       ++i)
-    if (!strcmp(_setters[i].name, key))
-      return ((_setters[i].func)(*this, value));
+  setters const* s(find_setter(_setters, key));
+  if (s)
+    return ((s->func)(*this, value));
   return (false);
 }
 
+/**
+ *  Check that the setter table is sorted, as properties are looked up
+ *  with a binary search.
+ *
+ *  @return True if the setter table is sorted.
+ */
+bool servicegroup::sorted_setters() throw () {
+  return (setters_are_sorted(_setters));
+}
+
 /**
  *  Get action_url.
  *
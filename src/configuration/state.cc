@@ -20,6 +20,7 @@
 #include <limits>
 #include "compatibility/locations.h"
 #include "com/centreon/engine/broker.hh"
+#include "com/centreon/engine/configuration/find_setter.hh"
 #include "com/centreon/engine/configuration/state.hh"
 #include "com/centreon/engine/error.hh"
 #include "com/centreon/engine/globals.hh"
@@ -47,8 +48,8 @@ state::setters const state::_setters[] = {
   { "auto_rescheduling_interval",                  SETTER(unsigned int, auto_rescheduling_interval) },
   { "auto_rescheduling_window",                    SETTER(unsigned int, auto_rescheduling_window) },
   { "bare_update_check",                           SETTER(std::string const&, _set_bare_update_check) },
-  { "broker_module_directory",                     SETTER(std::string const&, broker_module_directory) },
   { "broker_module",                               SETTER(std::string const&, _set_broker_module) },
+  { "broker_module_directory",                     SETTER(std::string const&, broker_module_directory) },
   { "cached_host_check_horizon",                   SETTER(unsigned long, cached_host_check_horizon) },
   { "cached_service_check_horizon",                SETTER(unsigned long, cached_service_check_horizon) },
   { "cfg_dir",                                     SETTER(std::string const&, _set_cfg_dir) },
@@ -60,6 +61,7 @@ state::setters const state::_setters[] = {
   { "check_host_freshness",                        SETTER(bool, check_host_freshness) },
   { "check_result_path",                           SETTER(std::string const&, _set_check_result_path) },
   { "check_result_reaper_frequency",               SETTER(unsigned int, check_reaper_interval) },
+  { "check_result_reaper_threads",                 SETTER(unsigned int, check_reaper_threads) },
   { "check_service_freshness",                     SETTER(bool, check_service_freshness) },
   { "child_processes_fork_twice",                  SETTER(std::string const&, _set_child_processes_fork_twice) },
   { "command_check_interval",                      SETTER(std::string const&, _set_command_check_interval) },
@@ -71,6 +73,7 @@ state::setters const state::_setters[] = {
   { "debug_level",                                 SETTER(unsigned long long, debug_level) },
   { "debug_verbosity",                             SETTER(unsigned int, debug_verbosity) },
   { "downtime_file",                               SETTER(std::string const&, _set_downtime_file) },
+  { "enable_async_system_commands",                SETTER(bool, enable_async_system_commands) },
   { "enable_embedded_perl",                        SETTER(std::string const&, _set_enable_embedded_perl) },
   { "enable_environment_macros",                   SETTER(bool, enable_environment_macros) },
   { "enable_event_handlers",                       SETTER(bool, enable_event_handlers) },
@@ -118,6 +121,10 @@ state::setters const state::_setters[] = {
   { "max_check_result_file_age",                   SETTER(unsigned long, max_check_result_file_age) },
   { "max_check_result_reaper_time",                SETTER(unsigned int, max_check_reaper_time) },
   { "max_concurrent_checks",                       SETTER(unsigned int, max_parallel_service_checks) },
+  { "max_concurrent_event_handlers",               SETTER(unsigned int, max_concurrent_event_handlers) },
+  { "max_concurrent_notifications",                SETTER(unsigned int, max_concurrent_notifications) },
+  { "max_concurrent_obsessive_commands",           SETTER(unsigned int, max_concurrent_obsessive_commands) },
+  { "max_concurrent_perfdata_commands",            SETTER(unsigned int, max_concurrent_perfdata_commands) },
   { "max_debug_file_size",                         SETTER(unsigned long, max_debug_file_size) },
   { "max_host_check_spread",                       SETTER(unsigned int, max_host_check_spread) },
   { "max_log_file_size",                           SETTER(unsigned long, max_log_file_size) },
@@ -134,17 +141,19 @@ state::setters const state::_setters[] = {
   { "ocsp_timeout",                                SETTER(unsigned int, ocsp_timeout) },
   { "p1_file",                                     SETTER(std::string const&, _set_p1_file) },
   { "passive_host_checks_are_soft",                SETTER(bool, passive_host_checks_are_soft) },
+  { "perfdata_file_flush_interval",                SETTER(unsigned int, perfdata_file_flush_interval) },
+  { "perfdata_file_flush_size",                    SETTER(unsigned int, perfdata_file_flush_size) },
   { "perfdata_timeout",                            SETTER(int, perfdata_timeout) },
   { "precached_object_file",                       SETTER(std::string const&, _set_precached_object_file) },
   { "process_performance_data",                    SETTER(bool, process_performance_data) },
   { "resource_file",                               SETTER(std::string const&, _set_resource_file) },
+  { "retain_state_information",                    SETTER(bool, retain_state_information) },
   { "retained_contact_host_attribute_mask",        SETTER(unsigned long, retained_contact_host_attribute_mask) },
   { "retained_contact_service_attribute_mask",     SETTER(unsigned long, retained_contact_service_attribute_mask) },
   { "retained_host_attribute_mask",                SETTER(unsigned long, retained_host_attribute_mask) },
   { "retained_process_host_attribute_mask",        SETTER(unsigned long, retained_process_host_attribute_mask) },
   { "retained_process_service_attribute_mask",     SETTER(std::string const&, _set_retained_process_service_attribute_mask) },
   { "retained_service_attribute_mask",             SETTER(std::string const&, _set_retained_service_attribute_mask) },
-  { "retain_state_information",                    SETTER(bool, retain_state_information) },
   { "retention_scheduling_horizon",                SETTER(unsigned int, retention_scheduling_horizon) },
   { "retention_update_interval",                   SETTER(unsigned int, retention_update_interval) },
   { "service_check_timeout",                       SETTER(unsigned int, service_check_timeout) },
@@ -169,8 +178,10 @@ state::setters const state::_setters[] = {
   { "translate_passive_host_checks",               SETTER(bool, translate_passive_host_checks) },
   { "use_aggressive_host_checking",                SETTER(bool, use_aggressive_host_checking) },
   { "use_agressive_host_checking",                 SETTER(bool, use_aggressive_host_checking) },
+  { "use_binary_state_retention",                  SETTER(bool, use_binary_state_retention) },
   { "use_check_result_path",                       SETTER(bool, use_check_result_path) },
   { "use_embedded_perl_implicitly",                SETTER(std::string const&, _set_use_embedded_perl_implicitly) },
+  { "use_incremental_reload",                      SETTER(bool, use_incremental_reload) },
   { "use_large_installation_tweaks",               SETTER(bool, use_large_installation_tweaks) },
   { "use_regexp_matching",                         SETTER(bool, use_regexp_matches) },
   { "use_retained_program_state",                  SETTER(bool, use_retained_program_state) },
@@ -201,6 +212,7 @@ static bool const                      default_check_host_freshness(false);
 static bool const                      default_check_orphaned_hosts(true);
 static bool const                      default_check_orphaned_services(true);
 static unsigned int const              default_check_reaper_interval(10);
+static unsigned int const              default_check_reaper_threads(0);
 static std::string const               default_check_result_path(DEFAULT_CHECK_RESULT_PATH);
 static bool const                      default_check_service_freshness(true);
 static int const                       default_command_check_interval(-1);
@@ -209,6 +221,7 @@ static state::date_type const          default_date_format(state::us);
 static std::string const               default_debug_file(DEFAULT_DEBUG_FILE);
 static unsigned long long const        default_debug_level(0);
 static unsigned int const              default_debug_verbosity(1);
+static bool const                      default_enable_async_system_commands(false);
 static bool const                      default_enable_environment_macros(false);
 static bool const                      default_enable_event_handlers(true);
 static bool const                      default_enable_flap_detection(false);
@@ -245,6 +258,10 @@ static float const                     default_low_host_flap_threshold(20.0);
 static float const                     default_low_service_flap_threshold(20.0);
 static unsigned int const              default_max_check_reaper_time(30);
 static unsigned long const             default_max_check_result_file_age(3600);
+static unsigned int const              default_max_concurrent_event_handlers(0);
+static unsigned int const              default_max_concurrent_notifications(0);
+static unsigned int const              default_max_concurrent_obsessive_commands(0);
+static unsigned int const              default_max_concurrent_perfdata_commands(0);
 static unsigned long const             default_max_debug_file_size(1000000);
 static unsigned int const              default_max_host_check_spread(5);
 static unsigned long const             default_max_log_file_size(0);
@@ -258,6 +275,8 @@ static unsigned int const              default_ochp_timeout(15);
 static std::string const               default_ocsp_command("");
 static unsigned int const              default_ocsp_timeout(15);
 static bool const                      default_passive_host_checks_are_soft(false);
+static unsigned int const              default_perfdata_file_flush_interval(0);
+static unsigned int const              default_perfdata_file_flush_size(65536);
 static int const                       default_perfdata_timeout(5);
 static bool const                      default_process_performance_data(false);
 static unsigned long const             default_retained_contact_host_attribute_mask(0L);
@@ -282,7 +301,9 @@ static unsigned int const              default_status_update_interval(60);
 static unsigned int const              default_time_change_threshold(900);
 static bool const                      default_translate_passive_host_checks(false);
 static bool const                      default_use_aggressive_host_checking(false);
+static bool const                      default_use_binary_state_retention(false);
 static bool const                      default_use_check_result_path(false);
+static bool const                      default_use_incremental_reload(false);
 static bool const                      default_use_large_installation_tweaks(false);
 static bool const                      default_use_regexp_matches(false);
 static bool const                      default_use_retained_program_state(true);
@@ -312,6 +333,7 @@ state::state()
     _check_orphaned_hosts(default_check_orphaned_hosts),
     _check_orphaned_services(default_check_orphaned_services),
     _check_reaper_interval(default_check_reaper_interval),
+    _check_reaper_threads(default_check_reaper_threads),
     _check_result_path(default_check_result_path),
     _check_service_freshness(default_check_service_freshness),
     _command_check_interval(default_command_check_interval),
@@ -321,6 +343,7 @@ state::state()
     _debug_file(default_debug_file),
     _debug_level(default_debug_level),
     _debug_verbosity(default_debug_verbosity),
+    _enable_async_system_commands(default_enable_async_system_commands),
     _enable_environment_macros(default_enable_environment_macros),
     _enable_event_handlers(default_enable_event_handlers),
     _enable_flap_detection(default_enable_flap_detection),
@@ -357,6 +380,10 @@ state::state()
     _low_service_flap_threshold(default_low_service_flap_threshold),
     _max_check_reaper_time(default_max_check_reaper_time),
     _max_check_result_file_age(default_max_check_result_file_age),
+    _max_concurrent_event_handlers(default_max_concurrent_event_handlers),
+    _max_concurrent_notifications(default_max_concurrent_notifications),
+    _max_concurrent_obsessive_commands(default_max_concurrent_obsessive_commands),
+    _max_concurrent_perfdata_commands(default_max_concurrent_perfdata_commands),
     _max_debug_file_size(default_max_debug_file_size),
     _max_host_check_spread(default_max_host_check_spread),
     _max_log_file_size(default_max_log_file_size),
@@ -370,6 +397,8 @@ state::state()
     _ocsp_command(default_ocsp_command),
     _ocsp_timeout(default_ocsp_timeout),
     _passive_host_checks_are_soft(default_passive_host_checks_are_soft),
+    _perfdata_file_flush_interval(default_perfdata_file_flush_interval),
+    _perfdata_file_flush_size(default_perfdata_file_flush_size),
     _perfdata_timeout(default_perfdata_timeout),
     _process_performance_data(default_process_performance_data),
     _retained_contact_host_attribute_mask(default_retained_contact_host_attribute_mask),
@@ -394,7 +423,9 @@ state::state()
     _time_change_threshold(default_time_change_threshold),
     _translate_passive_host_checks(default_translate_passive_host_checks),
     _use_aggressive_host_checking(default_use_aggressive_host_checking),
+    _use_binary_state_retention(default_use_binary_state_retention),
     _use_check_result_path(default_use_check_result_path),
+    _use_incremental_reload(default_use_incremental_reload),
     _use_large_installation_tweaks(default_use_large_installation_tweaks),
     _use_regexp_matches(default_use_regexp_matches),
     _use_retained_program_state(default_use_retained_program_state),
@@ -444,6 +475,7 @@ state& state::operator=(state const& right) {
     _check_orphaned_hosts = right._check_orphaned_hosts;
     _check_orphaned_services = right._check_orphaned_services;
     _check_reaper_interval = right._check_reaper_interval;
+    _check_reaper_threads = right._check_reaper_threads;
     _check_result_path = right._check_result_path;
     _check_service_freshness = right._check_service_freshness;
     _commands = right._commands;
@@ -457,6 +489,7 @@ state& state::operator=(state const& right) {
     _debug_file = right._debug_file;
     _debug_level = right._debug_level;
     _debug_verbosity = right._debug_verbosity;
+    _enable_async_system_commands = right._enable_async_system_commands;
     _enable_environment_macros = right._enable_environment_macros;
     _enable_event_handlers = right._enable_event_handlers;
     _enable_flap_detection = right._enable_flap_detection;
@@ -500,6 +533,10 @@ state& state::operator=(state const& right) {
     _low_service_flap_threshold = right._low_service_flap_threshold;
     _max_check_reaper_time = right._max_check_reaper_time;
     _max_check_result_file_age = right._max_check_result_file_age;
+    _max_concurrent_event_handlers = right._max_concurrent_event_handlers;
+    _max_concurrent_notifications = right._max_concurrent_notifications;
+    _max_concurrent_obsessive_commands = right._max_concurrent_obsessive_commands;
+    _max_concurrent_perfdata_commands = right._max_concurrent_perfdata_commands;
     _max_debug_file_size = right._max_debug_file_size;
     _max_host_check_spread = right._max_host_check_spread;
     _max_log_file_size = right._max_log_file_size;
@@ -513,6 +550,8 @@ state& state::operator=(state const& right) {
     _ocsp_command = right._ocsp_command;
     _ocsp_timeout = right._ocsp_timeout;
     _passive_host_checks_are_soft = right._passive_host_checks_are_soft;
+    _perfdata_file_flush_interval = right._perfdata_file_flush_interval;
+    _perfdata_file_flush_size = right._perfdata_file_flush_size;
     _perfdata_timeout = right._perfdata_timeout;
     _process_performance_data = right._process_performance_data;
     _retained_contact_host_attribute_mask = right._retained_contact_host_attribute_mask;
@@ -546,7 +585,9 @@ state& state::operator=(state const& right) {
     _translate_passive_host_checks = right._translate_passive_host_checks;
     _users = right._users;
     _use_aggressive_host_checking = right._use_aggressive_host_checking;
+    _use_binary_state_retention = right._use_binary_state_retention;
     _use_check_result_path = right._use_check_result_path;
+    _use_incremental_reload = right._use_incremental_reload;
     _use_large_installation_tweaks = right._use_large_installation_tweaks;
     _use_regexp_matches = right._use_regexp_matches;
     _use_retained_program_state = right._use_retained_program_state;
@@ -584,6 +625,7 @@ bool state::operator==(state const& right) const throw () {
           && _check_orphaned_hosts == right._check_orphaned_hosts
           && _check_orphaned_services == right._check_orphaned_services
           && _check_reaper_interval == right._check_reaper_interval
+          && _check_reaper_threads == right._check_reaper_threads
           && _check_result_path == right._check_result_path
           && _check_service_freshness == right._check_service_freshness
           && _commands == right._commands
@@ -597,6 +639,7 @@ bool state::operator==(state const& right) const throw () {
           && _debug_file == right._debug_file
           && _debug_level == right._debug_level
           && _debug_verbosity == right._debug_verbosity
+          && _enable_async_system_commands == right._enable_async_system_commands
           && _enable_environment_macros == right._enable_environment_macros
           && _enable_event_handlers == right._enable_event_handlers
           && _enable_flap_detection == right._enable_flap_detection
@@ -640,6 +683,10 @@ bool state::operator==(state const& right) const throw () {
           && _low_service_flap_threshold == right._low_service_flap_threshold
           && _max_check_reaper_time == right._max_check_reaper_time
           && _max_check_result_file_age == right._max_check_result_file_age
+          && _max_concurrent_event_handlers == right._max_concurrent_event_handlers
+          && _max_concurrent_notifications == right._max_concurrent_notifications
+          && _max_concurrent_obsessive_commands == right._max_concurrent_obsessive_commands
+          && _max_concurrent_perfdata_commands == right._max_concurrent_perfdata_commands
           && _max_debug_file_size == right._max_debug_file_size
           && _max_host_check_spread == right._max_host_check_spread
           && _max_log_file_size == right._max_log_file_size
@@ -653,6 +700,8 @@ bool state::operator==(state const& right) const throw () {
           && _ocsp_command == right._ocsp_command
           && _ocsp_timeout == right._ocsp_timeout
           && _passive_host_checks_are_soft == right._passive_host_checks_are_soft
+          && _perfdata_file_flush_interval == right._perfdata_file_flush_interval
+          && _perfdata_file_flush_size == right._perfdata_file_flush_size
           && _perfdata_timeout == right._perfdata_timeout
           && _process_performance_data == right._process_performance_data
           && _retained_contact_host_attribute_mask == right._retained_contact_host_attribute_mask
@@ -686,7 +735,9 @@ bool state::operator==(state const& right) const throw () {
           && _translate_passive_host_checks == right._translate_passive_host_checks
           && _users == right._users
           && _use_aggressive_host_checking == right._use_aggressive_host_checking
+          && _use_binary_state_retention == right._use_binary_state_retention
           && _use_check_result_path == right._use_check_result_path
+          && _use_incremental_reload == right._use_incremental_reload
           && _use_large_installation_tweaks == right._use_large_installation_tweaks
           && _use_regexp_matches == right._use_regexp_matches
           && _use_retained_program_state == right._use_retained_program_state
@@ -1081,6 +1132,24 @@ void state::check_reaper_interval(unsigned int value) {
   _check_reaper_interval = value;
 }
 
+/**
+ *  Get check_reaper_threads value.
+ *
+ *  @return The check_reaper_threads value.
+ */
+unsigned int state::check_reaper_threads() const throw () {
+  return (_check_reaper_threads);
+}
+
+/**
+ *  Set check_reaper_threads value.
+ *
+ *  @param[in] value The new check_reaper_threads value.
+ */
+void state::check_reaper_threads(unsigned int value) {
+  _check_reaper_threads = value;
+}
+
 /**
  *  Get check_result_path value.
  *
@@ -1148,15 +1217,7 @@ set_command& state::commands() throw () {
  */
 set_command::const_iterator state::commands_find(
                                      command::key_type const& k) const {
-  configuration::command below_searched(k);
-  set_command::const_iterator
-    it(_commands.upper_bound(below_searched));
-  if ((it != _commands.end()) && (it->command_name() == k))
-    return (it);
-  else if ((it != _commands.begin())
-           && ((--it)->command_name() == k))
-    return (it);
-  return (_commands.end());
+  return (_commands.find_key(k));
 }
 
 /**
@@ -1169,15 +1230,7 @@ set_command::const_iterator state::commands_find(
  */
 set_command::iterator state::commands_find(
                                command::key_type const& k) {
-  configuration::command below_searched(k);
-  set_command::iterator
-    it(_commands.upper_bound(below_searched));
-  if ((it != _commands.end()) && (it->command_name() == k))
-    return (it);
-  else if ((it != _commands.begin())
-           && ((--it)->command_name() == k))
-    return (it);
-  return (_commands.end());
+  return (_commands.find_key(k));
 }
 
 /**
@@ -1274,15 +1327,7 @@ set_connector& state::connectors() throw () {
  */
 set_connector::const_iterator state::connectors_find(
                                      connector::key_type const& k) const {
-  configuration::connector below_searched(k);
-  set_connector::const_iterator
-    it(_connectors.upper_bound(below_searched));
-  if ((it != _connectors.end()) && (it->connector_name() == k))
-    return (it);
-  else if ((it != _connectors.begin())
-           && ((--it)->connector_name() == k))
-    return (it);
-  return (_connectors.end());
+  return (_connectors.find_key(k));
 }
 
 /**
@@ -1295,15 +1340,7 @@ set_connector::const_iterator state::connectors_find(
  */
 set_connector::iterator state::connectors_find(
                                connector::key_type const& k) {
-  configuration::connector below_searched(k);
-  set_connector::iterator
-    it(_connectors.upper_bound(below_searched));
-  if ((it != _connectors.end()) && (it->connector_name() == k))
-    return (it);
-  else if ((it != _connectors.begin())
-           && ((--it)->connector_name() == k))
-    return (it);
-  return (_connectors.end());
+  return (_connectors.find_key(k));
 }
 
 /**
@@ -1334,15 +1371,7 @@ set_contact& state::contacts() throw () {
  */
 set_contact::const_iterator state::contacts_find(
                                      contact::key_type const& k) const {
-  configuration::contact below_searched(k);
-  set_contact::const_iterator
-    it(_contacts.upper_bound(below_searched));
-  if ((it != _contacts.end()) && (it->contact_name() == k))
-    return (it);
-  else if ((it != _contacts.begin())
-           && ((--it)->contact_name() == k))
-    return (it);
-  return (_contacts.end());
+  return (_contacts.find_key(k));
 }
 
 /**
@@ -1355,15 +1384,7 @@ set_contact::const_iterator state::contacts_find(
  */
 set_contact::iterator state::contacts_find(
                                contact::key_type const& k) {
-  configuration::contact below_searched(k);
-  set_contact::iterator
-    it(_contacts.upper_bound(below_searched));
-  if ((it != _contacts.end()) && (it->contact_name() == k))
-    return (it);
-  else if ((it != _contacts.begin())
-           && ((--it)->contact_name() == k))
-    return (it);
-  return (_contacts.end());
+  return (_contacts.find_key(k));
 }
 
 /**
@@ -1376,15 +1397,7 @@ set_contact::iterator state::contacts_find(
  */
 set_contactgroup::const_iterator state::contactgroups_find(
                                 contactgroup::key_type const& k) const {
-  configuration::contactgroup below_searched(k);
-  set_contactgroup::const_iterator
-    it(_contactgroups.upper_bound(below_searched));
-  if ((it != _contactgroups.end()) && (it->contactgroup_name() == k))
-    return (it);
-  else if ((it != _contactgroups.begin())
-           && ((--it)->contactgroup_name() == k))
-    return (it);
-  return (_contactgroups.end());
+  return (_contactgroups.find_key(k));
 }
 
 /**
@@ -1397,15 +1410,7 @@ set_contactgroup::const_iterator state::contactgroups_find(
  */
 set_contactgroup::iterator state::contactgroups_find(
                                  contactgroup::key_type const& k) {
-  configuration::contactgroup below_searched(k);
-  set_contactgroup::iterator
-    it(_contactgroups.upper_bound(below_searched));
-  if ((it != _contactgroups.end()) && (it->contactgroup_name() == k))
-    return (it);
-  else if ((it != _contactgroups.begin())
-           && ((--it)->contactgroup_name() == k))
-    return (it);
-  return (_contactgroups.end());
+  return (_contactgroups.find_key(k));
 }
 
 /**
@@ -1505,6 +1510,24 @@ void state::debug_verbosity(unsigned int value) {
     _debug_verbosity = value;
 }
 
+/**
+ *  Get enable_async_system_commands value.
+ *
+ *  @return The enable_async_system_commands value.
+ */
+bool state::enable_async_system_commands() const throw () {
+  return (_enable_async_system_commands);
+}
+
+/**
+ *  Set enable_async_system_commands value.
+ *
+ *  @param[in] value The new enable_async_system_commands value.
+ */
+void state::enable_async_system_commands(bool value) {
+  _enable_async_system_commands = value;
+}
+
 /**
  *  Get enable_environment_macros value.
  *
@@ -1850,15 +1873,7 @@ set_hostgroup& state::hostgroups() throw () {
  */
 set_hostgroup::const_iterator state::hostgroups_find(
                                 hostgroup::key_type const& k) const {
-  configuration::hostgroup below_searched(k);
-  set_hostgroup::const_iterator
-    it(_hostgroups.upper_bound(below_searched));
-  if ((it != _hostgroups.end()) && (it->hostgroup_name() == k))
-    return (it);
-  else if ((it != _hostgroups.begin())
-           && ((--it)->hostgroup_name() == k))
-    return (it);
-  return (_hostgroups.end());
+  return (_hostgroups.find_key(k));
 }
 
 /**
@@ -1871,14 +1886,7 @@ set_hostgroup::const_iterator state::hostgroups_find(
  */
 set_hostgroup::iterator state::hostgroups_find(
                                  hostgroup::key_type const& k) {
-  configuration::hostgroup below_searched(k);
-  set_hostgroup::iterator it(_hostgroups.upper_bound(below_searched));
-  if ((it != _hostgroups.end()) && (it->hostgroup_name() == k))
-    return (it);
-  else if ((it != _hostgroups.begin())
-           && ((--it)->hostgroup_name() == k))
-    return (it);
-  return (_hostgroups.end());
+  return (_hostgroups.find_key(k));
 }
 
 /**
@@ -1908,13 +1916,7 @@ set_host& state::hosts() throw () {
  */
 set_host::const_iterator state::hosts_find(
                                   host::key_type const& k) const {
-  configuration::host below_searched(k);
-  set_host::const_iterator it(_hosts.upper_bound(below_searched));
-  if ((it != _hosts.end()) && (it->host_name() == k))
-    return (it);
-  else if ((it != _hosts.begin()) && ((--it)->host_name() == k))
-    return (it);
-  return (_hosts.end());
+  return (_hosts.find_key(k));
 }
 
 /**
@@ -1926,13 +1928,7 @@ set_host::const_iterator state::hosts_find(
  */
 set_host::iterator state::hosts_find(
                             host::key_type const& k) {
-  configuration::host below_searched(k);
-  set_host::iterator it(_hosts.upper_bound(below_searched));
-  if ((it != _hosts.end()) && (it->host_name() == k))
-    return (it);
-  else if ((it != _hosts.begin()) && ((--it)->host_name() == k))
-    return (it);
-  return (_hosts.end());
+  return (_hosts.find_key(k));
 }
 
 /**
@@ -2391,6 +2387,78 @@ void state::max_check_result_file_age(unsigned long value) {
   ++config_warnings;
 }
 
+/**
+ *  Get max_concurrent_event_handlers value.
+ *
+ *  @return The max_concurrent_event_handlers value.
+ */
+unsigned int state::max_concurrent_event_handlers() const throw () {
+  return (_max_concurrent_event_handlers);
+}
+
+/**
+ *  Set max_concurrent_event_handlers value.
+ *
+ *  @param[in] value The new max_concurrent_event_handlers value.
+ */
+void state::max_concurrent_event_handlers(unsigned int value) {
+  _max_concurrent_event_handlers = value;
+}
+
+/**
+ *  Get max_concurrent_notifications value.
+ *
+ *  @return The max_concurrent_notifications value.
+ */
+unsigned int state::max_concurrent_notifications() const throw () {
+  return (_max_concurrent_notifications);
+}
+
+/**
+ *  Set max_concurrent_notifications value.
+ *
+ *  @param[in] value The new max_concurrent_notifications value.
+ */
+void state::max_concurrent_notifications(unsigned int value) {
+  _max_concurrent_notifications = value;
+}
+
+/**
+ *  Get max_concurrent_obsessive_commands value.
+ *
+ *  @return The max_concurrent_obsessive_commands value.
+ */
+unsigned int state::max_concurrent_obsessive_commands() const throw () {
+  return (_max_concurrent_obsessive_commands);
+}
+
+/**
+ *  Set max_concurrent_obsessive_commands value.
+ *
+ *  @param[in] value The new max_concurrent_obsessive_commands value.
+ */
+void state::max_concurrent_obsessive_commands(unsigned int value) {
+  _max_concurrent_obsessive_commands = value;
+}
+
+/**
+ *  Get max_concurrent_perfdata_commands value.
+ *
+ *  @return The max_concurrent_perfdata_commands value.
+ */
+unsigned int state::max_concurrent_perfdata_commands() const throw () {
+  return (_max_concurrent_perfdata_commands);
+}
+
+/**
+ *  Set max_concurrent_perfdata_commands value.
+ *
+ *  @param[in] value The new max_concurrent_perfdata_commands value.
+ */
+void state::max_concurrent_perfdata_commands(unsigned int value) {
+  _max_concurrent_perfdata_commands = value;
+}
+
 /**
  *  Get max_debug_file_size value.
  *
@@ -2636,6 +2704,42 @@ void state::passive_host_checks_are_soft(bool value) {
   _passive_host_checks_are_soft = value;
 }
 
+/**
+ *  Get perfdata_file_flush_interval value.
+ *
+ *  @return The perfdata_file_flush_interval value.
+ */
+unsigned int state::perfdata_file_flush_interval() const throw () {
+  return (_perfdata_file_flush_interval);
+}
+
+/**
+ *  Set perfdata_file_flush_interval value.
+ *
+ *  @param[in] value The new perfdata_file_flush_interval value.
+ */
+void state::perfdata_file_flush_interval(unsigned int value) {
+  _perfdata_file_flush_interval = value;
+}
+
+/**
+ *  Get perfdata_file_flush_size value.
+ *
+ *  @return The perfdata_file_flush_size value.
+ */
+unsigned int state::perfdata_file_flush_size() const throw () {
+  return (_perfdata_file_flush_size);
+}
+
+/**
+ *  Set perfdata_file_flush_size value.
+ *
+ *  @param[in] value The new perfdata_file_flush_size value.
+ */
+void state::perfdata_file_flush_size(unsigned int value) {
+  _perfdata_file_flush_size = value;
+}
+
 /**
  *  Get perfdata_timeout value.
  *
@@ -2885,15 +2989,7 @@ set_servicegroup& state::servicegroups() throw () {
  */
 set_servicegroup::const_iterator state::servicegroups_find(
                                    servicegroup::key_type const& k) const {
-  configuration::servicegroup below_searched(k);
-  set_servicegroup::const_iterator
-    it(_servicegroups.upper_bound(below_searched));
-  if ((it != _servicegroups.end()) && (it->servicegroup_name() == k))
-    return (it);
-  else if ((it != _servicegroups.begin())
-           && ((--it)->servicegroup_name() == k))
-    return (it);
-  return (_servicegroups.end());
+  return (_servicegroups.find_key(k));
 }
 
 /**
@@ -2906,15 +3002,7 @@ set_servicegroup::const_iterator state::servicegroups_find(
  */
 set_servicegroup::iterator state::servicegroups_find(
                              servicegroup::key_type const& k) {
-  configuration::servicegroup below_searched(k);
-  set_servicegroup::iterator
-    it(_servicegroups.upper_bound(below_searched));
-  if ((it != _servicegroups.end()) && (it->servicegroup_name() == k))
-    return (it);
-  else if ((it != _servicegroups.begin())
-           && ((--it)->servicegroup_name() == k))
-    return (it);
-  return (_servicegroups.end());
+  return (_servicegroups.find_key(k));
 }
 
 /**
@@ -2945,20 +3033,7 @@ set_service& state::services() throw () {
  */
 set_service::const_iterator state::services_find(
                                    service::key_type const& k) const {
-  configuration::service below_searched;
-  below_searched.hosts().insert(k.first);
-  below_searched.service_description() = k.second;
-  set_service::const_iterator
-    it(_services.upper_bound(below_searched));
-  if ((it != _services.end())
-      && (*it->hosts().begin() == k.first)
-      && (it->service_description() == k.second))
-    return (it);
-  else if ((it != _services.begin())
-           && (*(--it)->hosts().begin() == k.first)
-           && (it->service_description() == k.second))
-    return (it);
-  return (_services.end());
+  return (_services.find_key(k));
 }
 
 /**
@@ -2971,20 +3046,7 @@ set_service::const_iterator state::services_find(
  */
 set_service::iterator state::services_find(
                              service::key_type const& k) {
-  configuration::service below_searched;
-  below_searched.hosts().insert(k.first);
-  below_searched.service_description() = k.second;
-  set_service::iterator
-    it(_services.upper_bound(below_searched));
-  if ((it != _services.end())
-      && (*it->hosts().begin() == k.first)
-      && (it->service_description() == k.second))
-    return (it);
-  else if ((it != _services.begin())
-           && (*(--it)->hosts().begin() == k.first)
-           && (it->service_description() == k.second))
-    return (it);
-  return (_services.end());
+  return (_services.find_key(k));
 }
 
 /**
@@ -3285,11 +3347,9 @@ void state::status_update_interval(unsigned int value) {
  */
 bool state::set(char const* key, char const* value) {
   try {
-    for (unsigned int i(0);
-         i < sizeof(_setters) / sizeof(_setters[0]);
-         ++i)
-      if (!strcmp(_setters[i].name, key))
-        return ((_setters[i].func)(*this, value));
+    setters const* s(find_setter(_setters, key));
+    if (s)
+      return ((s->func)(*this, value));
   }
   catch (std::exception const& e) {
     logger(log_config_error, basic)
@@ -3299,6 +3359,16 @@ bool state::set(char const* key, char const* value) {
   return (true);
 }
 
+/**
+ *  Check that the setter table is sorted, as properties are looked up
+ *  with a binary search.
+ *
+ *  @return True if the setter table is sorted.
+ */
+bool state::sorted_setters() throw () {
+  return (setters_are_sorted(_setters));
+}
+
 /**
  *  Get all engine timeperiods.
  *
@@ -3326,15 +3396,7 @@ set_timeperiod& state::timeperiods() throw () {
  *          otherwise.
  */
 set_timeperiod::const_iterator state::timeperiods_find(timeperiod::key_type const& k) const {
-  configuration::timeperiod below_searched(k);
-  set_timeperiod::const_iterator
-    it(_timeperiods.upper_bound(below_searched));
-  if ((it != _timeperiods.end()) && (it->timeperiod_name() == k))
-    return (it);
-  else if ((it != _timeperiods.begin())
-           && ((--it)->timeperiod_name() == k))
-    return (it);
-  return (_timeperiods.end());
+  return (_timeperiods.find_key(k));
 }
 
 /**
@@ -3346,15 +3408,7 @@ set_timeperiod::const_iterator state::timeperiods_find(timeperiod::key_type cons
  *          otherwise.
  */
 set_timeperiod::iterator state::timeperiods_find(timeperiod::key_type const& k) {
-  configuration::timeperiod below_searched(k);
-  set_timeperiod::iterator
-    it(_timeperiods.upper_bound(below_searched));
-  if ((it != _timeperiods.end()) && (it->timeperiod_name() == k))
-    return (it);
-  else if ((it != _timeperiods.begin())
-           && ((--it)->timeperiod_name() == k))
-    return (it);
-  return (_timeperiods.end());
+  return (_timeperiods.find_key(k));
 }
 
 /**
@@ -3458,6 +3512,24 @@ void state::use_aggressive_host_checking(bool value) {
   _use_aggressive_host_checking = value;
 }
 
+/**
+ *  Get use_binary_state_retention value.
+ *
+ *  @return The use_binary_state_retention value.
+ */
+bool state::use_binary_state_retention() const throw () {
+  return (_use_binary_state_retention);
+}
+
+/**
+ *  Set use_binary_state_retention value.
+ *
+ *  @param[in] value The new use_binary_state_retention value.
+ */
+void state::use_binary_state_retention(bool value) {
+  _use_binary_state_retention = value;
+}
+
 /**
  *  Get use_check_result_path value.
  *
@@ -3476,6 +3548,24 @@ void state::use_check_result_path(bool value) {
   _use_check_result_path = value;
 }
 
+/**
+ *  Get use_incremental_reload value.
+ *
+ *  @return The use_incremental_reload value.
+ */
+bool state::use_incremental_reload() const throw () {
+  return (_use_incremental_reload);
+}
+
+/**
+ *  Set use_incremental_reload value.
+ *
+ *  @param[in] value The new use_incremental_reload value.
+ */
+void state::use_incremental_reload(bool value) {
+  _use_incremental_reload = value;
+}
+
 /**
  *  Get use_large_installation_tweaks value.
  *
@@ -19,6 +19,7 @@
 
 #include <cstdio>
 #include "com/centreon/engine/common.hh"
+#include "com/centreon/engine/configuration/find_setter.hh"
 #include "com/centreon/engine/configuration/timeperiod.hh"
 #include "com/centreon/engine/configuration/timerange.hh"
 #include "com/centreon/engine/error.hh"
@@ -190,14 +191,22 @@ void timeperiod::merge(object const& obj) {
  *  @return True on success, otherwise false.
  */
 bool timeperiod::parse(char const* key, char const* value) {
-  for (unsigned int i(0);
-       i < sizeof(_setters) / sizeof(_setters[0]);
-       ++i)
-    if (!strcmp(_setters[i].name, key))
-      return ((_setters[i].func)(*this, value));
+  setters const* s(find_setter(_setters, key));
+  if (s)
+    return ((s->func)(*this, value));
   return (_add_week_day(key, value));
 }
 
+/**
+ *  Check that the setter table is sorted, as properties are looked up
+ *  with a binary search.
+ *
+ *  @return True if the setter table is sorted.
+ */
+bool timeperiod::sorted_setters() throw () {
+  return (setters_are_sorted(_setters));
+}
+
 /**
  *  Parse and set the timeperiod property.
  *
@@ -26,6 +26,7 @@
 #include "com/centreon/engine/objects/timeperiod.hh"
 #include "com/centreon/engine/objects/timeperiodexclusion.hh"
 #include "com/centreon/engine/objects/timerange.hh"
+#include "com/centreon/engine/timeperiod.hh"
 
 using namespace com::centreon::engine;
 
@@ -39,6 +40,7 @@ void deleter::timeperiod(void* ptr) throw () {
     return;
 
   timeperiod_struct* obj(static_cast<timeperiod_struct*>(ptr));
+  clear_timeperiod_cache();
 
   for (unsigned int i(0);
        i < sizeof(obj->days) / sizeof(obj->days[0]);
@@ -21,15 +21,20 @@
 
 #include <cstdlib>
 #include <ctime>
+#include "com/centreon/concurrency/locker.hh"
 #include "com/centreon/engine/broker.hh"
-#include "com/centreon/concurrency/thread.hh"
+#include "com/centreon/engine/checks/checker.hh"
+#include "com/centreon/engine/commands/system_runner.hh"
 #include "com/centreon/engine/events/defines.hh"
 #include "com/centreon/engine/events/loop.hh"
 #include "com/centreon/engine/globals.hh"
 #include "com/centreon/engine/logging/logger.hh"
 #include "com/centreon/engine/statusdata.hh"
 #include "com/centreon/logging/engine.hh"
+#include "com/centreon/timestamp.hh"
 
+using namespace com::centreon;
+using namespace com::centreon::engine;
 using namespace com::centreon::engine::events;
 using namespace com::centreon::engine::logging;
 
@@ -100,6 +105,23 @@ void loop::unload() {
   return;
 }
 
+/**
+ *  Wake up the events loop, to handle new data as soon as possible.
+ *  Can be called from any thread, it only costs a flag check while
+ *  the loop is not waiting.
+ */
+void loop::wake_up() {
+  // A pending wake up will be seen by the loop before waiting.
+  if (__sync_lock_test_and_set(&_wakeup, 1))
+    return;
+  __sync_synchronize();
+  if (_waiting) {
+    concurrency::locker lock(&_lock_wakeup);
+    _cv_wakeup.wake_one();
+  }
+  return;
+}
+
 /**************************************
 *                                     *
 *           Private Methods           *
@@ -111,7 +133,9 @@ void loop::unload() {
  */
 loop::loop()
   : _need_reload(0),
-    _reload_running(false) {
+    _reload_running(false),
+    _waiting(0),
+    _wakeup(0) {
 
 }
 
@@ -122,6 +146,244 @@ loop::~loop() throw () {
 
 }
 
+/**
+ *  Count the events due at some time.
+ *
+ *  @param[in] current_time  The time the loop woke up.
+ *
+ *  @return Number of high and low priority events due.
+ */
+unsigned int loop::_count_due_events(time_t current_time) {
+  unsigned int count(0);
+  for (timed_event* evt(event_list_high);
+       evt && (evt->run_time <= current_time);
+       evt = evt->next)
+    ++count;
+  for (timed_event* evt(event_list_low);
+       evt && (evt->run_time <= current_time);
+       evt = evt->next)
+    ++count;
+  return (count);
+}
+
+/**
+ *  Handle the next due event.
+ *
+ *  @param[in]  current_time  The time the loop woke up.
+ *  @param[out] deferred      Set to true if a check could not be run
+ *                            and is still due.
+ *
+ *  @return True if an event was due, false otherwise.
+ */
+bool loop::_dispatch_event(time_t current_time, bool& deferred) {
+  // Handle high priority events.
+  bool run_event(true);
+  if (event_list_high
+      && (current_time >= event_list_high->run_time)) {
+    // Remove the first event from the timing loop.
+    timed_event* temp_event(event_list_high);
+    event_list_high = event_list_high->next;
+    // We may have just removed the only item from the list.
+    if (event_list_high)
+      event_list_high->prev = NULL;
+    quick_timed_event.erase(hash_timed_event::high, temp_event);
+    sorted_timed_events.erase(hash_timed_event::high, temp_event);
+    temp_event->next = NULL;
+
+    // Handle the event.
+    handle_timed_event(temp_event);
+
+    // Reschedule the event if necessary.
+    if (temp_event->recurring)
+      reschedule_event(
+        temp_event,
+        &event_list_high,
+        &event_list_high_tail);
+    // Else free memory associated with the event.
+    else
+      delete temp_event;
+  }
+  // Handle low priority events.
+  else if (event_list_low
+           && (current_time >= event_list_low->run_time)) {
+    // Default action is to execute the event.
+    run_event = true;
+
+    // Run a few checks before executing a service check...
+    if (event_list_low->event_type == EVENT_SERVICE_CHECK) {
+      int nudge_seconds(0);
+      service* temp_service(
+                 static_cast<service*>(event_list_low->event_data));
+
+      // Don't run a service check if we're already maxed out on the
+      // number of parallel service checks...
+      if (config->max_parallel_service_checks() != 0
+          && (currently_running_service_checks
+              >= config->max_parallel_service_checks())) {
+        // Move it at least 5 seconds (to overcome the current peak),
+        // with a random 10 seconds (to spread the load).
+        nudge_seconds = 5 + (rand() % 10);
+        logger(dbg_events | dbg_checks, basic)
+          << "**WARNING** Max concurrent service checks ("
+          << currently_running_service_checks << "/"
+          << config->max_parallel_service_checks()
+          << ") has been reached!  Nudging "
+          << temp_service->host_name << ":"
+          << temp_service->description << " by "
+          << nudge_seconds << " seconds...";
+        logger(log_runtime_warning, basic)
+          << "\tMax concurrent service checks ("
+          << currently_running_service_checks << "/"
+          << config->max_parallel_service_checks()
+          << ") has been reached.  Nudging "
+          << temp_service->host_name << ":"
+          << temp_service->description << " by "
+          << nudge_seconds << " seconds...";
+        run_event = false;
+      }
+
+      // Don't run a service check if active checks are disabled.
+      if (!config->execute_service_checks()) {
+        logger(dbg_events | dbg_checks, more)
+          << "We're not executing service checks right now, "
+          << "so we'll skip this event.";
+        run_event = false;
+      }
+
+      // Forced checks override normal check logic.
+      if (temp_service->check_options & CHECK_OPTION_FORCE_EXECUTION)
+        run_event = true;
+
+      // Reschedule the check if we can't run it now.
+      if (!run_event) {
+        // Remove the service check from the event queue and
+        // reschedule it for a later time. Since event was not
+        // executed, it needs to be remove()'ed to maintain sync with
+        // event broker modules.
+        timed_event* temp_event(event_list_low);
+        remove_event(
+          temp_event,
+          &event_list_low,
+          &event_list_low_tail);
+
+        // We nudge the next check time when it is
+        // due to too many concurrent service checks.
+        if (nudge_seconds)
+          temp_service->next_check
+            = (time_t)(temp_service->next_check + nudge_seconds);
+        // Otherwise reschedule (TODO: This should be smarter as it
+        // doesn't consider its timeperiod).
+        else {
+          if ((SOFT_STATE == temp_service->state_type)
+              && (temp_service->current_state != STATE_OK))
+            temp_service->next_check
+              = (time_t)(temp_service->next_check
+                         + (temp_service->retry_interval
+                            * config->interval_length()));
+          else
+            temp_service->next_check
+              = (time_t)(temp_service->next_check
+                         + (temp_service->check_interval
+                            * config->interval_length()));
+        }
+        temp_event->run_time = temp_service->next_check;
+        reschedule_event(temp_event, &event_list_low, &event_list_low_tail);
+        update_service_status(temp_service, false);
+        run_event = false;
+        // Let the loop wait if the event is still due.
+        if (temp_event->run_time <= current_time)
+          deferred = true;
+      }
+    }
+    // Run a few checks before executing a host check...
+    else if (EVENT_HOST_CHECK == event_list_low->event_type) {
+      // Default action is to execute the event.
+      run_event = true;
+      host* temp_host(static_cast<host*>(event_list_low->event_data));
+
+      // Don't run a host check if active checks are disabled.
+      if (!config->execute_host_checks()) {
+        logger(dbg_events | dbg_checks, more)
+          << "We're not executing host checks right now, "
+          << "so we'll skip this event.";
+        run_event = false;
+      }
+
+      // Forced checks override normal check logic.
+      if (temp_host->check_options & CHECK_OPTION_FORCE_EXECUTION)
+        run_event = true;
+
+      // Reschedule the host check if we can't run it right now.
+      if (!run_event) {
+        // Remove the host check from the event queue and reschedule
+        // it for a later time. Since event was not executed, it needs
+        // to be remove()'ed to maintain sync with event broker
+        // modules.
+        timed_event* temp_event(event_list_low);
+        remove_event(
+          temp_event,
+          &event_list_low,
+          &event_list_low_tail);
+
+        // Reschedule.
+        if ((SOFT_STATE == temp_host->state_type)
+            && (temp_host->current_state != STATE_OK))
+          temp_host->next_check
+            = (time_t)(temp_host->next_check
+                       + (temp_host->retry_interval
+                          * config->interval_length()));
+        else
+          temp_host->next_check
+            = (time_t)(temp_host->next_check
+                       + (temp_host->check_interval
+                          * config->interval_length()));
+        temp_event->run_time = temp_host->next_check;
+        reschedule_event(temp_event, &event_list_low, &event_list_low_tail);
+        update_host_status(temp_host, false);
+        run_event = false;
+        // Let the loop wait if the event is still due.
+        if (temp_event->run_time <= current_time)
+          deferred = true;
+      }
+    }
+
+    // Run the event.
+    if (run_event) {
+      // Remove the first event from the timing loop.
+      timed_event* temp_event(event_list_low);
+      event_list_low = event_list_low->next;
+      // We may have just removed the only item from the list.
+      if (event_list_low)
+        event_list_low->prev = NULL;
+      quick_timed_event.erase(hash_timed_event::low, temp_event);
+      sorted_timed_events.erase(hash_timed_event::low, temp_event);
+      temp_event->next = NULL;
+
+      // Handle the event.
+      logger(dbg_events, more)
+        << "Running event...";
+      handle_timed_event(temp_event);
+
+      // Reschedule the event if necessary.
+      if (temp_event->recurring)
+        reschedule_event(
+          temp_event,
+          &event_list_low,
+          &event_list_low_tail);
+      // Else free memory associated with the event.
+      else
+        delete temp_event;
+    }
+    else
+      logger(dbg_events, most)
+        << "Did not execute scheduled event.";
+  }
+  // No event is due.
+  else
+    return (false);
+  return (true);
+}
+
 /**
  *  Slot to dispatch Centreon Engine events.
  */
@@ -188,6 +450,14 @@ void loop::_dispatching() {
     // Keep track of the last time.
     _last_time = current_time;
 
+    // Handle results of notifications, event handlers, obsessive
+    // compulsive and performance data commands.
+    commands::system_runner::instance().reap();
+
+    // Handle check results as soon as they are received.
+    if (!checks::checker::instance().reaper_is_empty())
+      checks::checker::instance().reap();
+
     // Log messages about event lists.
     logger(dbg_events, more)
       << "** Event Check Loop";
@@ -217,249 +487,100 @@ void loop::_dispatching() {
       update_program_status(false);
     }
 
-    // Handle high priority events.
-    bool run_event(true);
-    if (event_list_high
-        && (current_time >= event_list_high->run_time)) {
-      // Remove the first event from the timing loop.
-      timed_event* temp_event(event_list_high);
-      event_list_high = event_list_high->next;
-      // We may have just removed the only item from the list.
-      if (event_list_high)
-        event_list_high->prev = NULL;
-      quick_timed_event.erase(hash_timed_event::high, temp_event);
-
-      // Handle the event.
-      handle_timed_event(temp_event);
-
-      // Reschedule the event if necessary.
-      if (temp_event->recurring)
-        reschedule_event(
-          temp_event,
-          &event_list_high,
-          &event_list_high_tail);
-      // Else free memory associated with the event.
-      else
-        delete temp_event;
+    // Handle the events that were due when the loop woke up. Recurring
+    // events late on schedule are rescheduled to now, so they are only
+    // handled again by the next iteration, after results and signals.
+    bool deferred(false);
+    for (unsigned int due(_count_due_events(current_time));
+         due
+           && !sigshutdown
+           && !sighup
+           && !deferred
+           && _dispatch_event(current_time, deferred);
+         --due)
+      ;
+    if (sigshutdown || sighup)
+      continue;
+
+    logger(dbg_events, most)
+      << "No events to execute at the moment. Idling for a bit...";
+
+    // Check for external commands if we're supposed to check as
+    // often as possible.
+    if (config->command_check_interval() == -1) {
+      // Send data to event broker.
+      broker_external_command(
+        NEBTYPE_EXTERNALCOMMAND_CHECK,
+        NEBFLAG_NONE,
+        NEBATTR_NONE,
+        CMD_NONE,
+        time(NULL),
+        NULL,
+        NULL,
+        NULL);
     }
-    // Handle low priority events.
-    else if (event_list_low
-             && (current_time >= event_list_low->run_time)) {
-      // Default action is to execute the event.
-      run_event = true;
 
-      // Run a few checks before executing a service check...
-      if (event_list_low->event_type == EVENT_SERVICE_CHECK) {
-        int nudge_seconds(0);
-        service* temp_service(
-                   static_cast<service*>(event_list_low->event_data));
-
-        // Don't run a service check if we're already maxed out on the
-        // number of parallel service checks...
-        if (config->max_parallel_service_checks() != 0
-            && (currently_running_service_checks
-                >= config->max_parallel_service_checks())) {
-          // Move it at least 5 seconds (to overcome the current peak),
-          // with a random 10 seconds (to spread the load).
-          nudge_seconds = 5 + (rand() % 10);
-          logger(dbg_events | dbg_checks, basic)
-            << "**WARNING** Max concurrent service checks ("
-            << currently_running_service_checks << "/"
-            << config->max_parallel_service_checks()
-            << ") has been reached!  Nudging "
-            << temp_service->host_name << ":"
-            << temp_service->description << " by "
-            << nudge_seconds << " seconds...";
-          logger(log_runtime_warning, basic)
-            << "\tMax concurrent service checks ("
-            << currently_running_service_checks << "/"
-            << config->max_parallel_service_checks()
-            << ") has been reached.  Nudging "
-            << temp_service->host_name << ":"
-            << temp_service->description << " by "
-            << nudge_seconds << " seconds...";
-          run_event = false;
-        }
-
-        // Don't run a service check if active checks are disabled.
-        if (!config->execute_service_checks()) {
-          logger(dbg_events | dbg_checks, more)
-            << "We're not executing service checks right now, "
-            << "so we'll skip this event.";
-          run_event = false;
-        }
-
-        // Forced checks override normal check logic.
-        if (temp_service->check_options & CHECK_OPTION_FORCE_EXECUTION)
-          run_event = true;
-
-        // Reschedule the check if we can't run it now.
-        if (!run_event) {
-          // Remove the service check from the event queue and
-          // reschedule it for a later time. Since event was not
-          // executed, it needs to be remove()'ed to maintain sync with
-          // event broker modules.
-          timed_event* temp_event(event_list_low);
-          remove_event(
-            temp_event,
-            &event_list_low,
-            &event_list_low_tail);
-
-          // We nudge the next check time when it is
-          // due to too many concurrent service checks.
-          if (nudge_seconds)
-            temp_service->next_check
-              = (time_t)(temp_service->next_check + nudge_seconds);
-          // Otherwise reschedule (TODO: This should be smarter as it
-          // doesn't consider its timeperiod).
-          else {
-            if ((SOFT_STATE == temp_service->state_type)
-                && (temp_service->current_state != STATE_OK))
-              temp_service->next_check
-                = (time_t)(temp_service->next_check
-                           + (temp_service->retry_interval
-                              * config->interval_length()));
-            else
-              temp_service->next_check
-                = (time_t)(temp_service->next_check
-                           + (temp_service->check_interval
-                              * config->interval_length()));
-          }
-          temp_event->run_time = temp_service->next_check;
-          reschedule_event(temp_event, &event_list_low, &event_list_low_tail);
-          update_service_status(temp_service, false);
-          run_event = false;
-        }
-      }
-      // Run a few checks before executing a host check...
-      else if (EVENT_HOST_CHECK == event_list_low->event_type) {
-        // Default action is to execute the event.
-        run_event = true;
-        host* temp_host(static_cast<host*>(event_list_low->event_data));
-
-        // Don't run a host check if active checks are disabled.
-        if (!config->execute_host_checks()) {
-          logger(dbg_events | dbg_checks, more)
-            << "We're not executing host checks right now, "
-            << "so we'll skip this event.";
-          run_event = false;
-        }
-
-        // Forced checks override normal check logic.
-        if (temp_host->check_options & CHECK_OPTION_FORCE_EXECUTION)
-          run_event = true;
-
-        // Reschedule the host check if we can't run it right now.
-        if (!run_event) {
-          // Remove the host check from the event queue and reschedule
-          // it for a later time. Since event was not executed, it needs
-          // to be remove()'ed to maintain sync with event broker
-          // modules.
-          timed_event* temp_event(event_list_low);
-          remove_event(
-            temp_event,
-            &event_list_low,
-            &event_list_low_tail);
-
-          // Reschedule.
-          if ((SOFT_STATE == temp_host->state_type)
-              && (temp_host->current_state != STATE_OK))
-            temp_host->next_check
-              = (time_t)(temp_host->next_check
-                         + (temp_host->retry_interval
-                            * config->interval_length()));
-          else
-            temp_host->next_check
-              = (time_t)(temp_host->next_check
-                         + (temp_host->check_interval
-                            * config->interval_length()));
-          temp_event->run_time = temp_host->next_check;
-          reschedule_event(temp_event, &event_list_low, &event_list_low_tail);
-          update_host_status(temp_host, false);
-          run_event = false;
-        }
-      }
-
-      // Run the event.
-      if (run_event) {
-        // Remove the first event from the timing loop.
-        timed_event* temp_event(event_list_low);
-        event_list_low = event_list_low->next;
-        // We may have just removed the only item from the list.
-        if (event_list_low)
-          event_list_low->prev = NULL;
-        quick_timed_event.erase(hash_timed_event::low, temp_event);
-
-        // Handle the event.
-        logger(dbg_events, more)
-          << "Running event...";
-        handle_timed_event(temp_event);
-
-        // Reschedule the event if necessary.
-        if (temp_event->recurring)
-          reschedule_event(
-            temp_event,
-            &event_list_low,
-            &event_list_low_tail);
-        // Else free memory associated with the event.
-        else
-          delete temp_event;
-      }
-      // Wait a while so we don't hog the CPU...
-      else {
-        logger(dbg_events, most)
-          << "Did not execute scheduled event. Idling for a bit...";
-        concurrency::thread::nsleep(
-          (unsigned long)(config->sleep_time() * 1000000000l));
-      }
+    // Wait until the next event is due, at most the sleep time to
+    // notice signals. A deferred check waits for the check that will
+    // free its slot.
+    unsigned long timeout(
+                    static_cast<unsigned long>(config->sleep_time() * 1000));
+    if (!timeout)
+      timeout = 1;
+    if (!deferred) {
+      time_t next_time(0);
+      if (event_list_high)
+        next_time = event_list_high->run_time;
+      if (event_list_low
+          && (!next_time || (event_list_low->run_time < next_time)))
+        next_time = event_list_low->run_time;
+      unsigned long long now(timestamp::now().to_mseconds());
+      unsigned long long next(next_time * 1000ull);
+      if (next <= now)
+        timeout = 0;
+      else if (next - now < timeout)
+        timeout = static_cast<unsigned long>(next - now);
     }
-    // We don't have anything to do at this moment in time...
-    else
-      if ((!event_list_high
-           || (current_time < event_list_high->run_time))
-          && (!event_list_low
-              || (current_time < event_list_low->run_time))) {
-        logger(dbg_events, most)
-          << "No events to execute at the moment. Idling for a bit...";
-
-        // Check for external commands if we're supposed to check as
-        // often as possible.
-        if (config->command_check_interval() == -1) {
-          // Send data to event broker.
-          broker_external_command(
-            NEBTYPE_EXTERNALCOMMAND_CHECK,
-            NEBFLAG_NONE,
-            NEBATTR_NONE,
-            CMD_NONE,
-            time(NULL),
-            NULL,
-            NULL,
-            NULL);
-        }
+    if (!timeout)
+      continue;
+
+    timespec sleep_time;
+    sleep_time.tv_sec = timeout / 1000;
+    sleep_time.tv_nsec = (timeout % 1000) * 1000000l;
+
+    // Populate fake "sleep" event.
+    _sleep_event.run_time = current_time;
+    _sleep_event.event_data = (void*)&sleep_time;
+
+    // Send event data to broker.
+    broker_timed_event(
+      NEBTYPE_TIMEDEVENT_SLEEP,
+      NEBFLAG_NONE,
+      NEBATTR_NONE,
+      &_sleep_event,
+      NULL);
+
+    _wait(timeout);
+  }
+  return;
+}
 
-        // Set time to sleep so we don't hog the CPU...
-        timespec sleep_time;
-        sleep_time.tv_sec = (time_t)config->sleep_time();
-        sleep_time.tv_nsec
-          = (long)((config->sleep_time()
-                    - (double)sleep_time.tv_sec) * 1000000000ull);
-
-        // Populate fake "sleep" event.
-        _sleep_event.run_time = current_time;
-        _sleep_event.event_data = (void*)&sleep_time;
-
-        // Send event data to broker.
-        broker_timed_event(
-          NEBTYPE_TIMEDEVENT_SLEEP,
-          NEBFLAG_NONE,
-          NEBATTR_NONE,
-          &_sleep_event,
-          NULL);
-
-        // Wait a while so we don't hog the CPU...
-        concurrency::thread::nsleep(
-          (unsigned long)(config->sleep_time() * 1000000000l));
-      }
+/**
+ *  Wait until the timeout or a wake up.
+ *
+ *  @param[in] timeout  Maximum time to wait in milliseconds.
+ */
+void loop::_wait(unsigned long timeout) {
+  {
+    concurrency::locker lock(&_lock_wakeup);
+    // Producers check the flag after setting the wake up.
+    _waiting = 1;
+    __sync_synchronize();
+    if (!_wakeup)
+      _cv_wakeup.wait(&_lock_wakeup, timeout);
+    _waiting = 0;
   }
+  // Data pushed before the wake up is handled by the next iteration.
+  __sync_lock_release(&_wakeup);
   return;
 }
@@ -0,0 +1,149 @@
+/*
+** Copyright 2017 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include "com/centreon/engine/events/sorted_timed_event.hh"
+#include "com/centreon/engine/events/timed_event.hh"
+
+using namespace com::centreon::engine::events;
+
+/**
+ *  Default constructor.
+ */
+sorted_timed_event::sorted_timed_event() {}
+
+/**
+ *  Copy constructor
+ *
+ *  @param[in] right  The object to copy.
+ */
+sorted_timed_event::sorted_timed_event(sorted_timed_event const& right) {
+  _internal_copy(right);
+}
+
+/**
+ *  Destructor.
+ */
+sorted_timed_event::~sorted_timed_event() {}
+
+/**
+ *  Copy operator.
+ *
+ *  @param[in] right  The object to copy.
+ *
+ *  @return This object.
+ */
+sorted_timed_event& sorted_timed_event::operator=(
+                      sorted_timed_event const& right) {
+  return (_internal_copy(right));
+}
+
+/**
+ *  Clear index.
+ *
+ *  @param[in] p  The index priority to clear.
+ */
+void sorted_timed_event::clear(priority p) {
+  _events[p].clear();
+  _position[p].clear();
+  return ;
+}
+
+/**
+ *  Check if an index is empty.
+ *
+ *  @param[in] p  The index priority.
+ *
+ *  @return True if no event is indexed with this priority.
+ */
+bool sorted_timed_event::empty(priority p) const {
+  return (_events[p].empty());
+}
+
+/**
+ *  Remove timed event.
+ *
+ *  @param[in] p      The index priority.
+ *  @param[in] event  The event to remove.
+ */
+void sorted_timed_event::erase(priority p, timed_event* event) {
+  umap<timed_event*, event_map::iterator>::iterator
+    it(_position[p].find(event));
+  if (it == _position[p].end())
+    return ;
+  _events[p].erase(it->second);
+  _position[p].erase(it);
+  return ;
+}
+
+/**
+ *  Add timed event. The event is placed after all the events that
+ *  have the same execution time.
+ *
+ *  @param[in] p      The index priority.
+ *  @param[in] event  The event to add.
+ *
+ *  @return The event that precedes the new event, NULL if the new
+ *          event is the first one.
+ */
+timed_event* sorted_timed_event::insert(priority p, timed_event* event) {
+  if (!event)
+    return (NULL);
+  erase(p, event);
+  event_map::iterator
+    it(_events[p].insert(
+                    _events[p].upper_bound(event->run_time),
+                    std::make_pair(event->run_time, event)));
+  _position[p][event] = it;
+  if (it == _events[p].begin())
+    return (NULL);
+  return ((--it)->second);
+}
+
+/**
+ *  Get the number of indexed events.
+ *
+ *  @param[in] p  The index priority.
+ *
+ *  @return The number of events indexed with this priority.
+ */
+std::size_t sorted_timed_event::size(priority p) const {
+  return (_events[p].size());
+}
+
+/**
+ *  Internal copy.
+ *
+ *  @param[in] other  The object to copy.
+ *
+ *  @return This object.
+ */
+sorted_timed_event& sorted_timed_event::_internal_copy(
+                      sorted_timed_event const& other) {
+  if (this != &other)
+    for (int i(0); i < hash_timed_event::priority_num; ++i) {
+      _events[i] = other._events[i];
+      _position[i].clear();
+      for (event_map::iterator
+             it(_events[i].begin()), end(_events[i].end());
+           it != end;
+           ++it)
+        _position[i][it->second] = it;
+    }
+  return (*this);
+}
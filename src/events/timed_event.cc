@@ -23,6 +23,7 @@
 #include "com/centreon/engine/broker.hh"
 #include "com/centreon/engine/error.hh"
 #include "com/centreon/engine/events/defines.hh"
+#include "com/centreon/engine/events/sorted_timed_event.hh"
 #include "com/centreon/engine/events/timed_event.hh"
 #include "com/centreon/engine/globals.hh"
 #include "com/centreon/engine/logging/logger.hh"
@@ -173,7 +174,7 @@ static void _exec_event_retention_save(timed_event* event) {
     << "** Retention Data Save Event";
 
   // save state retention data.
-  retention::dump::save(config->state_retention_file());
+  retention::dump::save_snapshot(config->state_retention_file());
   return;
 }
 
@@ -355,6 +356,26 @@ static void _exec_event_user_function(timed_event* event) {
   return;
 }
 
+/**
+ *  Get the priority of a timed event list.
+ *
+ *  @param[in]  event_list  The head of the event list.
+ *  @param[out] p           The priority of the event list.
+ *
+ *  @return True if event_list is one of the global event lists.
+ */
+static bool _get_priority(
+              timed_event** event_list,
+              hash_timed_event::priority& p) {
+  if (event_list == &event_list_low)
+    p = hash_timed_event::low;
+  else if (event_list == &event_list_high)
+    p = hash_timed_event::high;
+  else
+    return (false);
+  return (true);
+}
+
 /**
  *  Add an event to list ordered by execution time.
  *
@@ -372,50 +393,46 @@ void add_event(
   event->next = NULL;
   event->prev = NULL;
 
-  if (event_list == &event_list_low)
-    quick_timed_event.insert(hash_timed_event::low, event);
-  else if (event_list == &event_list_high)
-    quick_timed_event.insert(hash_timed_event::high, event);
-
-  timed_event* first_event(*event_list);
-
-  // add the event to the head of the list if there are
-  // no other events.
-  if (!(*event_list)) {
-    *event_list = event;
-    *event_list_tail = event;
+  // find the event after which the new event must be placed.
+  timed_event* prev_event(NULL);
+  hash_timed_event::priority p;
+  if (_get_priority(event_list, p)) {
+    // the event list was reset without its indexes.
+    if (!(*event_list)) {
+      quick_timed_event.clear(p);
+      sorted_timed_events.clear(p);
+    }
+    quick_timed_event.insert(p, event);
+    prev_event = sorted_timed_events.insert(p, event);
+  }
+  else {
+    // start from the end of the list, as new events are likely to
+    // be executed in the future, rather than now...
+    for (prev_event = *event_list_tail;
+         prev_event && (event->run_time < prev_event->run_time);
+         prev_event = prev_event->prev)
+      ;
   }
 
-  // add event to head of the list if it should be executed first.
-  else if (event->run_time < first_event->run_time) {
-    event->prev = NULL;
-    (*event_list)->prev = event;
+  // add event to head of the list.
+  if (!prev_event) {
     event->next = *event_list;
+    if (*event_list)
+      (*event_list)->prev = event;
+    else
+      *event_list_tail = event;
     *event_list = event;
   }
 
-  // else place the event according to next execution time.
+  // else place the event after the previous one.
   else {
-    // start from the end of the list, as new events are likely to
-    // be executed in the future, rather than now...
-    for (timed_event* tmp(*event_list_tail); tmp; tmp = tmp->prev) {
-      if (event->run_time >= tmp->run_time) {
-        event->next = tmp->next;
-        event->prev = tmp;
-        tmp->next = event;
-        if (!event->next)
-          *event_list_tail = event;
-        else
-          event->next->prev = event;
-        break;
-      }
-      else if (!tmp->prev) {
-        tmp->prev = event;
-        event->next = tmp;
-        *event_list = event;
-        break;
-      }
-    }
+    event->prev = prev_event;
+    event->next = prev_event->next;
+    prev_event->next = event;
+    if (!event->next)
+      *event_list_tail = event;
+    else
+      event->next->prev = event;
   }
 
   // send event data to broker.
@@ -605,16 +622,12 @@ void compensate_for_system_time_change(
       last_time,
       current_time,
       time_difference,
-      &service_other_props[std::make_pair(
-                                  svc->host_ptr->name,
-                                  svc->description)].initial_notif_time);
+      &svc->other_props->initial_notif_time);
     adjust_timestamp_for_time_change(
       last_time,
       current_time,
       time_difference,
-      &service_other_props[std::make_pair(
-                                  svc->host_ptr->name,
-                                  svc->description)].last_acknowledgement);
+      &svc->other_props->last_acknowledgement);
 
     // recalculate next re-notification time.
     svc->next_notification
@@ -662,12 +675,12 @@ void compensate_for_system_time_change(
       last_time,
       current_time,
       time_difference,
-      &host_other_props[hst->name].initial_notif_time);
+      &hst->other_props->initial_notif_time);
     adjust_timestamp_for_time_change(
       last_time,
       current_time,
       time_difference,
-      &host_other_props[hst->name].last_acknowledgement);
+      &hst->other_props->last_acknowledgement);
 
     // recalculate next re-notification time.
     hst->next_host_notification
@@ -781,34 +794,29 @@ void remove_event(
   if (!(*event_list) || !event)
     return;
 
-  if (*event_list == event_list_low)
+  if (*event_list == event_list_low) {
     quick_timed_event.erase(hash_timed_event::low, event);
-  else if (*event_list == event_list_high)
+    sorted_timed_events.erase(hash_timed_event::low, event);
+  }
+  else if (*event_list == event_list_high) {
     quick_timed_event.erase(hash_timed_event::high, event);
-
-  if (*event_list == event) {
-    event->prev = NULL;
-    *event_list = event->next;
-    if (!(*event_list))
-      *event_list_tail = NULL;
-    else
-      (*event_list)->prev = NULL;
+    sorted_timed_events.erase(hash_timed_event::high, event);
   }
 
-  else {
-    for (timed_event* tmp(*event_list); tmp; tmp = tmp->next) {
-      if (tmp->next == event) {
-        tmp->next = tmp->next->next;
-        if (!tmp->next)
-          *event_list_tail = tmp;
-        else
-          tmp->next->prev = tmp;
-        event->next = NULL;
-        event->prev = NULL;
-        break;
-      }
-    }
-  }
+  // the event is not linked in this list.
+  if (!event->prev && (*event_list != event))
+    return;
+
+  if (event->prev)
+    event->prev->next = event->next;
+  else
+    *event_list = event->next;
+  if (event->next)
+    event->next->prev = event->prev;
+  else
+    *event_list_tail = event->prev;
+  event->next = NULL;
+  event->prev = NULL;
   return;
 }
 
@@ -867,12 +875,14 @@ void resort_event_list(
     << "resort_event_list()";
 
   // move current event list to temp list.
-  if (*event_list == event_list_low)
-    quick_timed_event.clear(hash_timed_event::low);
-  else if (*event_list == event_list_high)
-    quick_timed_event.clear(hash_timed_event::high);
+  hash_timed_event::priority p;
+  if (_get_priority(event_list, p)) {
+    quick_timed_event.clear(p);
+    sorted_timed_events.clear(p);
+  }
   timed_event* temp_event_list(*event_list);
   *event_list = NULL;
+  *event_list_tail = NULL;
 
   // move all events to the new event list.
   timed_event* next_event(NULL);
@@ -27,6 +27,7 @@ using namespace com::centreon::engine;
 
 configuration::state* config(NULL);
 events::hash_timed_event quick_timed_event;
+events::sorted_timed_event sorted_timed_events;
 std::map<std::string, host_other_properties> host_other_props;
 std::map<std::pair<std::string, std::string>, service_other_properties> service_other_props;
 std::map<std::string, contact_other_properties> contact_other_props;
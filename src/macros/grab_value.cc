@@ -22,6 +22,7 @@
 #include "com/centreon/engine/globals.hh"
 #include "com/centreon/engine/logging/logger.hh"
 #include "com/centreon/engine/macros/grab_value.hh"
+#include "com/centreon/engine/macros/summary.hh"
 #include "com/centreon/engine/macros.hh"
 #include "com/centreon/engine/string.hh"
 #include "com/centreon/unordered_hash.hh"
@@ -573,139 +574,50 @@ static int handle_summary_macro(
 
   // Generate summary macros if needed.
   if (!mac->x[MACRO_TOTALHOSTSUP]) {
+    // Objects being processed may not have their status updated yet.
+    macros::summary& totals(macros::summary::instance());
+    totals.update(mac->host_ptr);
+    totals.update(mac->service_ptr);
+
+    // Filter totals based on contact if necessary.
+    unsigned int const* value(totals.get(mac->contact_ptr).value);
+
     // Get host totals.
-    unsigned int host_problems(0);
-    unsigned int host_problems_unhandled(0);
-    unsigned int hosts_down(0);
-    unsigned int hosts_down_unhandled(0);
-    unsigned int hosts_unreachable(0);
-    unsigned int hosts_unreachable_unhandled(0);
-    unsigned int hosts_up(0);
-    for (host* temp_host = host_list;
-         temp_host != NULL;
-         temp_host = temp_host->next) {
-      // Filter totals based on contact if necessary.
-      bool authorized(
-             mac->contact_ptr
-             ? is_contact_for_host(temp_host, mac->contact_ptr)
-             : true);
-      if (authorized) {
-        bool problem(true);
-        if ((temp_host->current_state == HOST_UP)
-            && (temp_host->has_been_checked == true))
-          hosts_up++;
-        else if (temp_host->current_state == HOST_DOWN) {
-          if (temp_host->scheduled_downtime_depth > 0)
-            problem = false;
-          if (temp_host->problem_has_been_acknowledged == true)
-            problem = false;
-          if (temp_host->checks_enabled == false)
-            problem = false;
-          if (problem)
-            hosts_down_unhandled++;
-          hosts_down++;
-        }
-        else if (temp_host->current_state == HOST_UNREACHABLE) {
-          if (temp_host->scheduled_downtime_depth > 0)
-            problem = false;
-          if (temp_host->problem_has_been_acknowledged == true)
-            problem = false;
-          if (temp_host->checks_enabled == false)
-            problem = false;
-          if (problem)
-            hosts_down_unhandled++;
-          hosts_unreachable++;
-        }
-      }
-    }
-    host_problems = hosts_down + hosts_unreachable;
-    host_problems_unhandled
-      = hosts_down_unhandled + hosts_unreachable_unhandled;
+    unsigned int hosts_down(value[macros::summary::hosts_down]);
+    unsigned int hosts_down_unhandled(
+                   value[macros::summary::hosts_down_unhandled]);
+    unsigned int hosts_unreachable(
+                   value[macros::summary::hosts_unreachable]);
+    unsigned int hosts_unreachable_unhandled(
+                   value[macros::summary::hosts_unreachable_unhandled]);
+    unsigned int hosts_up(value[macros::summary::hosts_up]);
+    unsigned int host_problems(hosts_down + hosts_unreachable);
+    unsigned int host_problems_unhandled(
+                   hosts_down_unhandled + hosts_unreachable_unhandled);
 
     // Get service totals.
-    unsigned int service_problems(0);
-    unsigned int service_problems_unhandled(0);
-    unsigned int services_critical(0);
-    unsigned int services_critical_unhandled(0);
-    unsigned int services_ok(0);
-    unsigned int services_unknown(0);
-    unsigned int services_unknown_unhandled(0);
-    unsigned int services_warning(0);
-    unsigned int services_warning_unhandled(0);
-    for (service* temp_service = service_list;
-         temp_service != NULL;
-         temp_service = temp_service->next) {
-      // Filter totals based on contact if necessary.
-      bool authorized(
-             mac->contact_ptr
-             ? is_contact_for_service(
-                 temp_service,
-                 mac->contact_ptr)
-             : true);
-      if (authorized) {
-        bool problem(true);
-        if (temp_service->current_state == STATE_OK
-            && temp_service->has_been_checked == true)
-          services_ok++;
-        else if (temp_service->current_state == STATE_WARNING) {
-          host* temp_host(find_host(temp_service->host_name));
-          if (temp_host != NULL
-              && (temp_host->current_state == HOST_DOWN
-                  || temp_host->current_state == HOST_UNREACHABLE))
-            problem = false;
-          if (temp_service->scheduled_downtime_depth > 0)
-            problem = false;
-          if (temp_service->problem_has_been_acknowledged == true)
-            problem = false;
-          if (temp_service->checks_enabled == false)
-            problem = false;
-          if (problem)
-            services_warning_unhandled++;
-          services_warning++;
-        }
-        else if (temp_service->current_state == STATE_UNKNOWN) {
-          host* temp_host(find_host(temp_service->host_name));
-          if (temp_host != NULL
-              && (temp_host->current_state == HOST_DOWN
-                  || temp_host->current_state == HOST_UNREACHABLE))
-            problem = false;
-          if (temp_service->scheduled_downtime_depth > 0)
-            problem = false;
-          if (temp_service->problem_has_been_acknowledged == true)
-            problem = false;
-          if (temp_service->checks_enabled == false)
-            problem = false;
-          if (problem)
-            services_unknown_unhandled++;
-          services_unknown++;
-        }
-        else if (temp_service->current_state == STATE_CRITICAL) {
-          host* temp_host(find_host(temp_service->host_name));
-          if (temp_host != NULL
-              && (temp_host->current_state == HOST_DOWN
-                  || temp_host->current_state == HOST_UNREACHABLE))
-            problem = false;
-          if (temp_service->scheduled_downtime_depth > 0)
-            problem = false;
-          if (temp_service->problem_has_been_acknowledged == true)
-            problem = false;
-          if (temp_service->checks_enabled == false)
-            problem = false;
-          if (problem)
-            services_critical_unhandled++;
-          services_critical++;
-        }
-      }
-    }
-    service_problems
-      = services_warning + services_critical + services_unknown;
-    service_problems_unhandled
-      = services_warning_unhandled
-      + services_critical_unhandled
-      + services_unknown_unhandled;
-
-    // These macros are time-intensive to compute, and will likely be
-    // used together, so save them all for future use.
+    unsigned int services_critical(
+                   value[macros::summary::services_critical]);
+    unsigned int services_critical_unhandled(
+                   value[macros::summary::services_critical_unhandled]);
+    unsigned int services_ok(value[macros::summary::services_ok]);
+    unsigned int services_unknown(
+                   value[macros::summary::services_unknown]);
+    unsigned int services_unknown_unhandled(
+                   value[macros::summary::services_unknown_unhandled]);
+    unsigned int services_warning(
+                   value[macros::summary::services_warning]);
+    unsigned int services_warning_unhandled(
+                   value[macros::summary::services_warning_unhandled]);
+    unsigned int service_problems(
+                   services_warning + services_critical + services_unknown);
+    unsigned int service_problems_unhandled(
+                   services_warning_unhandled
+                   + services_critical_unhandled
+                   + services_unknown_unhandled);
+
+    // These macros will likely be used together, so save them all
+    // for future use.
     string::setstr(mac->x[MACRO_TOTALHOSTSUP], hosts_up);
     string::setstr(mac->x[MACRO_TOTALHOSTSDOWN], hosts_down);
     string::setstr(mac->x[MACRO_TOTALHOSTSUNREACHABLE], hosts_unreachable);
@@ -1071,17 +983,9 @@ int grab_macro_value_r(
                  free_macro);
 
       /* post-processing */
-      /* host/service output/perfdata and author/comment macros should get cleaned */
-      if ((x >= 16 && x <= 19) || (x >= 49 && x <= 52)
-          || (x >= 99 && x <= 100) || (x >= 124 && x <= 127)) {
-        *clean_options |= (STRIP_ILLEGAL_MACRO_CHARS | ESCAPE_MACRO_CHARS);
-        logger(dbg_macros, most)
-          << "  New clean options: " << *clean_options;
-      }
-      /* url macros should get cleaned */
-      if ((x >= 125 && x <= 126) || (x >= 128 && x <= 129)
-          || (x >= 77 && x <= 78) || (x >= 74 && x <= 75)) {
-        *clean_options |= URL_ENCODE_MACRO_CHARS;
+      int macro_clean_options(get_macrox_clean_options(x));
+      if (macro_clean_options) {
+        *clean_options |= macro_clean_options;
         logger(dbg_macros, most)
           << "  New clean options: " << *clean_options;
       }
@@ -1281,6 +1185,27 @@ int grab_macrox_value_r(
   return (retval);
 }
 
+/**
+ *  Get the clean options that always apply to an x macro.
+ *
+ *  @param[in] macro_type Macro index.
+ *
+ *  @return Clean options of the macro, 0 if its value is not cleaned.
+ */
+int get_macrox_clean_options(int macro_type) {
+  int x(macro_type);
+  int clean_options(0);
+  /* host/service output/perfdata and author/comment macros should get cleaned */
+  if ((x >= 16 && x <= 19) || (x >= 49 && x <= 52)
+      || (x >= 99 && x <= 100) || (x >= 124 && x <= 127))
+    clean_options |= (STRIP_ILLEGAL_MACRO_CHARS | ESCAPE_MACRO_CHARS);
+  /* url macros should get cleaned */
+  if ((x >= 125 && x <= 126) || (x >= 128 && x <= 129)
+      || (x >= 77 && x <= 78) || (x >= 74 && x <= 75))
+    clean_options |= URL_ENCODE_MACRO_CHARS;
+  return (clean_options);
+}
+
 /**
  *  Grab a global macro value.
  *
@@ -0,0 +1,297 @@
+/*
+** Copyright 2017 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstdlib>
+#include <cstring>
+#include "com/centreon/engine/globals.hh"
+#include "com/centreon/engine/macros.hh"
+#include "com/centreon/engine/macros/plan.hh"
+
+using namespace com::centreon::engine;
+using namespace com::centreon::engine::macros;
+
+/**************************************
+*                                     *
+*           Public Methods            *
+*                                     *
+**************************************/
+
+/**
+ *  Default constructor, the plan is empty.
+ */
+plan::plan() : _text_size(0) {}
+
+/**
+ *  Constructor.
+ *
+ *  @param[in] text  Text to compile.
+ */
+plan::plan(std::string const& text) : _text_size(0) {
+  compile(text);
+}
+
+/**
+ *  Copy constructor.
+ *
+ *  @param[in] right  Object to copy.
+ */
+plan::plan(plan const& right) {
+  _internal_copy(right);
+}
+
+/**
+ *  Destructor.
+ */
+plan::~plan() throw () {}
+
+/**
+ *  Assignment operator.
+ *
+ *  @param[in] right  Object to copy.
+ *
+ *  @return This object.
+ */
+plan& plan::operator=(plan const& right) {
+  if (this != &right)
+    _internal_copy(right);
+  return (*this);
+}
+
+/**
+ *  Compile a text, replacing the current plan.
+ *
+ *  @param[in] text  Text with macros, as given to process_macros_r().
+ */
+void plan::compile(std::string const& text) {
+  _tokens.clear();
+  _text_size = 0;
+
+  // Text is split on '$', parts are alternatively plain text and
+  // macro names. A last macro without its closing '$' is still a macro.
+  bool in_macro(false);
+  std::size_t pos(0);
+  for (;;) {
+    std::size_t delim(text.find('$', pos));
+    std::string part(
+                  text,
+                  pos,
+                  (delim == std::string::npos)
+                  ? std::string::npos
+                  : delim - pos);
+
+    // Plain text, merged with the previous plain text.
+    // An escaped '$' is done by specifying two '$' next to each other.
+    if (!in_macro || part.empty()) {
+      if (in_macro)
+        part = "$";
+      if (!part.empty()) {
+        if (_tokens.empty() || (_tokens.back().type != token_text)) {
+          token t;
+          t.clean_options = 0;
+          t.has_arg1 = false;
+          t.has_arg2 = false;
+          t.index = -1;
+          t.type = token_text;
+          _tokens.push_back(t);
+        }
+        _tokens.back().value.append(part);
+        _text_size += part.size();
+      }
+    }
+    // Macro.
+    else {
+      token t;
+      t.clean_options = 0;
+      t.has_arg1 = false;
+      t.has_arg2 = false;
+      t.index = -1;
+      t.type = token_macro;
+      t.value = part;
+
+      // On-demand macros have one or two arguments.
+      std::size_t colon(part.find(':'));
+      std::string name(part, 0, colon);
+      if (colon != std::string::npos) {
+        std::size_t second(part.find(':', colon + 1));
+        t.has_arg1 = true;
+        t.arg1.assign(
+                 part,
+                 colon + 1,
+                 (second == std::string::npos)
+                 ? std::string::npos
+                 : second - colon - 1);
+        if (second != std::string::npos) {
+          t.has_arg2 = true;
+          t.arg2.assign(part, second + 1, std::string::npos);
+        }
+      }
+
+      // Standard, argument and user macros are resolved now, others
+      // when processed.
+      for (unsigned int x(0); x < MACRO_X_COUNT; ++x)
+        if (macro_x_names[x] && (name == macro_x_names[x])) {
+          t.clean_options = get_macrox_clean_options(x);
+          t.index = x;
+          t.type = token_macrox;
+          break;
+        }
+      if (t.type == token_macrox)
+        ;
+      else if (!name.compare(0, 3, "ARG")) {
+        t.index = atoi(name.c_str() + 3) - 1;
+        t.type = token_argv;
+      }
+      else if (!name.compare(0, 4, "USER")) {
+        t.index = atoi(name.c_str() + 4) - 1;
+        t.type = token_user;
+      }
+
+      // Invalid arguments or user macros expand to nothing.
+      if (((t.type == token_argv)
+           && ((t.index < 0) || (t.index >= MAX_COMMAND_ARGUMENTS)))
+          || ((t.type == token_user)
+              && ((t.index < 0) || (t.index >= MAX_USER_MACROS))))
+        ;
+      else
+        _tokens.push_back(t);
+    }
+
+    if (delim == std::string::npos)
+      break;
+    pos = delim + 1;
+    in_macro = !in_macro;
+  }
+  return ;
+}
+
+/**
+ *  Check if the plan is empty.
+ *
+ *  @return True if the compiled text was empty.
+ */
+bool plan::empty() const throw () {
+  return (_tokens.empty());
+}
+
+/**
+ *  Process the plan.
+ *
+ *  @param[in]  mac      Macros used to get values.
+ *  @param[out] output   Processed text.
+ *  @param[in]  options  Macro clean options.
+ */
+void plan::process(
+             nagios_macros* mac,
+             std::string& output,
+             int options) const {
+  output.clear();
+  output.reserve(_text_size + 64 * _tokens.size());
+  for (std::vector<token>::const_iterator
+         it(_tokens.begin()), end(_tokens.end());
+       it != end;
+       ++it) {
+    if (it->type == token_text) {
+      output.append(it->value);
+      continue ;
+    }
+    else if (it->type == token_argv) {
+      if (mac->argv[it->index])
+        _append(output, mac->argv[it->index], false, options);
+      continue ;
+    }
+    else if (it->type == token_user) {
+      if (macro_user[it->index])
+        _append(output, macro_user[it->index], false, options);
+      continue ;
+    }
+
+    char* value(NULL);
+    int clean_options(it->clean_options);
+    int free_value(true);
+    int result;
+    if (it->type == token_macrox)
+      result = grab_macrox_value_r(
+                 mac,
+                 it->index,
+                 it->has_arg1 ? it->arg1.c_str() : NULL,
+                 it->has_arg2 ? it->arg2.c_str() : NULL,
+                 &value,
+                 &free_value);
+    else
+      result = grab_macro_value_r(
+                 mac,
+                 const_cast<char*>(it->value.c_str()),
+                 &value,
+                 &clean_options,
+                 &free_value);
+    if ((result == ERROR) && free_value) {
+      delete[] value;
+      value = NULL;
+    }
+    if (value)
+      _append(output, value, free_value, options | clean_options);
+  }
+  return ;
+}
+
+/**************************************
+*                                     *
+*           Private Methods           *
+*                                     *
+**************************************/
+
+/**
+ *  Append a macro value to the output.
+ *
+ *  @param[out] output      Processed text.
+ *  @param[in]  value       Macro value, cleaned in place if necessary.
+ *  @param[in]  free_value  True if value must be freed.
+ *  @param[in]  options     Clean options of the value.
+ */
+void plan::_append(
+             std::string& output,
+             char* value,
+             bool free_value,
+             int options) {
+  if (options & URL_ENCODE_MACRO_CHARS) {
+    char* encoded(get_url_encoded_string(value));
+    if (free_value)
+      delete[] value;
+    value = encoded;
+    free_value = true;
+  }
+  if (options & (STRIP_ILLEGAL_MACRO_CHARS | ESCAPE_MACRO_CHARS))
+    output.append(clean_macro_chars(value, options));
+  else
+    output.append(value);
+  if (free_value)
+    delete[] value;
+  return ;
+}
+
+/**
+ *  Copy internal data members.
+ *
+ *  @param[in] right  Object to copy.
+ */
+void plan::_internal_copy(plan const& right) {
+  _text_size = right._text_size;
+  _tokens = right._tokens;
+  return ;
+}
@@ -0,0 +1,320 @@
+/*
+** Copyright 2017 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include "com/centreon/engine/configuration/applier/state.hh"
+#include "com/centreon/engine/globals.hh"
+#include "com/centreon/engine/macros/summary.hh"
+#include "com/centreon/engine/objects/contactgroup.hh"
+#include "com/centreon/engine/objects/contactgroupsmember.hh"
+#include "com/centreon/engine/objects/contactsmember.hh"
+#include "com/centreon/engine/objects/servicesmember.hh"
+
+using namespace com::centreon::engine;
+using namespace com::centreon::engine::macros;
+
+// Class instance.
+static summary* _instance = NULL;
+
+/**************************************
+*                                     *
+*           Public Methods            *
+*                                     *
+**************************************/
+
+/**
+ *  Constructor, all totals are zero.
+ */
+summary::counters::counters() {
+  for (unsigned int i(0); i < counter_num; ++i)
+    value[i] = 0;
+}
+
+/**
+ *  Get totals.
+ *
+ *  @param[in] cntct  If not NULL, only count objects this contact is
+ *                    a contact for.
+ *
+ *  @return Totals.
+ */
+summary::counters const& summary::get(contact* cntct) {
+  if (_generation
+      != configuration::applier::state::instance().generation())
+    _rebuild();
+  if (!cntct)
+    return (_totals);
+  return (_contact_totals[cntct]);
+}
+
+/**
+ *  Get instance of the summary singleton.
+ *
+ *  @return This singleton.
+ */
+summary& summary::instance() {
+  return (*_instance);
+}
+
+/**
+ *  Load singleton.
+ */
+void summary::load() {
+  if (!_instance)
+    _instance = new summary;
+  return;
+}
+
+/**
+ *  Unload singleton.
+ */
+void summary::unload() {
+  delete _instance;
+  _instance = NULL;
+  return;
+}
+
+/**
+ *  Update totals with the current status of a host and of its
+ *  services.
+ *
+ *  @param[in] hst  The host.
+ */
+void summary::update(host* hst) {
+  // Objects will be counted by the next rebuild.
+  if (!hst
+      || (_generation
+          != configuration::applier::state::instance().generation()))
+    return;
+
+  category& cat(_hosts[hst]);
+  category new_cat(_host_category(hst));
+  if (cat != new_cat) {
+    _count(cat, new_cat, hst->contacts, hst->contact_groups);
+    cat = new_cat;
+
+    // Services problems are not unhandled when their host is down.
+    for (servicesmember* member(hst->services);
+         member;
+         member = member->next)
+      update(member->service_ptr);
+  }
+  return;
+}
+
+/**
+ *  Update totals with the current status of a service.
+ *
+ *  @param[in] svc  The service.
+ */
+void summary::update(service* svc) {
+  // Objects will be counted by the next rebuild.
+  if (!svc
+      || (_generation
+          != configuration::applier::state::instance().generation()))
+    return;
+
+  category& cat(_services[svc]);
+  category new_cat(_service_category(svc));
+  if (cat != new_cat) {
+    _count(cat, new_cat, svc->contacts, svc->contact_groups);
+    cat = new_cat;
+  }
+  return;
+}
+
+/**************************************
+*                                     *
+*           Private Methods           *
+*                                     *
+**************************************/
+
+/**
+ *  Default constructor.
+ */
+summary::summary()
+  : _generation(static_cast<unsigned int>(-1)) {}
+
+/**
+ *  Destructor.
+ */
+summary::~summary() throw () {}
+
+/**
+ *  Add or remove an object category from totals.
+ *
+ *  @param[out] c      Totals.
+ *  @param[in]  cat    Object category.
+ *  @param[in]  delta  1 to add the object, -1 to remove it.
+ */
+void summary::_add(counters& c, category cat, int delta) {
+  switch (cat) {
+  case host_up:
+    c.value[hosts_up] += delta;
+    break;
+  case host_down_unhandled:
+    c.value[hosts_down_unhandled] += delta;
+    // Fall through.
+  case host_down:
+    c.value[hosts_down] += delta;
+    break;
+  case host_unreachable_unhandled:
+    c.value[hosts_unreachable_unhandled] += delta;
+    // Fall through.
+  case host_unreachable:
+    c.value[hosts_unreachable] += delta;
+    break;
+  case service_ok:
+    c.value[services_ok] += delta;
+    break;
+  case service_warning_unhandled:
+    c.value[services_warning_unhandled] += delta;
+    // Fall through.
+  case service_warning:
+    c.value[services_warning] += delta;
+    break;
+  case service_critical_unhandled:
+    c.value[services_critical_unhandled] += delta;
+    // Fall through.
+  case service_critical:
+    c.value[services_critical] += delta;
+    break;
+  case service_unknown_unhandled:
+    c.value[services_unknown_unhandled] += delta;
+    // Fall through.
+  case service_unknown:
+    c.value[services_unknown] += delta;
+    break;
+  default:
+    break;
+  }
+  return;
+}
+
+/**
+ *  Move an object from a category to another in global totals and in
+ *  totals of its contacts.
+ *
+ *  @param[in] old_cat   Previous object category.
+ *  @param[in] new_cat   New object category.
+ *  @param[in] contacts  Object contacts.
+ *  @param[in] groups    Object contact groups.
+ */
+void summary::_count(
+                category old_cat,
+                category new_cat,
+                contactsmember* contacts,
+                contactgroupsmember* groups) {
+  _add(_totals, old_cat, -1);
+  _add(_totals, new_cat, 1);
+
+  // A contact can be both a direct contact and a group member.
+  _contacts.clear();
+  for (contactsmember* member(contacts); member; member = member->next)
+    _contacts.push_back(member->contact_ptr);
+  for (contactgroupsmember* group(groups); group; group = group->next)
+    if (group->group_ptr)
+      for (contactsmember* member(group->group_ptr->members);
+           member;
+           member = member->next)
+        _contacts.push_back(member->contact_ptr);
+  std::sort(_contacts.begin(), _contacts.end());
+  _contacts.erase(
+    std::unique(_contacts.begin(), _contacts.end()),
+    _contacts.end());
+
+  for (std::vector<contact*>::const_iterator
+         it(_contacts.begin()), end(_contacts.end());
+       it != end;
+       ++it)
+    if (*it) {
+      counters& c(_contact_totals[*it]);
+      _add(c, old_cat, -1);
+      _add(c, new_cat, 1);
+    }
+  return;
+}
+
+/**
+ *  Get the category of a host.
+ *
+ *  @param[in] hst  The host.
+ *
+ *  @return Host category.
+ */
+summary::category summary::_host_category(host const* hst) {
+  bool unhandled(!hst->scheduled_downtime_depth
+                 && !hst->problem_has_been_acknowledged
+                 && hst->checks_enabled);
+  if (hst->current_state == HOST_UP)
+    return (hst->has_been_checked ? host_up : none);
+  else if (hst->current_state == HOST_DOWN)
+    return (unhandled ? host_down_unhandled : host_down);
+  else if (hst->current_state == HOST_UNREACHABLE)
+    return (unhandled ? host_unreachable_unhandled : host_unreachable);
+  return (none);
+}
+
+/**
+ *  Count all objects again.
+ */
+void summary::_rebuild() {
+  _contact_totals.clear();
+  _hosts.clear();
+  _services.clear();
+  _totals = counters();
+  _generation = configuration::applier::state::instance().generation();
+  for (host* hst(host_list); hst; hst = hst->next) {
+    category cat(_host_category(hst));
+    _hosts[hst] = cat;
+    _count(none, cat, hst->contacts, hst->contact_groups);
+  }
+  for (service* svc(service_list); svc; svc = svc->next) {
+    category cat(_service_category(svc));
+    _services[svc] = cat;
+    _count(none, cat, svc->contacts, svc->contact_groups);
+  }
+  return;
+}
+
+/**
+ *  Get the category of a service.
+ *
+ *  @param[in] svc  The service.
+ *
+ *  @return Service category.
+ */
+summary::category summary::_service_category(service const* svc) {
+  bool unhandled(!svc->scheduled_downtime_depth
+                 && !svc->problem_has_been_acknowledged
+                 && svc->checks_enabled
+                 && (!svc->host_ptr
+                     || ((svc->host_ptr->current_state != HOST_DOWN)
+                         && (svc->host_ptr->current_state
+                             != HOST_UNREACHABLE))));
+  if (svc->current_state == STATE_OK)
+    return (svc->has_been_checked ? service_ok : none);
+  else if (svc->current_state == STATE_WARNING)
+    return (unhandled ? service_warning_unhandled : service_warning);
+  else if (svc->current_state == STATE_CRITICAL)
+    return (unhandled ? service_critical_unhandled : service_critical);
+  else if (svc->current_state == STATE_UNKNOWN)
+    return (unhandled ? service_unknown_unhandled : service_unknown);
+  return (none);
+}
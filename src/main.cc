@@ -40,6 +40,7 @@
 #include "com/centreon/engine/broker/loader.hh"
 #include "com/centreon/engine/checks/checker.hh"
 #include "com/centreon/engine/commands/set.hh"
+#include "com/centreon/engine/commands/system_runner.hh"
 #include "com/centreon/engine/config.hh"
 #include "com/centreon/engine/configuration/applier/state.hh"
 #include "com/centreon/engine/configuration/parser.hh"
@@ -52,6 +53,7 @@
 #include "com/centreon/engine/logging/broker.hh"
 #include "com/centreon/engine/logging/logger.hh"
 #include "com/centreon/engine/macros/misc.hh"
+#include "com/centreon/engine/macros/summary.hh"
 #include "com/centreon/engine/nebmods.hh"
 #include "com/centreon/engine/notifications.hh"
 #include "com/centreon/engine/objects/comment.hh"
@@ -60,6 +62,7 @@
 #include "com/centreon/engine/retention/dump.hh"
 #include "com/centreon/engine/retention/parser.hh"
 #include "com/centreon/engine/retention/state.hh"
+#include "com/centreon/engine/snapshot_writer.hh"
 #include "com/centreon/engine/statusdata.hh"
 #include "com/centreon/engine/string.hh"
 #include "com/centreon/engine/timezone_manager.hh"
@@ -115,6 +118,9 @@ int main(int argc, char* argv[]) {
   com::centreon::engine::commands::set::load();
   com::centreon::engine::configuration::applier::state::load();
   com::centreon::engine::checks::checker::load();
+  com::centreon::engine::commands::system_runner::load();
+  com::centreon::engine::macros::summary::load();
+  com::centreon::engine::snapshot_writer::load();
   com::centreon::engine::events::loop::load();
   com::centreon::engine::broker::loader::load();
   com::centreon::engine::broker::compatibility::load();
@@ -464,12 +470,15 @@ int main(int argc, char* argv[]) {
   }
 
   // Unload singletons and global objects.
-  com::centreon::engine::events::loop::unload();
+  com::centreon::engine::snapshot_writer::unload();
+  com::centreon::engine::macros::summary::unload();
+  com::centreon::engine::commands::system_runner::unload();
   com::centreon::engine::broker::compatibility::unload();
   com::centreon::engine::broker::loader::unload();
   com::centreon::engine::configuration::applier::state::unload();
   com::centreon::engine::commands::set::unload();
   com::centreon::engine::checks::checker::unload();
+  com::centreon::engine::events::loop::unload();
   delete config;
   config = NULL;
   com::centreon::engine::timezone_manager::unload();
@@ -20,6 +20,7 @@
 */
 
 #include "com/centreon/engine/broker.hh"
+#include "com/centreon/engine/commands/system_runner.hh"
 #include "com/centreon/engine/configuration/applier/state.hh"
 #include "com/centreon/engine/globals.hh"
 #include "com/centreon/engine/logging/logger.hh"
@@ -30,8 +31,8 @@
 #include "com/centreon/engine/statusdata.hh"
 #include "com/centreon/engine/string.hh"
 #include "com/centreon/engine/timeperiod.hh"
-#include "com/centreon/engine/timezone_locker.hh"
 #include "com/centreon/engine/utils.hh"
+#include "find.hh"
 
 using namespace com::centreon;
 using namespace com::centreon::engine;
@@ -61,6 +62,107 @@ static char const* tab_service_state_str[] = {
   "CRITICAL"
 };
 
+/**
+ *  Send the notification method end event to the broker once the
+ *  notification command is over. Objects are looked up again because
+ *  they might have been removed in the meantime.
+ */
+class                notification_method_end
+  : public commands::system_runner::callback {
+public:
+                     notification_method_end(
+                       unsigned int notification_type,
+                       int reason_type,
+                       timeval const& start_time,
+                       char const* host_name,
+                       char const* service_description,
+                       char const* contact_name,
+                       char const* command,
+                       char const* not_author,
+                       char const* not_data,
+                       int escalated,
+                       char const* processed_command)
+    : _command(command ? command : ""),
+      _contact_name(contact_name ? contact_name : ""),
+      _escalated(escalated),
+      _has_not_author(not_author != NULL),
+      _has_not_data(not_data != NULL),
+      _host_name(host_name ? host_name : ""),
+      _not_author(not_author ? not_author : ""),
+      _not_data(not_data ? not_data : ""),
+      _notification_type(notification_type),
+      _processed_command(processed_command),
+      _reason_type(reason_type),
+      _service_description(
+        service_description ? service_description : ""),
+      _start_time(start_time) {}
+                     ~notification_method_end() throw () {}
+
+  void               finished(commands::result const& res) throw () {
+    /* check to see if the notification command timed out */
+    if (res.exit_status == process::timeout) {
+      bool is_service(_notification_type == SERVICE_NOTIFICATION);
+      logger((is_service
+              ? log_service_notification
+              : log_host_notification) | log_runtime_warning, basic)
+        << "Warning: Contact '" << _contact_name << "' "
+        << (is_service ? "service" : "host")
+        << " notification command '" << _processed_command
+        << "' timed out after " << config->notification_timeout()
+        << " seconds";
+    }
+
+    /* get end time */
+    timeval end_time;
+    gettimeofday(&end_time, NULL);
+
+    /* find the objects */
+    contact* cntct(find_contact(_contact_name.c_str()));
+    void* data(NULL);
+    if (_notification_type == SERVICE_NOTIFICATION)
+      data = find_service(
+               _host_name.c_str(),
+               _service_description.c_str());
+    else
+      data = find_host(_host_name.c_str());
+    if (!cntct || !data)
+      return;
+
+    /* send data to event broker */
+    broker_contact_notification_method_data(
+      NEBTYPE_CONTACTNOTIFICATIONMETHOD_END,
+      NEBFLAG_NONE,
+      NEBATTR_NONE,
+      _notification_type,
+      _reason_type,
+      _start_time,
+      end_time,
+      data,
+      cntct,
+      _command.c_str(),
+      _has_not_author ? const_cast<char*>(_not_author.c_str()) : NULL,
+      _has_not_data ? const_cast<char*>(_not_data.c_str()) : NULL,
+      _escalated,
+      NULL);
+    return;
+  }
+
+private:
+  std::string        _command;
+  std::string        _contact_name;
+  int                _escalated;
+  bool               _has_not_author;
+  bool               _has_not_data;
+  std::string        _host_name;
+  std::string        _not_author;
+  std::string        _not_data;
+  unsigned int       _notification_type;
+  std::string        _processed_command;
+  int                _reason_type;
+  std::string        _service_description;
+  timeval            _start_time;
+};
+
 /******************************************************************/
 /***************** SERVICE NOTIFICATION FUNCTIONS *****************/
 /******************************************************************/
@@ -363,9 +465,7 @@ int service_notification(
 
   /* Update recovery been sent parameter */
   if (svc->current_state == STATE_OK)
-    service_other_props[std::make_pair(
-                        svc->host_ptr->name,
-                        svc->description)].recovery_been_sent = true;
+    svc->other_props->recovery_been_sent = true;
 
   return (OK);
 }
@@ -416,10 +516,11 @@ int check_service_notification_viability(
 
   // See if the service can have notifications sent out at this time.
   {
-    timezone_locker lock(get_service_timezone(
-                           svc->host_name,
-                           svc->description));
-    if (check_time_against_period(current_time, temp_period) == ERROR) {
+    char const* tz(get_service_timezone(svc));
+    if (check_time_against_period_for_timezone(
+          current_time,
+          temp_period,
+          tz) == ERROR) {
       logger(dbg_notifications, more)
         << "This service shouldn't have notifications sent out "
         "at this time.";
@@ -427,10 +528,11 @@ int check_service_notification_viability(
       // Calculate the next acceptable notification time,
       // once the next valid time range arrives...
       if (type == NOTIFICATION_NORMAL) {
-        get_next_valid_time(
+        get_next_valid_time_for_timezone(
           current_time,
           &timeperiod_start,
-          svc->notification_period_ptr);
+          svc->notification_period_ptr,
+          tz);
 
         // Looks like there are no valid notification times defined, so
         // schedule the next one far into the future (one year)...
@@ -630,15 +732,11 @@ int check_service_notification_viability(
   if (type == NOTIFICATION_NORMAL
       && (svc->current_notification_number == 0
           || (svc->current_state == STATE_OK
-                && !service_other_props[std::make_pair(
-                    svc->host_ptr->name,
-                    svc->description)].recovery_been_sent))) {
+                && !svc->other_props->recovery_been_sent))) {
 
     /* get the time at which a notification should have been sent */
     time_t& initial_notif_time(
-              service_other_props[std::make_pair(
-                                         svc->host_ptr->name,
-                                         svc->description)].initial_notif_time);
+              svc->other_props->initial_notif_time);
 
     /* if not set, set it to now */
     if (!initial_notif_time)
@@ -646,9 +744,7 @@ int check_service_notification_viability(
 
     double notification_delay = (svc->current_state != STATE_OK ?
              svc->first_notification_delay
-             : service_other_props[std::make_pair(
-                 svc->host_ptr->name,
-                 svc->description)].recovery_notification_delay)
+             : svc->other_props->recovery_notification_delay)
         * config->interval_length();
 
     if (current_time
@@ -756,15 +852,13 @@ int check_contact_service_notification_viability(
   }
 
   // See if the contact can be notified at this time.
-  {
-    timezone_locker lock(get_contact_timezone(cntct->name));
-    if (check_time_against_period(
-          time(NULL),
-          cntct->service_notification_period_ptr) == ERROR) {
-      logger(dbg_notifications, most)
-        << "This contact shouldn't be notified at this time.";
-      return (ERROR);
-    }
+  if (check_time_against_period_for_timezone(
+        time(NULL),
+        cntct->service_notification_period_ptr,
+        get_contact_timezone(cntct->name)) == ERROR) {
+    logger(dbg_notifications, most)
+      << "This contact shouldn't be notified at this time.";
+    return (ERROR);
   }
 
   /*********************************************/
@@ -883,8 +977,6 @@ int notify_contact_of_service(
   char* command_name_ptr = NULL;
   char* raw_command = NULL;
   char* processed_command = NULL;
-  int early_timeout = false;
-  double exectime;
   struct timeval start_time, end_time;
   struct timeval method_start_time, method_end_time;
   int macro_options = STRIP_ILLEGAL_MACRO_CHARS | ESCAPE_MACRO_CHARS;
@@ -1036,54 +1128,28 @@ int notify_contact_of_service(
     }
 
     /* run the notification command */
-    try {
-      my_system_r(
-        mac,
-        processed_command,
-        config->notification_timeout(),
-        &early_timeout,
-        &exectime,
-        NULL,
-        0);
-    } catch (std::exception const& e) {
-      logger(log_runtime_error, basic)
-        << "Error: can't execute service notification '"
-        << cntct->name << "' : " << e.what();
-    }
-
-    /* check to see if the notification command timed out */
-    if (early_timeout == true) {
-      logger(log_service_notification | log_runtime_warning, basic)
-        << "Warning: Contact '" << cntct->name
-        << "' service notification command '" << processed_command
-        << "' timed out after " << config->notification_timeout()
-        << " seconds";
-    }
+    commands::system_runner::instance().run(
+      commands::system_runner::notification,
+      processed_command,
+      *mac,
+      config->notification_timeout(),
+      new notification_method_end(
+            SERVICE_NOTIFICATION,
+            type,
+            method_start_time,
+            svc->host_name,
+            svc->description,
+            cntct->name,
+            temp_commandsmember->cmd,
+            not_author,
+            not_data,
+            escalated,
+            processed_command));
 
     /* free memory */
     delete[] command_name;
     delete[] raw_command;
     delete[] processed_command;
-
-    /* get end time */
-    gettimeofday(&method_end_time, NULL);
-
-    /* send data to event broker */
-    broker_contact_notification_method_data(
-      NEBTYPE_CONTACTNOTIFICATIONMETHOD_END,
-      NEBFLAG_NONE,
-      NEBATTR_NONE,
-      SERVICE_NOTIFICATION,
-      type,
-      method_start_time,
-      method_end_time,
-      (void*)svc,
-      cntct,
-      temp_commandsmember->cmd,
-      not_author,
-      not_data,
-      escalated,
-      NULL);
   }
 
   /* get end time */
@@ -1637,7 +1703,7 @@ int host_notification(
 
   /* Update recovery been sent parameter */
   if (hst->current_state == HOST_UP)
-    host_other_props[hst->name].recovery_been_sent = true;
+    hst->other_props->recovery_been_sent = true;
 
   return (OK);
 }
@@ -1673,10 +1739,11 @@ int check_host_notification_viability(
 
   // See if the host can have notifications sent out at this time.
   {
-    timezone_locker lock(get_host_timezone(hst->name));
-    if (check_time_against_period(
+    char const* tz(get_host_timezone(hst));
+    if (check_time_against_period_for_timezone(
           current_time,
-          hst->notification_period_ptr) == ERROR) {
+          hst->notification_period_ptr,
+          tz) == ERROR) {
       logger(dbg_notifications, more)
         << "This host shouldn't have notifications sent out at "
            "this time.";
@@ -1684,10 +1751,11 @@ int check_host_notification_viability(
       // If this is a normal notification, calculate the next acceptable
       // notification time, once the next valid time range arrives...
       if (type == NOTIFICATION_NORMAL) {
-        get_next_valid_time(
+        get_next_valid_time_for_timezone(
           current_time,
           &timeperiod_start,
-          hst->notification_period_ptr);
+          hst->notification_period_ptr,
+          tz);
 
         // It looks like there is no notification time defined, so
         // schedule next one far into the future (one year)...
@@ -1866,10 +1934,10 @@ int check_host_notification_viability(
   if (type == NOTIFICATION_NORMAL
       && (hst->current_notification_number == 0
          || (hst->current_state == HOST_UP &&
-             !host_other_props[std::string(hst->name)].recovery_been_sent))) {
+             !hst->other_props->recovery_been_sent))) {
 
     /* get the time at which a notification should have been sent */
-    time_t& initial_notif_time(host_other_props[hst->name].initial_notif_time);
+    time_t& initial_notif_time(hst->other_props->initial_notif_time);
 
     /* if not set, set it to now */
     if (!initial_notif_time)
@@ -1877,7 +1945,7 @@ int check_host_notification_viability(
 
     double notification_delay = (hst->current_state != HOST_UP ?
              hst->first_notification_delay
-             : host_other_props[std::string(hst->name)].recovery_notification_delay)
+             : hst->other_props->recovery_notification_delay)
         * config->interval_length();
 
     if (current_time
@@ -1966,15 +2034,13 @@ int check_contact_host_notification_viability(
   }
 
   // See if the contact can be notified at this time.
-  {
-    timezone_locker lock(get_contact_timezone(cntct->name));
-    if (check_time_against_period(
-          time(NULL),
-          cntct->host_notification_period_ptr) == ERROR) {
-      logger(dbg_notifications, most)
-        << "This contact shouldn't be notified at this time.";
-      return (ERROR);
-    }
+  if (check_time_against_period_for_timezone(
+        time(NULL),
+        cntct->host_notification_period_ptr,
+        get_contact_timezone(cntct->name)) == ERROR) {
+    logger(dbg_notifications, most)
+      << "This contact shouldn't be notified at this time.";
+    return (ERROR);
   }
 
   /*********************************************/
@@ -2081,8 +2147,6 @@ int notify_contact_of_host(
   char* command_name_ptr = NULL;
   char* raw_command = NULL;
   char* processed_command = NULL;
-  int early_timeout = false;
-  double exectime;
   struct timeval start_time;
   struct timeval end_time;
   struct timeval method_start_time;
@@ -2235,54 +2299,28 @@ int notify_contact_of_host(
     }
 
     /* run the notification command */
-    try {
-      my_system_r(
-        mac,
-        processed_command,
-        config->notification_timeout(),
-        &early_timeout,
-        &exectime,
-        NULL,
-        0);
-    } catch (std::exception const& e) {
-      logger(log_runtime_error, basic)
-        << "Error: can't execute host notification '"
-        << cntct->name << "' : " << e.what();
-    }
-
-    /* check to see if the notification timed out */
-    if (early_timeout == true) {
-      logger(log_host_notification | log_runtime_warning, basic)
-        << "Warning: Contact '" << cntct->name
-        << "' host notification command '" << processed_command
-        << "' timed out after " << config->notification_timeout()
-        << " seconds";
-    }
+    commands::system_runner::instance().run(
+      commands::system_runner::notification,
+      processed_command,
+      *mac,
+      config->notification_timeout(),
+      new notification_method_end(
+            HOST_NOTIFICATION,
+            type,
+            method_start_time,
+            hst->name,
+            NULL,
+            cntct->name,
+            temp_commandsmember->cmd,
+            not_author,
+            not_data,
+            escalated,
+            processed_command));
 
     /* free memory */
     delete[] command_name;
     delete[] raw_command;
     delete[] processed_command;
-
-    /* get end time */
-    gettimeofday(&method_end_time, NULL);
-
-    /* send data to event broker */
-    broker_contact_notification_method_data(
-      NEBTYPE_CONTACTNOTIFICATIONMETHOD_END,
-      NEBFLAG_NONE,
-      NEBATTR_NONE,
-      HOST_NOTIFICATION,
-      type,
-      method_start_time,
-      method_end_time,
-      (void*)hst,
-      cntct,
-      temp_commandsmember->cmd,
-      not_author,
-      not_data,
-      escalated,
-      NULL);
   }
 
   /* get end time */
@@ -30,6 +30,9 @@ using namespace com::centreon::engine;
 using namespace com::centreon::engine::logging;
 using namespace com::centreon::engine::string;
 
+// Incremented each time custom variables of an object change.
+static unsigned int _generation(0);
+
 /**
  *  Equal operator.
  *
@@ -114,6 +117,7 @@ customvariablesmember* add_custom_variable_to_contact(
                          char const* varname,
                          char const* varvalue) {
   // Add custom variable to contact.
+  ++_generation;
   customvariablesmember* retval(add_custom_variable_to_object(
                                   &cntct->custom_variables,
                                   varname,
@@ -147,6 +151,7 @@ customvariablesmember* add_custom_variable_to_host(
                          char const* varname,
                          char const* varvalue) {
   // Add custom variable to host.
+  ++_generation;
   customvariablesmember* retval(add_custom_variable_to_object(
                                   &hst->custom_variables,
                                   varname,
@@ -226,6 +231,7 @@ customvariablesmember* add_custom_variable_to_service(
                          char const* varname,
                          char const* varvalue) {
   // Add custom variable to service.
+  ++_generation;
   customvariablesmember* retval(add_custom_variable_to_object(
                                   &svc->custom_variables,
                                   varname,
@@ -252,6 +258,7 @@ customvariablesmember* add_custom_variable_to_service(
  */
 void remove_all_custom_variables_from_contact(contact_struct* cntct) {
   // Browse all custom vars.
+  ++_generation;
   customvariablesmember* m(cntct->custom_variables);
   cntct->custom_variables = NULL;
   while (m) {
@@ -283,6 +290,7 @@ void remove_all_custom_variables_from_contact(contact_struct* cntct) {
  */
 void remove_all_custom_variables_from_host(host_struct* hst) {
   // Browse all custom vars.
+  ++_generation;
   customvariablesmember* m(hst->custom_variables);
   hst->custom_variables = NULL;
   while (m) {
@@ -314,6 +322,7 @@ void remove_all_custom_variables_from_host(host_struct* hst) {
  */
 void remove_all_custom_variables_from_service(service_struct* svc) {
   // Browse all custom vars.
+  ++_generation;
   customvariablesmember* m(svc->custom_variables);
   svc->custom_variables = NULL;
   while (m) {
@@ -338,6 +347,25 @@ void remove_all_custom_variables_from_service(service_struct* svc) {
   return ;
 }
 
+/**
+ *  Get the custom variables generation. It changes each time custom
+ *  variables of a contact, a host or a service are added, removed or
+ *  updated, so that values computed from them can be cached.
+ *
+ *  @return The custom variables generation.
+ */
+unsigned int engine::customvariables_generation() throw () {
+  return (_generation);
+}
+
+/**
+ *  Notify that custom variables of an object were modified in place.
+ */
+void engine::customvariables_modified() throw () {
+  ++_generation;
+  return ;
+}
+
 /**
  *  Update the custom variable value.
  *
@@ -358,6 +386,7 @@ bool engine::update_customvariable(
       if (strcmp(cv_value, m->variable_value)) {
         string::setstr(m->variable_value, value);
         m->has_been_modified = true;
+        ++_generation;
       }
       return (true);
     }
@@ -20,6 +20,10 @@
 
 #include <cstdlib>
 #include <cstring>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
 #include "com/centreon/engine/broker.hh"
 #include "com/centreon/engine/deleter/downtime.hh"
 #include "com/centreon/engine/deleter/listmember.hh"
@@ -33,11 +37,80 @@
 #include "com/centreon/engine/statusdata.hh"
 #include "com/centreon/engine/string.hh"
 #include "com/centreon/engine/xdddefault.hh"
+#include "com/centreon/unordered_hash.hh"
 
 using namespace com::centreon::engine;
 using namespace com::centreon::engine::logging;
 using namespace com::centreon::engine::string;
 
+/**
+ *  Indexes of scheduled_downtime_list. The list itself stays sorted by
+ *  start time for the status, retention and downtime finder readers.
+ */
+struct                  downtime_index {
+  typedef std::multimap<time_t, scheduled_downtime*> by_time;
+  typedef std::vector<scheduled_downtime*>           list;
+
+  by_time               by_end;
+  by_time               by_start;
+  umap<unsigned long, scheduled_downtime*>
+                        host_ids;
+  umap<std::string, list>
+                        hosts;
+  umap<unsigned long, scheduled_downtime*>
+                        service_ids;
+  umap<std::pair<std::string, std::string>, list>
+                        services;
+
+  void                  clear() {
+    by_end.clear();
+    by_start.clear();
+    host_ids.clear();
+    hosts.clear();
+    service_ids.clear();
+    services.clear();
+  }
+
+  /**
+   *  Get the downtimes of a host or of a service.
+   *
+   *  @param[in] dt  A downtime of the object.
+   *
+   *  @return Downtimes of the object.
+   */
+  list&                 object_list(scheduled_downtime const* dt) {
+    if (dt->type == HOST_DOWNTIME)
+      return (hosts[dt->host_name]);
+    return (services[std::make_pair(
+                        std::string(dt->host_name),
+                        std::string(dt->service_description))]);
+  }
+
+  /**
+   *  Find the position of a downtime in a time index.
+   *
+   *  @param[in] idx   Time index.
+   *  @param[in] key   Indexed time of the downtime.
+   *  @param[in] dt    The downtime.
+   *
+   *  @return Iterator on the downtime, end() if not found.
+   */
+  static by_time::iterator
+                        find(
+                          by_time& idx,
+                          time_t key,
+                          scheduled_downtime const* dt) {
+    std::pair<by_time::iterator, by_time::iterator>
+      range(idx.equal_range(key));
+    for (by_time::iterator it(range.first); it != range.second; ++it)
+      if (it->second == dt)
+        return (it);
+    return (idx.end());
+  }
+};
+
+static downtime_index downtimes;
+
 /**
  *  Equal operator.
  *
@@ -778,29 +851,33 @@ int check_pending_flex_host_downtime(host* hst) {
   if (hst->current_state == HOST_UP)
     return (OK);
 
-  /* check all downtime entries */
-  for (temp_downtime = scheduled_downtime_list;
-       temp_downtime != NULL;
-       temp_downtime = temp_downtime->next) {
-    if (temp_downtime->type != HOST_DOWNTIME
-        || temp_downtime->fixed == true
+  /* check all downtime entries of this host, a copy is used */
+  /* because starting a downtime can modify the index */
+  umap<std::string, downtime_index::list>::const_iterator
+    it(downtimes.hosts.find(hst->name));
+  if (it == downtimes.hosts.end())
+    return (OK);
+  downtime_index::list host_downtimes(it->second);
+  for (downtime_index::list::const_iterator
+         it(host_downtimes.begin()), end(host_downtimes.end());
+       it != end;
+       ++it) {
+    temp_downtime = *it;
+    if (temp_downtime->fixed == true
         || temp_downtime->is_in_effect == true
         || temp_downtime->triggered_by != 0)
       continue;
 
-    /* this entry matches our host! */
-    if (find_host(temp_downtime->host_name) == hst) {
-      /* if the time boundaries are okay, start this scheduled downtime */
-      if (temp_downtime->start_time <= current_time
-          && current_time <= temp_downtime->end_time) {
+    /* if the time boundaries are okay, start this scheduled downtime */
+    if (temp_downtime->start_time <= current_time
+        && current_time <= temp_downtime->end_time) {
 
-        logger(dbg_downtime, basic)
-          << "Flexible downtime (id=" << temp_downtime->downtime_id
-          << ") for host '" << hst->name << "' starting now...";
+      logger(dbg_downtime, basic)
+        << "Flexible downtime (id=" << temp_downtime->downtime_id
+        << ") for host '" << hst->name << "' starting now...";
 
-        temp_downtime->start_flex_downtime = true;
-        handle_scheduled_downtime(temp_downtime);
-      }
+      temp_downtime->start_flex_downtime = true;
+      handle_scheduled_downtime(temp_downtime);
     }
   }
   return (OK);
@@ -823,32 +900,35 @@ int check_pending_flex_service_downtime(service* svc) {
   if (svc->current_state == STATE_OK)
     return (OK);
 
-  /* check all downtime entries */
-  for (temp_downtime = scheduled_downtime_list;
-       temp_downtime != NULL;
-       temp_downtime = temp_downtime->next) {
-
-    if (temp_downtime->type != SERVICE_DOWNTIME
-        || temp_downtime->fixed == true
+  /* check all downtime entries of this service, a copy is used */
+  /* because starting a downtime can modify the index */
+  umap<std::pair<std::string, std::string>, downtime_index::list>::const_iterator
+    it(downtimes.services.find(std::make_pair(
+                                 std::string(svc->host_name),
+                                 std::string(svc->description))));
+  if (it == downtimes.services.end())
+    return (OK);
+  downtime_index::list service_downtimes(it->second);
+  for (downtime_index::list::const_iterator
+         it(service_downtimes.begin()), end(service_downtimes.end());
+       it != end;
+       ++it) {
+    temp_downtime = *it;
+    if (temp_downtime->fixed == true
         || temp_downtime->is_in_effect == true
         || temp_downtime->triggered_by != 0)
       continue;
 
-    /* this entry matches our service! */
-    if (find_service(
-          temp_downtime->host_name,
-          temp_downtime->service_description) == svc) {
-      /* if the time boundaries are okay, start this scheduled downtime */
-      if (temp_downtime->start_time <= current_time
-          && current_time <= temp_downtime->end_time) {
-        logger(dbg_downtime, basic)
-          << "Flexible downtime (id=" << temp_downtime->downtime_id
-          << ") for service '" << svc->description << "' on host '"
-          << svc->host_name << "' starting now...";
-
-        temp_downtime->start_flex_downtime = true;
-        handle_scheduled_downtime(temp_downtime);
-      }
+    /* if the time boundaries are okay, start this scheduled downtime */
+    if (temp_downtime->start_time <= current_time
+        && current_time <= temp_downtime->end_time) {
+      logger(dbg_downtime, basic)
+        << "Flexible downtime (id=" << temp_downtime->downtime_id
+        << ") for service '" << svc->description << "' on host '"
+        << svc->host_name << "' starting now...";
+
+      temp_downtime->start_flex_downtime = true;
+      handle_scheduled_downtime(temp_downtime);
     }
   }
   return (OK);
@@ -856,8 +936,6 @@ int check_pending_flex_service_downtime(service* svc) {
 
 /* checks for (and removes) expired downtime entries */
 int check_for_expired_downtime() {
-  scheduled_downtime* temp_downtime(NULL);
-  scheduled_downtime* next_downtime(NULL);
   time_t current_time(0L);
 
   logger(dbg_functions, basic)
@@ -865,15 +943,22 @@ int check_for_expired_downtime() {
 
   time(&current_time);
 
-  /* check all downtime entries... */
-  for (temp_downtime = scheduled_downtime_list;
-       temp_downtime != NULL;
-       temp_downtime = next_downtime) {
-    next_downtime = temp_downtime->next;
+  /* get downtime entries that ended... */
+  downtime_index::list ended;
+  for (downtime_index::by_time::const_iterator
+         it(downtimes.by_end.begin()), end(downtimes.by_end.end());
+       (it != end) && (it->first < current_time);
+       ++it)
+    ended.push_back(it->second);
+
+  for (downtime_index::list::const_iterator
+         it(ended.begin()), end(ended.end());
+       it != end;
+       ++it) {
+    scheduled_downtime* temp_downtime(*it);
 
     /* this entry should be removed */
-    if (temp_downtime->is_in_effect == false
-        && temp_downtime->end_time < current_time) {
+    if (temp_downtime->is_in_effect == false) {
       logger(dbg_downtime, basic)
         << "Expiring "
         << (temp_downtime->type == HOST_DOWNTIME ? "host" : "service")
@@ -1051,25 +1136,10 @@ int add_new_service_downtime(
 
 /* deletes a scheduled host or service downtime entry from the list in memory */
 int delete_downtime(int type, unsigned long downtime_id) {
-  scheduled_downtime* this_downtime(NULL);
-  scheduled_downtime* last_downtime(NULL);
-  scheduled_downtime* next_downtime(NULL);
-
   /* find the downtime we should remove */
-  for (this_downtime = scheduled_downtime_list,
-         last_downtime = scheduled_downtime_list;
-       this_downtime != NULL;
-       this_downtime = next_downtime) {
-    next_downtime = this_downtime->next;
-
-    /* we found the downtime we should delete */
-    if (this_downtime->downtime_id == downtime_id
-        && this_downtime->type == type)
-      break;
-
-    last_downtime = this_downtime;
-  }
-
+  if (type != HOST_DOWNTIME && type != SERVICE_DOWNTIME)
+    return (ERROR);
+  scheduled_downtime* this_downtime(find_downtime(type, downtime_id));
   if (this_downtime == NULL)
     return (ERROR);
 
@@ -1099,10 +1169,47 @@ int delete_downtime(int type, unsigned long downtime_id) {
     downtime_id,
     NULL);
 
-  if (scheduled_downtime_list == this_downtime)
+  /* remove the downtime from the list, its predecessor in the list */
+  /* is its predecessor in the start time index */
+  downtime_index::by_time::iterator
+    pos(downtime_index::find(
+          downtimes.by_start,
+          this_downtime->start_time,
+          this_downtime));
+  if (pos == downtimes.by_start.begin())
     scheduled_downtime_list = this_downtime->next;
+  else {
+    downtime_index::by_time::iterator prev(pos);
+    (--prev)->second->next = this_downtime->next;
+  }
+
+  /* remove the downtime from indexes */
+  downtimes.by_start.erase(pos);
+  downtimes.by_end.erase(downtime_index::find(
+                           downtimes.by_end,
+                           this_downtime->end_time,
+                           this_downtime));
+  if (type == HOST_DOWNTIME)
+    downtimes.host_ids.erase(downtime_id);
   else
-    last_downtime->next = next_downtime;
+    downtimes.service_ids.erase(downtime_id);
+  downtime_index::list& lst(downtimes.object_list(this_downtime));
+  for (downtime_index::list::iterator it(lst.begin()), end(lst.end());
+       it != end;
+       ++it)
+    if (*it == this_downtime) {
+      lst.erase(it);
+      break;
+    }
+  if (lst.empty()) {
+    if (type == HOST_DOWNTIME)
+      downtimes.hosts.erase(this_downtime->host_name);
+    else
+      downtimes.services.erase(std::make_pair(
+                                 std::string(this_downtime->host_name),
+                                 std::string(
+                                   this_downtime->service_description)));
+  }
 
   /* free memory */
   deleter::downtime(this_downtime);
@@ -1287,38 +1394,30 @@ int add_downtime(
   new_downtime->duration = duration;
   new_downtime->downtime_id = downtime_id;
 
-  if (defer_downtime_sorting) {
+  /* add new downtime to downtime list, sorted by start time */
+  downtime_index::by_time::iterator
+    pos(downtimes.by_start.upper_bound(new_downtime->start_time));
+  if (pos == downtimes.by_start.begin()) {
     new_downtime->next = scheduled_downtime_list;
     scheduled_downtime_list = new_downtime;
   }
   else {
-    /* add new downtime to downtime list, sorted by start time */
-    scheduled_downtime* last_downtime(scheduled_downtime_list);
-    scheduled_downtime* temp_downtime(NULL);
-    for (temp_downtime = scheduled_downtime_list;
-         temp_downtime != NULL;
-         temp_downtime = temp_downtime->next) {
-      if (new_downtime->start_time < temp_downtime->start_time) {
-        new_downtime->next = temp_downtime;
-        if (temp_downtime == scheduled_downtime_list)
-          scheduled_downtime_list = new_downtime;
-        else
-          last_downtime->next = new_downtime;
-        break;
-      }
-      else
-        last_downtime = temp_downtime;
-    }
-    if (scheduled_downtime_list == NULL) {
-      new_downtime->next = NULL;
-      scheduled_downtime_list = new_downtime;
-    }
-    else if (temp_downtime == NULL) {
-      new_downtime->next = NULL;
-      last_downtime->next = new_downtime;
-    }
+    scheduled_downtime* last_downtime((--pos)->second);
+    new_downtime->next = last_downtime->next;
+    last_downtime->next = new_downtime;
   }
 
+  /* index new downtime */
+  downtimes.by_start.insert(
+    std::make_pair(new_downtime->start_time, new_downtime));
+  downtimes.by_end.insert(
+    std::make_pair(new_downtime->end_time, new_downtime));
+  if (downtime_type == HOST_DOWNTIME)
+    downtimes.host_ids[downtime_id] = new_downtime;
+  else
+    downtimes.service_ids[downtime_id] = new_downtime;
+  downtimes.object_list(new_downtime).push_back(new_downtime);
+
   /* send data to event broker */
   broker_downtime_data(
     NEBTYPE_DOWNTIME_LOAD,
@@ -1340,53 +1439,12 @@ int add_downtime(
   return (OK);
 }
 
-static int downtime_compar(void const* p1, void const* p2) {
-  scheduled_downtime* d1 = *(scheduled_downtime**)p1;
-  scheduled_downtime* d2 = *(scheduled_downtime**)p2;
-  return ((d1->start_time < d2->start_time)
-          ? -1
-          : (d1->start_time - d2->start_time));
-}
-
 /*
-** If you are going to be adding a lot of downtime in sequence, set
-** defer_downtime_sorting to 1 before you start and then call
-** sort_downtime afterwards. Things will go MUCH faster.
-**
-** extern int defer_downtime_sorting;
+** Downtimes are always inserted at their place in the list, sorting
+** does not need to be deferred anymore. Kept for compatibility.
 */
 int sort_downtime() {
-  if (!defer_downtime_sorting)
-    return (OK);
   defer_downtime_sorting = 0;
-
-  unsigned long i = 0;
-  unsigned long unsorted_downtimes = 0;
-  scheduled_downtime* temp_downtime = scheduled_downtime_list;
-  while (temp_downtime != NULL) {
-    temp_downtime = temp_downtime->next;
-    unsorted_downtimes++;
-  }
-
-  if (!unsorted_downtimes)
-    return (OK);
-
-  scheduled_downtime** array
-    = new scheduled_downtime*[unsorted_downtimes];
-
-  while (scheduled_downtime_list) {
-    array[i++] = scheduled_downtime_list;
-    scheduled_downtime_list = scheduled_downtime_list->next;
-  }
-
-  qsort((void*)array, i, sizeof(*array), downtime_compar);
-  scheduled_downtime_list = temp_downtime = array[0];
-  for (i = 1; i < unsorted_downtimes; i++) {
-    temp_downtime->next = array[i];
-    temp_downtime = temp_downtime->next;
-  }
-  temp_downtime->next = NULL;
-  delete[] array;
   return (OK);
 }
 
@@ -1396,15 +1454,17 @@ int sort_downtime() {
 
 /* finds a specific downtime entry */
 scheduled_downtime* find_downtime(int type, unsigned long downtime_id) {
-  scheduled_downtime* temp_downtime(NULL);
-
-  for (temp_downtime = scheduled_downtime_list;
-       temp_downtime != NULL;
-       temp_downtime = temp_downtime->next) {
-    if (type != ANY_DOWNTIME && temp_downtime->type != type)
-      continue;
-    if (temp_downtime->downtime_id == downtime_id)
-      return (temp_downtime);
+  if (type == HOST_DOWNTIME || type == ANY_DOWNTIME) {
+    umap<unsigned long, scheduled_downtime*>::const_iterator
+      it(downtimes.host_ids.find(downtime_id));
+    if (it != downtimes.host_ids.end())
+      return (it->second);
+  }
+  if (type == SERVICE_DOWNTIME || type == ANY_DOWNTIME) {
+    umap<unsigned long, scheduled_downtime*>::const_iterator
+      it(downtimes.service_ids.find(downtime_id));
+    if (it != downtimes.service_ids.end())
+      return (it->second);
   }
   return (NULL);
 }
@@ -1425,6 +1485,7 @@ scheduled_downtime* find_service_downtime(unsigned long downtime_id) {
 
 /* frees memory allocated for the scheduled downtime data */
 void free_downtime_data() {
+  downtimes.clear();
   deleter::listmember(scheduled_downtime_list, &deleter::downtime);
   return;
 }
@@ -604,6 +604,9 @@ host* add_host(
     // for (unsigned int x(0); x < MAX_STATE_HISTORY_ENTRIES; ++x)
     //   obj->state_history[x] = STATE_OK;
 
+    // Link other properties, they live as long as the host.
+    obj->other_props = &host_other_props[id];
+
     // Add new items to the configuration state.
     state::instance().hosts()[id] = obj;
 
@@ -822,9 +825,9 @@ int number_of_total_parent_hosts(host* hst) {
 void engine::check_for_expired_acknowledgement(host* h) {
   if (h->problem_has_been_acknowledged) {
     int acknowledgement_timeout(
-          host_other_props[h->name].acknowledgement_timeout);
+          h->other_props->acknowledgement_timeout);
     if (acknowledgement_timeout > 0) {
-      time_t last_ack(host_other_props[h->name].last_acknowledgement);
+      time_t last_ack(h->other_props->last_acknowledgement);
       time_t now(time(NULL));
       if (last_ack + acknowledgement_timeout >= now) {
         logger(log_info_message, basic)
@@ -866,6 +869,18 @@ char const* engine::get_host_timezone(char const* name) {
   return (timezone.empty() ? NULL : timezone.c_str());
 }
 
+/**
+ *  Get host timezone without looking the host up by name.
+ *
+ *  @param[in] hst  Host.
+ *
+ *  @return Host timezone.
+ */
+char const* engine::get_host_timezone(host const* hst) {
+  std::string const& timezone(hst->other_props->timezone);
+  return (timezone.empty() ? NULL : timezone.c_str());
+}
+
 /**
  *  Get if host exist.
  *
@@ -898,8 +913,8 @@ unsigned int engine::get_host_id(char const* name) {
  *  @param[in] h  Target host.
  */
 void engine::schedule_acknowledgement_expiration(host* h) {
-  int ack_timeout(host_other_props[h->name].acknowledgement_timeout);
-  time_t last_ack(host_other_props[h->name].last_acknowledgement);
+  int ack_timeout(h->other_props->acknowledgement_timeout);
+  time_t last_ack(h->other_props->last_acknowledgement);
   if ((ack_timeout > 0) && (last_ack != (time_t)0)) {
     schedule_new_event(
       EVENT_EXPIRE_HOST_ACK,
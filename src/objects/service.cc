@@ -569,6 +569,9 @@ service* add_service(
     // for (unsigned int x(0); x < MAX_STATE_HISTORY_ENTRIES; ++x)
     //   obj->state_history[x] = STATE_OK;
 
+    // Link other properties, they live as long as the service.
+    obj->other_props = &service_other_props[id];
+
     // Add new items to the configuration state.
     state::instance().services()[id] = obj;
 
@@ -670,14 +673,10 @@ int is_escalated_contact_for_service(service* svc, contact* cntct) {
 void engine::check_for_expired_acknowledgement(service* s) {
   if (s->problem_has_been_acknowledged) {
     int acknowledgement_timeout(
-          service_other_props[std::make_pair(
-                                     s->host_ptr->name,
-                                     s->description)].acknowledgement_timeout);
+          s->other_props->acknowledgement_timeout);
     if (acknowledgement_timeout > 0) {
       time_t last_ack(
-               service_other_props[std::make_pair(
-                                          s->host_ptr->name,
-                                          s->description)].last_acknowledgement);
+               s->other_props->last_acknowledgement);
       time_t now(time(NULL));
       if (last_ack + acknowledgement_timeout >= now) {
         logger(log_info_message, basic)
@@ -732,6 +731,18 @@ char const* engine::get_service_timezone(
   return (timezone.empty() ? NULL : timezone.c_str());
 }
 
+/**
+ *  Get service timezone without looking the service up by name.
+ *
+ *  @param[in] svc  Service.
+ *
+ *  @return Service timezone.
+ */
+char const* engine::get_service_timezone(service const* svc) {
+  std::string const& timezone(svc->other_props->timezone);
+  return (timezone.empty() ? NULL : timezone.c_str());
+}
+
 /**
  *  Get if service exist.
  *
@@ -782,10 +793,8 @@ unsigned int engine::get_service_id(char const* host, char const* svc) {
  *  @param[in] s  Target service.
  */
 void engine::schedule_acknowledgement_expiration(service* s) {
-  std::pair<std::string, std::string>
-    hs(std::make_pair(s->host_ptr->name, s->description));
-  int ack_timeout(service_other_props[hs].acknowledgement_timeout);
-  time_t last_ack(service_other_props[hs].last_acknowledgement);
+  int ack_timeout(s->other_props->acknowledgement_timeout);
+  time_t last_ack(s->other_props->last_acknowledgement);
   if ((ack_timeout > 0) && (last_ack != (time_t)0)) {
     schedule_new_event(
       EVENT_EXPIRE_SERVICE_ACK,
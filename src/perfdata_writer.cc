@@ -0,0 +1,280 @@
+/*
+** Copyright 2017 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include "com/centreon/concurrency/locker.hh"
+#include "com/centreon/engine/logging/logger.hh"
+#include "com/centreon/engine/perfdata_writer.hh"
+
+using namespace com::centreon;
+using namespace com::centreon::engine;
+using namespace com::centreon::engine::logging;
+
+// Minimum duration in seconds the throughput is computed over.
+static unsigned int const rate_period(10);
+
+/**************************************
+*                                     *
+*           Public Methods            *
+*                                     *
+**************************************/
+
+/**
+ *  Constructor.
+ *
+ *  @param[in] name            Name of the file, used in logs.
+ *  @param[in] flush_interval  Maximum time in milliseconds a line is
+ *                             kept before being written, 0 to write
+ *                             lines as soon as they are pushed.
+ *  @param[in] flush_size      Pending bytes that trigger a write.
+ *  @param[in] max_held_size   Bytes kept while no file is attached,
+ *                             oldest lines are dropped beyond.
+ */
+perfdata_writer::perfdata_writer(
+                   std::string const& name,
+                   unsigned int flush_interval,
+                   unsigned int flush_size,
+                   unsigned long max_held_size)
+  : _fp(NULL),
+    _flush_interval(flush_interval),
+    _flush_size(flush_size),
+    _held_first(NULL),
+    _held_last(NULL),
+    _held_size(0),
+    _max_held_size(max_held_size),
+    _name(name),
+    _pending_size(0),
+    _quit(false),
+    _rate_lines(0),
+    _rate_start(timestamp::now()),
+    _running(flush_interval != 0),
+    _wakeup(false) {
+  _stats.lines = 0;
+  _stats.lines_per_second = 0.0;
+  _stats.write_time = 0;
+  _stats.writes = 0;
+  if (_running)
+    exec();
+}
+
+/**
+ *  Destructor, pending lines are written if a file is attached.
+ */
+perfdata_writer::~perfdata_writer() throw () {
+  if (_running) {
+    {
+      concurrency::locker lock(&_lock);
+      _quit = true;
+      _cv.wake_one();
+    }
+    concurrency::thread::wait();
+  }
+  flush();
+  while (_held_first) {
+    line* next(_held_first->next);
+    delete _held_first;
+    _held_first = next;
+  }
+}
+
+/**
+ *  Attach a file, lines kept while no file was attached are written.
+ *
+ *  @param[in] fp  The file, still owned by the caller.
+ */
+void perfdata_writer::attach(FILE* fp) {
+  {
+    concurrency::locker lock(&_file_lock);
+    _fp = fp;
+  }
+  flush();
+  return ;
+}
+
+/**
+ *  Write pending lines and detach the file so that it can be closed.
+ *
+ *  @return The file that was attached, NULL if none.
+ */
+FILE* perfdata_writer::detach() {
+  flush();
+  concurrency::locker lock(&_file_lock);
+  FILE* fp(_fp);
+  _fp = NULL;
+  return (fp);
+}
+
+/**
+ *  Write pending lines with a single write.
+ */
+void perfdata_writer::flush() {
+  concurrency::locker lock(&_file_lock);
+
+  // Take pushed lines.
+  line* first(_queue.pop_all());
+  if (first) {
+    unsigned long size(0);
+    line* last(first);
+    for (line* l(first); l; l = l->next) {
+      size += l->data.size() + 1;
+      last = l;
+    }
+    __sync_sub_and_fetch(&_pending_size, size);
+    if (_held_last)
+      _held_last->next = first;
+    else
+      _held_first = first;
+    _held_last = last;
+    _held_size += size;
+  }
+
+  // Drop the oldest lines that no file could receive.
+  if (!_fp && (_held_size > _max_held_size)) {
+    unsigned int dropped(0);
+    while (_held_first && (_held_size > _max_held_size)) {
+      line* next(_held_first->next);
+      _held_size -= _held_first->data.size() + 1;
+      delete _held_first;
+      _held_first = next;
+      ++dropped;
+    }
+    if (!_held_first)
+      _held_last = NULL;
+    logger(log_runtime_warning, basic)
+      << "Warning: " << dropped << " line(s) dropped as no "
+      << _name << " performance data file is opened";
+  }
+
+  // Write them.
+  unsigned int lines(0);
+  if (_fp && _held_first) {
+    std::string buffer;
+    std::size_t size(0);
+    for (line* l(_held_first); l; l = l->next)
+      size += l->data.size() + 1;
+    buffer.reserve(size);
+    while (_held_first) {
+      line* next(_held_first->next);
+      buffer.append(_held_first->data);
+      buffer.push_back('\n');
+      delete _held_first;
+      _held_first = next;
+      ++lines;
+    }
+    _held_last = NULL;
+    _held_size = 0;
+
+    timestamp start(timestamp::now());
+    fwrite(buffer.data(), 1, buffer.size(), _fp);
+    fflush(_fp);
+    unsigned long long duration(
+      (timestamp::now() - start).to_useconds());
+    logger(dbg_perfdata, most)
+      << lines << " line(s) (" << buffer.size() << " bytes) written to "
+      << _name << " performance data file in " << duration << " us";
+
+    concurrency::locker stats_lock(&_lock);
+    _stats.lines += lines;
+    _stats.write_time = duration;
+    ++_stats.writes;
+  }
+  _update_rate(lines);
+  return ;
+}
+
+/**
+ *  Get writer statistics.
+ *
+ *  @return Statistics.
+ */
+perfdata_writer::stats perfdata_writer::get_stats() {
+  _update_rate(0);
+  concurrency::locker lock(&_lock);
+  return (_stats);
+}
+
+/**
+ *  Push a line, without its newline.
+ *
+ *  @param[in,out] data  The line, emptied as its content is moved.
+ */
+void perfdata_writer::push(std::string& data) {
+  line* l(new line);
+  l->data.swap(data);
+  l->next = NULL;
+  unsigned long size(l->data.size() + 1);
+  unsigned long pending(__sync_add_and_fetch(&_pending_size, size));
+  _queue.push(l);
+
+  if (!_running)
+    flush();
+  // Only the push that crosses the size threshold wakes the thread.
+  else if ((pending >= _flush_size) && (pending - size < _flush_size)) {
+    concurrency::locker lock(&_lock);
+    _wakeup = true;
+    _cv.wake_one();
+  }
+  return ;
+}
+
+/**************************************
+*                                     *
+*           Private Methods           *
+*                                     *
+**************************************/
+
+/**
+ *  Thread main loop.
+ */
+void perfdata_writer::_run() {
+  for (;;) {
+    bool quit;
+    {
+      concurrency::locker lock(&_lock);
+      if (!_quit && !_wakeup)
+        _cv.wait(&_lock, _flush_interval);
+      _wakeup = false;
+      quit = _quit;
+    }
+    flush();
+    if (quit)
+      break ;
+  }
+  return ;
+}
+
+/**
+ *  Update the throughput.
+ *
+ *  @param[in] lines  Lines written since the last update.
+ */
+void perfdata_writer::_update_rate(unsigned int lines) {
+  concurrency::locker lock(&_lock);
+  _rate_lines += lines;
+  timestamp now(timestamp::now());
+  unsigned long long elapsed((now - _rate_start).to_useconds());
+  if (elapsed >= rate_period * 1000000ull) {
+    _stats.lines_per_second = _rate_lines * 1000000.0 / elapsed;
+    logger(dbg_perfdata, more)
+      << _name << " performance data file throughput: "
+      << _stats.lines_per_second << " line(s)/s";
+    _rate_lines = 0;
+    _rate_start = now;
+  }
+  return ;
+}
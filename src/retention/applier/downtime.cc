@@ -30,9 +30,6 @@ using namespace com::centreon::engine::retention;
  *  @param[in] lst The downtime list to add.
  */
 void applier::downtime::apply(list_downtime const& lst) {
-  // Big speedup when reading retention.dat in bulk.
-  defer_downtime_sorting = 1;
-
   for (list_downtime::const_iterator it(lst.begin()), end(lst.end());
        it != end;
        ++it) {
@@ -41,9 +38,6 @@ void applier::downtime::apply(list_downtime const& lst) {
     else
       _add_service_downtime(**it);
   }
-
-  // Sort all downtimes.
-  sort_downtime();
 }
 
 /**
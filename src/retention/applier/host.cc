@@ -96,7 +96,7 @@ void applier::host::_update(
     if (state.performance_data().is_set())
       string::setstr(obj.perf_data, *state.performance_data());
     if (state.last_acknowledgement().is_set())
-      host_other_props[obj.name].last_acknowledgement = *state.last_acknowledgement();
+      obj.other_props->last_acknowledgement = *state.last_acknowledgement();
     if (state.last_check().is_set())
       obj.last_check = *state.last_check();
     if (state.next_check().is_set()
@@ -311,7 +311,7 @@ void applier::host::_update(
 
   // Handle recovery been sent
   if (state.recovery_been_sent().is_set())
-    host_other_props[obj.name].recovery_been_sent = *state.recovery_been_sent();
+    obj.other_props->recovery_been_sent = *state.recovery_been_sent();
 
   // update host status.
   update_host_status(&obj, false);
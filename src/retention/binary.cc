@@ -0,0 +1,398 @@
+/*
+** Copyright 2017 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "com/centreon/engine/error.hh"
+#include "com/centreon/engine/retention/binary.hh"
+
+using namespace com::centreon::engine;
+using namespace com::centreon::engine::retention;
+
+// File header.
+static char const         magic[8] = {
+  'C', 'C', 'E', 'R', 'E', 'T', 'N', '\x0'
+};
+static unsigned int const byte_order(0x01020304);
+static std::size_t const  count_offset(
+  sizeof(magic) + 2 * sizeof(unsigned int));
+static std::size_t const  header_size(
+  sizeof(magic) + 4 * sizeof(unsigned int));
+
+/**
+ *  Check if a file is a binary retention file.
+ *
+ *  @param[in] path  The file path.
+ *
+ *  @return True if the file starts with the binary retention magic.
+ */
+bool binary::is_binary(std::string const& path) {
+  std::ifstream stream(path.c_str(), std::ios::binary);
+  char buffer[sizeof(magic)];
+  if (!stream.read(buffer, sizeof(buffer)))
+    return (false);
+  return (!memcmp(buffer, magic, sizeof(magic)));
+}
+
+/**************************************
+*                                     *
+*               Reader                *
+*                                     *
+**************************************/
+
+/**
+ *  Map and check a binary retention file.
+ *
+ *  @param[in] path  The file path.
+ */
+binary::reader::reader(std::string const& path)
+  : _data(NULL), _length(0) {
+  int fd(open(path.c_str(), O_RDONLY));
+  if (fd < 0) {
+    char const* msg(strerror(errno));
+    throw (engine_error() << "Parsing of retention file failed: "
+           "Can't open file '" << path << "': " << msg);
+  }
+  struct stat st;
+  if (fstat(fd, &st) || (st.st_size < static_cast<off_t>(header_size))) {
+    close(fd);
+    throw (engine_error() << "Parsing of retention file failed: "
+           "File '" << path << "' is too small");
+  }
+  _length = st.st_size;
+  void* data(mmap(NULL, _length, PROT_READ, MAP_PRIVATE, fd, 0));
+  close(fd);
+  if (data == MAP_FAILED) {
+    char const* msg(strerror(errno));
+    throw (engine_error() << "Parsing of retention file failed: "
+           "Can't map file '" << path << "': " << msg);
+  }
+  _data = static_cast<char*>(data);
+
+  try {
+    unsigned int header[4];
+    memcpy(header, _data + sizeof(magic), sizeof(header));
+    if (memcmp(_data, magic, sizeof(magic)))
+      throw (engine_error() << "Parsing of retention file failed: "
+             "File '" << path << "' is not a binary retention file");
+    if (header[1] != byte_order)
+      throw (engine_error() << "Parsing of retention file failed: "
+             "File '" << path << "' was written on another architecture");
+    if (header[0] != version)
+      throw (engine_error() << "Parsing of retention file failed: "
+             "File '" << path << "' has unsupported version "
+             << header[0]);
+
+    // Index records.
+    _records.reserve(header[2]);
+    std::size_t pos(header_size);
+    for (unsigned int i(0); i < header[2]; ++i) {
+      unsigned int size;
+      if (_length - pos < sizeof(size))
+        break;
+      memcpy(&size, _data + pos, sizeof(size));
+      pos += sizeof(size);
+      if (!size || (_length - pos < size) || _data[pos + size - 1])
+        break;
+      _records.push_back(std::make_pair(
+                           _data + pos,
+                           _data + pos + size));
+      pos += size;
+    }
+    if ((_records.size() != header[2]) || (pos != _length))
+      throw (engine_error() << "Parsing of retention file failed: "
+             "File '" << path << "' is truncated or corrupted");
+  }
+  catch (...) {
+    munmap(_data, _length);
+    throw;
+  }
+}
+
+/**
+ *  Destructor, unmap file.
+ */
+binary::reader::~reader() throw () {
+  munmap(_data, _length);
+}
+
+/**
+ *  Get a record.
+ *
+ *  @param[in]  index  Record index.
+ *  @param[out] f      Record key/value pairs.
+ *
+ *  @return Record object type.
+ */
+char const* binary::reader::get(std::size_t index, fields& f) const {
+  char const* type(_records[index].first);
+  char const* end(_records[index].second);
+  f.clear();
+  char const* ptr(type + strlen(type) + 1);
+  while (ptr < end) {
+    char const* key(ptr);
+    ptr += strlen(ptr) + 1;
+    if (ptr >= end)
+      break;
+    f.push_back(std::make_pair(key, ptr));
+    ptr += strlen(ptr) + 1;
+  }
+  return (type);
+}
+
+/**
+ *  Get the number of records.
+ *
+ *  @return Number of records.
+ */
+std::size_t binary::reader::size() const throw () {
+  return (_records.size());
+}
+
+/**************************************
+*                                     *
+*               Buffer                *
+*                                     *
+**************************************/
+
+/**
+ *  Default constructor.
+ */
+binary::buffer::buffer()
+  : _count(0),
+    _in_field(false),
+    _record(std::string::npos),
+    _stream(this) {}
+
+/**
+ *  Destructor.
+ */
+binary::buffer::~buffer() throw () {}
+
+/**
+ *  Append records built by another buffer.
+ *
+ *  @param[in] records  Data of the other buffer.
+ */
+void binary::buffer::append(std::string const& records) {
+  std::size_t pos(0);
+  while ((pos < records.size())
+         && (records.size() - pos >= sizeof(unsigned int))) {
+    unsigned int size;
+    memcpy(&size, records.data() + pos, sizeof(size));
+    pos += sizeof(size) + size;
+    ++_count;
+  }
+  _data.append(records);
+  return;
+}
+
+/**
+ *  Start a record.
+ *
+ *  @param[in] type  The object type.
+ */
+void binary::buffer::begin(char const* type) {
+  _record = _data.size();
+  _data.append(sizeof(unsigned int), '\0');
+  _data.append(type, strlen(type) + 1);
+  _in_field = false;
+  return;
+}
+
+/**
+ *  Get the number of records.
+ *
+ *  @return Number of records.
+ */
+unsigned int binary::buffer::count() const throw () {
+  return (_count);
+}
+
+/**
+ *  Get the records, each one preceded by its size.
+ *
+ *  @return The records.
+ */
+std::string const& binary::buffer::data() const throw () {
+  return (_data);
+}
+
+/**
+ *  Terminate the current record and write its size.
+ */
+void binary::buffer::end() {
+  if (_record == std::string::npos)
+    throw (engine_error() << "Cannot write retention record: "
+           "No object was started");
+  if (_in_field)
+    _data.append(1, '\0');
+  unsigned int size(_data.size() - _record - sizeof(size));
+  memcpy(&_data[_record], &size, sizeof(size));
+  _record = std::string::npos;
+  _in_field = false;
+  ++_count;
+  return;
+}
+
+/**
+ *  Start a field of the current record.
+ *
+ *  @param[in] key  The field name.
+ *
+ *  @return The stream to write the field value to.
+ */
+std::ostream& binary::buffer::field(char const* key) {
+  if (_in_field)
+    _data.append(1, '\0');
+  _data.append(key, strlen(key) + 1);
+  _in_field = true;
+  return (_stream);
+}
+
+/**
+ *  Write a character of the current value.
+ *
+ *  @param[in] c  The character.
+ *
+ *  @return The character.
+ */
+binary::buffer::int_type binary::buffer::overflow(int_type c) {
+  if (traits_type::eq_int_type(c, traits_type::eof()))
+    return (traits_type::not_eof(c));
+  _data.push_back(traits_type::to_char_type(c));
+  return (c);
+}
+
+/**
+ *  Write characters of the current value.
+ *
+ *  @param[in] s  The characters.
+ *  @param[in] n  Number of characters.
+ *
+ *  @return Number of characters written.
+ */
+std::streamsize binary::buffer::xsputn(char const* s, std::streamsize n) {
+  _data.append(s, n);
+  return (n);
+}
+
+/**************************************
+*                                     *
+*               Writer                *
+*                                     *
+**************************************/
+
+// Records are written in the file once this size is reached.
+static std::size_t const  flush_size(64 * 1024);
+
+/**
+ *  Open a temporary file next to the target file.
+ *
+ *  @param[in] path  The target file path.
+ */
+binary::writer::writer(std::string const& path)
+  : _file(NULL),
+    _path(path),
+    _tmp_path(path + ".tmp") {
+  _file = fopen(_tmp_path.c_str(), "wb");
+  if (!_file) {
+    char const* msg(strerror(errno));
+    throw (engine_error() << "Cannot open retention file '"
+           << _tmp_path << "': " << msg);
+  }
+  unsigned int header[4] = { version, byte_order, 0, 0 };
+  _write(magic, sizeof(magic));
+  _write(header, sizeof(header));
+}
+
+/**
+ *  Destructor, drop the temporary file if it was not committed.
+ */
+binary::writer::~writer() throw () {
+  if (_file) {
+    fclose(_file);
+    unlink(_tmp_path.c_str());
+  }
+}
+
+/**
+ *  Write the remaining records and their number, sync the temporary
+ *  file and replace the target file.
+ */
+void binary::writer::commit() {
+  if (_record != std::string::npos)
+    throw (engine_error() << "Cannot write retention file '"
+           << _path << "': Last object is not terminated");
+  _flush();
+  if (fseek(_file, count_offset, SEEK_SET))
+    throw (engine_error() << "Cannot write retention file '"
+           << _tmp_path << "': " << strerror(errno));
+  _write(&_count, sizeof(_count));
+  if (fflush(_file) || fsync(fileno(_file)))
+    throw (engine_error() << "Cannot write retention file '"
+           << _tmp_path << "': " << strerror(errno));
+  int ret(fclose(_file));
+  _file = NULL;
+  if (ret || rename(_tmp_path.c_str(), _path.c_str())) {
+    char const* msg(strerror(errno));
+    unlink(_tmp_path.c_str());
+    throw (engine_error() << "Cannot write retention file '"
+           << _path << "': " << msg);
+  }
+  return;
+}
+
+/**
+ *  Terminate the current record, write records in the file when
+ *  enough of them are buffered.
+ */
+void binary::writer::end() {
+  buffer::end();
+  if (_data.size() >= flush_size)
+    _flush();
+  return;
+}
+
+/**
+ *  Write buffered records in the temporary file.
+ */
+void binary::writer::_flush() {
+  _write(_data.data(), _data.size());
+  _data.clear();
+  return;
+}
+
+/**
+ *  Write raw data in the temporary file.
+ *
+ *  @param[in] data  The data.
+ *  @param[in] size  Data size.
+ */
+void binary::writer::_write(void const* data, std::size_t size) {
+  if (fwrite(data, 1, size, _file) != size)
+    throw (engine_error() << "Cannot write retention file '"
+           << _tmp_path << "': " << strerror(errno));
+  return;
+}
@@ -19,161 +19,220 @@
 
 #include <fstream>
 #include <iomanip>
+#include <memory>
+#include <sstream>
 #include "com/centreon/engine/broker.hh"
 #include "com/centreon/engine/error.hh"
 #include "com/centreon/engine/globals.hh"
 #include "com/centreon/engine/logging/logger.hh"
 #include "com/centreon/engine/objects/comment.hh"
 #include "com/centreon/engine/objects/downtime.hh"
+#include "com/centreon/engine/retention/binary.hh"
 #include "com/centreon/engine/retention/dump.hh"
+#include "com/centreon/engine/retention/output.hh"
+#include "com/centreon/engine/snapshot_writer.hh"
 
+using namespace com::centreon::engine;
 using namespace com::centreon::engine::logging;
 using namespace com::centreon::engine::retention;
 
+/**
+ *  Dump retention data of the objects of a snapshot.
+ *
+ *  @param[out] out  The output.
+ *  @param[in]  snap The snapshot.
+ *
+ *  @return The output.
+ */
+output& dump::all(output& out, snapshot const& snap) {
+  for (std::vector<host_struct>::const_iterator
+         it(snap.hosts().begin()), end(snap.hosts().end());
+       it != end;
+       ++it)
+    dump::host(out, *it, snap.retained_host_attribute_mask());
+  for (std::vector<service_struct>::const_iterator
+         it(snap.services().begin()), end(snap.services().end());
+       it != end;
+       ++it)
+    dump::service(out, *it, snap.retained_host_attribute_mask());
+  for (std::vector<contact_struct>::const_iterator
+         it(snap.contacts().begin()), end(snap.contacts().end());
+       it != end;
+       ++it)
+    dump::contact(
+      out,
+      *it,
+      snap.retained_contact_host_attribute_mask(),
+      snap.retained_contact_service_attribute_mask());
+  for (std::vector<comment_struct>::const_iterator
+         it(snap.comments().begin()), end(snap.comments().end());
+       it != end;
+       ++it)
+    dump::comment(out, *it);
+  for (std::vector<scheduled_downtime_struct>::const_iterator
+         it(snap.downtimes().begin()), end(snap.downtimes().end());
+       it != end;
+       ++it)
+    dump::downtime(out, *it);
+  return (out);
+}
+
 /**
  *  Dump retention of comment.
  *
- *  @param[out] os  The output stream.
+ *  @param[out] out The output.
  *  @param[in]  obj The comment to dump.
  *
- *  @return The output stream.
+ *  @return The output.
  */
-std::ostream& dump::comment(std::ostream& os, comment_struct const& obj) {
+output& dump::comment(output& out, comment_struct const& obj) {
   if (obj.comment_type == HOST_COMMENT)
-    os << "hostcomment {\n";
+    out.begin("hostcomment");
   else
-    os << "servicecomment {\n";
-  os << "host_name=" << obj.host_name << "\n";
+    out.begin("servicecomment");
+  out.field("host_name") << obj.host_name;
   if (obj.comment_type == SERVICE_COMMENT)
-    os << "service_description=" << obj.service_description << "\n";
-  os << "author=" << obj.author << "\n"
-    "comment_data=" << obj.comment_data << "\n"
-    "comment_id=" << obj.comment_id << "\n"
-    "entry_time=" << static_cast<unsigned long>(obj.entry_time) << "\n"
-    "expire_time=" << static_cast<unsigned long>(obj.expire_time) << "\n"
-    "expires=" << obj.expires << "\n"
-    "persistent=" << obj.persistent << "\n"
-    "source=" << obj.source << "\n"
-    "entry_type=" << obj.entry_type << "\n"
-    "}\n";
-  return (os);
+    out.field("service_description") << obj.service_description;
+  out.field("author") << obj.author;
+  out.field("comment_data") << obj.comment_data;
+  out.field("comment_id") << obj.comment_id;
+  out.field("entry_time") << static_cast<unsigned long>(obj.entry_time);
+  out.field("expire_time") << static_cast<unsigned long>(obj.expire_time);
+  out.field("expires") << obj.expires;
+  out.field("persistent") << obj.persistent;
+  out.field("source") << obj.source;
+  out.field("entry_type") << obj.entry_type;
+  out.end();
+  return (out);
 }
 
 /**
  *  Dump retention of comments.
  *
- *  @param[out] os The output stream.
+ *  @param[out] out The output.
  *
- *  @return The output stream.
+ *  @return The output.
  */
-std::ostream& dump::comments(std::ostream& os) {
+output& dump::comments(output& out) {
   for (comment_struct* obj(comment_list); obj; obj = obj->next)
-    dump::comment(os, *obj);
-  return (os);
+    dump::comment(out, *obj);
+  return (out);
 }
 
 /**
  *  Dump retention of contact.
  *
- *  @param[out] os  The output stream.
- *  @param[in]  obj The contact to dump.
+ *  @param[out] out          The output.
+ *  @param[in]  obj          The contact to dump.
+ *  @param[in]  host_mask    Retained contact host attribute mask.
+ *  @param[in]  service_mask Retained contact service attribute mask.
  *
- *  @return The output stream.
+ *  @return The output.
  */
-std::ostream& dump::contact(std::ostream& os, contact_struct const& obj) {
-  os << "contact {\n"
-    "contact_name=" << obj.name << "\n"
-    "host_notification_period=" << (obj.host_notification_period ? obj.host_notification_period : "") << "\n"
-    "host_notifications_enabled=" << obj.host_notifications_enabled << "\n"
-    "last_host_notification=" << static_cast<unsigned long>(obj.last_host_notification) << "\n"
-    "last_service_notification=" << static_cast<unsigned long>(obj.last_service_notification) << "\n"
-    "modified_attributes=" << (obj.modified_attributes & ~0L) << "\n"
-    "modified_host_attributes=" << (obj.modified_host_attributes & ~config->retained_contact_host_attribute_mask()) << "\n"
-    "modified_service_attributes=" << (obj.modified_service_attributes & ~config->retained_contact_service_attribute_mask()) << "\n"
-    "service_notification_period=" << (obj.service_notification_period ? obj.service_notification_period : "") << "\n"
-    "service_notifications_enabled=" << obj.service_notifications_enabled << "\n";
-  dump::customvariables(os, *obj.custom_variables);
-  os << "}\n";
-  return (os);
+output& dump::contact(
+                output& out,
+                contact_struct const& obj,
+                unsigned long host_mask,
+                unsigned long service_mask) {
+  out.begin("contact");
+  out.field("contact_name") << obj.name;
+  out.field("host_notification_period") << (obj.host_notification_period ? obj.host_notification_period : "");
+  out.field("host_notifications_enabled") << obj.host_notifications_enabled;
+  out.field("last_host_notification") << static_cast<unsigned long>(obj.last_host_notification);
+  out.field("last_service_notification") << static_cast<unsigned long>(obj.last_service_notification);
+  out.field("modified_attributes") << (obj.modified_attributes & ~0L);
+  out.field("modified_host_attributes") << (obj.modified_host_attributes & ~host_mask);
+  out.field("modified_service_attributes") << (obj.modified_service_attributes & ~service_mask);
+  out.field("service_notification_period") << (obj.service_notification_period ? obj.service_notification_period : "");
+  out.field("service_notifications_enabled") << obj.service_notifications_enabled;
+  dump::customvariables(out, *obj.custom_variables);
+  out.end();
+  return (out);
 }
 
 /**
  *  Dump retention of contacts.
  *
- *  @param[out] os The output stream.
+ *  @param[out] out The output.
  *
- *  @return The output stream.
+ *  @return The output.
  */
-std::ostream& dump::contacts(std::ostream& os) {
+output& dump::contacts(output& out) {
   for (contact_struct* obj(contact_list); obj; obj = obj->next)
-    dump::contact(os, *obj);
-  return (os);
+    dump::contact(
+      out,
+      *obj,
+      config->retained_contact_host_attribute_mask(),
+      config->retained_contact_service_attribute_mask());
+  return (out);
 }
 
 /**
  *  Dump retention of custom variables.
  *
- *  @param[out] os  The output stream.
+ *  @param[out] out The output.
  *  @param[in]  obj The custom variables to dump.
  *
- *  @return The output stream.
+ *  @return The output.
  */
-std::ostream& dump::customvariables(
-                std::ostream& os,
+output& dump::customvariables(
+                output& out,
                 customvariablesmember_struct const& obj) {
   for (customvariablesmember const* member(&obj);
        member;
        member = member->next)
-    if (member->variable_name)
-      os << "_" << member->variable_name << "="
-         << member->has_been_modified << ","
-         << (member->variable_value ? member->variable_value : "")
-         << "\n";
-  return (os);
+    if (member->variable_name) {
+      std::string key("_");
+      key.append(member->variable_name);
+      out.field(key.c_str())
+        << member->has_been_modified << ","
+        << (member->variable_value ? member->variable_value : "");
+    }
+  return (out);
 }
 
 /**
  *  Dump retention of downtime.
  *
- *  @param[out] os  The output stream.
+ *  @param[out] out The output.
  *  @param[in]  obj The downtime to dump.
  *
- *  @return The output stream.
+ *  @return The output.
  */
-std::ostream& dump::downtime(std::ostream& os, scheduled_downtime_struct const& obj) {
+output& dump::downtime(output& out, scheduled_downtime_struct const& obj) {
   if (obj.type == HOST_DOWNTIME)
-    os << "hostdowntime {\n";
+    out.begin("hostdowntime");
   else
-    os << "servicedowntime {\n";
-  os << "host_name=" << obj.host_name << "\n";
+    out.begin("servicedowntime");
+  out.field("host_name") << obj.host_name;
   if (obj.type == SERVICE_DOWNTIME)
-    os << "service_description=" << obj.service_description << "\n";
-  os << "author=" << obj.author << "\n"
-    "comment=" << obj.comment << "\n"
-    "duration=" << obj.duration << "\n"
-    "end_time=" << static_cast<unsigned long>(obj.end_time) << "\n"
-    "entry_time=" << static_cast<unsigned long>(obj.entry_time) << "\n"
-    "fixed=" << obj.fixed << "\n"
-    "start_time=" << static_cast<unsigned long>(obj.start_time) << "\n"
-    "triggered_by=" << obj.triggered_by << "\n"
-    "downtime_id=" << obj.downtime_id << "\n"
-    "}\n";
-  return (os);
+    out.field("service_description") << obj.service_description;
+  out.field("author") << obj.author;
+  out.field("comment") << obj.comment;
+  out.field("duration") << obj.duration;
+  out.field("end_time") << static_cast<unsigned long>(obj.end_time);
+  out.field("entry_time") << static_cast<unsigned long>(obj.entry_time);
+  out.field("fixed") << obj.fixed;
+  out.field("start_time") << static_cast<unsigned long>(obj.start_time);
+  out.field("triggered_by") << obj.triggered_by;
+  out.field("downtime_id") << obj.downtime_id;
+  out.end();
+  return (out);
 }
 
 /**
  *  Dump retention of downtimes.
  *
- *  @param[out] os The output stream.
+ *  @param[out] out The output.
  *
- *  @return The output stream.
+ *  @return The output.
  */
-std::ostream& dump::downtimes(std::ostream& os) {
+output& dump::downtimes(output& out) {
   for (scheduled_downtime* obj(scheduled_downtime_list);
        obj;
        obj = obj->next)
-    dump::downtime(os, *obj);
-  return (os);
+    dump::downtime(out, *obj);
+  return (out);
 }
 
 /**
@@ -196,135 +255,159 @@ std::ostream& dump::header(std::ostream& os) {
 /**
  *  Dump retention of host.
  *
- *  @param[out] os  The output stream.
- *  @param[in]  obj The host to dump.
+ *  @param[out] out  The output.
+ *  @param[in]  obj  The host to dump.
+ *  @param[in]  mask Retained attribute mask.
  *
- *  @return The output stream.
+ *  @return The output.
  */
-std::ostream& dump::host(std::ostream& os, host_struct const& obj) {
-  os << "host {\n"
-    "host_name=" << obj.name << "\n"
-    "acknowledgement_type=" << obj.acknowledgement_type << "\n"
-    "active_checks_enabled=" << obj.checks_enabled << "\n"
-    "check_command=" << (obj.host_check_command ? obj.host_check_command : "") << "\n"
-    "check_execution_time=" << std::setprecision(3) << std::fixed << obj.execution_time << "\n"
-    "check_flapping_recovery_notification=" << obj.check_flapping_recovery_notification << "\n"
-    "check_latency=" << std::setprecision(3) << std::fixed << obj.latency << "\n"
-    "check_options=" << obj.check_options << "\n"
-    "check_period=" << (obj.check_period ? obj.check_period : "") << "\n"
-    "check_type=" << obj.check_type << "\n"
-    "current_attempt=" << obj.current_attempt << "\n"
-    "current_event_id=" << obj.current_event_id << "\n"
-    "current_notification_id=" << obj.current_notification_id << "\n"
-    "current_notification_number=" << obj.current_notification_number << "\n"
-    "current_problem_id=" << obj.current_problem_id << "\n"
-    "current_state=" << obj.current_state << "\n"
-    "event_handler=" << (obj.event_handler ? obj.event_handler : "") << "\n"
-    "event_handler_enabled=" << obj.event_handler_enabled << "\n"
-    "flap_detection_enabled=" << obj.flap_detection_enabled << "\n"
-    "has_been_checked=" << obj.has_been_checked << "\n"
-    "is_flapping=" << obj.is_flapping << "\n"
-    "last_acknowledgement=" << host_other_props[obj.name].last_acknowledgement << "\n"
-    "last_check=" << static_cast<unsigned long>(obj.last_check) << "\n"
-    "last_event_id=" << obj.last_event_id << "\n"
-    "last_hard_state=" << obj.last_hard_state << "\n"
-    "last_hard_state_change=" << static_cast<unsigned long>(obj.last_hard_state_change) << "\n"
-    "last_notification=" << static_cast<unsigned long>(obj.last_host_notification) << "\n"
-    "last_problem_id=" << obj.last_problem_id << "\n"
-    "last_state=" << obj.last_state << "\n"
-    "last_state_change=" << static_cast<unsigned long>(obj.last_state_change) << "\n"
-    "last_time_down=" << static_cast<unsigned long>(obj.last_time_down) << "\n"
-    "last_time_unreachable=" << static_cast<unsigned long>(obj.last_time_unreachable) << "\n"
-    "last_time_up=" << static_cast<unsigned long>(obj.last_time_up) << "\n"
-    "long_plugin_output=" << (obj.long_plugin_output ? obj.long_plugin_output : "") << "\n"
-    "max_attempts=" << obj.max_attempts << "\n"
-    "modified_attributes=" << (obj.modified_attributes & ~config->retained_host_attribute_mask()) << "\n"
-    "next_check=" << static_cast<unsigned long>(obj.next_check) << "\n"
-    "normal_check_interval=" << obj.check_interval << "\n"
-    "notification_period=" << (obj.notification_period ? obj.notification_period : "") << "\n"
-    "notifications_enabled=" << obj.notifications_enabled << "\n"
-    "notified_on_down=" << obj.notified_on_down << "\n"
-    "notified_on_unreachable=" << obj.notified_on_unreachable << "\n"
-    "obsess_over_host=" << obj.obsess_over_host << "\n"
-    "passive_checks_enabled=" << obj.accept_passive_host_checks << "\n"
-    "percent_state_change=" << std::setprecision(2) << std::fixed << obj.percent_state_change << "\n"
-    "performance_data=" << (obj.perf_data ? obj.perf_data : "") << "\n"
-    "plugin_output=" << (obj.plugin_output ? obj.plugin_output : "") << "\n"
-    "problem_has_been_acknowledged=" << obj.problem_has_been_acknowledged << "\n"
-    "process_performance_data=" << obj.process_performance_data << "\n"
-    "retry_check_interval=" << obj.check_interval << "\n"
-    "state_type=" << obj.state_type << "\n"
-    "recovery_been_sent=" << host_other_props[obj.name].recovery_been_sent << "\n";
-
-  os << "state_history=";
+output& dump::host(
+                output& out,
+                host_struct const& obj,
+                unsigned long mask) {
+  out.begin("host");
+  out.field("host_name") << obj.name;
+  out.field("acknowledgement_type") << obj.acknowledgement_type;
+  out.field("active_checks_enabled") << obj.checks_enabled;
+  out.field("check_command") << (obj.host_check_command ? obj.host_check_command : "");
+  out.field("check_execution_time") << std::setprecision(3) << std::fixed << obj.execution_time;
+  out.field("check_flapping_recovery_notification") << obj.check_flapping_recovery_notification;
+  out.field("check_latency") << std::setprecision(3) << std::fixed << obj.latency;
+  out.field("check_options") << obj.check_options;
+  out.field("check_period") << (obj.check_period ? obj.check_period : "");
+  out.field("check_type") << obj.check_type;
+  out.field("current_attempt") << obj.current_attempt;
+  out.field("current_event_id") << obj.current_event_id;
+  out.field("current_notification_id") << obj.current_notification_id;
+  out.field("current_notification_number") << obj.current_notification_number;
+  out.field("current_problem_id") << obj.current_problem_id;
+  out.field("current_state") << obj.current_state;
+  out.field("event_handler") << (obj.event_handler ? obj.event_handler : "");
+  out.field("event_handler_enabled") << obj.event_handler_enabled;
+  out.field("flap_detection_enabled") << obj.flap_detection_enabled;
+  out.field("has_been_checked") << obj.has_been_checked;
+  out.field("is_flapping") << obj.is_flapping;
+  out.field("last_acknowledgement") << obj.other_props->last_acknowledgement;
+  out.field("last_check") << static_cast<unsigned long>(obj.last_check);
+  out.field("last_event_id") << obj.last_event_id;
+  out.field("last_hard_state") << obj.last_hard_state;
+  out.field("last_hard_state_change") << static_cast<unsigned long>(obj.last_hard_state_change);
+  out.field("last_notification") << static_cast<unsigned long>(obj.last_host_notification);
+  out.field("last_problem_id") << obj.last_problem_id;
+  out.field("last_state") << obj.last_state;
+  out.field("last_state_change") << static_cast<unsigned long>(obj.last_state_change);
+  out.field("last_time_down") << static_cast<unsigned long>(obj.last_time_down);
+  out.field("last_time_unreachable") << static_cast<unsigned long>(obj.last_time_unreachable);
+  out.field("last_time_up") << static_cast<unsigned long>(obj.last_time_up);
+  out.field("long_plugin_output") << (obj.long_plugin_output ? obj.long_plugin_output : "");
+  out.field("max_attempts") << obj.max_attempts;
+  out.field("modified_attributes") << (obj.modified_attributes & ~mask);
+  out.field("next_check") << static_cast<unsigned long>(obj.next_check);
+  out.field("normal_check_interval") << obj.check_interval;
+  out.field("notification_period") << (obj.notification_period ? obj.notification_period : "");
+  out.field("notifications_enabled") << obj.notifications_enabled;
+  out.field("notified_on_down") << obj.notified_on_down;
+  out.field("notified_on_unreachable") << obj.notified_on_unreachable;
+  out.field("obsess_over_host") << obj.obsess_over_host;
+  out.field("passive_checks_enabled") << obj.accept_passive_host_checks;
+  out.field("percent_state_change") << std::setprecision(2) << std::fixed << obj.percent_state_change;
+  out.field("performance_data") << (obj.perf_data ? obj.perf_data : "");
+  out.field("plugin_output") << (obj.plugin_output ? obj.plugin_output : "");
+  out.field("problem_has_been_acknowledged") << obj.problem_has_been_acknowledged;
+  out.field("process_performance_data") << obj.process_performance_data;
+  out.field("retry_check_interval") << obj.check_interval;
+  out.field("state_type") << obj.state_type;
+  out.field("recovery_been_sent") << obj.other_props->recovery_been_sent;
+
+  std::ostream& history(out.field("state_history"));
   for (unsigned int x(0); x < MAX_STATE_HISTORY_ENTRIES; ++x)
-    os << (x > 0 ? "," : "") << obj.state_history[(x + obj.state_history_index) % MAX_STATE_HISTORY_ENTRIES];
-  os << "\n";
+    history << (x > 0 ? "," : "") << obj.state_history[(x + obj.state_history_index) % MAX_STATE_HISTORY_ENTRIES];
 
-  dump::customvariables(os, *obj.custom_variables);
-  os << "}\n";
-  return (os);
+  dump::customvariables(out, *obj.custom_variables);
+  out.end();
+  return (out);
 }
 
 /**
  *  Dump retention of hosts.
  *
- *  @param[out] os The output stream.
+ *  @param[out] out The output.
  *
- *  @return The output stream.
+ *  @return The output.
  */
-std::ostream& dump::hosts(std::ostream& os) {
+output& dump::hosts(output& out) {
   for (host_struct* obj(host_list); obj; obj = obj->next)
-    dump::host(os, *obj);
-  return (os);
+    dump::host(out, *obj, config->retained_host_attribute_mask());
+  return (out);
 }
 
 /**
  *  Dump retention of info.
  *
- *  @param[out] os The output stream.
+ *  @param[out] out The output.
  *
- *  @return The output stream.
+ *  @return The output.
  */
-std::ostream& dump::info(std::ostream& os) {
-  os << "info {\n"
-    "created=" << static_cast<unsigned long>(time(NULL)) << "\n"
-    "}\n";
-  return (os);
+output& dump::info(output& out) {
+  out.begin("info");
+  out.field("created") << static_cast<unsigned long>(time(NULL));
+  out.end();
+  return (out);
 }
 
 /**
  *  Dump retention of program.
  *
- *  @param[out] os The output stream.
+ *  @param[out] out The output.
  *
- *  @return The output stream.
+ *  @return The output.
  */
-std::ostream& dump::program(std::ostream& os) {
-  os << "program {\n"
-    "active_host_checks_enabled=" << config->execute_host_checks() << "\n"
-    "active_service_checks_enabled=" << config->execute_service_checks() << "\n"
-    "check_host_freshness=" << config->check_host_freshness() << "\n"
-    "check_service_freshness=" << config->check_service_freshness() << "\n"
-    "enable_event_handlers=" << config->enable_event_handlers() << "\n"
-    "enable_flap_detection=" << config->enable_flap_detection() << "\n"
-    "enable_notifications=" << config->enable_notifications() << "\n"
-    "global_host_event_handler=" << config->global_host_event_handler().c_str() << "\n"
-    "global_service_event_handler=" << config->global_service_event_handler().c_str() << "\n"
-    "modified_host_attributes=" << (modified_host_process_attributes & ~config->retained_process_host_attribute_mask()) << "\n"
-    "modified_service_attributes=" << (modified_service_process_attributes & ~config->retained_process_host_attribute_mask()) << "\n"
-    "next_comment_id=" << next_comment_id << "\n"
-    "next_downtime_id=" << next_downtime_id << "\n"
-    "next_event_id=" << next_event_id << "\n"
-    "next_notification_id=" << next_notification_id << "\n"
-    "next_problem_id=" << next_problem_id << "\n"
-    "obsess_over_hosts=" << config->obsess_over_hosts() << "\n"
-    "obsess_over_services=" << config->obsess_over_services() << "\n"
-    "passive_host_checks_enabled=" << config->accept_passive_host_checks() << "\n"
-    "passive_service_checks_enabled=" << config->accept_passive_service_checks() << "\n"
-    "process_performance_data=" << config->process_performance_data() << "\n"
-    "}\n";
-  return (os);
+output& dump::program(output& out) {
+  out.begin("program");
+  out.field("active_host_checks_enabled") << config->execute_host_checks();
+  out.field("active_service_checks_enabled") << config->execute_service_checks();
+  out.field("check_host_freshness") << config->check_host_freshness();
+  out.field("check_service_freshness") << config->check_service_freshness();
+  out.field("enable_event_handlers") << config->enable_event_handlers();
+  out.field("enable_flap_detection") << config->enable_flap_detection();
+  out.field("enable_notifications") << config->enable_notifications();
+  out.field("global_host_event_handler") << config->global_host_event_handler().c_str();
+  out.field("global_service_event_handler") << config->global_service_event_handler().c_str();
+  out.field("modified_host_attributes") << (modified_host_process_attributes & ~config->retained_process_host_attribute_mask());
+  out.field("modified_service_attributes") << (modified_service_process_attributes & ~config->retained_process_host_attribute_mask());
+  out.field("next_comment_id") << next_comment_id;
+  out.field("next_downtime_id") << next_downtime_id;
+  out.field("next_event_id") << next_event_id;
+  out.field("next_notification_id") << next_notification_id;
+  out.field("next_problem_id") << next_problem_id;
+  out.field("obsess_over_hosts") << config->obsess_over_hosts();
+  out.field("obsess_over_services") << config->obsess_over_services();
+  out.field("passive_host_checks_enabled") << config->accept_passive_host_checks();
+  out.field("passive_service_checks_enabled") << config->accept_passive_service_checks();
+  out.field("process_performance_data") << config->process_performance_data();
+  out.end();
+  return (out);
+}
+
+/**
+ *  Take a snapshot of retention data.
+ *
+ *  @return The snapshot.
+ */
+static snapshot* _take_snapshot() {
+  // The head is written in the format of the retention file.
+  if (config->use_binary_state_retention()) {
+    binary::buffer head;
+    dump::info(head);
+    dump::program(head);
+    return (new snapshot(head.data()));
+  }
+  std::ostringstream head;
+  dump::header(head);
+  text_output out(head);
+  dump::info(out);
+  dump::program(out);
+  return (new snapshot(head.str()));
 }
 
 /**
@@ -338,6 +421,9 @@ bool dump::save(std::string const& path) {
   if (!config->retain_state_information())
     return (true);
 
+  // Snapshots written in background must not overwrite this one.
+  snapshot_writer::instance().flush();
+
   // send data to event broker
   broker_retention_data(
     NEBTYPE_RETENTIONDATA_STARTSAVE,
@@ -347,22 +433,8 @@ bool dump::save(std::string const& path) {
 
   bool ret(false);
   try {
-    std::ofstream stream(
-                    path.c_str(),
-                    std::ios::binary | std::ios::trunc);
-    if (!stream.is_open())
-      throw (engine_error() << "Cannot open retention file '"
-             << config->state_retention_file() << "'");
-    dump::header(stream);
-    dump::info(stream);
-    dump::program(stream);
-    dump::hosts(stream);
-    dump::services(stream);
-    dump::contacts(stream);
-    dump::comments(stream);
-    dump::downtimes(stream);
-
-    ret = true;
+    std::auto_ptr<snapshot> snap(_take_snapshot());
+    ret = dump::write(*snap, path);
   }
   catch (std::exception const& e) {
     logger(log_runtime_error, basic)
@@ -378,93 +450,169 @@ bool dump::save(std::string const& path) {
   return (ret);
 }
 
+/**
+ *  Take a snapshot of all data, that is saved by the snapshot writer
+ *  thread.
+ *
+ *  @param[in] path The file path to use to save.
+ */
+void dump::save_snapshot(std::string const& path) {
+  if (!config->retain_state_information())
+    return;
+
+  // send data to event broker
+  broker_retention_data(
+    NEBTYPE_RETENTIONDATA_STARTSAVE,
+    NEBFLAG_NONE,
+    NEBATTR_NONE,
+    NULL);
+
+  try {
+    snapshot_writer::instance().push(
+      snapshot_writer::retention_file,
+      _take_snapshot(),
+      &dump::write,
+      path);
+  }
+  catch (std::exception const& e) {
+    logger(log_runtime_error, basic)
+      << e.what();
+  }
+
+  // send data to event broker.
+  broker_retention_data(
+    NEBTYPE_RETENTIONDATA_ENDSAVE,
+    NEBFLAG_NONE,
+    NEBATTR_NONE,
+    NULL);
+  return;
+}
+
 /**
  *  Dump retention of service.
  *
- *  @param[out] os  The output stream.
- *  @param[in]  obj The service to dump.
+ *  @param[out] out  The output.
+ *  @param[in]  obj  The service to dump.
+ *  @param[in]  mask Retained attribute mask.
  *
- *  @return The output stream.
+ *  @return The output.
  */
-std::ostream& dump::service(std::ostream& os, service_struct const& obj) {
-  os << "service {\n"
-    "host_name=" << obj.host_name << "\n"
-    "service_description=" << obj.description << "\n"
-    "acknowledgement_type=" << obj.acknowledgement_type << "\n"
-    "active_checks_enabled=" << obj.checks_enabled << "\n"
-    "check_command=" << (obj.service_check_command ? obj.service_check_command : "") << "\n"
-    "check_execution_time=" << std::setprecision(3) << std::fixed << obj.execution_time << "\n"
-    "check_flapping_recovery_notification=" << obj.check_flapping_recovery_notification << "\n"
-    "check_latency=" << std::setprecision(3) << std::fixed << obj.latency << "\n"
-    "check_options=" << obj.check_options << "\n"
-    "check_period=" << (obj.check_period ? obj.check_period : "") << "\n"
-    "check_type=" << obj.check_type << "\n"
-    "current_attempt=" << obj.current_attempt << "\n"
-    "current_event_id=" << obj.current_event_id << "\n"
-    "current_notification_id=" << obj.current_notification_id << "\n"
-    "current_notification_number=" << obj.current_notification_number << "\n"
-    "current_problem_id=" << obj.current_problem_id << "\n"
-    "current_state=" << obj.current_state << "\n"
-    "event_handler=" << (obj.event_handler ? obj.event_handler : "") << "\n"
-    "event_handler_enabled=" << obj.event_handler_enabled << "\n"
-    "flap_detection_enabled=" << obj.flap_detection_enabled << "\n"
-    "has_been_checked=" << obj.has_been_checked << "\n"
-    "is_flapping=" << obj.is_flapping << "\n"
-    "last_acknowledgement=" << service_other_props[std::make_pair(obj.host_ptr->name, obj.description)].last_acknowledgement << "\n"
-    "last_check=" << static_cast<unsigned long>(obj.last_check) << "\n"
-    "last_event_id=" << obj.last_event_id << "\n"
-    "last_hard_state=" << obj.last_hard_state << "\n"
-    "last_hard_state_change=" << static_cast<unsigned long>(obj.last_hard_state_change) << "\n"
-    "last_notification=" << static_cast<unsigned long>(obj.last_notification) << "\n"
-    "last_problem_id=" << obj.last_problem_id << "\n"
-    "last_state=" << obj.last_state << "\n"
-    "last_state_change=" << static_cast<unsigned long>(obj.last_state_change) << "\n"
-    "last_time_critical=" << static_cast<unsigned long>(obj.last_time_critical) << "\n"
-    "last_time_ok=" << static_cast<unsigned long>(obj.last_time_ok) << "\n"
-    "last_time_unknown=" << static_cast<unsigned long>(obj.last_time_unknown) << "\n"
-    "last_time_warning=" << static_cast<unsigned long>(obj.last_time_warning) << "\n"
-    "long_plugin_output=" << (obj.long_plugin_output ? obj.long_plugin_output : "") << "\n"
-    "max_attempts=" << obj.max_attempts << "\n"
-    "modified_attributes=" << (obj.modified_attributes & ~config->retained_host_attribute_mask()) << "\n"
-    "next_check=" << static_cast<unsigned long>(obj.next_check) << "\n"
-    "normal_check_interval=" << obj.check_interval << "\n"
-    "notification_period=" << (obj.notification_period ? obj.notification_period : "") << "\n"
-    "notifications_enabled=" << obj.notifications_enabled << "\n"
-    "notified_on_critical=" << obj.notified_on_critical << "\n"
-    "notified_on_unknown=" << obj.notified_on_unknown << "\n"
-    "notified_on_warning=" << obj.notified_on_warning << "\n"
-    "obsess_over_service=" << obj.obsess_over_service << "\n"
-    "passive_checks_enabled=" << obj.accept_passive_service_checks << "\n"
-    "percent_state_change=" << std::setprecision(2) << std::fixed << obj.percent_state_change << "\n"
-    "performance_data=" << (obj.perf_data ? obj.perf_data : "") << "\n"
-    "plugin_output=" << (obj.plugin_output ? obj.plugin_output : "") << "\n"
-    "problem_has_been_acknowledged=" << obj.problem_has_been_acknowledged << "\n"
-    "process_performance_data=" << obj.process_performance_data << "\n"
-    "retry_check_interval=" << obj.retry_interval << "\n"
-    "state_type=" << obj.state_type << "\n"
-    "recovery_been_sent=" << service_other_props[
-                               std::make_pair(obj.description,
-                                              obj.host_ptr->name)].recovery_been_sent << "\n";
-
-  os << "state_history=";
+output& dump::service(
+                output& out,
+                service_struct const& obj,
+                unsigned long mask) {
+  out.begin("service");
+  out.field("host_name") << obj.host_name;
+  out.field("service_description") << obj.description;
+  out.field("acknowledgement_type") << obj.acknowledgement_type;
+  out.field("active_checks_enabled") << obj.checks_enabled;
+  out.field("check_command") << (obj.service_check_command ? obj.service_check_command : "");
+  out.field("check_execution_time") << std::setprecision(3) << std::fixed << obj.execution_time;
+  out.field("check_flapping_recovery_notification") << obj.check_flapping_recovery_notification;
+  out.field("check_latency") << std::setprecision(3) << std::fixed << obj.latency;
+  out.field("check_options") << obj.check_options;
+  out.field("check_period") << (obj.check_period ? obj.check_period : "");
+  out.field("check_type") << obj.check_type;
+  out.field("current_attempt") << obj.current_attempt;
+  out.field("current_event_id") << obj.current_event_id;
+  out.field("current_notification_id") << obj.current_notification_id;
+  out.field("current_notification_number") << obj.current_notification_number;
+  out.field("current_problem_id") << obj.current_problem_id;
+  out.field("current_state") << obj.current_state;
+  out.field("event_handler") << (obj.event_handler ? obj.event_handler : "");
+  out.field("event_handler_enabled") << obj.event_handler_enabled;
+  out.field("flap_detection_enabled") << obj.flap_detection_enabled;
+  out.field("has_been_checked") << obj.has_been_checked;
+  out.field("is_flapping") << obj.is_flapping;
+  out.field("last_acknowledgement") << obj.other_props->last_acknowledgement;
+  out.field("last_check") << static_cast<unsigned long>(obj.last_check);
+  out.field("last_event_id") << obj.last_event_id;
+  out.field("last_hard_state") << obj.last_hard_state;
+  out.field("last_hard_state_change") << static_cast<unsigned long>(obj.last_hard_state_change);
+  out.field("last_notification") << static_cast<unsigned long>(obj.last_notification);
+  out.field("last_problem_id") << obj.last_problem_id;
+  out.field("last_state") << obj.last_state;
+  out.field("last_state_change") << static_cast<unsigned long>(obj.last_state_change);
+  out.field("last_time_critical") << static_cast<unsigned long>(obj.last_time_critical);
+  out.field("last_time_ok") << static_cast<unsigned long>(obj.last_time_ok);
+  out.field("last_time_unknown") << static_cast<unsigned long>(obj.last_time_unknown);
+  out.field("last_time_warning") << static_cast<unsigned long>(obj.last_time_warning);
+  out.field("long_plugin_output") << (obj.long_plugin_output ? obj.long_plugin_output : "");
+  out.field("max_attempts") << obj.max_attempts;
+  out.field("modified_attributes") << (obj.modified_attributes & ~mask);
+  out.field("next_check") << static_cast<unsigned long>(obj.next_check);
+  out.field("normal_check_interval") << obj.check_interval;
+  out.field("notification_period") << (obj.notification_period ? obj.notification_period : "");
+  out.field("notifications_enabled") << obj.notifications_enabled;
+  out.field("notified_on_critical") << obj.notified_on_critical;
+  out.field("notified_on_unknown") << obj.notified_on_unknown;
+  out.field("notified_on_warning") << obj.notified_on_warning;
+  out.field("obsess_over_service") << obj.obsess_over_service;
+  out.field("passive_checks_enabled") << obj.accept_passive_service_checks;
+  out.field("percent_state_change") << std::setprecision(2) << std::fixed << obj.percent_state_change;
+  out.field("performance_data") << (obj.perf_data ? obj.perf_data : "");
+  out.field("plugin_output") << (obj.plugin_output ? obj.plugin_output : "");
+  out.field("problem_has_been_acknowledged") << obj.problem_has_been_acknowledged;
+  out.field("process_performance_data") << obj.process_performance_data;
+  out.field("retry_check_interval") << obj.retry_interval;
+  out.field("state_type") << obj.state_type;
+  out.field("recovery_been_sent") << obj.other_props->recovery_been_sent;
+
+  std::ostream& history(out.field("state_history"));
   for (unsigned int x(0); x < MAX_STATE_HISTORY_ENTRIES; ++x)
-    os << (x > 0 ? "," : "") << obj.state_history[(x + obj.state_history_index) % MAX_STATE_HISTORY_ENTRIES];
-  os << "\n";
+    history << (x > 0 ? "," : "") << obj.state_history[(x + obj.state_history_index) % MAX_STATE_HISTORY_ENTRIES];
 
-  dump::customvariables(os, *obj.custom_variables);
-  os << "}\n";
-  return (os);
+  dump::customvariables(out, *obj.custom_variables);
+  out.end();
+  return (out);
 }
 
 /**
  *  Dump retention of services.
  *
- *  @param[out] os The output stream.
+ *  @param[out] out The output.
  *
- *  @return The output stream.
+ *  @return The output.
  */
-std::ostream& dump::services(std::ostream& os) {
+output& dump::services(output& out) {
   for (service_struct* obj(service_list); obj; obj = obj->next)
-    dump::service(os, *obj);
-  return (os);
+    dump::service(out, *obj, config->retained_host_attribute_mask());
+  return (out);
+}
+
+/**
+ *  Write a snapshot of all data.
+ *
+ *  @param[in] snap The snapshot.
+ *  @param[in] path The file path to use to save.
+ *
+ *  @return True on success, otherwise false.
+ */
+bool dump::write(snapshot const& snap, std::string const& path) {
+  try {
+    if (snap.use_binary_state_retention()) {
+      // The file is replaced only once complete.
+      binary::writer writer(path);
+      writer.append(snap.head());
+      dump::all(writer, snap);
+      writer.commit();
+    }
+    else {
+      std::ofstream stream(
+                      path.c_str(),
+                      std::ios::binary | std::ios::trunc);
+      if (!stream.is_open())
+        throw (engine_error() << "Cannot open retention file '"
+               << path << "'");
+      stream << snap.head();
+      text_output out(stream);
+      dump::all(out, snap);
+    }
+  }
+  catch (std::exception const& e) {
+    logger(log_runtime_error, basic)
+      << e.what();
+    return (false);
+  }
+  return (true);
 }
@@ -0,0 +1,72 @@
+/*
+** Copyright 2017 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include "com/centreon/engine/retention/output.hh"
+
+using namespace com::centreon::engine::retention;
+
+/**
+ *  Constructor.
+ *
+ *  @param[in] os  The stream objects are written to.
+ */
+text_output::text_output(std::ostream& os)
+  : _in_field(false), _os(os) {}
+
+/**
+ *  Destructor.
+ */
+text_output::~text_output() throw () {}
+
+/**
+ *  Start an object.
+ *
+ *  @param[in] type  The object type.
+ */
+void text_output::begin(char const* type) {
+  _os << type << " {\n";
+  _in_field = false;
+  return;
+}
+
+/**
+ *  Terminate the current object.
+ */
+void text_output::end() {
+  if (_in_field)
+    _os << "\n";
+  _os << "}\n";
+  _in_field = false;
+  return;
+}
+
+/**
+ *  Start a field of the current object.
+ *
+ *  @param[in] key  The field name.
+ *
+ *  @return The stream to write the field value to.
+ */
+std::ostream& text_output::field(char const* key) {
+  if (_in_field)
+    _os << "\n";
+  _os << key << "=";
+  _in_field = true;
+  return (_os);
+}
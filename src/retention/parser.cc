@@ -18,13 +18,73 @@
 */
 
 #include <fstream>
+#include <unistd.h>
+#include <vector>
+#include "com/centreon/concurrency/thread.hh"
 #include "com/centreon/engine/error.hh"
+#include "com/centreon/engine/retention/binary.hh"
 #include "com/centreon/engine/retention/parser.hh"
 #include "com/centreon/engine/retention/state.hh"
 #include "com/centreon/engine/string.hh"
 
+using namespace com::centreon;
 using namespace com::centreon::engine::retention;
 
+// Binary records decoded by each thread.
+static std::size_t const min_records_per_thread(1000);
+static unsigned int const max_threads(8);
+
+/**
+ *  Decode a range of binary retention records.
+ */
+class                      binary_chunk : public concurrency::thread {
+public:
+                           binary_chunk(
+                             binary::reader const& reader,
+                             std::size_t begin,
+                             std::size_t end)
+    : _begin(begin), _end(end), _reader(reader) {}
+                           ~binary_chunk() throw () {}
+
+  /**
+   *  Create objects from records.
+   */
+  void                     decode() {
+    try {
+      objects.reserve(_end - _begin);
+      binary::reader::fields f;
+      for (std::size_t i(_begin); i < _end; ++i) {
+        object_ptr obj(object::create(_reader.get(i, f)));
+        if (obj.is_null())
+          continue;
+        for (binary::reader::fields::const_iterator
+               it(f.begin()), end(f.end());
+             it != end;
+             ++it)
+          obj->set(it->first, it->second);
+        objects.push_back(obj);
+      }
+    }
+    catch (std::exception const& e) {
+      error = e.what();
+    }
+    return;
+  }
+
+  std::string              error;
+  std::vector<object_ptr>  objects;
+
+private:
+  void                     _run() {
+    decode();
+    return;
+  }
+
+  std::size_t              _begin;
+  std::size_t              _end;
+  binary::reader const&    _reader;
+};
+
 parser::store parser::_store[] = {
   &parser::_store_into_list<list_comment, &state::comments>,
   &parser::_store_into_list<list_contact, &state::contacts>,
@@ -51,6 +111,11 @@ parser::~parser() throw () {}
  *  @param[in] path The configuration file path.
  */
 void parser::parse(std::string const& path, state& retention) {
+  if (binary::is_binary(path)) {
+    _parse_binary(path, retention);
+    return;
+  }
+
   std::ifstream stream(path.c_str(), std::ios::binary);
   if (!stream.is_open())
     throw (engine_error() << "Parsing of retention file failed: "
@@ -79,6 +144,70 @@ void parser::parse(std::string const& path, state& retention) {
   }
 }
 
+/**
+ *  Parse binary retention file. Records are decoded by several
+ *  threads, then stored in file order.
+ *
+ *  @param[in]  path       The retention file path.
+ *  @param[out] retention  The state to fill.
+ */
+void parser::_parse_binary(std::string const& path, state& retention) {
+  binary::reader reader(path);
+
+  long cpus(sysconf(_SC_NPROCESSORS_ONLN));
+  std::size_t threads(reader.size() / min_records_per_thread);
+  if (threads > max_threads)
+    threads = max_threads;
+  if ((cpus > 0) && (threads > static_cast<std::size_t>(cpus)))
+    threads = cpus;
+  if (!threads)
+    threads = 1;
+
+  std::vector<binary_chunk*> chunks;
+  std::size_t running(0);
+  try {
+    for (std::size_t i(0); i < threads; ++i)
+      chunks.push_back(new binary_chunk(
+                             reader,
+                             reader.size() * i / threads,
+                             reader.size() * (i + 1) / threads));
+    if (threads == 1)
+      chunks[0]->decode();
+    else {
+      for (; running < threads; ++running)
+        chunks[running]->exec();
+      for (std::size_t i(0); i < threads; ++i)
+        chunks[i]->wait();
+      running = 0;
+    }
+
+    for (std::vector<binary_chunk*>::const_iterator
+           it(chunks.begin()), end(chunks.end());
+         it != end;
+         ++it) {
+      if (!(*it)->error.empty())
+        throw (engine_error() << "Parsing of retention file '"
+               << path << "' failed: " << (*it)->error);
+      for (std::vector<object_ptr>::const_iterator
+             obj((*it)->objects.begin()), obj_end((*it)->objects.end());
+           obj != obj_end;
+           ++obj)
+        (this->*_store[(*obj)->type()])(retention, *obj);
+    }
+  }
+  catch (...) {
+    for (std::size_t i(0); i < chunks.size(); ++i) {
+      if (i < running)
+        chunks[i]->wait();
+      delete chunks[i];
+    }
+    throw;
+  }
+  for (std::size_t i(0); i < chunks.size(); ++i)
+    delete chunks[i];
+  return;
+}
+
 /**
  *  Store object into the state list.
  *
@@ -20,6 +20,7 @@
 
 #include <sstream>
 #include "com/centreon/engine/broker.hh"
+#include "com/centreon/engine/commands/system_runner.hh"
 #include "com/centreon/engine/globals.hh"
 #include "com/centreon/engine/logging.hh"
 #include "com/centreon/engine/logging/logger.hh"
@@ -31,9 +32,108 @@
 #include "com/centreon/engine/perfdata.hh"
 #include "com/centreon/engine/sehandlers.hh"
 #include "com/centreon/engine/utils.hh"
+#include "find.hh"
 
+using namespace com::centreon;
+using namespace com::centreon::engine;
 using namespace com::centreon::engine::logging;
 
+/**
+ *  Send the event handler end event to the broker once the event
+ *  handler command is over. Host and service are looked up again
+ *  because they might have been removed in the meantime.
+ */
+class                event_handler_end
+  : public commands::system_runner::callback {
+public:
+                     event_handler_end(
+                       unsigned int type,
+                       char const* host_name,
+                       char const* service_description,
+                       timeval const& start_time,
+                       char const* command_name,
+                       char const* processed_command,
+                       char const* label)
+    : _command_name(command_name ? command_name : ""),
+      _host_name(host_name ? host_name : ""),
+      _label(label),
+      _processed_command(processed_command),
+      _service_description(
+        service_description ? service_description : ""),
+      _start_time(start_time),
+      _type(type) {}
+                     ~event_handler_end() throw () {}
+
+  void               finished(commands::result const& res) throw () {
+    int early_timeout(res.exit_status == process::timeout);
+    double exectime((res.end_time - res.start_time).to_seconds());
+
+    /* check to see if the event handler timed out */
+    if (early_timeout)
+      logger(log_event_handler | log_runtime_warning, basic)
+        << "Warning: " << _label << " command '"
+        << _processed_command << "' timed out after "
+        << config->event_handler_timeout() << " seconds";
+
+    /* get end time */
+    timeval end_time;
+    gettimeofday(&end_time, NULL);
+
+    /* find the object */
+    void* data(NULL);
+    int state(0);
+    int state_type(0);
+    if (_service_description.empty()) {
+      host* hst(find_host(_host_name.c_str()));
+      if (!hst)
+        return;
+      data = hst;
+      state = hst->current_state;
+      state_type = hst->state_type;
+    }
+    else {
+      service* svc(find_service(
+                     _host_name.c_str(),
+                     _service_description.c_str()));
+      if (!svc)
+        return;
+      data = svc;
+      state = svc->current_state;
+      state_type = svc->state_type;
+    }
+
+    /* send event data to broker */
+    broker_event_handler(
+      NEBTYPE_EVENTHANDLER_END,
+      NEBFLAG_NONE,
+      NEBATTR_NONE,
+      _type,
+      data,
+      state,
+      state_type,
+      _start_time,
+      end_time,
+      exectime,
+      config->event_handler_timeout(),
+      early_timeout,
+      res.exit_code,
+      _command_name.c_str(),
+      const_cast<char*>(_processed_command.c_str()),
+      const_cast<char*>(res.output.c_str()),
+      NULL);
+    return;
+  }
+
+private:
+  std::string        _command_name;
+  std::string        _host_name;
+  char const*        _label;
+  std::string        _processed_command;
+  std::string        _service_description;
+  timeval            _start_time;
+  unsigned int       _type;
+};
+
 /******************************************************************/
 /************* OBSESSIVE COMPULSIVE HANDLER FUNCTIONS *************/
 /******************************************************************/
@@ -43,8 +143,6 @@ int obsessive_compulsive_service_check_processor(service* svc) {
   char* raw_command = NULL;
   char* processed_command = NULL;
   host* temp_host = NULL;
-  int early_timeout = false;
-  double exectime = 0.0;
   int macro_options = STRIP_ILLEGAL_MACRO_CHARS | ESCAPE_MACRO_CHARS;
   nagios_macros mac;
 
@@ -104,31 +202,22 @@ int obsessive_compulsive_service_check_processor(service* svc) {
     "processor command line: " << processed_command;
 
   /* run the command */
-  try {
-      my_system_r(
-      &mac,
+  {
+    std::ostringstream oss;
+    oss << "Warning: OCSP command '" << processed_command
+        << "' for service '" << svc->description << "' on host '"
+        << svc->host_name << "' timed out after "
+        << config->ocsp_timeout() << " seconds";
+    commands::system_runner::instance().run(
+      commands::system_runner::obsessive_command,
       processed_command,
+      mac,
       config->ocsp_timeout(),
-      &early_timeout,
-      &exectime,
-      NULL,
-      0);
-  } catch (std::exception const& e) {
-    logger(log_runtime_error, basic)
-      << "Error: can't execute compulsive service processor command line '"
-      << processed_command << "' : " << e.what();
+      new commands::system_runner::timeout_warning(oss.str()));
   }
 
   clear_volatile_macros_r(&mac);
 
-  /* check to see if the command timed out */
-  if (early_timeout == true)
-    logger(log_runtime_warning, basic)
-      << "Warning: OCSP command '" << processed_command
-      << "' for service '" << svc->description << "' on host '"
-      << svc->host_name << "' timed out after "
-      << config->ocsp_timeout() << " seconds";
-
   /* free memory */
   delete[] raw_command;
   delete[] processed_command;
@@ -140,8 +229,6 @@ int obsessive_compulsive_service_check_processor(service* svc) {
 int obsessive_compulsive_host_check_processor(host* hst) {
   char* raw_command = NULL;
   char* processed_command = NULL;
-  int early_timeout = false;
-  double exectime = 0.0;
   int macro_options = STRIP_ILLEGAL_MACRO_CHARS | ESCAPE_MACRO_CHARS;
   nagios_macros mac;
 
@@ -196,29 +283,20 @@ int obsessive_compulsive_host_check_processor(host* hst) {
     "command line: " << processed_command;
 
   /* run the command */
-  try {
-    my_system_r(
-      &mac,
+  {
+    std::ostringstream oss;
+    oss << "Warning: OCHP command '" << processed_command
+        << "' for host '" << hst->name << "' timed out after "
+        << config->ochp_timeout() << " seconds";
+    commands::system_runner::instance().run(
+      commands::system_runner::obsessive_command,
       processed_command,
+      mac,
       config->ochp_timeout(),
-      &early_timeout,
-      &exectime,
-      NULL,
-      0);
-  } catch (std::exception const& e) {
-    logger(log_runtime_error, basic)
-      << "Error: can't execute compulsive host processor command line '"
-      << processed_command << "' : " << e.what();
+      new commands::system_runner::timeout_warning(oss.str()));
   }
   clear_volatile_macros_r(&mac);
 
-  /* check to see if the command timed out */
-  if (early_timeout == true)
-    logger(log_runtime_warning, basic)
-      << "Warning: OCHP command '" << processed_command
-      << "' for host '" << hst->name << "' timed out after "
-      << config->ochp_timeout() << " seconds";
-
   /* free memory */
   delete[] raw_command;
   delete[] processed_command;
@@ -296,7 +374,6 @@ int run_global_service_event_handler(nagios_macros* mac, service* svc) {
   char* raw_command = NULL;
   char* processed_command = NULL;
   char* processed_logentry = NULL;
-  char* command_output = NULL;
   int early_timeout = false;
   double exectime = 0.0;
   int result = 0;
@@ -396,54 +473,21 @@ int run_global_service_event_handler(nagios_macros* mac, service* svc) {
   }
 
   /* run the command */
-  try {
-    result = my_system_r(
-               mac,
-               processed_command,
-               config->event_handler_timeout(),
-               &early_timeout,
-               &exectime,
-               &command_output,
-               0);
-  } catch (std::exception const& e) {
-    logger(log_runtime_error, basic)
-      << "Error: can't execute global service event handler "
-         "command line '"
-      << processed_command << "' : " << e.what();
-  }
-
-  /* check to see if the event handler timed out */
-  if (early_timeout == true)
-    logger(log_event_handler | log_runtime_warning, basic)
-      << "Warning: Global service event handler command '"
-      << processed_command << "' timed out after "
-      << config->event_handler_timeout() << " seconds";
-
-  /* get end time */
-  gettimeofday(&end_time, NULL);
-
-  /* send event data to broker */
-  broker_event_handler(
-    NEBTYPE_EVENTHANDLER_END,
-    NEBFLAG_NONE,
-    NEBATTR_NONE,
-    GLOBAL_SERVICE_EVENTHANDLER,
-    (void*)svc,
-    svc->current_state,
-    svc->state_type,
-    start_time,
-    end_time,
-    exectime,
-    config->event_handler_timeout(),
-    early_timeout,
-    result,
-    config->global_service_event_handler().c_str(),
+  commands::system_runner::instance().run(
+    commands::system_runner::event_handler,
     processed_command,
-    command_output,
-    NULL);
+    *mac,
+    config->event_handler_timeout(),
+    new event_handler_end(
+          GLOBAL_SERVICE_EVENTHANDLER,
+          svc->host_name,
+          svc->description,
+          start_time,
+          config->global_service_event_handler().c_str(),
+          processed_command,
+          "Global service event handler"));
 
   /* free memory */
-  delete[] command_output;
   delete[] raw_command;
   delete[] processed_command;
   delete[] processed_logentry;
@@ -456,7 +500,6 @@ int run_service_event_handler(nagios_macros* mac, service* svc) {
   char* raw_command = NULL;
   char* processed_command = NULL;
   char* processed_logentry = NULL;
-  char* command_output = NULL;
   int early_timeout = false;
   double exectime = 0.0;
   int result = 0;
@@ -556,53 +599,21 @@ int run_service_event_handler(nagios_macros* mac, service* svc) {
   }
 
   /* run the command */
-  try {
-    result = my_system_r(
-               mac,
-               processed_command,
-               config->event_handler_timeout(),
-               &early_timeout,
-               &exectime,
-               &command_output,
-               0);
-  } catch (std::exception const& e) {
-    logger(log_runtime_error, basic)
-      << "Error: can't execute service event handler command line '"
-      << processed_command << "' : " << e.what();
-  }
-
-  /* check to see if the event handler timed out */
-  if (early_timeout == true)
-    logger(log_event_handler | log_runtime_warning, basic)
-      << "Warning: Service event handler command '" << processed_command
-      << "' timed out after " << config->event_handler_timeout()
-      << " seconds";
-
-  /* get end time */
-  gettimeofday(&end_time, NULL);
-
-  /* send event data to broker */
-  broker_event_handler(
-    NEBTYPE_EVENTHANDLER_END,
-    NEBFLAG_NONE,
-    NEBATTR_NONE,
-    SERVICE_EVENTHANDLER,
-    (void*)svc,
-    svc->current_state,
-    svc->state_type,
-    start_time,
-    end_time,
-    exectime,
-    config->event_handler_timeout(),
-    early_timeout,
-    result,
-    svc->event_handler,
+  commands::system_runner::instance().run(
+    commands::system_runner::event_handler,
     processed_command,
-    command_output,
-    NULL);
+    *mac,
+    config->event_handler_timeout(),
+    new event_handler_end(
+          SERVICE_EVENTHANDLER,
+          svc->host_name,
+          svc->description,
+          start_time,
+          svc->event_handler,
+          processed_command,
+          "Service event handler"));
 
   /* free memory */
-  delete[] command_output;
   delete[] raw_command;
   delete[] processed_command;
   delete[] processed_logentry;
@@ -673,7 +684,6 @@ int run_global_host_event_handler(nagios_macros* mac, host* hst) {
   char* raw_command = NULL;
   char* processed_command = NULL;
   char* processed_logentry = NULL;
-  char* command_output = NULL;
   int early_timeout = false;
   double exectime = 0.0;
   int result = 0;
@@ -773,53 +783,21 @@ int run_global_host_event_handler(nagios_macros* mac, host* hst) {
   }
 
   /* run the command */
-  try {
-    result = my_system_r(
-               mac,
-               processed_command,
-               config->event_handler_timeout(),
-               &early_timeout,
-               &exectime,
-               &command_output,
-               0);
-  } catch (std::exception const& e) {
-    logger(log_runtime_error, basic)
-      << "Error: can't execute global host event handler command line '"
-      << processed_command << "' : " << e.what();
-  }
-
-  /* check for a timeout in the execution of the event handler command */
-  if (early_timeout == true)
-    logger(log_event_handler | log_runtime_warning, basic)
-      << "Warning: Global host event handler command '"
-      << processed_command << "' timed out after "
-      << config->event_handler_timeout() << " seconds";
-
-  /* get end time */
-  gettimeofday(&end_time, NULL);
-
-  /* send event data to broker */
-  broker_event_handler(
-    NEBTYPE_EVENTHANDLER_END,
-    NEBFLAG_NONE,
-    NEBATTR_NONE,
-    GLOBAL_HOST_EVENTHANDLER,
-    (void*)hst,
-    hst->current_state,
-    hst->state_type,
-    start_time,
-    end_time,
-    exectime,
-    config->event_handler_timeout(),
-    early_timeout,
-    result,
-    config->global_host_event_handler().c_str(),
+  commands::system_runner::instance().run(
+    commands::system_runner::event_handler,
     processed_command,
-    command_output,
-    NULL);
+    *mac,
+    config->event_handler_timeout(),
+    new event_handler_end(
+          GLOBAL_HOST_EVENTHANDLER,
+          hst->name,
+          NULL,
+          start_time,
+          config->global_host_event_handler().c_str(),
+          processed_command,
+          "Global host event handler"));
 
   /* free memory */
-  delete[] command_output;
   delete[] raw_command;
   delete[] processed_command;
   delete[] processed_logentry;
@@ -832,7 +810,6 @@ int run_host_event_handler(nagios_macros* mac, host* hst) {
   char* raw_command = NULL;
   char* processed_command = NULL;
   char* processed_logentry = NULL;
-  char* command_output = NULL;
   int early_timeout = false;
   double exectime = 0.0;
   int result = 0;
@@ -929,53 +906,21 @@ int run_host_event_handler(nagios_macros* mac, host* hst) {
   }
 
   /* run the command */
-  try {
-    result = my_system_r(
-               mac,
-               processed_command,
-               config->event_handler_timeout(),
-               &early_timeout,
-               &exectime,
-               &command_output,
-               0);
-  } catch (std::exception const& e) {
-    logger(log_runtime_error, basic)
-      << "Error: can't execute host event handler command line '"
-      << processed_command << "' : " << e.what();
-  }
-
-  /* check to see if the event handler timed out */
-  if (early_timeout == true)
-    logger(log_event_handler | log_runtime_warning, basic)
-      << "Warning: Host event handler command '" << processed_command
-      << "' timed out after " << config->event_handler_timeout()
-      << " seconds";
-
-  /* get end time */
-  gettimeofday(&end_time, NULL);
-
-  /* send event data to broker */
-  broker_event_handler(
-    NEBTYPE_EVENTHANDLER_END,
-    NEBFLAG_NONE,
-    NEBATTR_NONE,
-    HOST_EVENTHANDLER,
-    (void*)hst,
-    hst->current_state,
-    hst->state_type,
-    start_time,
-    end_time,
-    exectime,
-    config->event_handler_timeout(),
-    early_timeout,
-    result,
-    hst->event_handler,
+  commands::system_runner::instance().run(
+    commands::system_runner::event_handler,
     processed_command,
-    command_output,
-    NULL);
+    *mac,
+    config->event_handler_timeout(),
+    new event_handler_end(
+          HOST_EVENTHANDLER,
+          hst->name,
+          NULL,
+          start_time,
+          hst->event_handler,
+          processed_command,
+          "Host event handler"));
 
   /* free memory */
-  delete[] command_output;
   delete[] raw_command;
   delete[] processed_command;
   delete[] processed_logentry;
@@ -1096,8 +1041,8 @@ int handle_host_state(host* hst) {
     check_pending_flex_host_downtime(hst);
 
     if (hst->current_state == HOST_UP) {
-      host_other_props[hst->name].recovery_been_sent = false;
-      host_other_props[hst->name].initial_notif_time = 0;
+      hst->other_props->recovery_been_sent = false;
+      hst->other_props->initial_notif_time = 0;
     }
 
     /* notify contacts about the recovery or problem if its a "hard" state */
@@ -1117,7 +1062,7 @@ int handle_host_state(host* hst) {
       hst->current_attempt = 1;
 
     /* the host recovered, so reset the current notification number and state flags (after the recovery notification has gone out) */
-    if (hst->current_state == HOST_UP && host_other_props[hst->name].recovery_been_sent) {
+    if (hst->current_state == HOST_UP && hst->other_props->recovery_been_sent) {
       hst->current_notification_number = 0;
       hst->notified_on_down = false;
       hst->notified_on_unreachable = false;
@@ -1128,12 +1073,12 @@ int handle_host_state(host* hst) {
   else {
 
     bool old_recovery_been_sent
-           = host_other_props[hst->name].recovery_been_sent;
+           = hst->other_props->recovery_been_sent;
 
     /* notify contacts if needed */
     if ((hst->current_state != HOST_UP ||
          (hst->current_state == HOST_UP
-          && !host_other_props[hst->name].recovery_been_sent))
+          && !hst->other_props->recovery_been_sent))
         && hst->state_type == HARD_STATE)
       host_notification(
         hst,
@@ -1144,7 +1089,7 @@ int handle_host_state(host* hst) {
 
     /* the host recovered, so reset the current notification number and state flags (after the recovery notification has gone out) */
     if (!old_recovery_been_sent
-        && host_other_props[hst->name].recovery_been_sent
+        && hst->other_props->recovery_been_sent
         && hst->current_state == HOST_UP) {
       hst->current_notification_number = 0;
       hst->notified_on_down = false;
@@ -0,0 +1,274 @@
+/*
+** Copyright 2017 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstring>
+#include "com/centreon/engine/globals.hh"
+#include "com/centreon/engine/snapshot.hh"
+#include "com/centreon/timestamp.hh"
+
+using namespace com::centreon;
+using namespace com::centreon::engine;
+
+/**
+ *  Take a snapshot of all hosts, services, contacts, comments and
+ *  downtimes.
+ *
+ *  @param[in] head  Data that does not belong to objects (program
+ *                   status, ...), already serialized by the caller.
+ */
+snapshot::snapshot(std::string const& head)
+  : _created(time(NULL)),
+    _duration(0),
+    _head(head),
+    _retained_contact_host_attribute_mask(
+      config->retained_contact_host_attribute_mask()),
+    _retained_contact_service_attribute_mask(
+      config->retained_contact_service_attribute_mask()),
+    _retained_host_attribute_mask(config->retained_host_attribute_mask()),
+    _size(head.size()),
+    _use_binary_state_retention(config->use_binary_state_retention()) {
+  timestamp start(timestamp::now());
+
+  // Only check outputs change at every check, other strings and
+  // custom variables are shared with objects (runtime commands that
+  // replace them flush the snapshot writer first). Other properties
+  // are copied in vectors that must not be reallocated once pointed
+  // to.
+  unsigned int count(0);
+  for (host* hst(host_list); hst; hst = hst->next)
+    ++count;
+  _hosts.reserve(count);
+  _host_props.reserve(count);
+  for (host* hst(host_list); hst; hst = hst->next) {
+    _hosts.push_back(*hst);
+    host& h(_hosts.back());
+    h.plugin_output = _dup(hst->plugin_output);
+    h.long_plugin_output = _dup(hst->long_plugin_output);
+    h.perf_data = _dup(hst->perf_data);
+    if (hst->other_props) {
+      _host_props.push_back(*hst->other_props);
+      h.other_props = &_host_props.back();
+    }
+    h.next = NULL;
+  }
+  _size += _hosts.size() * sizeof(host);
+
+  count = 0;
+  for (service* svc(service_list); svc; svc = svc->next)
+    ++count;
+  _services.reserve(count);
+  _service_props.reserve(count);
+  for (service* svc(service_list); svc; svc = svc->next) {
+    _services.push_back(*svc);
+    service& s(_services.back());
+    s.plugin_output = _dup(svc->plugin_output);
+    s.long_plugin_output = _dup(svc->long_plugin_output);
+    s.perf_data = _dup(svc->perf_data);
+    if (svc->other_props) {
+      _service_props.push_back(*svc->other_props);
+      s.other_props = &_service_props.back();
+    }
+    s.next = NULL;
+  }
+  _size += _services.size() * sizeof(service);
+
+  for (contact* cntct(contact_list); cntct; cntct = cntct->next) {
+    _contacts.push_back(*cntct);
+    _contacts.back().next = NULL;
+  }
+  _size += _contacts.size() * sizeof(contact);
+
+  // Comments and downtimes can be deleted at any time.
+  for (comment* com(comment_list); com; com = com->next) {
+    _comments.push_back(*com);
+    comment& c(_comments.back());
+    c.host_name = _dup(com->host_name);
+    c.service_description = _dup(com->service_description);
+    c.author = _dup(com->author);
+    c.comment_data = _dup(com->comment_data);
+    c.next = NULL;
+    c.nexthash = NULL;
+  }
+  _size += _comments.size() * sizeof(comment);
+
+  for (scheduled_downtime* dt(scheduled_downtime_list);
+       dt;
+       dt = dt->next) {
+    _downtimes.push_back(*dt);
+    scheduled_downtime& d(_downtimes.back());
+    d.host_name = _dup(dt->host_name);
+    d.service_description = _dup(dt->service_description);
+    d.author = _dup(dt->author);
+    d.comment = _dup(dt->comment);
+    d.next = NULL;
+  }
+  _size += _downtimes.size() * sizeof(scheduled_downtime);
+
+  _duration = (timestamp::now() - start).to_useconds();
+}
+
+/**
+ *  Destructor, release copied data.
+ */
+snapshot::~snapshot() throw () {
+  for (std::vector<char*>::const_iterator
+         it(_strings.begin()), end(_strings.end());
+       it != end;
+       ++it)
+    delete[] *it;
+}
+
+/**
+ *  Get copied comments.
+ *
+ *  @return Comments.
+ */
+std::vector<comment_struct> const& snapshot::comments() const throw () {
+  return (_comments);
+}
+
+/**
+ *  Get copied contacts.
+ *
+ *  @return Contacts.
+ */
+std::vector<contact_struct> const& snapshot::contacts() const throw () {
+  return (_contacts);
+}
+
+/**
+ *  Get the time the snapshot was taken.
+ *
+ *  @return Creation time.
+ */
+time_t snapshot::created() const throw () {
+  return (_created);
+}
+
+/**
+ *  Get copied downtimes.
+ *
+ *  @return Downtimes.
+ */
+std::vector<scheduled_downtime_struct> const&
+  snapshot::downtimes() const throw () {
+  return (_downtimes);
+}
+
+/**
+ *  Get the time spent taking the snapshot.
+ *
+ *  @return Duration in microseconds.
+ */
+unsigned long long snapshot::duration() const throw () {
+  return (_duration);
+}
+
+/**
+ *  Get data serialized by the caller.
+ *
+ *  @return Serialized data.
+ */
+std::string const& snapshot::head() const throw () {
+  return (_head);
+}
+
+/**
+ *  Get copied hosts.
+ *
+ *  @return Hosts.
+ */
+std::vector<host_struct> const& snapshot::hosts() const throw () {
+  return (_hosts);
+}
+
+/**
+ *  Get the retained contact host attribute mask when the snapshot was
+ *  taken.
+ *
+ *  @return Attribute mask.
+ */
+unsigned long snapshot::retained_contact_host_attribute_mask() const throw () {
+  return (_retained_contact_host_attribute_mask);
+}
+
+/**
+ *  Get the retained contact service attribute mask when the snapshot
+ *  was taken.
+ *
+ *  @return Attribute mask.
+ */
+unsigned long snapshot::retained_contact_service_attribute_mask() const throw () {
+  return (_retained_contact_service_attribute_mask);
+}
+
+/**
+ *  Get the retained host attribute mask when the snapshot was taken.
+ *
+ *  @return Attribute mask.
+ */
+unsigned long snapshot::retained_host_attribute_mask() const throw () {
+  return (_retained_host_attribute_mask);
+}
+
+/**
+ *  Get copied services.
+ *
+ *  @return Services.
+ */
+std::vector<service_struct> const& snapshot::services() const throw () {
+  return (_services);
+}
+
+/**
+ *  Get the approximate memory size of the snapshot.
+ *
+ *  @return Size in bytes.
+ */
+unsigned long snapshot::size() const throw () {
+  return (_size);
+}
+
+/**
+ *  Check if binary state retention was used when the snapshot was
+ *  taken.
+ *
+ *  @return True if binary state retention is used.
+ */
+bool snapshot::use_binary_state_retention() const throw () {
+  return (_use_binary_state_retention);
+}
+
+/**
+ *  Duplicate a string.
+ *
+ *  @param[in] str  The string, can be NULL.
+ *
+ *  @return The copy, owned by the snapshot.
+ */
+char* snapshot::_dup(char const* str) {
+  if (!str)
+    return (NULL);
+  std::size_t len(strlen(str) + 1);
+  char* copy(new char[len]);
+  memcpy(copy, str, len);
+  _strings.push_back(copy);
+  _size += len;
+  return (copy);
+}
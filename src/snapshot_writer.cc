@@ -0,0 +1,202 @@
+/*
+** Copyright 2017 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <exception>
+#include "com/centreon/concurrency/locker.hh"
+#include "com/centreon/engine/logging/logger.hh"
+#include "com/centreon/engine/snapshot_writer.hh"
+#include "com/centreon/timestamp.hh"
+
+using namespace com::centreon;
+using namespace com::centreon::engine;
+using namespace com::centreon::engine::logging;
+
+// Class instance.
+static snapshot_writer* _instance = NULL;
+
+/**************************************
+*                                     *
+*           Public Methods            *
+*                                     *
+**************************************/
+
+/**
+ *  Wait until all pushed snapshots are written.
+ */
+void snapshot_writer::flush() {
+  concurrency::locker lock(&_lock);
+  for (;;) {
+    bool pending(_busy);
+    for (unsigned int i(0); !pending && (i < file_num); ++i)
+      pending = (_pending[i].snap != NULL);
+    if (!pending)
+      break;
+    _cv.wait(&_lock);
+  }
+  return;
+}
+
+/**
+ *  Get statistics of the last snapshots of a file.
+ *
+ *  @param[in] f  The file.
+ *
+ *  @return Statistics.
+ */
+snapshot_writer::stats snapshot_writer::get_stats(file f) const {
+  concurrency::locker lock(&_lock);
+  return (_stats[f]);
+}
+
+/**
+ *  Get instance of the snapshot writer singleton.
+ *
+ *  @return This singleton.
+ */
+snapshot_writer& snapshot_writer::instance() {
+  return (*_instance);
+}
+
+/**
+ *  Load singleton.
+ */
+void snapshot_writer::load() {
+  if (!_instance) {
+    _instance = new snapshot_writer;
+    _instance->exec();
+  }
+  return;
+}
+
+/**
+ *  Write a snapshot from the background thread.
+ *
+ *  @param[in] f     The file the snapshot is written to.
+ *  @param[in] snap  The snapshot, owned by the writer.
+ *  @param[in] func  Function that writes the snapshot.
+ *  @param[in] path  The file path given to func.
+ */
+void snapshot_writer::push(
+                        file f,
+                        snapshot* snap,
+                        writer func,
+                        std::string const& path) {
+  concurrency::locker lock(&_lock);
+  if (_pending[f].snap) {
+    delete _pending[f].snap;
+    ++_stats[f].dropped;
+    logger(dbg_events, more)
+      << "Snapshot writer is late, snapshot of '" << _pending[f].path
+      << "' dropped";
+  }
+  _pending[f].func = func;
+  _pending[f].path = path;
+  _pending[f].snap = snap;
+  _stats[f].snapshot_time = snap->duration();
+  _stats[f].snapshot_size = snap->size();
+  _cv.wake_all();
+  return;
+}
+
+/**
+ *  Unload singleton, waiting for pushed snapshots to be written.
+ */
+void snapshot_writer::unload() {
+  delete _instance;
+  _instance = NULL;
+  return;
+}
+
+/**************************************
+*                                     *
+*           Private Methods           *
+*                                     *
+**************************************/
+
+/**
+ *  Default constructor.
+ */
+snapshot_writer::snapshot_writer()
+  : _busy(false), _quit(false) {
+  for (unsigned int i(0); i < file_num; ++i) {
+    _pending[i].func = NULL;
+    _pending[i].snap = NULL;
+    _stats[i].dropped = 0;
+    _stats[i].snapshot_time = 0;
+    _stats[i].snapshot_size = 0;
+    _stats[i].write_time = 0;
+  }
+}
+
+/**
+ *  Destructor.
+ */
+snapshot_writer::~snapshot_writer() throw () {
+  {
+    concurrency::locker lock(&_lock);
+    _quit = true;
+    _cv.wake_all();
+  }
+  concurrency::thread::wait();
+}
+
+/**
+ *  Thread main loop.
+ */
+void snapshot_writer::_run() {
+  concurrency::locker lock(&_lock);
+  for (;;) {
+    unsigned int f(0);
+    while ((f < file_num) && !_pending[f].snap)
+      ++f;
+    if (f == file_num) {
+      if (_quit)
+        break;
+      _cv.wait(&_lock);
+      continue;
+    }
+
+    job j(_pending[f]);
+    _pending[f].snap = NULL;
+    _busy = true;
+    lock.unlock();
+
+    timestamp start(timestamp::now());
+    try {
+      (*j.func)(*j.snap, j.path);
+    }
+    catch (std::exception const& e) {
+      logger(log_runtime_error, basic)
+        << "Error: Could not write snapshot of '" << j.path
+        << "': " << e.what();
+    }
+    unsigned long long duration((timestamp::now() - start).to_useconds());
+    logger(dbg_events, more)
+      << "Snapshot of '" << j.path << "' (" << j.snap->size()
+      << " bytes) taken in " << j.snap->duration()
+      << " us and written in " << duration << " us";
+    delete j.snap;
+
+    lock.relock();
+    _busy = false;
+    _stats[f].write_time = duration;
+    _cv.wake_all();
+  }
+  return;
+}
@@ -21,6 +21,7 @@
 #include "com/centreon/engine/broker.hh"
 #include "com/centreon/engine/events/defines.hh"
 #include "com/centreon/engine/globals.hh"
+#include "com/centreon/engine/macros/summary.hh"
 #include "com/centreon/engine/statusdata.hh"
 #include "com/centreon/engine/xsddefault.hh"
 
@@ -77,6 +78,9 @@ int update_program_status(int aggregated_dump) {
 
 /* updates host status info */
 int update_host_status(host* hst, int aggregated_dump) {
+  /* update summary macros totals */
+  com::centreon::engine::macros::summary::instance().update(hst);
+
   /* send data to event broker (non-aggregated dumps only) */
   if (aggregated_dump == false)
     broker_host_status(
@@ -90,6 +94,9 @@ int update_host_status(host* hst, int aggregated_dump) {
 
 /* updates service status info */
 int update_service_status(service* svc, int aggregated_dump) {
+  /* update summary macros totals */
+  com::centreon::engine::macros::summary::instance().update(svc);
+
   /* send data to event broker (non-aggregated dumps only) */
   if (aggregated_dump == false)
     broker_service_status(
@@ -19,36 +19,71 @@
 ** <http://www.gnu.org/licenses/>.
 */
 
+#include <algorithm>
+#include <cstring>
 #include <ctime>
+#include <limits>
+#include <utility>
+#include <vector>
 #include "com/centreon/engine/logging/logger.hh"
 #include "com/centreon/engine/objects/daterange.hh"
 #include "com/centreon/engine/objects/timeperiod.hh"
 #include "com/centreon/engine/objects/timeperiodexclusion.hh"
 #include "com/centreon/engine/objects/timerange.hh"
 #include "com/centreon/engine/timeperiod.hh"
+#include "com/centreon/engine/zoneinfo.hh"
+#include "com/centreon/unordered_hash.hh"
 
 using namespace com::centreon::engine;
 using namespace com::centreon::engine::logging;
 
+// Number of days resolved by the valid intervals cache.
+static unsigned int const _cache_days(7);
+
+// Valid intervals of a time period, resolved for some days.
+struct                    cached_intervals {
+  time_t                  end;
+  time_t                  start;
+  std::vector<std::pair<time_t, time_t> >
+                          valid;
+};
+
+// Valid intervals of a time period for one timezone. Days starting at
+// the current time are kept apart from those of farther queries, so
+// that these do not evict them.
+struct                    cached_windows {
+  cached_intervals        current;
+  cached_intervals        other;
+  zoneinfo const*         zone;
+};
+
+// Valid intervals cache.
+static umap<timeperiod*, std::vector<cached_windows> > _cache;
+
 // Static declarations.
 static void _get_next_valid_time_per_timeperiod(
               time_t preferred_time,
               time_t* valid_time,
-              timeperiod* tperiod);
+              timeperiod* tperiod,
+              zoneinfo const& zone);
 
 /**
  *  Add a round number of days (expressed in seconds) to a date.
  *
  *  @param[in] middnight  Midnight of base day.
  *  @param[in] skip       Number of days to skip (in seconds).
+ *  @param[in] zone       Timezone.
  *
  *  @return Midnight of the day in skip seconds.
  */
-static time_t _add_round_days_to_midnight(time_t midnight, time_t skip) {
+static time_t _add_round_days_to_midnight(
+                time_t midnight,
+                time_t skip,
+                zoneinfo const& zone) {
   // Compute expected time with no DST.
   time_t next_day_time(midnight + skip);
   struct tm next_day;
-  localtime_r(&next_day_time, &next_day);
+  zone.localtime(next_day_time, &next_day);
 
   // There was a DST shift in between.
   if (next_day.tm_hour || next_day.tm_min || next_day.tm_sec) {
@@ -59,12 +94,12 @@ static time_t _add_round_days_to_midnight(time_t midnight, time_t skip) {
     ** time to midnight, convert back and we're done.
     */
     next_day_time += 12 * 60 * 60;
-    localtime_r(&next_day_time, &next_day);
+    zone.localtime(next_day_time, &next_day);
     next_day.tm_hour = 0;
     next_day.tm_min = 0;
     next_day.tm_sec = 0;
     next_day.tm_isdst = -1;
-    next_day_time = mktime(&next_day);
+    next_day_time = zone.mktime(&next_day);
   }
 
   return (next_day_time);
@@ -77,13 +112,15 @@ static time_t _add_round_days_to_midnight(time_t midnight, time_t skip) {
  *  @param[in] year      Year.
  *  @param[in] month     Month.
  *  @param[in] monthday  Day in month.
+ *  @param[in] zone      Timezone.
  *
  *  @return Requested timestamp, (time_t)-1 if conversion failed.
  */
 static time_t calculate_time_from_day_of_month(
                 int year,
                 int month,
-                int monthday) {
+                int monthday,
+                zoneinfo const& zone) {
   time_t midnight;
   tm t;
 
@@ -96,7 +133,7 @@ static time_t calculate_time_from_day_of_month(
     t.tm_mon = month;
     t.tm_mday = monthday;
     t.tm_isdst = -1;
-    midnight = mktime(&t);
+    midnight = zone.mktime(&t);
 
     // If we rolled over to the next month, time is invalid, assume the
     // user's intention is to keep it in the current month.
@@ -116,7 +153,7 @@ static time_t calculate_time_from_day_of_month(
       t.tm_year = year;
       t.tm_mday = day;
       t.tm_isdst = -1;
-      midnight = mktime(&t);
+      midnight = zone.mktime(&t);
     } while ((midnight == (time_t)-1)
              || (t.tm_mon != month));
 
@@ -130,7 +167,7 @@ static time_t calculate_time_from_day_of_month(
     else
       t.tm_mday += monthday + 1;
     t.tm_isdst = -1;
-    midnight = mktime(&t);
+    midnight = zone.mktime(&t);
   }
 
   return (midnight);
@@ -145,6 +182,7 @@ static time_t calculate_time_from_day_of_month(
  *  @param[in] weekday         Target weekday.
  *  @param[in] weekday_offset  Weekday offset (1 is first, 2 is second,
  *                             -1 is last).
+ *  @param[in] zone            Timezone.
  *
  *  @return Requested timestamp, (time_t)-1 if conversion failed.
  */
@@ -152,7 +190,8 @@ static time_t calculate_time_from_weekday_of_month(
                 int year,
                 int month,
                 int weekday,
-                int weekday_offset) {
+                int weekday_offset,
+                zoneinfo const& zone) {
   // Compute first day of month (to get weekday).
   tm t;
   t.tm_sec = 0;
@@ -162,7 +201,7 @@ static time_t calculate_time_from_weekday_of_month(
   t.tm_mon = month;
   t.tm_mday = 1;
   t.tm_isdst = -1;
-  time_t midnight(mktime(&t));
+  time_t midnight(zone.mktime(&t));
 
   // How many days must we advance to reach the first instance of the
   // weekday this month ?
@@ -181,7 +220,7 @@ static time_t calculate_time_from_weekday_of_month(
     t.tm_year = year;
     t.tm_mday = days + 1;
     t.tm_isdst = -1;
-    midnight = mktime(&t);
+    midnight = zone.mktime(&t);
 
     // If we rolled over to the next month, time is invalid, assume the
     // user's intention is to keep it in the current month.
@@ -201,7 +240,7 @@ static time_t calculate_time_from_weekday_of_month(
       t.tm_year = year;
       t.tm_mday = days + 1;
       t.tm_isdst = -1;
-      midnight = mktime(&t);
+      midnight = zone.mktime(&t);
     } while ((midnight == (time_t)-1)
              || (t.tm_mon != month));
 
@@ -215,7 +254,7 @@ static time_t calculate_time_from_weekday_of_month(
     else
       t.tm_mday += days;
     t.tm_isdst = -1;
-    midnight = mktime(&t);
+    midnight = zone.mktime(&t);
   }
 
   return (midnight);
@@ -228,6 +267,8 @@ struct   time_info {
   time_t preferred_time;
   tm     preftime;
   time_t midnight;
+  zoneinfo const*
+         zone;
 };
 
 /**
@@ -245,7 +286,7 @@ static bool _daterange_calendar_date_to_time_t(
               time_info const& ti,
               time_t& start,
               time_t& end) {
-  (void)ti;
+  zoneinfo const& zone(*ti.zone);
 
   tm t;
   t.tm_sec = 0;
@@ -255,7 +296,7 @@ static bool _daterange_calendar_date_to_time_t(
   t.tm_mday = r.smday;
   t.tm_mon = r.smon;
   t.tm_year = r.syear - 1900;
-  if ((start = mktime(&t)) == (time_t)-1)
+  if ((start = zone.mktime(&t)) == (time_t)-1)
     return (false);
 
   if (r.eyear) {
@@ -266,9 +307,9 @@ static bool _daterange_calendar_date_to_time_t(
     t.tm_mday = r.emday;
     t.tm_mon = r.emon;
     t.tm_year = r.eyear - 1900;
-    if ((end = mktime(&t)) == (time_t)-1)
+    if ((end = zone.mktime(&t)) == (time_t)-1)
       return (false);
-    end = _add_round_days_to_midnight(end, 24 * 60 * 60);
+    end = _add_round_days_to_midnight(end, 24 * 60 * 60, zone);
   }
   else
     end = (time_t)-1;
@@ -291,6 +332,8 @@ static bool _daterange_month_date_to_time_t(
               time_info const& ti,
               time_t& start,
               time_t& end) {
+  zoneinfo const& zone(*ti.zone);
+
   // End before start ?
   bool end_before_start(
          (r.smon > r.emon)
@@ -302,13 +345,14 @@ static bool _daterange_month_date_to_time_t(
         : ti.preftime.tm_year);
   bool found(false);
   for (int i(0); (i < 3) && !found; ++i, ++year) {
-    start = calculate_time_from_day_of_month(year, r.smon, r.smday);
+    start = calculate_time_from_day_of_month(year, r.smon, r.smday, zone);
     end = calculate_time_from_day_of_month(
             year + (end_before_start ? 1 : 0),
             r.emon,
-            r.emday);
+            r.emday,
+            zone);
     if (end != (time_t)-1) {
-      end = _add_round_days_to_midnight(end, 24 * 60 * 60);
+      end = _add_round_days_to_midnight(end, 24 * 60 * 60, zone);
       if (ti.preferred_time < end)
         found = true;
     }
@@ -332,6 +376,8 @@ static bool _daterange_month_day_to_time_t(
               time_info const& ti,
               time_t& start,
               time_t& end) {
+  zoneinfo const& zone(*ti.zone);
+
   // Check if there is a month decay between start and end.
   bool decay;
   if (r.smday >= 0) {
@@ -358,14 +404,16 @@ static bool _daterange_month_day_to_time_t(
     start = calculate_time_from_day_of_month(
               ti.preftime.tm_year,
               ti.preftime.tm_mon,
-              r.smday);
+              r.smday,
+              zone);
     end = calculate_time_from_day_of_month(
             ti.preftime.tm_year,
             ti.preftime.tm_mon,
-            r.emday);
+            r.emday,
+            zone);
     if ((start == (time_t)-1) || (end == (time_t)-1))
       return (false);
-    end = _add_round_days_to_midnight(end, 24 * 60 * 60);
+    end = _add_round_days_to_midnight(end, 24 * 60 * 60, zone);
   }
   // Decay.
   else {
@@ -381,14 +429,16 @@ static bool _daterange_month_day_to_time_t(
     start = calculate_time_from_day_of_month(
               year,
               month,
-              r.smday);
+              r.smday,
+              zone);
     end = calculate_time_from_day_of_month(
             ti.preftime.tm_year,
             ti.preftime.tm_mon,
-            r.emday);
+            r.emday,
+            zone);
     if ((start == (time_t)-1) || (end == (time_t)-1))
       return (false);
-    end = _add_round_days_to_midnight(end, 24 * 60 * 60);
+    end = _add_round_days_to_midnight(end, 24 * 60 * 60, zone);
 
     // If interval is invalid, we need to check
     // current month -> next month.
@@ -404,14 +454,16 @@ static bool _daterange_month_day_to_time_t(
       start = calculate_time_from_day_of_month(
                 ti.preftime.tm_year,
                 ti.preftime.tm_mon,
-                r.smday);
+                r.smday,
+                zone);
       end = calculate_time_from_day_of_month(
               year,
               month,
-              r.emday);
+              r.emday,
+              zone);
       if ((start == (time_t)-1) || (end == (time_t)-1))
         return (false);
-      end = _add_round_days_to_midnight(end, 24 * 60 * 60);
+      end = _add_round_days_to_midnight(end, 24 * 60 * 60, zone);
     }
   }
 
@@ -433,6 +485,8 @@ static bool _daterange_month_week_day_to_time_t(
               time_info const& ti,
               time_t& start,
               time_t& end) {
+  zoneinfo const& zone(*ti.zone);
+
   // Check if there is a year decay between start and end.
   bool decay(r.smon > r.emon);
 
@@ -442,15 +496,17 @@ static bool _daterange_month_week_day_to_time_t(
               ti.preftime.tm_year,
               r.smon,
               r.swday,
-              r.swday_offset);
+              r.swday_offset,
+              zone);
     end = calculate_time_from_weekday_of_month(
             ti.preftime.tm_year,
             r.emon,
             r.ewday,
-            r.ewday_offset);
+            r.ewday_offset,
+            zone);
     if ((start == (time_t)-1) || (end == (time_t)-1))
       return (false);
-    end = _add_round_days_to_midnight(end, 24 * 60 * 60);
+    end = _add_round_days_to_midnight(end, 24 * 60 * 60, zone);
   }
   // Decay, check previous year -> current year and
   // current year -> next year intervals.
@@ -460,15 +516,17 @@ static bool _daterange_month_week_day_to_time_t(
               ti.preftime.tm_year - 1,
               r.smon,
               r.swday,
-              r.swday_offset);
+              r.swday_offset,
+              zone);
     end = calculate_time_from_weekday_of_month(
             ti.preftime.tm_year,
             r.emon,
             r.ewday,
-            r.ewday_offset);
+            r.ewday_offset,
+            zone);
     if ((start == (time_t)-1) || (end == (time_t)-1))
       return (false);
-    end = _add_round_days_to_midnight(end, 24 * 60 * 60);
+    end = _add_round_days_to_midnight(end, 24 * 60 * 60, zone);
 
     // If interval is invalid, we need to check
     // current year -> next year.
@@ -477,15 +535,17 @@ static bool _daterange_month_week_day_to_time_t(
                 ti.preftime.tm_year,
                 r.smon,
                 r.swday,
-                r.swday_offset);
+                r.swday_offset,
+                zone);
       end = calculate_time_from_weekday_of_month(
               ti.preftime.tm_year + 1,
               r.emon,
               r.ewday,
-              r.ewday_offset);
+              r.ewday_offset,
+              zone);
       if ((start == (time_t)-1) || (end == (time_t)-1))
         return (false);
-      end = _add_round_days_to_midnight(end, 24 * 60 * 60);
+      end = _add_round_days_to_midnight(end, 24 * 60 * 60, zone);
     }
   }
 
@@ -507,6 +567,8 @@ static bool _daterange_week_day_to_time_t(
               time_info const& ti,
               time_t& start,
               time_t& end) {
+  zoneinfo const& zone(*ti.zone);
+
   // What year/month should we use ?
   int year;
   int month;
@@ -519,14 +581,16 @@ static bool _daterange_week_day_to_time_t(
               year,
               month,
               r.swday,
-              r.swday_offset);
+              r.swday_offset,
+              zone);
 
     // Use same year and month as was calculated for start time above.
     end = calculate_time_from_weekday_of_month(
             year,
             month,
             r.ewday,
-            r.ewday_offset);
+            r.ewday_offset,
+            zone);
     if (end == (time_t)-1) {
       // End date can't be helped, so skip it.
       if (r.ewday_offset < 0)
@@ -544,10 +608,10 @@ static bool _daterange_week_day_to_time_t(
         end_month = 0;
         end_year = year + 1;
       }
-      end = calculate_time_from_day_of_month(end_year, end_month, 0);
+      end = calculate_time_from_day_of_month(end_year, end_month, 0, zone);
     }
     else
-      end = _add_round_days_to_midnight(end, 24 * 60 * 60);
+      end = _add_round_days_to_midnight(end, 24 * 60 * 60, zone);
 
     // Error checking.
     if (((time_t)-1 == start)
@@ -610,6 +674,8 @@ static bool _daterange_to_time_t(
   if (!(*tabfunc[type])(*r, *ti, start, end))
     return (false);
 
+  zoneinfo const& zone(*ti->zone);
+
   // If skipping days...
   if (r->skip_interval > 1) {
     // Advance to the next possible skip date
@@ -621,12 +687,16 @@ static bool _daterange_to_time_t(
 
       // Advance start date to next skip day
       if (!(days % r->skip_interval))
-        start = _add_round_days_to_midnight(start, days * 24 * 60 * 60);
+        start = _add_round_days_to_midnight(
+                  start,
+                  days * 24 * 60 * 60,
+                  zone);
       else
         start = _add_round_days_to_midnight(
                   start,
                   ((days - (days % r->skip_interval) + r->skip_interval)
-                   * 24 * 60 * 60));
+                   * 24 * 60 * 60),
+                  zone);
     }
   }
 
@@ -641,6 +711,7 @@ static bool _daterange_to_time_t(
  *  @param[in] drange             Date range.
  *  @param[in] drange_start_time  Date range start time.
  *  @param[in] drange_end_time    Date range end time.
+ *  @param[in] zone               Timezone.
  *
  *  @return Earliest midnight.
  */
@@ -648,14 +719,16 @@ static time_t _earliest_midnight_in_daterange(
                 time_t preferred_time,
                 daterange* drange,
                 time_t drange_start_time,
-                time_t drange_end_time) {
+                time_t drange_end_time,
+                zoneinfo const& zone) {
   // XXX : handle full day skipping directly (from preferred_time to next midnight)
   while ((drange_start_time < drange_end_time)
          || (drange_end_time == (time_t)-1)) {
     // Next day at midnight.
     time_t next_day(_add_round_days_to_midnight(
                       drange_start_time,
-                      24 * 60 * 60));
+                      24 * 60 * 60,
+                      zone));
 
     // Check range.
     if ((preferred_time < drange_start_time)
@@ -669,7 +742,8 @@ static time_t _earliest_midnight_in_daterange(
     else
       drange_start_time = _add_round_days_to_midnight(
                             drange_start_time,
-                            drange->skip_interval * 24 * 60 * 60);
+                            drange->skip_interval * 24 * 60 * 60,
+                            zone);
   }
   return ((time_t)-1);
 }
@@ -681,6 +755,7 @@ static time_t _earliest_midnight_in_daterange(
  *  @param[in]  midnight     Midnight of day.
  *  @param[out] range_start  Start of time range in this specific day.
  *  @param[out] range_end    End of time range in this specific day.
+ *  @param[in]  zone         Timezone.
  *
  *  @return True upon successful conversion.
  */
@@ -688,20 +763,236 @@ static bool _timerange_to_time_t(
               timerange* trange,
               struct tm const* midnight,
               time_t& range_start,
-              time_t& range_end) {
+              time_t& range_end,
+              zoneinfo const& zone) {
   struct tm my_tm;
   memcpy(&my_tm, midnight, sizeof(my_tm));
   my_tm.tm_hour = trange->range_start / 60 / 60;
   my_tm.tm_min = (trange->range_start / 60) % 60;
   my_tm.tm_isdst = -1;
-  range_start = mktime(&my_tm);
+  range_start = zone.mktime(&my_tm);
   my_tm.tm_hour = trange->range_end / 60 / 60;
   my_tm.tm_min = (trange->range_end / 60) % 60;
   my_tm.tm_isdst = -1;
-  range_end = mktime(&my_tm);
+  range_end = zone.mktime(&my_tm);
   return (range_start <= range_end);
 }
 
+/**
+ *  Add boundaries of time ranges to a list.
+ *
+ *  @param[in]  trange      Time ranges.
+ *  @param[in]  midnight    Midnight of day.
+ *  @param[out] boundaries  Boundaries list.
+ *  @param[in]  zone        Timezone.
+ */
+static void _add_timerange_boundaries(
+              timerange* trange,
+              struct tm const* midnight,
+              std::vector<time_t>& boundaries,
+              zoneinfo const& zone) {
+  for (; trange; trange = trange->next) {
+    time_t range_start((time_t)-1);
+    time_t range_end((time_t)-1);
+    _timerange_to_time_t(trange, midnight, range_start, range_end, zone);
+    boundaries.push_back(range_start);
+    boundaries.push_back(range_end);
+  }
+  return ;
+}
+
+/**
+ *  Add to a list all times of a day at which a time period (or one of
+ *  its exclusions) can become valid or invalid.
+ *
+ *  @param[in]     tperiod     The time period.
+ *  @param[in]     midnight    Midnight of day.
+ *  @param[out]    boundaries  Boundaries list.
+ *  @param[in,out] visited     Time periods already browsed.
+ *  @param[in]     zone        Timezone.
+ */
+static void _add_timeperiod_boundaries(
+              timeperiod* tperiod,
+              struct tm const* midnight,
+              std::vector<time_t>& boundaries,
+              std::vector<timeperiod*>& visited,
+              zoneinfo const& zone) {
+  if (!tperiod
+      || (std::find(visited.begin(), visited.end(), tperiod)
+          != visited.end()))
+    return ;
+  visited.push_back(tperiod);
+
+  // Date ranges only change on midnights, their time ranges do not
+  // depend on the date range applying or not.
+  _add_timerange_boundaries(
+    tperiod->days[midnight->tm_wday],
+    midnight,
+    boundaries,
+    zone);
+  for (unsigned int i(0); i < DATERANGE_TYPES; ++i)
+    for (daterange* drange(tperiod->exceptions[i]);
+         drange;
+         drange = drange->next)
+      _add_timerange_boundaries(drange->times, midnight, boundaries, zone);
+  for (timeperiodexclusion* exclusion(tperiod->exclusions);
+       exclusion;
+       exclusion = exclusion->next)
+    _add_timeperiod_boundaries(
+      exclusion->timeperiod_ptr,
+      midnight,
+      boundaries,
+      visited,
+      zone);
+  return ;
+}
+
+/**
+ *  Resolve valid intervals of a time period for the days starting at
+ *  a given time.
+ *
+ *  @param[in]  tperiod  The time period.
+ *  @param[in]  t        Time within the first day.
+ *  @param[out] cache    Resolved intervals.
+ *  @param[in]  zone     Timezone.
+ */
+static void _build_cache(
+              timeperiod* tperiod,
+              time_t t,
+              cached_intervals& cache,
+              zoneinfo const& zone) {
+  struct tm midnight;
+  zone.localtime(t, &midnight);
+  midnight.tm_hour = 0;
+  midnight.tm_min = 0;
+  midnight.tm_sec = 0;
+  midnight.tm_isdst = -1;
+  time_t day(zone.mktime(&midnight));
+  cache.start = day;
+
+  // Validity can only change on boundaries.
+  std::vector<time_t> boundaries;
+  for (unsigned int i(0); i < _cache_days; ++i) {
+    zone.localtime(day, &midnight);
+    midnight.tm_isdst = -1;
+    boundaries.push_back(day);
+    std::vector<timeperiod*> visited;
+    _add_timeperiod_boundaries(tperiod, &midnight, boundaries, visited, zone);
+    day = _add_round_days_to_midnight(day, 24 * 60 * 60, zone);
+  }
+  cache.end = day;
+  std::sort(boundaries.begin(), boundaries.end());
+  boundaries.erase(
+    std::unique(boundaries.begin(), boundaries.end()),
+    boundaries.end());
+
+  // Check each interval between two boundaries, skipping those before
+  // the next valid time.
+  cache.valid.clear();
+  time_t current(cache.start);
+  while (current < cache.end) {
+    std::vector<time_t>::const_iterator it(std::upper_bound(
+                                             boundaries.begin(),
+                                             boundaries.end(),
+                                             current));
+    time_t next(
+             ((it == boundaries.end()) || (*it > cache.end))
+             ? cache.end
+             : *it);
+    time_t valid_time((time_t)-1);
+    _get_next_valid_time_per_timeperiod(current, &valid_time, tperiod, zone);
+    if (valid_time == current) {
+      if (!cache.valid.empty() && (cache.valid.back().second == current))
+        cache.valid.back().second = next;
+      else
+        cache.valid.push_back(std::make_pair(current, next));
+      current = next;
+    }
+    else if (valid_time > current)
+      current = valid_time;
+    else
+      current = next;
+  }
+  return ;
+}
+
+/**
+ *  Get the next valid time within a time period from the valid
+ *  intervals cache.
+ *
+ *  @param[in]  preferred_time  The preferred time to check.
+ *  @param[out] valid_time      Variable to fill.
+ *  @param[in]  tperiod         The time period to use.
+ *  @param[in]  zone            Timezone.
+ *
+ *  @return True if the cache could answer, false if the time must be
+ *          computed.
+ */
+static bool _get_cached_next_valid_time(
+              time_t preferred_time,
+              time_t* valid_time,
+              timeperiod* tperiod,
+              zoneinfo const& zone) {
+  // Intervals depend on the timezone.
+  std::vector<cached_windows>& entries(_cache[tperiod]);
+  std::vector<cached_windows>::iterator it(entries.begin());
+  while ((it != entries.end()) && (it->zone != &zone))
+    ++it;
+  if (it == entries.end()) {
+    entries.push_back(cached_windows());
+    it = entries.end() - 1;
+    it->current.end = 0;
+    it->current.start = 0;
+    it->other.end = 0;
+    it->other.start = 0;
+    it->zone = &zone;
+  }
+
+  // Resolve intervals of the current days again when the horizon has
+  // passed. Times before are computed.
+  time_t now(time(NULL));
+  if (now >= it->current.end)
+    _build_cache(tperiod, now, it->current, zone);
+  if (preferred_time < it->current.start)
+    return (false);
+
+  // Farther times use their own days.
+  cached_intervals* window(&it->current);
+  if (preferred_time >= window->end) {
+    window = &it->other;
+    if ((preferred_time < window->start) || (preferred_time >= window->end))
+      _build_cache(tperiod, preferred_time, *window, zone);
+  }
+
+  // Find the first interval starting after preferred time.
+  std::vector<std::pair<time_t, time_t> > const& valid(window->valid);
+  std::vector<std::pair<time_t, time_t> >::const_iterator
+    interval(std::upper_bound(
+                    valid.begin(),
+                    valid.end(),
+                    std::make_pair(
+                      preferred_time,
+                      std::numeric_limits<time_t>::max())));
+  if ((interval != valid.begin())
+      && (preferred_time < (interval - 1)->second))
+    *valid_time = preferred_time;
+  else if (interval != valid.end())
+    *valid_time = interval->first;
+  // No valid time within horizon.
+  else
+    return (false);
+  return (true);
+}
+
+/**
+ *  Clear the valid intervals cache of all time periods. Must be called
+ *  whenever a time period is modified or deleted.
+ */
+void clear_timeperiod_cache() {
+  _cache.clear();
+  return ;
+}
+
 /**
  *  See if the specified time falls into a valid time range in the given
  *  time period.
@@ -714,6 +1005,26 @@ static bool _timerange_to_time_t(
 int check_time_against_period(
       time_t test_time,
       timeperiod* tperiod) {
+  return (check_time_against_period_for_timezone(
+            test_time,
+            tperiod,
+            NULL));
+}
+
+/**
+ *  See if the specified time falls into a valid time range in the given
+ *  time period, evaluated in a given timezone.
+ *
+ *  @param[in] test_time  Time to test.
+ *  @param[in] tperiod    Target time period.
+ *  @param[in] tz         Timezone, NULL for the process timezone.
+ *
+ *  @return OK on success, ERROR on failure.
+ */
+int check_time_against_period_for_timezone(
+      time_t test_time,
+      timeperiod* tperiod,
+      char const* tz) {
   logger(dbg_functions, basic)
     << "check_time_against_period()";
 
@@ -722,11 +1033,18 @@ int check_time_against_period(
     return (OK);
 
   // Faked next valid time must be tested time.
+  zoneinfo const& zone(zoneinfo::find(tz));
   time_t next_valid_time((time_t)-1);
-  _get_next_valid_time_per_timeperiod(
-    test_time,
-    &next_valid_time,
-    tperiod);
+  if (!_get_cached_next_valid_time(
+         test_time,
+         &next_valid_time,
+         tperiod,
+         zone))
+    _get_next_valid_time_per_timeperiod(
+      test_time,
+      &next_valid_time,
+      tperiod,
+      zone);
   return ((next_valid_time == test_time) ? OK : ERROR);
 }
 
@@ -737,11 +1055,13 @@ int check_time_against_period(
  *  @param[in]  preferred_time  The preferred time to check.
  *  @param[out] invalid_time    Variable to fill.
  *  @param[in]  tperiod         The time period to use.
+ *  @param[in]  zone            Timezone.
  */
 static void _get_next_invalid_time_per_timeperiod(
               time_t preferred_time,
               time_t* invalid_time,
-              timeperiod* tperiod) {
+              timeperiod* tperiod,
+              zoneinfo const& zone) {
   logger(dbg_functions, basic)
     << "get_next_invalid_time_per_timeperiod()";
 
@@ -766,12 +1086,13 @@ static void _get_next_invalid_time_per_timeperiod(
     // Compute time information.
     time_info ti;
     ti.preferred_time = preferred_time;
-    localtime_r(&preferred_time, &ti.preftime);
+    ti.zone = &zone;
+    zone.localtime(preferred_time, &ti.preftime);
     ti.preftime.tm_sec = 0;
     ti.preftime.tm_min = 0;
     ti.preftime.tm_hour = 0;
     ti.preftime.tm_isdst = -1;
-    ti.midnight = mktime(&ti.preftime);
+    ti.midnight = zone.mktime(&ti.preftime);
 
     // XXX: handle range end reached.
     // Browse all date range.
@@ -797,11 +1118,12 @@ static void _get_next_invalid_time_per_timeperiod(
                                      preferred_time,
                                      drange,
                                      daterange_start_time,
-                                     daterange_end_time));
+                                     daterange_end_time,
+                                     zone));
           if (earliest_midnight != (time_t)-1) {
             // Midnight.
             struct tm midnight;
-            localtime_r(&earliest_midnight, &midnight);
+            zone.localtime(earliest_midnight, &midnight);
 
             // Browse all time range of date range.
             for (timerange* trange(drange->times);
@@ -814,7 +1136,8 @@ static void _get_next_invalid_time_per_timeperiod(
                     trange,
                     &midnight,
                     range_start,
-                    range_end)
+                    range_end,
+                    zone)
                   && (preferred_time >= range_start)
                   && (preferred_time < range_end))
                 earliest_time = range_end;
@@ -838,9 +1161,10 @@ static void _get_next_invalid_time_per_timeperiod(
       // Calculate start of this future weekday.
       time_t day_start(_add_round_days_to_midnight(
                          ti.midnight,
-                         days_into_the_future * 24 * 60 * 60));
+                         days_into_the_future * 24 * 60 * 60,
+                         zone));
       struct tm day_midnight;
-      localtime_r(&day_start, &day_midnight);
+      zone.localtime(day_start, &day_midnight);
 
       // Check all time ranges for this day of the week.
       for (timerange* trange(tperiod->days[weekday]);
@@ -853,7 +1177,8 @@ static void _get_next_invalid_time_per_timeperiod(
               trange,
               &day_midnight,
               range_start,
-              range_end)
+              range_end,
+              zone)
             && (preferred_time >= range_start)
             && (preferred_time < range_end))
           earliest_time = range_end;
@@ -871,7 +1196,8 @@ static void _get_next_invalid_time_per_timeperiod(
       _get_next_valid_time_per_timeperiod(
         preferred_time,
         &valid,
-        exclusion->timeperiod_ptr);
+        exclusion->timeperiod_ptr,
+        zone);
       if ((valid != (time_t)-1)
           && (((time_t)-1 == next_exclusion)
               || (valid < next_exclusion)))
@@ -890,7 +1216,8 @@ static void _get_next_invalid_time_per_timeperiod(
     if ((next_exclusion != (time_t)-1)
         && (next_exclusion < _add_round_days_to_midnight(
                                ti.midnight,
-                               24 * 60 * 60))
+                               24 * 60 * 60,
+                               zone))
         && (((time_t)-1 == earliest_time)
             || (next_exclusion <= earliest_time))) {
       earliest_time = (time_t)-1;
@@ -918,15 +1245,17 @@ static void _get_next_invalid_time_per_timeperiod(
  *
  *  @param[in] preferred_time  Preferred time.
  *  @param[in] timeranges      Time ranges.
+ *  @param[in] zone            Timezone.
  *
  *  @return The next valid time found within the day.
  */
 static time_t _get_next_valid_time_in_timeranges(
                 time_t preferred_time,
-                timerange* timeranges) {
+                timerange* timeranges,
+                zoneinfo const& zone) {
   time_t earliest_time((time_t)-1);
   struct tm midnight;
-  localtime_r(&preferred_time, &midnight);
+  zone.localtime(preferred_time, &midnight);
   midnight.tm_hour = 0;
   midnight.tm_min = 0;
   midnight.tm_sec = 0;
@@ -938,7 +1267,8 @@ static time_t _get_next_valid_time_in_timeranges(
           timeranges,
           &midnight,
           range_start,
-          range_end)) {
+          range_end,
+          zone)) {
       // Time range is in the future.
       if (range_start >= preferred_time) {
         if ((earliest_time == (time_t)-1)
@@ -960,11 +1290,13 @@ static time_t _get_next_valid_time_in_timeranges(
  *  @param[in]  preferred_time  The preferred time to check.
  *  @param[out] valid_time      Variable to fill.
  *  @param[in]  tperiod         The time period to use.
+ *  @param[in]  zone            Timezone.
  */
 static void _get_next_valid_time_per_timeperiod(
               time_t preferred_time,
               time_t* valid_time,
-              timeperiod* tperiod) {
+              timeperiod* tperiod,
+              zoneinfo const& zone) {
   logger(dbg_functions, basic)
     << "get_next_valid_time_per_timeperiod()";
 
@@ -982,16 +1314,17 @@ static void _get_next_valid_time_per_timeperiod(
   time_t earliest_time((time_t)-1);
   time_info ti;
   ti.preferred_time = preferred_time;
+  ti.zone = &zone;
   for (time_t in_one_year(ti.preferred_time + 366 * 24 * 60 * 60);
        (earliest_time == (time_t)-1)
        && (ti.preferred_time < in_one_year);) {
     // Compute time information.
-    localtime_r(&ti.preferred_time, &ti.preftime);
+    zone.localtime(ti.preferred_time, &ti.preftime);
     ti.preftime.tm_sec = 0;
     ti.preftime.tm_min = 0;
     ti.preftime.tm_hour = 0;
     ti.preftime.tm_isdst = -1;
-    ti.midnight = mktime(&ti.preftime);
+    ti.midnight = zone.mktime(&ti.preftime);
 
     // Browse all date range types in precedence order.
     bool skip_this_day(false);
@@ -1023,7 +1356,8 @@ static void _get_next_valid_time_per_timeperiod(
           // but could be valid tomorrow.
           time_t potential_time(_get_next_valid_time_in_timeranges(
                                   ti.preferred_time,
-                                  drange->times));
+                                  drange->times,
+                                  zone));
 
           // Potential time found.
           if (potential_time != (time_t)-1) {
@@ -1049,7 +1383,8 @@ static void _get_next_valid_time_per_timeperiod(
       if (earliest_time == (time_t)-1) {
         time_t potential_time(_get_next_valid_time_in_timeranges(
                                 ti.preferred_time,
-                                tperiod->days[ti.preftime.tm_wday]));
+                                tperiod->days[ti.preftime.tm_wday],
+                                zone));
         if ((potential_time != (time_t)-1)
             && ((earliest_time == (time_t)-1)
                 || (potential_time < earliest_time)))
@@ -1070,7 +1405,8 @@ static void _get_next_valid_time_per_timeperiod(
         _get_next_invalid_time_per_timeperiod(
           earliest_time,
           &invalid,
-          exclusion->timeperiod_ptr);
+          exclusion->timeperiod_ptr,
+          zone);
         if ((invalid != (time_t)-1)
             && (((time_t)-1 == max_invalid)
                 || (invalid > max_invalid)))
@@ -1089,7 +1425,8 @@ static void _get_next_valid_time_per_timeperiod(
     if (!skipped)
       ti.preferred_time = _add_round_days_to_midnight(
                              ti.midnight,
-                             24 * 60 * 60);
+                             24 * 60 * 60,
+                             zone);
   }
 
   // If we couldn't find a time period there must be none defined.
@@ -1114,6 +1451,24 @@ void get_next_valid_time(
        time_t pref_time,
        time_t* valid_time,
        timeperiod* tperiod) {
+  get_next_valid_time_for_timezone(pref_time, valid_time, tperiod, NULL);
+  return ;
+}
+
+/**
+ *  Given a preferred time, get the next valid time within a time
+ *  period, evaluated in a given timezone.
+ *
+ *  @param[in]  preferred_time  The preferred time to check.
+ *  @param[out] valid_time      Variable to fill.
+ *  @param[in]  tperiod         The time period to use.
+ *  @param[in]  tz              Timezone, NULL for the process timezone.
+ */
+void get_next_valid_time_for_timezone(
+       time_t pref_time,
+       time_t* valid_time,
+       timeperiod* tperiod,
+       char const* tz) {
   logger(dbg_functions, basic) << "get_next_valid_time()";
 
   // Preferred time must be now or in the future.
@@ -1127,11 +1482,18 @@ void get_next_valid_time(
   // First check for possible timeperiod exclusions
   // before getting a valid_time.
   else {
+    zoneinfo const& zone(zoneinfo::find(tz));
     *valid_time = 0;
-    _get_next_valid_time_per_timeperiod(
-      preferred_time,
-      valid_time,
-      tperiod);
+    if (!_get_cached_next_valid_time(
+           preferred_time,
+           valid_time,
+           tperiod,
+           zone))
+      _get_next_valid_time_per_timeperiod(
+        preferred_time,
+        valid_time,
+        tperiod,
+        zone);
   }
 
   return ;
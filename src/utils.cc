@@ -256,7 +256,10 @@ int get_raw_command_line_r(
 
       /* ADDED 01/29/04 EG */
       /* process any macros we find in the argument */
-      process_macros_r(mac, temp_arg, &arg_buffer, macro_options);
+      if (strchr(temp_arg, '$'))
+        process_macros_r(mac, temp_arg, &arg_buffer, macro_options);
+      else
+        arg_buffer = string::dup(temp_arg);
 
       mac->argv[x] = arg_buffer;
     }
@@ -380,6 +383,69 @@ int free_check_result(check_result* info) {
   return (OK);
 }
 
+/* finds the end of the plugin output line starting at begin, sets next to the beginning of the next line or NULL on the last line */
+static char const* check_output_line_end(
+                     char const* begin,
+                     bool escaped_newlines,
+                     char const** next) {
+  char const* ptr(begin);
+  while (*ptr != '\x0') {
+    if (*ptr == '\n') {
+      *next = ptr + 1;
+      return (ptr);
+    }
+    if (escaped_newlines && *ptr == '\\' && ptr[1] == 'n') {
+      *next = ptr + 2;
+      return (ptr);
+    }
+    ++ptr;
+  }
+  *next = NULL;
+  return (ptr);
+}
+
+/* copies plugin output lines, replacing line separators and optionally escaping backslashes, returns the length of the copy (nothing is copied if out is NULL) */
+static unsigned int copy_check_output_lines(
+                      char const* begin,
+                      char const* end,
+                      bool escaped_newlines,
+                      char const* separator,
+                      bool escape_backslashes,
+                      char* out) {
+  unsigned int separator_len(strlen(separator));
+  unsigned int len(0);
+  char const* line(begin);
+  while (line) {
+    char const* next;
+    char const* eol(check_output_line_end(line, escaped_newlines, &next));
+    if (eol > end)
+      eol = end;
+    for (char const* ptr(line); ptr != eol; ++ptr) {
+      if (escape_backslashes && *ptr == '\\') {
+        if (out) {
+          out[len] = '\\';
+          out[len + 1] = '\\';
+        }
+        len += 2;
+      }
+      else {
+        if (out)
+          out[len] = *ptr;
+        ++len;
+      }
+    }
+    if (eol == end)
+      break;
+    if (out)
+      memcpy(out + len, separator, separator_len);
+    len += separator_len;
+    line = next;
+  }
+  if (out)
+    out[len] = '\x0';
+  return (len);
+}
+
 /* parse raw plugin output and return: short and long output, perf data */
 int parse_check_output(
       char* buf,
@@ -388,16 +454,8 @@ int parse_check_output(
       char** perf_data,
       int escape_newlines_please,
       int newlines_are_escaped) {
-  int current_line = 0;
-  bool found_newline = false;
-  bool eof = false;
-  int used_buf = 0;
-  int dbuf_chunk = 1024;
-  dbuf db1;
-  dbuf db2;
-  char* ptr = NULL;
-  bool in_perf_data = false;
-  char* tempbuf = NULL;
+  bool escaped_newlines(newlines_are_escaped == true);
+  char const* next(NULL);
   int x = 0;
   int y = 0;
 
@@ -413,12 +471,6 @@ int parse_check_output(
   if (buf == NULL || *buf == 0)
     return (OK);
 
-  used_buf = strlen(buf) + 1;
-
-  /* initialize dynamic buffers (1KB chunk size) */
-  dbuf_init(&db1, dbuf_chunk);
-  dbuf_init(&db2, dbuf_chunk);
-
   /* unescape newlines and escaped backslashes first */
   if (newlines_are_escaped) {
     for (x = 0, y = 0; buf[x] != '\x0'; x++) {
@@ -436,146 +488,114 @@ int parse_check_output(
     buf[y] = '\x0';
   }
 
-  /* process each line of input */
-  for (x = 0; !eof; x++) {
-
-    /* we found the end of a line */
-    if (buf[x] == '\n')
-      found_newline = true;
-    else if (buf[x] == '\\' && buf[x + 1] == 'n'
-             && newlines_are_escaped == true) {
-      found_newline = true;
-      buf[x] = '\x0';
-      x++;
-    }
-    else if (buf[x] == '\x0') {
-      found_newline = true;
-      eof = true;
-    }
-    else
-      found_newline = false;
-
-    if (found_newline == true) {
-
-      current_line++;
-
-      /* handle this line of input */
-      buf[x] = '\x0';
-      tempbuf = string::dup(buf);
-
-      /* first line contains short plugin output and optional perf data */
-      if (current_line == 1) {
-
-        /* get the short plugin output */
-        if ((ptr = strtok(tempbuf, "|"))) {
-          if (short_output)
-            *short_output = string::dup(ptr);
-
-          /* get the optional perf data */
-          if ((ptr = strtok(NULL, "\n")))
-            dbuf_strcat(&db2, ptr);
-        }
-      }
-
-      /* additional lines contain long plugin output and optional perf data */
-      else {
-
-        /* rest of the output is perf data */
-        if (in_perf_data) {
-          dbuf_strcat(&db2, tempbuf);
-          dbuf_strcat(&db2, " ");
-        }
+  /*
+  ** Locate every part of the output in the buffer. Nothing is copied
+  ** until the size of each part is known.
+  */
 
-        /* we're still in long output */
-        else {
-
-          /* perf data separator has been found */
-          if (strstr(tempbuf, "|")) {
-
-            /* NOTE: strtok() causes problems if first character of tempbuf='|', so use my_strtok() instead */
-            /* get the remaining long plugin output */
-            if ((ptr = my_strtok(tempbuf, "|"))) {
-
-              if (current_line > 2)
-                dbuf_strcat(&db1, "\n");
-              dbuf_strcat(&db1, ptr);
-
-              /* get the perf data */
-              if ((ptr = my_strtok(NULL, "\n"))) {
-                dbuf_strcat(&db2, ptr);
-                dbuf_strcat(&db2, " ");
-              }
-            }
-
-            /* set the perf data flag */
-            in_perf_data = true;
-          }
-
-          /* just long output */
-          else {
-            if (current_line > 2)
-              dbuf_strcat(&db1, "\n");
-            dbuf_strcat(&db1, tempbuf);
-          }
-        }
-      }
+  /* first line contains short plugin output and optional perf data */
+  char const* eol(check_output_line_end(buf, escaped_newlines, &next));
+  char const* short_begin(buf);
+  while (short_begin != eol && *short_begin == '|')
+    ++short_begin;
+  char const* short_end(short_begin);
+  while (short_end != eol && *short_end != '|')
+    ++short_end;
+  char const* perf_first_begin(NULL);
+  char const* perf_first_end(NULL);
+  if (short_begin == short_end)
+    short_begin = NULL;
+  else if (short_end != eol && short_end + 1 != eol) {
+    perf_first_begin = short_end + 1;
+    perf_first_end = eol;
+  }
 
-      delete[] tempbuf;
-      tempbuf = NULL;
-
-      /* shift data back to front of buffer and adjust counters */
-      memmove(
-        (void*)&buf[0],
-        (void*)&buf[x + 1],
-        (size_t)((int)used_buf - x - 1));
-      used_buf -= (x + 1);
-      buf[used_buf] = '\x0';
-      x = -1;
+  /* additional lines contain long plugin output up to the perf data separator */
+  char const* long_begin(next);
+  char const* long_end(next);
+  char const* perf_begin(NULL);
+  for (char const* line(next); line; line = next) {
+    eol = check_output_line_end(line, escaped_newlines, &next);
+    char const* separator(
+      static_cast<char const*>(memchr(line, '|', eol - line)));
+    if (separator) {
+      long_end = separator;
+      /* rest of the output is perf data, empty remaining of the separator line is skipped */
+      if (separator + 1 != eol)
+        perf_begin = separator + 1;
+      else
+        perf_begin = next;
+      break;
     }
+    long_end = eol;
   }
+  char const* buf_end(perf_begin ? perf_begin + strlen(perf_begin) : NULL);
 
-  /* save long output */
-  if (long_output && (db1.buf && strcmp(db1.buf, ""))) {
-    if (escape_newlines_please == false)
-      *long_output = string::dup(db1.buf);
-    else {
-      /* escape newlines (and backslashes) in long output */
-      tempbuf = new char[strlen(db1.buf) * 2 + 1];
+  /*
+  ** Copy parts, each one in a single allocation.
+  */
 
-      for (x = 0, y = 0; db1.buf[x] != '\x0'; x++) {
+  /* save short output */
+  if (short_output && short_begin) {
+    *short_output = new char[short_end - short_begin + 1];
+    memcpy(*short_output, short_begin, short_end - short_begin);
+    (*short_output)[short_end - short_begin] = '\x0';
+  }
 
-        if (db1.buf[x] == '\n') {
-          tempbuf[y++] = '\\';
-          tempbuf[y++] = 'n';
-        }
-        else if (db1.buf[x] == '\\') {
-          tempbuf[y++] = '\\';
-          tempbuf[y++] = '\\';
-        }
-        else
-          tempbuf[y++] = db1.buf[x];
-      }
+  /* save long output (escaping newlines and backslashes if needed) */
+  if (long_output && long_begin != long_end) {
+    char const* separator(escape_newlines_please ? "\\n" : "\n");
+    unsigned int len(copy_check_output_lines(
+                       long_begin,
+                       long_end,
+                       escaped_newlines,
+                       separator,
+                       escape_newlines_please,
+                       NULL));
+    *long_output = new char[len + 1];
+    copy_check_output_lines(
+      long_begin,
+      long_end,
+      escaped_newlines,
+      separator,
+      escape_newlines_please,
+      *long_output);
+  }
 
-      tempbuf[y] = '\x0';
-      *long_output = string::dup(tempbuf);
-      delete[] tempbuf;
+  /* save perf data (every line of the long output perf data is followed by a space) */
+  if (perf_data && (perf_first_begin || perf_begin)) {
+    unsigned int first_len(perf_first_end - perf_first_begin);
+    unsigned int len(first_len);
+    if (perf_begin)
+      len += copy_check_output_lines(
+               perf_begin,
+               buf_end,
+               escaped_newlines,
+               " ",
+               false,
+               NULL) + 1;
+    *perf_data = new char[len + 1];
+    if (first_len)
+      memcpy(*perf_data, perf_first_begin, first_len);
+    if (perf_begin) {
+      copy_check_output_lines(
+        perf_begin,
+        buf_end,
+        escaped_newlines,
+        " ",
+        false,
+        *perf_data + first_len);
+      (*perf_data)[len - 1] = ' ';
     }
+    (*perf_data)[len] = '\x0';
   }
 
-  /* save perf data */
-  if (perf_data && (db2.buf && strcmp(db2.buf, "")))
-    *perf_data = string::dup(db2.buf);
-
   /* strip short output and perf data */
   if (short_output)
     strip(*short_output);
   if (perf_data)
     strip(*perf_data);
 
-  /* free dynamic buffers */
-  dbuf_free(&db1);
-  dbuf_free(&db2);
-
   return (OK);
 }
 
@@ -978,6 +998,7 @@ void free_memory(nagios_macros* mac) {
   }
   event_list_high = NULL;
   quick_timed_event.clear(hash_timed_event::high);
+  sorted_timed_events.clear(hash_timed_event::high);
 
   // Free memory for the low priority event list.
   for (timed_event* this_event(event_list_low); this_event;) {
@@ -991,6 +1012,7 @@ void free_memory(nagios_macros* mac) {
   }
   event_list_low = NULL;
   quick_timed_event.clear(hash_timed_event::low);
+  sorted_timed_events.clear(hash_timed_event::low);
 
   // Free any notification list that may have been overlooked.
   free_notification_list();
@@ -20,18 +20,23 @@
 
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
+#include <sstream>
 #include <fcntl.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
+#include "com/centreon/engine/commands/system_runner.hh"
 #include "com/centreon/engine/common.hh"
 #include "com/centreon/engine/events/defines.hh"
 #include "com/centreon/engine/globals.hh"
 #include "com/centreon/engine/logging/logger.hh"
 #include "com/centreon/engine/macros.hh"
+#include "com/centreon/engine/macros/plan.hh"
 #include "com/centreon/engine/objects/command.hh"
 #include "com/centreon/engine/objects/host.hh"
 #include "com/centreon/engine/objects/service.hh"
+#include "com/centreon/engine/perfdata_writer.hh"
 #include "com/centreon/engine/string.hh"
 #include "com/centreon/engine/xpddefault.hh"
 #include "find.hh"
@@ -42,8 +47,8 @@ using namespace com::centreon::engine::logging;
 static command*        xpddefault_host_perfdata_command_ptr(NULL);
 static command*        xpddefault_service_perfdata_command_ptr(NULL);
 
-static char*           xpddefault_host_perfdata_file_template(NULL);
-static char*           xpddefault_service_perfdata_file_template(NULL);
+static macros::plan    xpddefault_host_perfdata_file_plan;
+static macros::plan    xpddefault_service_perfdata_file_plan;
 
 static command*        xpddefault_host_perfdata_file_processing_command_ptr(NULL);
 static command*        xpddefault_service_perfdata_file_processing_command_ptr(NULL);
@@ -53,8 +58,11 @@ static FILE*           xpddefault_service_perfdata_fp(NULL);
 static int             xpddefault_host_perfdata_fd(-1);
 static int             xpddefault_service_perfdata_fd(-1);
 
-static pthread_mutex_t xpddefault_host_perfdata_fp_lock;
-static pthread_mutex_t xpddefault_service_perfdata_fp_lock;
+// bytes kept by a writer while its performance data file is closed.
+static unsigned long const xpddefault_max_held_size(16 * 1024 * 1024);
+
+static perfdata_writer* xpddefault_host_perfdata_writer(NULL);
+static perfdata_writer* xpddefault_service_perfdata_writer(NULL);
 
 /******************************************************************/
 /************** INITIALIZATION & CLEANUP FUNCTIONS ****************/
@@ -71,13 +79,34 @@ int xpddefault_initialize_performance_data() {
   xpddefault_host_perfdata_file_processing_command_ptr = NULL;
   xpddefault_service_perfdata_file_processing_command_ptr = NULL;
 
-  // grab config info from main config file.
-  xpddefault_host_perfdata_file_template = string::dup(config->host_perfdata_file_template());
-  xpddefault_service_perfdata_file_template = string::dup(config->service_perfdata_file_template());
+  // grab config info from main config file, process special chars
+  // and compile the templates once.
+  {
+    char* tmpl(string::dup(config->host_perfdata_file_template()));
+    xpddefault_preprocess_file_templates(tmpl);
+    xpddefault_host_perfdata_file_plan.compile(tmpl);
+    delete[] tmpl;
+    tmpl = string::dup(config->service_perfdata_file_template());
+    xpddefault_preprocess_file_templates(tmpl);
+    xpddefault_service_perfdata_file_plan.compile(tmpl);
+    delete[] tmpl;
+  }
 
-  // process special chars in templates.
-  xpddefault_preprocess_file_templates(xpddefault_host_perfdata_file_template);
-  xpddefault_preprocess_file_templates(xpddefault_service_perfdata_file_template);
+  // lines are written to the performance data files by writers.
+  if (!config->host_perfdata_file().empty())
+    xpddefault_host_perfdata_writer
+      = new perfdata_writer(
+              "host",
+              config->perfdata_file_flush_interval(),
+              config->perfdata_file_flush_size(),
+              xpddefault_max_held_size);
+  if (!config->service_perfdata_file().empty())
+    xpddefault_service_perfdata_writer
+      = new perfdata_writer(
+              "service",
+              config->perfdata_file_flush_interval(),
+              config->perfdata_file_flush_size(),
+              xpddefault_max_held_size);
 
   // open the performance data files.
   xpddefault_open_host_perfdata_file();
@@ -169,16 +198,18 @@ int xpddefault_initialize_performance_data() {
 // cleans up performance data.
 int xpddefault_cleanup_performance_data() {
   // free memory.
-  delete[] xpddefault_host_perfdata_file_template;
-  delete[] xpddefault_service_perfdata_file_template;
+  xpddefault_host_perfdata_file_plan = macros::plan();
+  xpddefault_service_perfdata_file_plan = macros::plan();
 
-  xpddefault_host_perfdata_file_template = NULL;
-  xpddefault_service_perfdata_file_template = NULL;
-
-  // close the files.
+  // close the files, pending lines are written first.
   xpddefault_close_host_perfdata_file();
   xpddefault_close_service_perfdata_file();
 
+  delete xpddefault_host_perfdata_writer;
+  xpddefault_host_perfdata_writer = NULL;
+  delete xpddefault_service_perfdata_writer;
+  xpddefault_service_perfdata_writer = NULL;
+
   return (OK);
 }
 
@@ -198,7 +229,7 @@ int xpddefault_update_service_performance_data(service* svc) {
   if (!svc || !svc->perf_data || !*svc->perf_data)
     return (OK);
   if ((!xpddefault_service_perfdata_fp
-       || !xpddefault_service_perfdata_file_template)
+       || !xpddefault_service_perfdata_writer)
       && config->service_perfdata_command().empty())
     return (OK);
 
@@ -238,7 +269,7 @@ int xpddefault_update_host_performance_data(host* hst) {
   if (!hst || !hst->perf_data || !*hst->perf_data)
     return (OK);
   if ((!xpddefault_host_perfdata_fp
-       || !xpddefault_host_perfdata_file_template)
+       || !xpddefault_host_perfdata_writer)
       && config->host_perfdata_command().empty())
     return (OK);
 
@@ -271,8 +302,6 @@ int xpddefault_run_service_performance_data_command(
       service* svc) {
   char* raw_command_line(NULL);
   char* processed_command_line(NULL);
-  int early_timeout(false);
-  double exectime;
   int result(OK);
   int macro_options(STRIP_ILLEGAL_MACRO_CHARS | ESCAPE_MACRO_CHARS);
 
@@ -314,30 +343,21 @@ int xpddefault_run_service_performance_data_command(
     "command line: " << processed_command_line;
 
   // run the command.
-  try {
-    my_system_r(
-      mac,
+  {
+    std::ostringstream oss;
+    oss << "Warning: Service performance data command '"
+        << processed_command_line << "' for service '"
+        << svc->description << "' on host '"
+        << svc->host_name << "' timed out after "
+        << config->perfdata_timeout() << " seconds";
+    commands::system_runner::instance().run(
+      commands::system_runner::perfdata_command,
       processed_command_line,
+      *mac,
       config->perfdata_timeout(),
-      &early_timeout,
-      &exectime,
-      NULL,
-      0);
-  } catch (std::exception const& e) {
-    logger(log_runtime_error, basic)
-      << "Error: can't execute service performance data command line '"
-      << processed_command_line << "' : " << e.what();
+      new commands::system_runner::timeout_warning(oss.str()));
   }
 
-  // check to see if the command timed out.
-  if (early_timeout == true)
-    logger(log_runtime_warning, basic)
-      << "Warning: Service performance data command '"
-      << processed_command_line << "' for service '"
-      << svc->description << "' on host '"
-      << svc->host_name << "' timed out after "
-      << config->perfdata_timeout() << " seconds";
-
   // free memory.
   delete[] raw_command_line;
   delete[] processed_command_line;
@@ -351,8 +371,6 @@ int xpddefault_run_host_performance_data_command(
       host* hst) {
   char* raw_command_line(NULL);
   char* processed_command_line(NULL);
-  int early_timeout(false);
-  double exectime;
   int result(OK);
   int macro_options(STRIP_ILLEGAL_MACRO_CHARS | ESCAPE_MACRO_CHARS);
 
@@ -385,38 +403,28 @@ int xpddefault_run_host_performance_data_command(
     raw_command_line,
     &processed_command_line,
     macro_options);
+  if (processed_command_line == NULL)
+    return (ERROR);
 
   logger(dbg_perfdata, most)
     << "Processed host performance data command line: "
     << processed_command_line;
 
   // run the command.
-  try {
-    my_system_r(
-      mac,
+  {
+    std::ostringstream oss;
+    oss << "Warning: Host performance data command '"
+        << processed_command_line << "' for host '" << hst->name
+        << "' timed out after " << config->perfdata_timeout()
+        << " seconds";
+    commands::system_runner::instance().run(
+      commands::system_runner::perfdata_command,
       processed_command_line,
+      *mac,
       config->perfdata_timeout(),
-      &early_timeout,
-      &exectime,
-      NULL,
-      0);
-  } catch (std::exception const& e) {
-    logger(log_runtime_error, basic)
-      << "Error: can't execute host performance data command line '"
-      << processed_command_line << "' : " << e.what();
+      new commands::system_runner::timeout_warning(oss.str()));
   }
 
-  if (processed_command_line == NULL)
-    return (ERROR);
-
-  // check to see if the command timed out.
-  if (early_timeout == true)
-    logger(log_runtime_warning, basic)
-      << "Warning: Host performance data command '"
-      << processed_command_line << "' for host '" << hst->name
-      << "' timed out after " << config->perfdata_timeout()
-      << " seconds";
-
   // free memory.
   delete[] raw_command_line;
   delete[] processed_command_line;
@@ -452,6 +460,8 @@ int xpddefault_open_host_perfdata_file() {
 
       return (ERROR);
     }
+    if (xpddefault_host_perfdata_writer)
+      xpddefault_host_perfdata_writer->attach(xpddefault_host_perfdata_fp);
   }
 
   return (OK);
@@ -481,6 +491,9 @@ int xpddefault_open_service_perfdata_file() {
 
       return (ERROR);
     }
+    if (xpddefault_service_perfdata_writer)
+      xpddefault_service_perfdata_writer->attach(
+        xpddefault_service_perfdata_fp);
   }
 
   return (OK);
@@ -488,8 +501,13 @@ int xpddefault_open_service_perfdata_file() {
 
 // close the host performance data file.
 int xpddefault_close_host_perfdata_file() {
-  if (xpddefault_host_perfdata_fp != NULL)
+  // write pending lines before the file is closed.
+  if (xpddefault_host_perfdata_writer)
+    xpddefault_host_perfdata_writer->detach();
+  if (xpddefault_host_perfdata_fp != NULL) {
     fclose(xpddefault_host_perfdata_fp);
+    xpddefault_host_perfdata_fp = NULL;
+  }
   if (xpddefault_host_perfdata_fd >= 0) {
     close(xpddefault_host_perfdata_fd);
     xpddefault_host_perfdata_fd = -1;
@@ -500,8 +518,13 @@ int xpddefault_close_host_perfdata_file() {
 
 // close the service performance data file.
 int xpddefault_close_service_perfdata_file() {
-  if (xpddefault_service_perfdata_fp != NULL)
+  // write pending lines before the file is closed.
+  if (xpddefault_service_perfdata_writer)
+    xpddefault_service_perfdata_writer->detach();
+  if (xpddefault_service_perfdata_fp != NULL) {
     fclose(xpddefault_service_perfdata_fp);
+    xpddefault_service_perfdata_fp = NULL;
+  }
   if (xpddefault_service_perfdata_fd >= 0) {
     close(xpddefault_service_perfdata_fd);
     xpddefault_service_perfdata_fd = -1;
@@ -551,10 +574,6 @@ void xpddefault_preprocess_file_templates(char* tmpl) {
 int xpddefault_update_service_performance_data_file(
       nagios_macros* mac,
       service* svc) {
-  char* raw_output(NULL);
-  char* processed_output(NULL);
-  int result(OK);
-
   logger(dbg_functions, basic)
     << "update_service_performance_data_file()";
 
@@ -563,46 +582,26 @@ int xpddefault_update_service_performance_data_file(
 
   // we don't have a file to write to.
   if (xpddefault_service_perfdata_fp == NULL
-      || xpddefault_service_perfdata_file_template == NULL)
+      || xpddefault_service_perfdata_writer == NULL)
     return (OK);
 
-  // get the raw line to write.
-  raw_output = string::dup(xpddefault_service_perfdata_file_template);
-
-  logger(dbg_perfdata, most)
-    << "Raw service performance data file output: " << raw_output;
-
-  // process any macros in the raw output line.
-  process_macros_r(mac, raw_output, &processed_output, 0);
-  if (processed_output == NULL)
-    return (ERROR);
+  // process the macros of the compiled template.
+  std::string output;
+  xpddefault_service_perfdata_file_plan.process(mac, output);
 
   logger(dbg_perfdata, most)
-    << "Processed service performance data file output: "
-    << processed_output;
+    << "Processed service performance data file output: " << output;
 
-  // lock, write to and unlock host performance data file.
-  pthread_mutex_lock(&xpddefault_service_perfdata_fp_lock);
-  fputs(processed_output, xpddefault_service_perfdata_fp);
-  fputc('\n', xpddefault_service_perfdata_fp);
-  fflush(xpddefault_service_perfdata_fp);
-  pthread_mutex_unlock(&xpddefault_service_perfdata_fp_lock);
-
-  // free memory.
-  delete[] raw_output;
-  delete[] processed_output;
+  // the line is written by the service performance data file writer.
+  xpddefault_service_perfdata_writer->push(output);
 
-  return (result);
+  return (OK);
 }
 
 // updates host performance data file.
 int xpddefault_update_host_performance_data_file(
       nagios_macros* mac,
       host* hst) {
-  char* raw_output(NULL);
-  char* processed_output(NULL);
-  int result(OK);
-
   logger(dbg_functions, basic)
     << "update_host_performance_data_file()";
 
@@ -611,36 +610,20 @@ int xpddefault_update_host_performance_data_file(
 
   // we don't have a host perfdata file.
   if (xpddefault_host_perfdata_fp == NULL
-      || xpddefault_host_perfdata_file_template == NULL)
+      || xpddefault_host_perfdata_writer == NULL)
     return (OK);
 
-  // get the raw output.
-  raw_output = string::dup(xpddefault_host_perfdata_file_template);
-
-  logger(dbg_perfdata, most)
-    << "Raw host performance file output: " << raw_output;
-
-  // process any macros in the raw output.
-  process_macros_r(mac, raw_output, &processed_output, 0);
-  if (processed_output == NULL)
-    return (ERROR);
+  // process the macros of the compiled template.
+  std::string output;
+  xpddefault_host_perfdata_file_plan.process(mac, output);
 
   logger(dbg_perfdata, most)
-    << "Processed host performance data file output: "
-    << processed_output;
+    << "Processed host performance data file output: " << output;
 
-  // lock, write to and unlock host performance data file.
-  pthread_mutex_lock(&xpddefault_host_perfdata_fp_lock);
-  fputs(processed_output, xpddefault_host_perfdata_fp);
-  fputc('\n', xpddefault_host_perfdata_fp);
-  fflush(xpddefault_host_perfdata_fp);
-  pthread_mutex_unlock(&xpddefault_host_perfdata_fp_lock);
+  // the line is written by the host performance data file writer.
+  xpddefault_host_perfdata_writer->push(output);
 
-  // free memory.
-  delete[] raw_output;
-  delete[] processed_output;
-
-  return (result);
+  return (OK);
 }
 
 // periodically process the host perf data file.
@@ -694,8 +677,7 @@ int xpddefault_process_host_perfdata_file() {
     << "Processed host performance data file processing command "
     "line: " << processed_command_line;
 
-  // lock and close the performance data file.
-  pthread_mutex_lock(&xpddefault_host_perfdata_fp_lock);
+  // close the performance data file, pending lines are written first.
   xpddefault_close_host_perfdata_file();
 
   // run the command.
@@ -716,9 +698,8 @@ int xpddefault_process_host_perfdata_file() {
   }
   clear_volatile_macros_r(&mac);
 
-  // re-open and unlock the performance data file.
+  // re-open the performance data file.
   xpddefault_open_host_perfdata_file();
-  pthread_mutex_unlock(&xpddefault_host_perfdata_fp_lock);
 
   // check to see if the command timed out.
   if (early_timeout == true)
@@ -785,8 +766,7 @@ int xpddefault_process_service_perfdata_file() {
     << "Processed service performance data file processing "
     "command line: " << processed_command_line;
 
-  // lock and close the performance data file.
-  pthread_mutex_lock(&xpddefault_service_perfdata_fp_lock);
+  // close the performance data file, pending lines are written first.
   xpddefault_close_service_perfdata_file();
 
   // run the command.
@@ -806,9 +786,8 @@ int xpddefault_process_service_perfdata_file() {
       << processed_command_line << "' : " << e.what();
   }
 
-  // re-open and unlock the performance data file.
+  // re-open the performance data file.
   xpddefault_open_service_perfdata_file();
-  pthread_mutex_unlock(&xpddefault_service_perfdata_fp_lock);
 
   clear_volatile_macros_r(&mac);
 
@@ -825,3 +804,23 @@ int xpddefault_process_service_perfdata_file() {
 
   return (result);
 }
+
+// get host performance data file statistics.
+perfdata_writer::stats xpddefault_get_host_perfdata_file_stats() {
+  perfdata_writer::stats s;
+  if (xpddefault_host_perfdata_writer)
+    s = xpddefault_host_perfdata_writer->get_stats();
+  else
+    memset(&s, 0, sizeof(s));
+  return (s);
+}
+
+// get service performance data file statistics.
+perfdata_writer::stats xpddefault_get_service_perfdata_file_stats() {
+  perfdata_writer::stats s;
+  if (xpddefault_service_perfdata_writer)
+    s = xpddefault_service_perfdata_writer->get_stats();
+  else
+    memset(&s, 0, sizeof(s));
+  return (s);
+}
@@ -28,13 +28,17 @@
 #include <string>
 #include <sys/stat.h>
 #include <unistd.h>
+#include <vector>
 #include "com/centreon/engine/common.hh"
 #include "com/centreon/engine/globals.hh"
 #include "com/centreon/engine/logging/logger.hh"
 #include "com/centreon/engine/macros.hh"
 #include "com/centreon/engine/objects/comment.hh"
 #include "com/centreon/engine/objects/downtime.hh"
+#include "com/centreon/engine/perfdata_writer.hh"
+#include "com/centreon/engine/snapshot_writer.hh"
 #include "com/centreon/engine/statusdata.hh"
+#include "com/centreon/engine/xpddefault.hh"
 #include "com/centreon/engine/xsddefault.hh"
 #include "skiplist.h"
 
@@ -74,6 +78,9 @@ int xsddefault_cleanup_status_data(int delete_status_data) {
   if (verify_config)
     return (OK);
 
+  // Wait for the status file to be written.
+  snapshot_writer::instance().flush();
+
   // delete the status log.
   if (delete_status_data && !config->status_file().empty()) {
     if (unlink(config->status_file().c_str()))
@@ -91,125 +98,30 @@ int xsddefault_cleanup_status_data(int delete_status_data) {
 /****************** STATUS DATA OUTPUT FUNCTIONS ******************/
 /******************************************************************/
 
-/* write all status data to file */
-int xsddefault_save_status_data() {
+/**
+ *  Write a status snapshot to the status file.
+ *
+ *  @param[in] snap The snapshot, its head holds the info and program
+ *                  status.
+ *  @param[in] path The status file path.
+ *
+ *  @return True on success.
+ */
+static bool _write_status_data(
+              snapshot const& snap,
+              std::string const& path) {
   if (xsddefault_status_log_fd == -1)
-    return (OK);
-
-  int used_external_command_buffer_slots(0);
-  int high_external_command_buffer_slots(0);
-
-  logger(logging::dbg_functions, logging::basic)
-    << "save_status_data()";
-
-  // get number of items in the command buffer
-  if (config->check_external_commands()) {
-    pthread_mutex_lock(&external_command_buffer.buffer_lock);
-    used_external_command_buffer_slots = external_command_buffer.items;
-    high_external_command_buffer_slots = external_command_buffer.high;
-    pthread_mutex_unlock(&external_command_buffer.buffer_lock);
-  }
-
-  // generate check statistics
-  generate_check_stats();
+    return (true);
 
   std::ostringstream stream;
-
-  time_t current_time;
-  time(&current_time);
-
-  // write version info to status file
-  stream
-    << "#############################################\n"
-       "#        CENTREON ENGINE STATUS FILE        #\n"
-       "#                                           #\n"
-       "# THIS FILE IS AUTOMATICALLY GENERATED BY   #\n"
-       "# CENTREON ENGINE. DO NOT MODIFY THIS FILE! #\n"
-       "#############################################\n"
-       "\n"
-       "info {\n"
-       "\tcreated=" << static_cast<unsigned long>(current_time) << "\n"
-       "\t}\n\n";
-
-  // save program status data
-  stream
-    << "programstatus {\n"
-       "\tmodified_host_attributes=" << modified_host_process_attributes << "\n"
-       "\tmodified_service_attributes=" << modified_service_process_attributes << "\n"
-       "\tnagios_pid=" << static_cast<unsigned int>(getpid()) << "\n"
-       "\tprogram_start=" << static_cast<long long>(program_start) << "\n"
-       "\tlast_command_check=" << static_cast<long long>(last_command_check) << "\n"
-       "\tlast_log_rotation=" << static_cast<long long>(last_log_rotation) << "\n"
-       "\tenable_notifications=" << config->enable_notifications() << "\n"
-       "\tactive_service_checks_enabled=" << config->execute_service_checks() << "\n"
-       "\tpassive_service_checks_enabled=" << config->accept_passive_service_checks() << "\n"
-       "\tactive_host_checks_enabled=" << config->execute_host_checks() << "\n"
-       "\tpassive_host_checks_enabled=" << config->accept_passive_host_checks() << "\n"
-       "\tenable_event_handlers=" << config->enable_event_handlers() << "\n"
-       "\tobsess_over_services=" << config->obsess_over_services() << "\n"
-       "\tobsess_over_hosts=" << config->obsess_over_hosts() << "\n"
-       "\tcheck_service_freshness=" << config->check_service_freshness() << "\n"
-       "\tcheck_host_freshness=" << config->check_host_freshness() << "\n"
-       "\tenable_flap_detection=" << config->enable_flap_detection() << "\n"
-       "\tprocess_performance_data=" << config->process_performance_data() << "\n"
-       "\tglobal_host_event_handler=" << config->global_host_event_handler().c_str() << "\n"
-       "\tglobal_service_event_handler=" << config->global_service_event_handler().c_str() << "\n"
-       "\tnext_comment_id=" << next_comment_id << "\n"
-       "\tnext_downtime_id=" << next_downtime_id << "\n"
-       "\tnext_event_id=" << next_event_id << "\n"
-       "\tnext_problem_id=" << next_problem_id << "\n"
-       "\tnext_notification_id=" << next_notification_id << "\n"
-       "\ttotal_external_command_buffer_slots=" << config->external_command_buffer_slots() << "\n"
-       "\tused_external_command_buffer_slots=" << used_external_command_buffer_slots << "\n"
-       "\thigh_external_command_buffer_slots=" << high_external_command_buffer_slots << "\n"
-       "\tactive_scheduled_host_check_stats="
-    << check_statistics[ACTIVE_SCHEDULED_HOST_CHECK_STATS].minute_stats[0] << ","
-    << check_statistics[ACTIVE_SCHEDULED_HOST_CHECK_STATS].minute_stats[1] << ","
-    << check_statistics[ACTIVE_SCHEDULED_HOST_CHECK_STATS].minute_stats[2] << "\n"
-       "\tactive_ondemand_host_check_stats="
-    << check_statistics[ACTIVE_ONDEMAND_HOST_CHECK_STATS].minute_stats[0] << ","
-    << check_statistics[ACTIVE_ONDEMAND_HOST_CHECK_STATS].minute_stats[1] << ","
-    << check_statistics[ACTIVE_ONDEMAND_HOST_CHECK_STATS].minute_stats[2] << "\n"
-       "\tpassive_host_check_stats="
-    << check_statistics[PASSIVE_HOST_CHECK_STATS].minute_stats[0] << ","
-    << check_statistics[PASSIVE_HOST_CHECK_STATS].minute_stats[1] << ","
-    << check_statistics[PASSIVE_HOST_CHECK_STATS].minute_stats[2] << "\n"
-       "\tactive_scheduled_service_check_stats="
-    << check_statistics[ACTIVE_SCHEDULED_SERVICE_CHECK_STATS].minute_stats[0] << ","
-    << check_statistics[ACTIVE_SCHEDULED_SERVICE_CHECK_STATS].minute_stats[1] << ","
-    << check_statistics[ACTIVE_SCHEDULED_SERVICE_CHECK_STATS].minute_stats[2] << "\n"
-       "\tactive_ondemand_service_check_stats="
-    << check_statistics[ACTIVE_ONDEMAND_SERVICE_CHECK_STATS].minute_stats[0] << ","
-    << check_statistics[ACTIVE_ONDEMAND_SERVICE_CHECK_STATS].minute_stats[1] << ","
-    << check_statistics[ACTIVE_ONDEMAND_SERVICE_CHECK_STATS].minute_stats[2] << "\n"
-       "\tpassive_service_check_stats="
-    << check_statistics[PASSIVE_SERVICE_CHECK_STATS].minute_stats[0] << ","
-    << check_statistics[PASSIVE_SERVICE_CHECK_STATS].minute_stats[1] << ","
-    << check_statistics[PASSIVE_SERVICE_CHECK_STATS].minute_stats[2] << "\n"
-       "\tcached_host_check_stats="
-    << check_statistics[ACTIVE_CACHED_HOST_CHECK_STATS].minute_stats[0] << ","
-    << check_statistics[ACTIVE_CACHED_HOST_CHECK_STATS].minute_stats[1] << ","
-    << check_statistics[ACTIVE_CACHED_HOST_CHECK_STATS].minute_stats[2] << "\n"
-       "\tcached_service_check_stats="
-    << check_statistics[ACTIVE_CACHED_SERVICE_CHECK_STATS].minute_stats[0] << ","
-    << check_statistics[ACTIVE_CACHED_SERVICE_CHECK_STATS].minute_stats[1] << ","
-    << check_statistics[ACTIVE_CACHED_SERVICE_CHECK_STATS].minute_stats[2] << "\n"
-       "\texternal_command_stats="
-    << check_statistics[EXTERNAL_COMMAND_STATS].minute_stats[0] << ","
-    << check_statistics[EXTERNAL_COMMAND_STATS].minute_stats[1] << ","
-    << check_statistics[EXTERNAL_COMMAND_STATS].minute_stats[2] << "\n"
-       "\tparallel_host_check_stats="
-    << check_statistics[PARALLEL_HOST_CHECK_STATS].minute_stats[0] << ","
-    << check_statistics[PARALLEL_HOST_CHECK_STATS].minute_stats[1] << ","
-    << check_statistics[PARALLEL_HOST_CHECK_STATS].minute_stats[2] << "\n"
-       "\tserial_host_check_stats="
-    << check_statistics[SERIAL_HOST_CHECK_STATS].minute_stats[0] << ","
-    << check_statistics[SERIAL_HOST_CHECK_STATS].minute_stats[1] << ","
-    << check_statistics[SERIAL_HOST_CHECK_STATS].minute_stats[2] << "\n"
-       "\t}\n\n";
+  stream << snap.head();
 
   /* save host status data */
-  for (host* hst = host_list; hst; hst = hst->next) {
+  for (std::vector<host_struct>::const_iterator
+         it(snap.hosts().begin()), end(snap.hosts().end());
+       it != end;
+       ++it) {
+    host const* hst(&*it);
     stream
       << "hoststatus {\n"
          "\thost_name=" << hst->name << "\n"
@@ -259,7 +171,7 @@ int xsddefault_save_status_data() {
          "\tflap_detection_enabled=" << hst->flap_detection_enabled << "\n"
          "\tprocess_performance_data=" << hst->process_performance_data << "\n"
          "\tobsess_over_host=" << hst->obsess_over_host << "\n"
-         "\tlast_update=" << static_cast<unsigned long>(current_time) << "\n"
+         "\tlast_update=" << static_cast<unsigned long>(snap.created()) << "\n"
          "\tis_flapping=" << hst->is_flapping << "\n"
          "\tpercent_state_change=" << std::setprecision(2) << std::fixed << hst->percent_state_change << "\n"
          "\tscheduled_downtime_depth=" << hst->scheduled_downtime_depth << "\n";
@@ -274,7 +186,11 @@ int xsddefault_save_status_data() {
   }
 
   // save service status data
-  for (service* svc = service_list; svc; svc = svc->next) {
+  for (std::vector<service_struct>::const_iterator
+         it(snap.services().begin()), end(snap.services().end());
+       it != end;
+       ++it) {
+    service const* svc(&*it);
     stream
       << "servicestatus {\n"
          "\thost_name=" << svc->host_name << "\n"
@@ -326,7 +242,7 @@ int xsddefault_save_status_data() {
          "\tflap_detection_enabled=" << svc->flap_detection_enabled << "\n"
          "\tprocess_performance_data=" << svc->process_performance_data << "\n"
          "\tobsess_over_service=" << svc->obsess_over_service << "\n"
-         "\tlast_update=" << static_cast<unsigned long>(current_time) << "\n"
+         "\tlast_update=" << static_cast<unsigned long>(snap.created()) << "\n"
          "\tis_flapping=" << svc->is_flapping << "\n"
          "\tpercent_state_change=" << std::setprecision(2) << std::fixed << svc->percent_state_change << "\n"
          "\tscheduled_downtime_depth=" << svc->scheduled_downtime_depth << "\n";
@@ -341,7 +257,11 @@ int xsddefault_save_status_data() {
   }
 
   // save contact status data
-  for (contact* cntct = contact_list; cntct; cntct = cntct->next) {
+  for (std::vector<contact_struct>::const_iterator
+         it(snap.contacts().begin()), end(snap.contacts().end());
+       it != end;
+       ++it) {
+    contact const* cntct(&*it);
     stream
       << "contactstatus {\n"
          "\tcontact_name=" << cntct->name << "\n"
@@ -364,7 +284,11 @@ int xsddefault_save_status_data() {
   }
 
   // save all comments
-  for (comment* com = comment_list; com; com = com->next) {
+  for (std::vector<comment_struct>::const_iterator
+         it(snap.comments().begin()), end(snap.comments().end());
+       it != end;
+       ++it) {
+    comment const* com(&*it);
     if (com->comment_type == HOST_COMMENT)
       stream << "hostcomment {\n";
     else
@@ -386,7 +310,11 @@ int xsddefault_save_status_data() {
   }
 
   // save all downtime
-  for (scheduled_downtime* dt = scheduled_downtime_list; dt; dt = dt->next) {
+  for (std::vector<scheduled_downtime_struct>::const_iterator
+         it(snap.downtimes().begin()), end(snap.downtimes().end());
+       it != end;
+       ++it) {
+    scheduled_downtime const* dt(&*it);
     if (dt->type == HOST_DOWNTIME)
       stream << "hostdowntime {\n";
     else
@@ -407,9 +335,6 @@ int xsddefault_save_status_data() {
          "\t}\n\n";
   }
 
-  // Write data in buffer.
-  stream.flush();
-
   // Prepare status file for overwrite.
   if ((ftruncate(xsddefault_status_log_fd, 0) == -1)
       || (fsync(xsddefault_status_log_fd) == -1)
@@ -417,8 +342,8 @@ int xsddefault_save_status_data() {
     char const* msg(strerror(errno));
     logger(logging::log_runtime_error, logging::basic)
       << "Error: Unable to update status data file '"
-      << config->status_file() << "': " << msg;
-    return (ERROR);
+      << path << "': " << msg;
+    return (false);
   }
 
   // Write status file.
@@ -431,12 +356,172 @@ int xsddefault_save_status_data() {
       char const* msg(strerror(errno));
       logger(logging::log_runtime_error, logging::basic)
         << "Error: Unable to update status data file '"
-        << config->status_file() << "': " << msg;
-      return (ERROR);
+        << path << "': " << msg;
+      return (false);
     }
     data_ptr += wb;
     size -= wb;
   }
 
+  return (true);
+}
+
+/* write all status data to file */
+int xsddefault_save_status_data() {
+  if (xsddefault_status_log_fd == -1)
+    return (OK);
+
+  int used_external_command_buffer_slots(0);
+  int high_external_command_buffer_slots(0);
+
+  logger(logging::dbg_functions, logging::basic)
+    << "save_status_data()";
+
+  // get number of items in the command buffer
+  if (config->check_external_commands()) {
+    pthread_mutex_lock(&external_command_buffer.buffer_lock);
+    used_external_command_buffer_slots = external_command_buffer.items;
+    high_external_command_buffer_slots = external_command_buffer.high;
+    pthread_mutex_unlock(&external_command_buffer.buffer_lock);
+  }
+
+  // generate check statistics
+  generate_check_stats();
+
+  std::ostringstream stream;
+
+  time_t current_time;
+  time(&current_time);
+
+  snapshot_writer::stats retention_stats(
+    snapshot_writer::instance().get_stats(snapshot_writer::retention_file));
+  snapshot_writer::stats status_stats(
+    snapshot_writer::instance().get_stats(snapshot_writer::status_file));
+  perfdata_writer::stats host_perfdata_stats(
+    xpddefault_get_host_perfdata_file_stats());
+  perfdata_writer::stats service_perfdata_stats(
+    xpddefault_get_service_perfdata_file_stats());
+
+  // write version info to status file
+  stream
+    << "#############################################\n"
+       "#        CENTREON ENGINE STATUS FILE        #\n"
+       "#                                           #\n"
+       "# THIS FILE IS AUTOMATICALLY GENERATED BY   #\n"
+       "# CENTREON ENGINE. DO NOT MODIFY THIS FILE! #\n"
+       "#############################################\n"
+       "\n"
+       "info {\n"
+       "\tcreated=" << static_cast<unsigned long>(current_time) << "\n"
+       "\t}\n\n";
+
+  // save program status data
+  stream
+    << "programstatus {\n"
+       "\tmodified_host_attributes=" << modified_host_process_attributes << "\n"
+       "\tmodified_service_attributes=" << modified_service_process_attributes << "\n"
+       "\tnagios_pid=" << static_cast<unsigned int>(getpid()) << "\n"
+       "\tprogram_start=" << static_cast<long long>(program_start) << "\n"
+       "\tlast_command_check=" << static_cast<long long>(last_command_check) << "\n"
+       "\tlast_log_rotation=" << static_cast<long long>(last_log_rotation) << "\n"
+       "\tenable_notifications=" << config->enable_notifications() << "\n"
+       "\tactive_service_checks_enabled=" << config->execute_service_checks() << "\n"
+       "\tpassive_service_checks_enabled=" << config->accept_passive_service_checks() << "\n"
+       "\tactive_host_checks_enabled=" << config->execute_host_checks() << "\n"
+       "\tpassive_host_checks_enabled=" << config->accept_passive_host_checks() << "\n"
+       "\tenable_event_handlers=" << config->enable_event_handlers() << "\n"
+       "\tobsess_over_services=" << config->obsess_over_services() << "\n"
+       "\tobsess_over_hosts=" << config->obsess_over_hosts() << "\n"
+       "\tcheck_service_freshness=" << config->check_service_freshness() << "\n"
+       "\tcheck_host_freshness=" << config->check_host_freshness() << "\n"
+       "\tenable_flap_detection=" << config->enable_flap_detection() << "\n"
+       "\tprocess_performance_data=" << config->process_performance_data() << "\n"
+       "\tglobal_host_event_handler=" << config->global_host_event_handler().c_str() << "\n"
+       "\tglobal_service_event_handler=" << config->global_service_event_handler().c_str() << "\n"
+       "\tnext_comment_id=" << next_comment_id << "\n"
+       "\tnext_downtime_id=" << next_downtime_id << "\n"
+       "\tnext_event_id=" << next_event_id << "\n"
+       "\tnext_problem_id=" << next_problem_id << "\n"
+       "\tnext_notification_id=" << next_notification_id << "\n"
+       "\ttotal_external_command_buffer_slots=" << config->external_command_buffer_slots() << "\n"
+       "\tused_external_command_buffer_slots=" << used_external_command_buffer_slots << "\n"
+       "\thigh_external_command_buffer_slots=" << high_external_command_buffer_slots << "\n"
+       "\tactive_scheduled_host_check_stats="
+    << check_statistics[ACTIVE_SCHEDULED_HOST_CHECK_STATS].minute_stats[0] << ","
+    << check_statistics[ACTIVE_SCHEDULED_HOST_CHECK_STATS].minute_stats[1] << ","
+    << check_statistics[ACTIVE_SCHEDULED_HOST_CHECK_STATS].minute_stats[2] << "\n"
+       "\tactive_ondemand_host_check_stats="
+    << check_statistics[ACTIVE_ONDEMAND_HOST_CHECK_STATS].minute_stats[0] << ","
+    << check_statistics[ACTIVE_ONDEMAND_HOST_CHECK_STATS].minute_stats[1] << ","
+    << check_statistics[ACTIVE_ONDEMAND_HOST_CHECK_STATS].minute_stats[2] << "\n"
+       "\tpassive_host_check_stats="
+    << check_statistics[PASSIVE_HOST_CHECK_STATS].minute_stats[0] << ","
+    << check_statistics[PASSIVE_HOST_CHECK_STATS].minute_stats[1] << ","
+    << check_statistics[PASSIVE_HOST_CHECK_STATS].minute_stats[2] << "\n"
+       "\tactive_scheduled_service_check_stats="
+    << check_statistics[ACTIVE_SCHEDULED_SERVICE_CHECK_STATS].minute_stats[0] << ","
+    << check_statistics[ACTIVE_SCHEDULED_SERVICE_CHECK_STATS].minute_stats[1] << ","
+    << check_statistics[ACTIVE_SCHEDULED_SERVICE_CHECK_STATS].minute_stats[2] << "\n"
+       "\tactive_ondemand_service_check_stats="
+    << check_statistics[ACTIVE_ONDEMAND_SERVICE_CHECK_STATS].minute_stats[0] << ","
+    << check_statistics[ACTIVE_ONDEMAND_SERVICE_CHECK_STATS].minute_stats[1] << ","
+    << check_statistics[ACTIVE_ONDEMAND_SERVICE_CHECK_STATS].minute_stats[2] << "\n"
+       "\tpassive_service_check_stats="
+    << check_statistics[PASSIVE_SERVICE_CHECK_STATS].minute_stats[0] << ","
+    << check_statistics[PASSIVE_SERVICE_CHECK_STATS].minute_stats[1] << ","
+    << check_statistics[PASSIVE_SERVICE_CHECK_STATS].minute_stats[2] << "\n"
+       "\tcached_host_check_stats="
+    << check_statistics[ACTIVE_CACHED_HOST_CHECK_STATS].minute_stats[0] << ","
+    << check_statistics[ACTIVE_CACHED_HOST_CHECK_STATS].minute_stats[1] << ","
+    << check_statistics[ACTIVE_CACHED_HOST_CHECK_STATS].minute_stats[2] << "\n"
+       "\tcached_service_check_stats="
+    << check_statistics[ACTIVE_CACHED_SERVICE_CHECK_STATS].minute_stats[0] << ","
+    << check_statistics[ACTIVE_CACHED_SERVICE_CHECK_STATS].minute_stats[1] << ","
+    << check_statistics[ACTIVE_CACHED_SERVICE_CHECK_STATS].minute_stats[2] << "\n"
+       "\texternal_command_stats="
+    << check_statistics[EXTERNAL_COMMAND_STATS].minute_stats[0] << ","
+    << check_statistics[EXTERNAL_COMMAND_STATS].minute_stats[1] << ","
+    << check_statistics[EXTERNAL_COMMAND_STATS].minute_stats[2] << "\n"
+       "\tparallel_host_check_stats="
+    << check_statistics[PARALLEL_HOST_CHECK_STATS].minute_stats[0] << ","
+    << check_statistics[PARALLEL_HOST_CHECK_STATS].minute_stats[1] << ","
+    << check_statistics[PARALLEL_HOST_CHECK_STATS].minute_stats[2] << "\n"
+       "\tserial_host_check_stats="
+    << check_statistics[SERIAL_HOST_CHECK_STATS].minute_stats[0] << ","
+    << check_statistics[SERIAL_HOST_CHECK_STATS].minute_stats[1] << ","
+    << check_statistics[SERIAL_HOST_CHECK_STATS].minute_stats[2] << "\n"
+       "\treaped_check_result_stats="
+    << check_statistics[REAPED_CHECK_RESULT_STATS].minute_stats[0] << ","
+    << check_statistics[REAPED_CHECK_RESULT_STATS].minute_stats[1] << ","
+    << check_statistics[REAPED_CHECK_RESULT_STATS].minute_stats[2] << "\n"
+       "\tretention_snapshot_stats="
+    << retention_stats.snapshot_time << ","
+    << retention_stats.snapshot_size << ","
+    << retention_stats.write_time << ","
+    << retention_stats.dropped << "\n"
+       "\tstatus_snapshot_stats="
+    << status_stats.snapshot_time << ","
+    << status_stats.snapshot_size << ","
+    << status_stats.write_time << ","
+    << status_stats.dropped << "\n"
+       "\thost_perfdata_file_stats="
+    << host_perfdata_stats.lines << ","
+    << host_perfdata_stats.lines_per_second << ","
+    << host_perfdata_stats.writes << ","
+    << host_perfdata_stats.write_time << "\n"
+       "\tservice_perfdata_file_stats="
+    << service_perfdata_stats.lines << ","
+    << service_perfdata_stats.lines_per_second << ","
+    << service_perfdata_stats.writes << ","
+    << service_perfdata_stats.write_time << "\n"
+       "\t}\n\n";
+
+  // Objects are written by the snapshot writer thread.
+  snapshot_writer::instance().push(
+    snapshot_writer::status_file,
+    new snapshot(stream.str()),
+    &_write_status_data,
+    config->status_file());
+
   return (OK);
 }
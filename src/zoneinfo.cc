@@ -0,0 +1,547 @@
+/*
+** Copyright 2017 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include "com/centreon/concurrency/locker.hh"
+#include "com/centreon/concurrency/mutex.hh"
+#include "com/centreon/engine/logging/logger.hh"
+#include "com/centreon/engine/zoneinfo.hh"
+#include "com/centreon/shared_ptr.hh"
+#include "com/centreon/unordered_hash.hh"
+
+using namespace com::centreon;
+using namespace com::centreon::engine;
+using namespace com::centreon::engine::logging;
+
+// Loaded zones.
+static concurrency::mutex _zones_lock;
+static umap<std::string, shared_ptr<zoneinfo> > _zones;
+
+/**
+ *  Get the number of days between the epoch and a date.
+ *
+ *  @param[in] year   Year.
+ *  @param[in] month  Month (1 to 12).
+ *  @param[in] day    Day in month (1 to 31).
+ *
+ *  @return Number of days, negative before the epoch.
+ */
+static long long _days_from_civil(
+                   long long year,
+                   unsigned int month,
+                   unsigned int day) {
+  year -= (month <= 2);
+  long long era((year >= 0 ? year : year - 399) / 400);
+  long long year_of_era(year - era * 400);
+  long long day_of_year(
+              (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1);
+  long long day_of_era(
+              year_of_era * 365
+              + year_of_era / 4
+              - year_of_era / 100
+              + day_of_year);
+  return (era * 146097 + day_of_era - 719468);
+}
+
+/**
+ *  Read a big endian signed integer.
+ *
+ *  @param[in] data  Data.
+ *  @param[in] size  Integer size (4 or 8).
+ *
+ *  @return The integer.
+ */
+static long long _read_integer(char const* data, unsigned int size) {
+  unsigned long long value(0);
+  for (unsigned int i(0); i < size; ++i)
+    value = (value << 8) | static_cast<unsigned char>(data[i]);
+  if ((size < 8) && (value & (1ull << (size * 8 - 1))))
+    value |= ~0ull << (size * 8);
+  return (static_cast<long long>(value));
+}
+
+/**
+ *  Get a zone.
+ *
+ *  @param[in] tz  Zone name, as it would be set in the TZ environment
+ *                 variable. NULL is the current process timezone.
+ *
+ *  @return The zone, loaded on first use.
+ */
+zoneinfo const& zoneinfo::find(char const* tz) {
+  if (!tz)
+    tz = getenv("TZ");
+  std::string name(tz ? tz : "/etc/localtime");
+
+  concurrency::locker lock(&_zones_lock);
+  umap<std::string, shared_ptr<zoneinfo> >::const_iterator
+    it(_zones.find(name));
+  if (it == _zones.end())
+    it = _zones.insert(std::make_pair(
+                         name,
+                         shared_ptr<zoneinfo>(new zoneinfo(name)))).first;
+  return (*it->second);
+}
+
+/**
+ *  Convert a time to a broken-down local time of this zone, like
+ *  localtime_r() does.
+ *
+ *  @param[in]  t       Time.
+ *  @param[out] result  Broken-down local time.
+ */
+void zoneinfo::localtime(time_t t, struct tm* result) const {
+  ttinfo const& info(_find(t));
+  time_t local(t + info.offset);
+  gmtime_r(&local, result);
+  result->tm_isdst = info.isdst;
+#ifdef HAVE_TM_ZONE
+  result->tm_gmtoff = info.offset;
+  result->tm_zone = info.abbr.c_str();
+#endif // HAVE_TM_ZONE
+  return ;
+}
+
+/**
+ *  Convert a broken-down local time of this zone to a time, like
+ *  mktime() does. Out of range fields are normalized and ambiguous or
+ *  nonexistent local times are resolved the same way as the GNU C
+ *  library.
+ *
+ *  @param[in,out] t  Broken-down local time, normalized on return.
+ *
+ *  @return Time.
+ */
+time_t zoneinfo::mktime(struct tm* t) const {
+  long long year(t->tm_year + 1900ll);
+  long long month(t->tm_mon);
+  year += month / 12;
+  month %= 12;
+  if (month < 0) {
+    month += 12;
+    --year;
+  }
+  long long local(
+              (_days_from_civil(year, month + 1, 1) + t->tm_mday - 1)
+              * 24 * 60 * 60
+              + t->tm_hour * 60ll * 60
+              + t->tm_min * 60ll
+              + t->tm_sec);
+
+  // A local time is within one day of its UTC time, there is at most
+  // one transition in between.
+  ttinfo const* candidates[2];
+  candidates[0] = &_find(local - 24 * 60 * 60);
+  candidates[1] = &_find(local + 24 * 60 * 60);
+
+  // Like the GNU C library, ambiguous local times resolve to the
+  // requested or to the DST one and nonexistent local times use the
+  // standard offset. A requested DST flag that does not match shifts
+  // the time by one hour.
+  bool valid[2];
+  for (unsigned int i(0); i < 2; ++i)
+    valid[i] = (_find(local - candidates[i]->offset).offset
+                == candidates[i]->offset);
+  unsigned int i(0);
+  if (valid[0] && valid[1]) {
+    if (t->tm_isdst >= 0)
+      i = (candidates[1]->isdst == (t->tm_isdst > 0)) ? 1 : 0;
+    else
+      i = (!candidates[0]->isdst && candidates[1]->isdst) ? 1 : 0;
+  }
+  else if (valid[0] || valid[1])
+    i = valid[0] ? 0 : 1;
+  else
+    i = (candidates[0]->isdst && !candidates[1]->isdst) ? 1 : 0;
+  time_t result(local - candidates[i]->offset);
+  if ((t->tm_isdst >= 0)
+      && (candidates[i]->isdst != (t->tm_isdst > 0)))
+    result += (t->tm_isdst > 0) ? -60 * 60 : 60 * 60;
+
+  localtime(result, t);
+  return (result);
+}
+
+/**
+ *  Get the zone name.
+ *
+ *  @return Name, as given to find().
+ */
+std::string const& zoneinfo::name() const throw () {
+  return (_name);
+}
+
+/**
+ *  Load zone rules.
+ *
+ *  @param[in] name  Zone name.
+ */
+zoneinfo::zoneinfo(std::string const& name)
+  : _has_dst(false), _has_posix(false), _name(name) {
+  std::string path(name);
+  if (!path.empty() && (path[0] == ':'))
+    path.erase(0, 1);
+  bool loaded(false);
+  if (!path.empty()) {
+    if (path[0] != '/') {
+      char const* dir(getenv("TZDIR"));
+      path.insert(0, "/");
+      path.insert(0, dir ? dir : "/usr/share/zoneinfo");
+    }
+    loaded = _load_file(path);
+  }
+  if (!loaded) {
+    _has_posix = false;
+    _transitions.clear();
+    _transition_types.clear();
+    _types.clear();
+    if (!_parse_posix(name.c_str())) {
+      if (!name.empty())
+        logger(log_runtime_warning, basic)
+          << "Warning: Unknown timezone '" << name << "', using UTC";
+      ttinfo utc;
+      utc.abbr = "UTC";
+      utc.isdst = false;
+      utc.offset = 0;
+      _types.push_back(utc);
+    }
+  }
+}
+
+/**
+ *  Find the local time type of a time.
+ *
+ *  @param[in] t  Time.
+ *
+ *  @return Local time type.
+ */
+zoneinfo::ttinfo const& zoneinfo::_find(time_t t) const {
+  if (_transitions.empty())
+    return (_has_posix ? _find_posix(t) : _types[0]);
+  if (t < _transitions.front())
+    return (_types[0]);
+  if (_has_posix && (t >= _transitions.back()))
+    return (_find_posix(t));
+  std::vector<long long>::const_iterator
+    it(std::upper_bound(_transitions.begin(), _transitions.end(), t));
+  return (_types[_transition_types[it - _transitions.begin() - 1]]);
+}
+
+/**
+ *  Find the local time type of a time from POSIX TZ rules.
+ *
+ *  @param[in] t  Time.
+ *
+ *  @return Local time type.
+ */
+zoneinfo::ttinfo const& zoneinfo::_find_posix(time_t t) const {
+  if (!_has_dst)
+    return (_posix[0]);
+  time_t local(t + _posix[0].offset);
+  struct tm tmp;
+  gmtime_r(&local, &tmp);
+  long long year(tmp.tm_year + 1900ll);
+  long long start(_rule_to_time(_start, year) - _posix[0].offset);
+  long long end(_rule_to_time(_end, year) - _posix[1].offset);
+  bool isdst(
+         (start < end)
+         ? ((t >= start) && (t < end))
+         : ((t < end) || (t >= start)));
+  return (_posix[isdst ? 1 : 0]);
+}
+
+/**
+ *  Load rules from a TZif file of the zoneinfo database.
+ *
+ *  @param[in] path  File path.
+ *
+ *  @return True on success.
+ */
+bool zoneinfo::_load_file(std::string const& path) {
+  std::ifstream file(path.c_str(), std::ios::binary);
+  if (!file.is_open())
+    return (false);
+  std::string data(
+                (std::istreambuf_iterator<char>(file)),
+                std::istreambuf_iterator<char>());
+
+  // Header: magic, version, 15 reserved bytes and 6 counts.
+  std::size_t const header_size(44);
+  std::size_t pos(0);
+  unsigned int time_size(4);
+  unsigned long long counts[6];
+  for (unsigned int pass(0); pass < 2; ++pass) {
+    if ((data.size() < pos + header_size)
+        || data.compare(pos, 4, "TZif"))
+      return (false);
+    for (unsigned int i(0); i < 6; ++i)
+      counts[i] = _read_integer(data.data() + pos + 20 + i * 4, 4);
+    // Version 1 data is followed by 64-bit data.
+    if ((pass == 1) || (data[4] < '2'))
+      break;
+    pos += header_size
+      + counts[3] * 5
+      + counts[4] * 6
+      + counts[5]
+      + counts[2] * 8
+      + counts[1]
+      + counts[0];
+    time_size = 8;
+  }
+  pos += header_size;
+  unsigned long long leapcnt(counts[2]);
+  unsigned long long timecnt(counts[3]);
+  unsigned long long typecnt(counts[4]);
+  unsigned long long charcnt(counts[5]);
+  std::size_t size(
+                timecnt * (time_size + 1)
+                + typecnt * 6
+                + charcnt
+                + leapcnt * (time_size + 4)
+                + counts[1]
+                + counts[0]);
+  if (!typecnt || (data.size() < pos + size))
+    return (false);
+
+  // Transitions.
+  char const* ptr(data.data() + pos);
+  _transitions.resize(timecnt);
+  _transition_types.resize(timecnt);
+  for (unsigned long long i(0); i < timecnt; ++i)
+    _transitions[i] = _read_integer(ptr + i * time_size, time_size);
+  ptr += timecnt * time_size;
+  for (unsigned long long i(0); i < timecnt; ++i) {
+    _transition_types[i] = static_cast<unsigned char>(ptr[i]);
+    if (_transition_types[i] >= typecnt)
+      return (false);
+  }
+  ptr += timecnt;
+
+  // Local time types.
+  char const* abbrs(ptr + typecnt * 6);
+  _types.resize(typecnt);
+  for (unsigned long long i(0); i < typecnt; ++i) {
+    char const* type(ptr + i * 6);
+    unsigned int index(static_cast<unsigned char>(type[5]));
+    if (index >= charcnt)
+      return (false);
+    _types[i].offset = _read_integer(type, 4);
+    _types[i].isdst = (type[4] != 0);
+    char const* end(std::find(abbrs + index, abbrs + charcnt, '\0'));
+    _types[i].abbr.assign(abbrs + index, end);
+  }
+  pos += size;
+
+  // Footer: POSIX TZ string for times after the last transition.
+  if ((time_size == 8)
+      && (pos < data.size())
+      && (data[pos] == '\n')) {
+    std::size_t end(data.find('\n', pos + 1));
+    if ((end != std::string::npos) && (end > pos + 1))
+      _parse_posix(data.substr(pos + 1, end - pos - 1).c_str());
+  }
+  return (true);
+}
+
+/**
+ *  Parse a POSIX TZ string (std offset [dst [offset] [,start,end]]).
+ *
+ *  @param[in] str  String.
+ *
+ *  @return True on success.
+ */
+bool zoneinfo::_parse_posix(char const* str) {
+  ttinfo std_type;
+  long offset;
+  str = _parse_posix_name(str, std_type.abbr);
+  if (!str || !(str = _parse_posix_time(str, offset)))
+    return (false);
+  std_type.isdst = false;
+  std_type.offset = -offset;
+
+  ttinfo dst_type(std_type);
+  rule start;
+  rule end;
+  bool has_dst(*str != '\0');
+  if (has_dst) {
+    if (!(str = _parse_posix_name(str, dst_type.abbr)))
+      return (false);
+    dst_type.isdst = true;
+    dst_type.offset = std_type.offset + 60 * 60;
+    if (*str && (*str != ',')) {
+      if (!(str = _parse_posix_time(str, offset)))
+        return (false);
+      dst_type.offset = -offset;
+    }
+    // Default rules are the US ones.
+    if (!*str)
+      str = ",M3.2.0,M11.1.0";
+    if ((*str != ',')
+        || !(str = _parse_posix_rule(str + 1, start))
+        || (*str != ',')
+        || !(str = _parse_posix_rule(str + 1, end))
+        || *str)
+      return (false);
+  }
+
+  _end = end;
+  _has_dst = has_dst;
+  _has_posix = true;
+  _posix[0] = std_type;
+  _posix[1] = dst_type;
+  _start = start;
+  return (true);
+}
+
+/**
+ *  Parse a zone abbreviation of a POSIX TZ string.
+ *
+ *  @param[in]  str   String.
+ *  @param[out] name  Abbreviation.
+ *
+ *  @return Pointer past the abbreviation, NULL on error.
+ */
+char const* zoneinfo::_parse_posix_name(
+                        char const* str,
+                        std::string& name) {
+  char const* end(str);
+  if (*str == '<') {
+    while (*end && (*end != '>'))
+      ++end;
+    if (!*end)
+      return (NULL);
+    name.assign(str + 1, end);
+    ++end;
+  }
+  else {
+    while (isalpha(static_cast<unsigned char>(*end)))
+      ++end;
+    name.assign(str, end);
+  }
+  return ((name.size() < 3) ? NULL : end);
+}
+
+/**
+ *  Parse a transition rule of a POSIX TZ string (Jn, n or Mm.w.d,
+ *  optionally followed by /time).
+ *
+ *  @param[in]  str  String.
+ *  @param[out] r    Rule.
+ *
+ *  @return Pointer past the rule, NULL on error.
+ */
+char const* zoneinfo::_parse_posix_rule(char const* str, rule& r) {
+  char* end;
+  r.kind = *str;
+  if (r.kind == 'M') {
+    r.month = strtol(str + 1, &end, 10);
+    if ((end == str + 1) || (*end != '.'))
+      return (NULL);
+    str = end + 1;
+    r.week = strtol(str, &end, 10);
+    if ((end == str) || (*end != '.'))
+      return (NULL);
+    str = end + 1;
+    r.day = strtol(str, &end, 10);
+    if ((end == str)
+        || (r.month < 1) || (r.month > 12)
+        || (r.week < 1) || (r.week > 5)
+        || (r.day < 0) || (r.day > 6))
+      return (NULL);
+  }
+  else {
+    if (r.kind == 'J')
+      ++str;
+    else
+      r.kind = 'D';
+    r.day = strtol(str, &end, 10);
+    if ((end == str)
+        || (r.day < ((r.kind == 'J') ? 1 : 0))
+        || (r.day > 365))
+      return (NULL);
+  }
+  str = end;
+
+  r.time = 2 * 60 * 60;
+  if (*str == '/')
+    str = _parse_posix_time(str + 1, r.time);
+  return (str);
+}
+
+/**
+ *  Parse a time or offset of a POSIX TZ string ([+-]hh[:mm[:ss]]).
+ *
+ *  @param[in]  str  String.
+ *  @param[out] t    Time in seconds.
+ *
+ *  @return Pointer past the time, NULL on error.
+ */
+char const* zoneinfo::_parse_posix_time(char const* str, long& t) {
+  long sign(1);
+  if ((*str == '+') || (*str == '-'))
+    sign = ((*str++ == '-') ? -1 : 1);
+  if (!isdigit(static_cast<unsigned char>(*str)))
+    return (NULL);
+  char* end;
+  t = strtol(str, &end, 10) * 60 * 60;
+  for (long unit(60); (unit >= 1) && (*end == ':'); unit /= 60) {
+    str = end + 1;
+    t += strtol(str, &end, 10) * unit;
+    if (end == str)
+      return (NULL);
+  }
+  t *= sign;
+  return (end);
+}
+
+/**
+ *  Get the local time of a transition rule in a given year.
+ *
+ *  @param[in] r     Rule.
+ *  @param[in] year  Year.
+ *
+ *  @return Local time, in seconds since the epoch.
+ */
+long long zoneinfo::_rule_to_time(rule const& r, long long year) {
+  long long days(_days_from_civil(year, 1, 1));
+  bool leap(!(year % 4) && ((year % 100) || !(year % 400)));
+  if (r.kind == 'J')
+    days += r.day - 1 + ((leap && (r.day >= 60)) ? 1 : 0);
+  else if (r.kind == 'D')
+    days += r.day;
+  else {
+    // Day of the week of the first day of the month (epoch was a
+    // thursday), then the requested week, the fifth being the last.
+    long long first(_days_from_civil(year, r.month, 1));
+    long long next(
+                (r.month == 12)
+                ? _days_from_civil(year + 1, 1, 1)
+                : _days_from_civil(year, r.month + 1, 1));
+    int wday(((first + 4) % 7 + 7) % 7);
+    long long day((r.day - wday + 7) % 7 + (r.week - 1) * 7);
+    while (first + day >= next)
+      day -= 7;
+    days = first + day;
+  }
+  return (days * 24 * 60 * 60 + r.time);
+}
@@ -28,12 +28,15 @@
 #  include "com/centreon/engine/broker/loader.hh"
 #  include "com/centreon/engine/checks/checker.hh"
 #  include "com/centreon/engine/commands/set.hh"
+#  include "com/centreon/engine/commands/system_runner.hh"
 #  include "com/centreon/engine/configuration/applier/state.hh"
 #  include "com/centreon/engine/configuration/state.hh"
 #  include "com/centreon/engine/events/loop.hh"
 #  include "com/centreon/engine/globals.hh"
 #  include "com/centreon/engine/logging/logger.hh"
+#  include "com/centreon/engine/macros/summary.hh"
 #  include "com/centreon/engine/namespace.hh"
+#  include "com/centreon/engine/snapshot_writer.hh"
 #  include "com/centreon/engine/timezone_manager.hh"
 #  include "com/centreon/logging/backend.hh"
 #  include "com/centreon/logging/engine.hh"
@@ -132,6 +135,9 @@ private:
       commands::set::load();
       configuration::applier::state::load();
       checks::checker::load();
+      commands::system_runner::load();
+      macros::summary::load();
+      snapshot_writer::load();
       events::loop::load();
       broker::loader::load();
       broker::compatibility::load();
@@ -151,12 +157,15 @@ private:
 
   bool       _deinit() {
     try {
+      snapshot_writer::unload();
+      macros::summary::unload();
+      commands::system_runner::unload();
       broker::compatibility::unload();
       broker::loader::unload();
-      events::loop::unload();
-      checks::checker::unload();
       configuration::applier::state::unload();
       commands::set::unload();
+      checks::checker::unload();
+      events::loop::unload();
       delete config;
       config = NULL;
       com::centreon::clib::unload();
@@ -0,0 +1,110 @@
+/*
+** Copyright 2017 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstring>
+#include <gtest/gtest.h>
+#include "com/centreon/engine/checks.hh"
+#include "com/centreon/engine/checks/checker.hh"
+#include "com/centreon/engine/configuration/applier/state.hh"
+#include "com/centreon/engine/configuration/state.hh"
+#include "com/centreon/engine/events/timed_event.hh"
+#include "com/centreon/engine/globals.hh"
+#include "com/centreon/engine/macros/summary.hh"
+#include "com/centreon/engine/objects/host.hh"
+
+using namespace com::centreon::engine;
+
+class CheckDeadlines : public ::testing::Test {
+public:
+  void SetUp() {
+    config = new configuration::state;
+    config->check_host_freshness(true);
+    configuration::applier::state::load();
+    checks::checker::load();
+    macros::summary::load();
+
+    // Passive host whose results are stale for long.
+    memset(&_hst, 0, sizeof(_hst));
+    _hst.name = const_cast<char*>("passive");
+    _hst.accept_passive_host_checks = true;
+    _hst.check_freshness = true;
+    _hst.check_type = HOST_CHECK_PASSIVE;
+    _hst.current_state = HOST_UP;
+    _hst.freshness_threshold = 60;
+    _hst.has_been_checked = true;
+    _hst.last_check = 1;
+    _hst.last_hard_state = HOST_UP;
+    _hst.last_state = HOST_UP;
+    _hst.max_attempts = 1;
+    _hst.state_type = HARD_STATE;
+    _props.recovery_been_sent = true;
+    _hst.other_props = &_props;
+    host_list = &_hst;
+  }
+
+  void TearDown() {
+    // Objects must not stay indexed once the test is over.
+    _hst.check_freshness = false;
+    _hst.is_executing = false;
+    update_host_check_deadlines(&_hst);
+    timed_event* evt(quick_timed_event.find(
+                                        events::hash_timed_event::low,
+                                        events::hash_timed_event::host_check,
+                                        &_hst));
+    if (evt) {
+      remove_event(evt, &event_list_low, &event_list_low_tail);
+      delete evt;
+    }
+    host_list = NULL;
+    macros::summary::unload();
+    checks::checker::unload();
+    configuration::applier::state::unload();
+    delete config;
+    config = NULL;
+  }
+
+protected:
+  host                  _hst;
+  host_other_properties _props;
+};
+
+// Given a host dropped from the freshness index while its check runs
+// When the processing of its result finishes later
+// Then its freshness is checked again once its results are stale
+TEST_F(CheckDeadlines, FreshnessAfterDeferredResult) {
+  _hst.is_executing = true;
+  update_host_check_deadlines(&_hst);
+  check_host_result_freshness();
+  ASSERT_FALSE(_hst.is_being_freshened);
+
+  // The result was reaped while the host was still executing, its
+  // processing is finished afterwards.
+  _hst.is_executing = false;
+  process_host_check_result_3x(
+    &_hst,
+    HOST_UP,
+    NULL,
+    CHECK_OPTION_NONE,
+    false,
+    true,
+    0);
+
+  check_host_result_freshness();
+  ASSERT_TRUE(_hst.is_being_freshened);
+}
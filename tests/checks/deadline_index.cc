@@ -0,0 +1,80 @@
+/*
+** Copyright 2017 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <gtest/gtest.h>
+#include "com/centreon/engine/checks/deadline_index.hh"
+
+using namespace com::centreon::engine;
+
+// Given an index with objects whose deadlines are not sorted
+// When objects are popped at some time
+// Then only the objects whose deadline has passed are popped, earliest first
+TEST(DeadlineIndex, PopPassedDeadlines) {
+  int objs[3];
+  checks::deadline_index<int> index;
+  index.set(&objs[0], 30);
+  index.set(&objs[1], 10);
+  index.set(&objs[2], 20);
+
+  int* obj(NULL);
+  ASSERT_FALSE(index.pop(9, obj));
+  ASSERT_TRUE(index.pop(20, obj));
+  ASSERT_EQ(obj, &objs[1]);
+  ASSERT_TRUE(index.pop(20, obj));
+  ASSERT_EQ(obj, &objs[2]);
+  ASSERT_FALSE(index.pop(20, obj));
+  ASSERT_EQ(index.size(), 1u);
+}
+
+// Given an object with a deadline
+// When its deadline is set again
+// Then it only has the new deadline
+TEST(DeadlineIndex, SetReplacesDeadline) {
+  int objs[2];
+  checks::deadline_index<int> index;
+  index.set(&objs[0], 10);
+  index.set(&objs[1], 20);
+  index.set(&objs[0], 30);
+  ASSERT_EQ(index.size(), 2u);
+
+  int* obj(NULL);
+  ASSERT_TRUE(index.pop(30, obj));
+  ASSERT_EQ(obj, &objs[1]);
+  ASSERT_TRUE(index.pop(30, obj));
+  ASSERT_EQ(obj, &objs[0]);
+  ASSERT_TRUE(index.empty());
+}
+
+// Given an index with objects
+// When an object is erased
+// Then it is not popped anymore
+TEST(DeadlineIndex, Erase) {
+  int objs[2];
+  checks::deadline_index<int> index;
+  index.set(&objs[0], 10);
+  index.set(&objs[1], 20);
+  index.erase(&objs[0]);
+  index.erase(&objs[0]);
+  ASSERT_EQ(index.size(), 1u);
+
+  int* obj(NULL);
+  ASSERT_TRUE(index.pop(30, obj));
+  ASSERT_EQ(obj, &objs[1]);
+  ASSERT_FALSE(index.pop(30, obj));
+}
@@ -0,0 +1,142 @@
+/*
+** Copyright 2017 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstring>
+#include <gtest/gtest.h>
+#include <vector>
+#include "com/centreon/engine/checks.hh"
+#include "com/centreon/engine/checks/checker.hh"
+#include "com/centreon/engine/configuration/applier/state.hh"
+#include "com/centreon/engine/configuration/state.hh"
+#include "com/centreon/engine/globals.hh"
+
+using namespace com::centreon::engine;
+
+static std::vector<std::pair<host*, void*> > called;
+
+static void record(host* hst, void* arg) {
+  called.push_back(std::make_pair(hst, arg));
+}
+
+static void register_again(host* hst, void* arg) {
+  record(hst, arg);
+  if (hst)
+    checks::checker::instance().add_host_continuation(hst, &record, arg);
+}
+
+class HostContinuations : public ::testing::Test {
+public:
+  void SetUp() {
+    called.clear();
+    config = new configuration::state;
+    configuration::applier::state::load();
+    checks::checker::load();
+    memset(&_parent, 0, sizeof(_parent));
+    _parent.name = const_cast<char*>("parent");
+    memset(&_other, 0, sizeof(_other));
+    _other.name = const_cast<char*>("other");
+  }
+
+  void TearDown() {
+    host_list = NULL;
+    checks::checker::unload();
+    configuration::applier::state::unload();
+    delete config;
+    config = NULL;
+  }
+
+protected:
+  host _other;
+  host _parent;
+};
+
+// Given continuations registered on two hosts
+// When the continuations of one host are run
+// Then only its continuations are called, once
+TEST_F(HostContinuations, RunOnlyHostContinuations) {
+  int arg1;
+  int arg2;
+  int arg3;
+  checks::checker& c(checks::checker::instance());
+  c.add_host_continuation(&_parent, &record, &arg1);
+  c.add_host_continuation(&_other, &record, &arg2);
+  c.add_host_continuation(&_parent, &record, &arg3);
+
+  c.run_host_continuations(&_parent);
+  ASSERT_EQ(called.size(), 2u);
+  ASSERT_EQ(called[0].first, &_parent);
+  ASSERT_EQ(called[1].first, &_parent);
+  ASSERT_NE(called[0].second, called[1].second);
+
+  c.run_host_continuations(&_parent);
+  ASSERT_EQ(called.size(), 2u);
+}
+
+// Given a continuation registering a new one on the same host
+// When the continuations of the host are run
+// Then the new continuation is only run the next time
+TEST_F(HostContinuations, RegisterFromContinuation) {
+  int arg;
+  checks::checker& c(checks::checker::instance());
+  c.add_host_continuation(&_parent, &register_again, &arg);
+
+  c.run_host_continuations(&_parent);
+  ASSERT_EQ(called.size(), 1u);
+  c.run_host_continuations(&_parent);
+  ASSERT_EQ(called.size(), 2u);
+  ASSERT_EQ(called[1].first, &_parent);
+  ASSERT_EQ(called[1].second, &arg);
+}
+
+// Given pending continuations
+// When the checker is unloaded
+// Then they are cancelled with a NULL host
+TEST_F(HostContinuations, CancelOnUnload) {
+  int arg;
+  checks::checker::instance().add_host_continuation(
+                                &_parent,
+                                &record,
+                                &arg);
+  checks::checker::unload();
+  ASSERT_EQ(called.size(), 1u);
+  ASSERT_EQ(called[0].first, (host*)NULL);
+  ASSERT_EQ(called[0].second, &arg);
+  checks::checker::load();
+}
+
+// Given a continuation waiting for a host whose check is orphaned
+// When orphaned hosts are checked
+// Then the continuation is run with the host
+TEST_F(HostContinuations, RunOnOrphan) {
+  _parent.is_executing = true;
+  _parent.next_check = 1;
+  host_list = &_parent;
+  update_host_check_deadlines(&_parent);
+
+  int arg;
+  checks::checker::instance().add_host_continuation(
+                                &_parent,
+                                &record,
+                                &arg);
+  check_for_orphaned_hosts();
+  ASSERT_FALSE(_parent.is_executing);
+  ASSERT_EQ(called.size(), 1u);
+  ASSERT_EQ(called[0].first, &_parent);
+  ASSERT_EQ(called[0].second, &arg);
+}
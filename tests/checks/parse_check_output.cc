@@ -0,0 +1,118 @@
+/*
+** Copyright 2017 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstring>
+#include <gtest/gtest.h>
+#include <string>
+#include "com/centreon/engine/string.hh"
+#include "com/centreon/engine/utils.hh"
+
+using namespace com::centreon::engine;
+
+class ParseCheckOutputTest : public ::testing::Test {
+public:
+  void SetUp() {
+    _short_output = NULL;
+    _long_output = NULL;
+    _perf_data = NULL;
+  }
+
+  void TearDown() {
+    delete[] _short_output;
+    delete[] _long_output;
+    delete[] _perf_data;
+  }
+
+protected:
+  void _parse(char const* output) {
+    char* buf(string::dup(output));
+    parse_check_output(
+      buf,
+      &_short_output,
+      &_long_output,
+      &_perf_data,
+      true,
+      true);
+    delete[] buf;
+  }
+
+  char* _short_output;
+  char* _long_output;
+  char* _perf_data;
+};
+
+// Given a single line output with performance data
+// When parse_check_output() is called
+// Then short output and performance data are split
+TEST_F(ParseCheckOutputTest, ShortOutputAndPerfData) {
+  _parse("OK - load is fine|load=0.5");
+  ASSERT_STREQ(_short_output, "OK - load is fine");
+  ASSERT_EQ(_long_output, (char*)NULL);
+  ASSERT_STREQ(_perf_data, "load=0.5");
+}
+
+// Given a multiline output with performance data on the long output
+// When parse_check_output() is called
+// Then every part is extracted
+TEST_F(ParseCheckOutputTest, LongOutputAndPerfData) {
+  _parse("OK\\nline 2\\nline 3|b=2\\nc=3");
+  ASSERT_STREQ(_short_output, "OK");
+  ASSERT_STREQ(_long_output, "line 2\\nline 3");
+  ASSERT_STREQ(_perf_data, "b=2 c=3");
+}
+
+// Given a long output line starting with the separator
+// When parse_check_output() is called
+// Then the rest of the line is performance data
+TEST_F(ParseCheckOutputTest, LongOutputStartingWithSeparator) {
+  _parse("OK\\nline 2\\n|b=2");
+  ASSERT_STREQ(_short_output, "OK");
+  ASSERT_STREQ(_long_output, "line 2\\n");
+  ASSERT_STREQ(_perf_data, "b=2");
+}
+
+// Given a first line starting with separators
+// When parse_check_output() is called
+// Then separators are skipped before the short output
+TEST_F(ParseCheckOutputTest, ShortOutputStartingWithSeparator) {
+  _parse("||OK|a=1|b=2");
+  ASSERT_STREQ(_short_output, "OK");
+  ASSERT_EQ(_long_output, (char*)NULL);
+  ASSERT_STREQ(_perf_data, "a=1|b=2");
+}
+
+// Given a long output with empty lines and escaped backslashes
+// When parse_check_output() is called
+// Then newlines and backslashes are escaped again in the long output
+TEST_F(ParseCheckOutputTest, LongOutputWithEscapedCharacters) {
+  _parse(" OK \\n\\nC:\\\\temp\\n");
+  ASSERT_STREQ(_short_output, "OK");
+  ASSERT_STREQ(_long_output, "\\nC:\\\\temp\\n");
+  ASSERT_EQ(_perf_data, (char*)NULL);
+}
+
+// Given performance data split over several lines
+// When parse_check_output() is called
+// Then lines following the separator line are performance data
+TEST_F(ParseCheckOutputTest, PerfDataOnSeveralLines) {
+  _parse("OK|a=1\\nline 2|\\nb=2\\nc=3\\n");
+  ASSERT_STREQ(_short_output, "OK");
+  ASSERT_STREQ(_long_output, "line 2");
+  ASSERT_STREQ(_perf_data, "a=1b=2 c=3");
+}
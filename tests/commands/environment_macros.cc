@@ -0,0 +1,125 @@
+/*
+** Copyright 2017 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstring>
+#include <gtest/gtest.h>
+#include <map>
+#include <string>
+#include "com/centreon/engine/commands/environment.hh"
+#include "com/centreon/engine/commands/raw.hh"
+#include "com/centreon/engine/configuration/applier/state.hh"
+#include "com/centreon/engine/configuration/state.hh"
+#include "com/centreon/engine/globals.hh"
+#include "com/centreon/engine/macros.hh"
+#include "com/centreon/engine/objects/customvariablesmember.hh"
+#include "com/centreon/engine/objects/host.hh"
+#include "com/centreon/engine/string.hh"
+
+using namespace com::centreon::engine;
+
+class EnvironmentMacros : public ::testing::Test {
+public:
+  void SetUp() {
+    config = new configuration::state;
+    config->enable_environment_macros(true);
+    configuration::applier::state::load();
+    memset(&_hst, 0, sizeof(_hst));
+    _hst.name = const_cast<char*>("host");
+  }
+
+  void TearDown() {
+    remove_all_custom_variables_from_host(&_hst);
+    configuration::applier::state::unload();
+    delete config;
+    config = NULL;
+  }
+
+  /**
+   *  Build the environment of a command run on the test host.
+   *
+   *  @return Environment variables by name.
+   */
+  std::map<std::string, std::string> build() {
+    // Standard macros are set so that none of them are grabbed.
+    nagios_macros mac;
+    memset(&mac, 0, sizeof(mac));
+    for (unsigned int i(0); i < MACRO_X_COUNT; ++i)
+      mac.x[i] = const_cast<char*>("");
+    mac.host_ptr = &_hst;
+
+    commands::environment env;
+    commands::raw::build_environment_macros(mac, env);
+    std::map<std::string, std::string> retval;
+    for (char** var(env.data()); var && *var; ++var) {
+      char const* value(strchr(*var, '='));
+      if (value)
+        retval[std::string(*var, value - *var)] = value + 1;
+    }
+    return (retval);
+  }
+
+protected:
+  host _hst;
+};
+
+// Given a host used by a command
+// When a custom variable is added to the host
+// Then the next environment has the new variable
+TEST_F(EnvironmentMacros, CustomVariableAdded) {
+  ASSERT_EQ(build().count("NAGIOS__HOSTSNMP"), 0u);
+  add_custom_variable_to_host(&_hst, "SNMP", "public");
+  std::map<std::string, std::string> env(build());
+  ASSERT_EQ(env.count("NAGIOS__HOSTSNMP"), 1u);
+  ASSERT_EQ(env["NAGIOS__HOSTSNMP"], "public");
+}
+
+// Given a host with a custom variable used by a command
+// When the custom variable is updated
+// Then the next environment has the new value
+TEST_F(EnvironmentMacros, CustomVariableUpdated) {
+  add_custom_variable_to_host(&_hst, "SNMP", "public");
+  ASSERT_EQ(build()["NAGIOS__HOSTSNMP"], "public");
+  ASSERT_TRUE(update_customvariable(_hst.custom_variables, "SNMP", "private"));
+  ASSERT_EQ(build()["NAGIOS__HOSTSNMP"], "private");
+}
+
+// Given a host with custom variables used by a command
+// When its custom variables are removed
+// Then the next environment has none of them
+TEST_F(EnvironmentMacros, CustomVariableRemoved) {
+  add_custom_variable_to_host(&_hst, "SNMP", "public");
+  add_custom_variable_to_host(&_hst, "PORT", "161");
+  ASSERT_EQ(build().count("NAGIOS__HOSTPORT"), 1u);
+  remove_all_custom_variables_from_host(&_hst);
+  std::map<std::string, std::string> env(build());
+  ASSERT_EQ(env.count("NAGIOS__HOSTSNMP"), 0u);
+  ASSERT_EQ(env.count("NAGIOS__HOSTPORT"), 0u);
+}
+
+// Given a host with a custom variable modified in place
+// When the custom variables generation changes
+// Then the next environment has the new value
+TEST_F(EnvironmentMacros, GenerationChanged) {
+  add_custom_variable_to_host(&_hst, "SNMP", "public");
+  ASSERT_EQ(build()["NAGIOS__HOSTSNMP"], "public");
+  string::setstr(_hst.custom_variables->variable_value, "private");
+  ASSERT_EQ(build()["NAGIOS__HOSTSNMP"], "public");
+  customvariables_modified();
+  ASSERT_EQ(build()["NAGIOS__HOSTSNMP"], "private");
+}
@@ -0,0 +1,102 @@
+/*
+** Copyright 2017 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstring>
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <vector>
+#include "com/centreon/engine/commands/system_runner.hh"
+#include "com/centreon/engine/configuration/state.hh"
+#include "com/centreon/engine/events/loop.hh"
+#include "com/centreon/engine/globals.hh"
+
+using namespace com::centreon::engine;
+
+static std::vector<commands::result> results;
+
+class record : public commands::system_runner::callback {
+public:
+  void finished(commands::result const& res) throw () {
+    results.push_back(res);
+  }
+};
+
+class SystemRunner : public ::testing::Test {
+public:
+  void SetUp() {
+    results.clear();
+    config = new configuration::state;
+    config->enable_async_system_commands(true);
+    config->max_concurrent_notifications(1);
+    events::loop::load();
+    commands::system_runner::load();
+    memset(&_mac, 0, sizeof(_mac));
+  }
+
+  void TearDown() {
+    commands::system_runner::unload();
+    events::loop::unload();
+    delete config;
+    config = NULL;
+  }
+
+  void run(std::string const& cmd) {
+    commands::system_runner::instance().run(
+      commands::system_runner::notification,
+      cmd,
+      _mac,
+      10,
+      new record);
+  }
+
+protected:
+  nagios_macros _mac;
+};
+
+// Given commands of a category limited to one running command
+// When they are over
+// Then their callbacks are executed in submission order with results
+TEST_F(SystemRunner, Completion) {
+  run("/bin/echo first");
+  run("/bin/echo second");
+  for (unsigned int i(0); (i < 1000) && (results.size() < 2); ++i) {
+    usleep(10000);
+    commands::system_runner::instance().reap();
+  }
+  ASSERT_EQ(results.size(), 2u);
+  ASSERT_EQ(results[0].exit_code, 0);
+  ASSERT_EQ(results[0].output, "first\n");
+  ASSERT_EQ(results[1].exit_code, 0);
+  ASSERT_EQ(results[1].output, "second\n");
+}
+
+// Given a running command and a command waiting to be started
+// When the runner is unloaded
+// Then both callbacks are executed with an error result
+TEST_F(SystemRunner, Shutdown) {
+  run("/bin/sleep 1");
+  run("/bin/echo waiting");
+  commands::system_runner::unload();
+  ASSERT_EQ(results.size(), 2u);
+  for (unsigned int i(0); i < results.size(); ++i) {
+    ASSERT_EQ(results[i].exit_code, STATE_UNKNOWN);
+    ASSERT_EQ(results[i].output, "(Command cancelled on shutdown)");
+  }
+  commands::system_runner::load();
+}
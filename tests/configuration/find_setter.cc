@@ -0,0 +1,118 @@
+/*
+** Copyright 2017 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <gtest/gtest.h>
+#include "com/centreon/engine/configuration/command.hh"
+#include "com/centreon/engine/configuration/connector.hh"
+#include "com/centreon/engine/configuration/contact.hh"
+#include "com/centreon/engine/configuration/contactgroup.hh"
+#include "com/centreon/engine/configuration/find_setter.hh"
+#include "com/centreon/engine/configuration/host.hh"
+#include "com/centreon/engine/configuration/hostdependency.hh"
+#include "com/centreon/engine/configuration/hostescalation.hh"
+#include "com/centreon/engine/configuration/hostextinfo.hh"
+#include "com/centreon/engine/configuration/hostgroup.hh"
+#include "com/centreon/engine/configuration/object.hh"
+#include "com/centreon/engine/configuration/service.hh"
+#include "com/centreon/engine/configuration/servicedependency.hh"
+#include "com/centreon/engine/configuration/serviceescalation.hh"
+#include "com/centreon/engine/configuration/serviceextinfo.hh"
+#include "com/centreon/engine/configuration/servicegroup.hh"
+#include "com/centreon/engine/configuration/state.hh"
+#include "com/centreon/engine/configuration/timeperiod.hh"
+
+using namespace com::centreon::engine;
+
+struct test_setter {
+  char const* name;
+  int         id;
+};
+
+static test_setter const test_setters[] = {
+  { "_ID",               0 },
+  { "broker_module",     1 },
+  { "broker_module_dir", 2 },
+  { "host",              3 },
+  { "host_name",         4 },
+  { "hostgroups",        5 },
+  { "timezone",          6 }
+};
+
+// Given a sorted setter table
+// When every name of the table is looked up
+// Then its own entry is found
+TEST(ConfigurationFindSetter, AllNamesFound) {
+  for (unsigned int i(0);
+       i < sizeof(test_setters) / sizeof(test_setters[0]);
+       ++i) {
+    test_setter const* s(
+      configuration::find_setter(test_setters, test_setters[i].name));
+    ASSERT_TRUE(s != NULL);
+    ASSERT_EQ(s->id, test_setters[i].id);
+  }
+}
+
+// Given a sorted setter table
+// When unknown names are looked up
+// Then no entry is found
+TEST(ConfigurationFindSetter, UnknownNames) {
+  ASSERT_TRUE(!configuration::find_setter(test_setters, ""));
+  ASSERT_TRUE(!configuration::find_setter(test_setters, "_"));
+  ASSERT_TRUE(!configuration::find_setter(test_setters, "broker"));
+  ASSERT_TRUE(!configuration::find_setter(test_setters, "hosts"));
+  ASSERT_TRUE(!configuration::find_setter(test_setters, "zzz"));
+}
+
+// Given the setter tables of configuration objects
+// When their order is checked
+// Then they are all sorted
+TEST(ConfigurationFindSetter, TablesSorted) {
+  ASSERT_TRUE(configuration::command::sorted_setters());
+  ASSERT_TRUE(configuration::connector::sorted_setters());
+  ASSERT_TRUE(configuration::contact::sorted_setters());
+  ASSERT_TRUE(configuration::contactgroup::sorted_setters());
+  ASSERT_TRUE(configuration::host::sorted_setters());
+  ASSERT_TRUE(configuration::hostdependency::sorted_setters());
+  ASSERT_TRUE(configuration::hostescalation::sorted_setters());
+  ASSERT_TRUE(configuration::hostextinfo::sorted_setters());
+  ASSERT_TRUE(configuration::hostgroup::sorted_setters());
+  ASSERT_TRUE(configuration::object::sorted_setters());
+  ASSERT_TRUE(configuration::service::sorted_setters());
+  ASSERT_TRUE(configuration::servicedependency::sorted_setters());
+  ASSERT_TRUE(configuration::serviceescalation::sorted_setters());
+  ASSERT_TRUE(configuration::serviceextinfo::sorted_setters());
+  ASSERT_TRUE(configuration::servicegroup::sorted_setters());
+  ASSERT_TRUE(configuration::state::sorted_setters());
+  ASSERT_TRUE(configuration::timeperiod::sorted_setters());
+}
+
+// Given a service configuration object
+// When the first and last properties of its table are parsed
+// Then they are set
+// And unknown properties starting with '_' are custom variables
+TEST(ConfigurationFindSetter, ServiceProperties) {
+  configuration::service s;
+  ASSERT_TRUE(s.parse("_SERVICE_ID", "42"));
+  ASSERT_EQ(s.service_id(), 42u);
+  ASSERT_TRUE(s.parse("timezone", ":Europe/Paris"));
+  ASSERT_EQ(s.timezone(), ":Europe/Paris");
+  ASSERT_TRUE(s.parse("_SNMP", "public"));
+  ASSERT_EQ(s.customvariables().find("SNMP")->second, "public");
+  ASSERT_FALSE(s.parse("no_such_property", "1"));
+}
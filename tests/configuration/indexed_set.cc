@@ -0,0 +1,121 @@
+/*
+** Copyright 2017 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <gtest/gtest.h>
+#include <iterator>
+#include "com/centreon/engine/configuration/host.hh"
+#include "com/centreon/engine/configuration/service.hh"
+
+using namespace com::centreon::engine;
+
+/**
+ *  Build a service configuration.
+ */
+static configuration::service make_service(
+                                std::string const& host_name,
+                                std::string const& description) {
+  configuration::service s;
+  s.parse("host_name", host_name.c_str());
+  s.parse("service_description", description.c_str());
+  return (s);
+}
+
+// Given an indexed set of hosts
+// When hosts are inserted and erased
+// Then they are found by their key until they are erased
+TEST(ConfigurationIndexedSet, InsertErase) {
+  configuration::set_host hosts;
+  hosts.insert(configuration::host("h1"));
+  hosts.insert(configuration::host("h2"));
+  hosts.insert(configuration::host("h3"));
+  ASSERT_EQ(hosts.find_key("h2")->host_name(), "h2");
+  ASSERT_TRUE(hosts.find_key("h4") == hosts.end());
+
+  hosts.erase(hosts.find_key("h2"));
+  ASSERT_TRUE(hosts.find_key("h2") == hosts.end());
+  ASSERT_EQ(hosts.find_key("h3")->host_name(), "h3");
+  ASSERT_EQ(hosts.erase(configuration::host("h1")), 1u);
+  ASSERT_TRUE(hosts.find_key("h1") == hosts.end());
+  ASSERT_EQ(hosts.size(), 1u);
+
+  hosts.clear();
+  ASSERT_TRUE(hosts.find_key("h3") == hosts.end());
+}
+
+// Given an indexed set with two objects of the same key
+// When the indexed one is erased
+// Then the other one is found by the key
+TEST(ConfigurationIndexedSet, SameKey) {
+  configuration::set_host hosts;
+  configuration::host h1("h1");
+  configuration::host h1_bis("h1");
+  h1_bis.parse("address", "127.0.0.1");
+  hosts.insert(h1);
+  hosts.insert(h1_bis);
+  ASSERT_EQ(hosts.size(), 2u);
+  hosts.erase(hosts.find_key("h1"));
+  ASSERT_EQ(hosts.size(), 1u);
+  ASSERT_TRUE(hosts.find_key("h1") == hosts.begin());
+}
+
+// Given services of the same key ordered apart by their other hosts
+// When they are erased one by one through the key
+// Then each one is found until all of them are erased
+TEST(ConfigurationIndexedSet, SameKeyNotAdjacent) {
+  configuration::set_service services;
+  services.insert(make_service("h1", "s"));
+  services.insert(make_service("h1,h2", "t"));
+  services.insert(make_service("h1,h3", "s"));
+  ASSERT_EQ(services.size(), 3u);
+
+  services.erase(services.find_key(std::make_pair("h1", "s")));
+  configuration::set_service::iterator
+    it(services.find_key(std::make_pair("h1", "s")));
+  ASSERT_TRUE(it != services.end());
+  ASSERT_EQ(it->service_description(), "s");
+  services.erase(it);
+  ASSERT_TRUE(services.find_key(std::make_pair("h1", "s"))
+              == services.end());
+  ASSERT_EQ(services.size(), 1u);
+  ASSERT_TRUE(services.find_key(std::make_pair("h1", "t"))
+              != services.end());
+}
+
+// Given an indexed set filled through an insert iterator
+// When it is copied and swapped
+// Then objects are found in the right set
+TEST(ConfigurationIndexedSet, CopySwap) {
+  configuration::set_service services;
+  std::insert_iterator<configuration::set_service>
+    ins(std::inserter(services, services.begin()));
+  *ins++ = make_service("h1", "s1");
+  *ins++ = make_service("h1", "s2");
+  configuration::set_service copy(services);
+  services.erase(services.find_key(std::make_pair("h1", "s1")));
+  ASSERT_TRUE(copy.find_key(std::make_pair("h1", "s1")) != copy.end());
+  ASSERT_TRUE(services.find_key(std::make_pair("h1", "s1"))
+              == services.end());
+
+  configuration::set_service other;
+  other.swap(copy);
+  ASSERT_TRUE(copy.empty());
+  ASSERT_EQ(
+    other.find_key(std::make_pair("h1", "s2"))->service_description(),
+    "s2");
+}
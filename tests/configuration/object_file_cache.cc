@@ -0,0 +1,112 @@
+/*
+** Copyright 2017 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <gtest/gtest.h>
+#include <list>
+#include "com/centreon/engine/configuration/host.hh"
+#include "com/centreon/engine/configuration/object_file_cache.hh"
+
+using namespace com::centreon::engine;
+
+/**
+ *  Build a file status.
+ */
+static configuration::object_file_cache::file_status make_status(
+                                                       time_t mtime) {
+  configuration::object_file_cache::file_status status;
+  status.ctime = mtime;
+  status.dev = 1;
+  status.ino = 42;
+  status.mtime = mtime;
+  status.size = 1024;
+  return (status);
+}
+
+/**
+ *  Build the objects of a file.
+ */
+static configuration::object_file_cache::objects make_objects() {
+  configuration::object_file_cache::objects objs;
+  configuration::object_ptr obj(configuration::object::create("host"));
+  obj->parse("host_name", "central");
+  obj->parse("address", "127.0.0.1");
+  objs.push_back(std::make_pair(obj, 3u));
+  return (objs);
+}
+
+// Given a cache holding the objects of a file
+// When the file is looked up with the same status
+// Then copies of its objects are returned
+TEST(ConfigurationObjectFileCache, UnchangedFile) {
+  configuration::object_file_cache cache;
+  configuration::object_file_cache::objects objs(make_objects());
+  cache.insert("hosts.cfg", make_status(1000), ~0u, objs);
+
+  // Objects stored are not modified afterwards.
+  objs[0].first->parse("address", "10.0.0.1");
+
+  configuration::object_file_cache::objects found;
+  ASSERT_TRUE(cache.find("hosts.cfg", make_status(1000), ~0u, found));
+  ASSERT_EQ(found.size(), 1u);
+  ASSERT_NE(found[0].first.get(), objs[0].first.get());
+  ASSERT_EQ(found[0].second, 3u);
+  configuration::host const& h(
+    *static_cast<configuration::host*>(found[0].first.get()));
+  ASSERT_EQ(h.host_name(), "central");
+  ASSERT_EQ(h.address(), "127.0.0.1");
+}
+
+// Given a cache holding the objects of a file
+// When the file status or the read options changed
+// Then the file is not found
+TEST(ConfigurationObjectFileCache, ChangedFile) {
+  configuration::object_file_cache cache;
+  cache.insert("hosts.cfg", make_status(1000), ~0u, make_objects());
+
+  configuration::object_file_cache::objects found;
+  ASSERT_FALSE(cache.find("hosts.cfg", make_status(1001), ~0u, found));
+  configuration::object_file_cache::file_status status(make_status(1000));
+  status.size = 1025;
+  ASSERT_FALSE(cache.find("hosts.cfg", status, ~0u, found));
+  status = make_status(1000);
+  status.ino = 43;
+  ASSERT_FALSE(cache.find("hosts.cfg", status, ~0u, found));
+  ASSERT_FALSE(cache.find("hosts.cfg", make_status(1000), 1u, found));
+  ASSERT_FALSE(cache.find("services.cfg", make_status(1000), ~0u, found));
+  ASSERT_TRUE(found.empty());
+}
+
+// Given a cache holding the objects of two files
+// When only one of them is retained
+// Then the other one is removed
+TEST(ConfigurationObjectFileCache, Retain) {
+  configuration::object_file_cache cache;
+  cache.insert("hosts.cfg", make_status(1000), ~0u, make_objects());
+  cache.insert("old.cfg", make_status(1000), ~0u, make_objects());
+  ASSERT_EQ(cache.size(), 2u);
+
+  std::list<std::string> paths;
+  paths.push_back("hosts.cfg");
+  paths.push_back("new.cfg");
+  cache.retain(paths);
+  ASSERT_EQ(cache.size(), 1u);
+  configuration::object_file_cache::objects found;
+  ASSERT_TRUE(cache.find("hosts.cfg", make_status(1000), ~0u, found));
+  ASSERT_FALSE(cache.find("old.cfg", make_status(1000), ~0u, found));
+}
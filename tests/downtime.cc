@@ -0,0 +1,164 @@
+/*
+** Copyright 2017 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <ctime>
+#include <gtest/gtest.h>
+#include <vector>
+#include "com/centreon/engine/configuration/state.hh"
+#include "com/centreon/engine/globals.hh"
+#include "com/centreon/engine/objects/downtime.hh"
+
+using namespace com::centreon::engine;
+
+class Downtime : public ::testing::Test {
+public:
+  void SetUp() {
+    config = new configuration::state;
+    _now = time(NULL);
+  }
+
+  void TearDown() {
+    free_downtime_data();
+    delete config;
+    config = NULL;
+  }
+
+  /**
+   *  Get the ids of the downtime list.
+   */
+  std::vector<unsigned long> list_ids() {
+    std::vector<unsigned long> retval;
+    for (scheduled_downtime* dt(scheduled_downtime_list); dt; dt = dt->next)
+      retval.push_back(dt->downtime_id);
+    return (retval);
+  }
+
+  /**
+   *  Add a downtime starting and ending some seconds from now.
+   */
+  void add_host(unsigned long id, int start, int end) {
+    ASSERT_EQ(add_host_downtime(
+                "host",
+                _now,
+                "author",
+                "comment",
+                _now + start,
+                _now + end,
+                true,
+                0,
+                end - start,
+                id), OK);
+  }
+
+  void add_service(unsigned long id, int start, int end) {
+    ASSERT_EQ(add_service_downtime(
+                "host",
+                "service",
+                _now,
+                "author",
+                "comment",
+                _now + start,
+                _now + end,
+                true,
+                0,
+                end - start,
+                id), OK);
+  }
+
+protected:
+  time_t _now;
+};
+
+// Given downtimes added in any start time order
+// When they are looked up
+// Then the list is sorted by start time and each id is found with its type
+TEST_F(Downtime, Add) {
+  add_host(1, 300, 600);
+  add_service(2, 100, 600);
+  add_host(3, 200, 600);
+  add_service(4, 400, 600);
+  add_host(5, 100, 600);
+
+  std::vector<unsigned long> expected;
+  expected.push_back(2);
+  expected.push_back(5);
+  expected.push_back(3);
+  expected.push_back(1);
+  expected.push_back(4);
+  ASSERT_EQ(list_ids(), expected);
+
+  ASSERT_EQ(find_host_downtime(1)->downtime_id, 1u);
+  ASSERT_EQ(find_service_downtime(2)->downtime_id, 2u);
+  ASSERT_EQ(find_downtime(ANY_DOWNTIME, 4)->downtime_id, 4u);
+  ASSERT_EQ(find_service_downtime(1), (scheduled_downtime*)NULL);
+  ASSERT_EQ(find_host_downtime(2), (scheduled_downtime*)NULL);
+  ASSERT_EQ(find_downtime(ANY_DOWNTIME, 6), (scheduled_downtime*)NULL);
+}
+
+// Given downtimes
+// When the first, a middle and the last downtimes are deleted
+// Then they are not found anymore and the list stays linked and sorted
+TEST_F(Downtime, Delete) {
+  add_host(1, 100, 600);
+  add_service(2, 200, 600);
+  add_host(3, 300, 600);
+  add_service(4, 400, 600);
+  add_host(5, 500, 600);
+
+  ASSERT_EQ(delete_downtime(HOST_DOWNTIME, 3), OK);
+  ASSERT_EQ(delete_downtime(HOST_DOWNTIME, 1), OK);
+  ASSERT_EQ(delete_downtime(HOST_DOWNTIME, 5), OK);
+  ASSERT_EQ(delete_downtime(HOST_DOWNTIME, 2), ERROR);
+
+  std::vector<unsigned long> expected;
+  expected.push_back(2);
+  expected.push_back(4);
+  ASSERT_EQ(list_ids(), expected);
+  ASSERT_EQ(find_downtime(ANY_DOWNTIME, 1), (scheduled_downtime*)NULL);
+  ASSERT_EQ(find_downtime(ANY_DOWNTIME, 3), (scheduled_downtime*)NULL);
+  ASSERT_EQ(find_downtime(ANY_DOWNTIME, 5), (scheduled_downtime*)NULL);
+
+  // Downtimes can still be added at their place.
+  add_host(6, 300, 600);
+  expected.insert(expected.begin() + 1, 6);
+  ASSERT_EQ(list_ids(), expected);
+}
+
+// Given ended, in effect and pending downtimes
+// When expired downtimes are checked
+// Then only the ended downtimes not in effect are deleted
+TEST_F(Downtime, Expire) {
+  add_host(1, -600, -300);
+  add_service(2, -600, -300);
+  add_host(3, -600, -300);
+  find_host_downtime(3)->is_in_effect = true;
+  add_service(4, -600, 600);
+  add_host(5, 100, 600);
+
+  ASSERT_EQ(check_for_expired_downtime(), OK);
+
+  std::vector<unsigned long> expected;
+  expected.push_back(3);
+  expected.push_back(4);
+  expected.push_back(5);
+  ASSERT_EQ(list_ids(), expected);
+  ASSERT_EQ(find_host_downtime(1), (scheduled_downtime*)NULL);
+  ASSERT_EQ(find_service_downtime(2), (scheduled_downtime*)NULL);
+  ASSERT_NE(find_host_downtime(3), (scheduled_downtime*)NULL);
+}
@@ -0,0 +1,148 @@
+/*
+** Copyright 2017 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstring>
+#include <ctime>
+#include <gtest/gtest.h>
+#include <vector>
+#include "com/centreon/concurrency/thread.hh"
+#include "com/centreon/engine/checks/checker.hh"
+#include "com/centreon/engine/commands/system_runner.hh"
+#include "com/centreon/engine/configuration/state.hh"
+#include "com/centreon/engine/events/defines.hh"
+#include "com/centreon/engine/events/loop.hh"
+#include "com/centreon/engine/events/timed_event.hh"
+#include "com/centreon/engine/globals.hh"
+#include "com/centreon/timestamp.hh"
+
+using namespace com::centreon;
+using namespace com::centreon::engine;
+
+static std::vector<commands::result> results;
+static unsigned int calls;
+static time_t deadline;
+
+class record : public commands::system_runner::callback {
+public:
+  void finished(commands::result const& res) throw () {
+    results.push_back(res);
+  }
+};
+
+class loop_thread : public concurrency::thread {
+private:
+  void _run() {
+    events::loop::instance().run();
+  }
+};
+
+/**
+ *  Run a command on first call, then stop the loop once its result
+ *  was handled (or after the deadline if it never is).
+ */
+static void always_due(void* args) {
+  (void)args;
+  if (!calls++) {
+    nagios_macros mac;
+    memset(&mac, 0, sizeof(mac));
+    commands::system_runner::instance().run(
+      commands::system_runner::notification,
+      "/bin/true",
+      mac,
+      10,
+      new record);
+  }
+  else if (!results.empty() || (time(NULL) > deadline))
+    sigshutdown = true;
+}
+
+class Loop : public ::testing::Test {
+public:
+  void SetUp() {
+    results.clear();
+    calls = 0;
+    deadline = time(NULL) + 10;
+    sigshutdown = false;
+    config = new configuration::state;
+    config->enable_async_system_commands(true);
+    events::loop::load();
+    checks::checker::load();
+    commands::system_runner::load();
+  }
+
+  void TearDown() {
+    while (event_list_high) {
+      timed_event* evt(event_list_high);
+      remove_event(evt, &event_list_high, &event_list_high_tail);
+      delete evt;
+    }
+    sigshutdown = false;
+    commands::system_runner::unload();
+    checks::checker::unload();
+    events::loop::unload();
+    delete config;
+    config = NULL;
+  }
+};
+
+// Given an events loop waiting for an event due in an hour
+// When another thread sets the shutdown flag and wakes it up
+// Then the loop exits without waiting for its sleep time
+TEST_F(Loop, WakeUp) {
+  config->sleep_time(60);
+  schedule_new_event(
+    EVENT_USER_FUNCTION,
+    true,
+    time(NULL) + 60 * 60,
+    false,
+    0,
+    NULL,
+    false,
+    NULL,
+    NULL,
+    0);
+  loop_thread thr;
+  timestamp start(timestamp::now());
+  thr.exec();
+  concurrency::thread::msleep(100);
+  sigshutdown = true;
+  events::loop::instance().wake_up();
+  thr.wait();
+  ASSERT_LT((timestamp::now() - start).to_mseconds(), 10000);
+}
+
+// Given a recurring event that is always due
+// When the events loop runs
+// Then results of commands are still handled between its executions
+TEST_F(Loop, DrainIsBounded) {
+  schedule_new_event(
+    EVENT_USER_FUNCTION,
+    true,
+    time(NULL) - 1,
+    true,
+    0,
+    NULL,
+    false,
+    (void*)&always_due,
+    NULL,
+    0);
+  events::loop::instance().run();
+  ASSERT_EQ(results.size(), 1u);
+  ASSERT_GT(calls, 1u);
+}
@@ -0,0 +1,102 @@
+/*
+** Copyright 2017 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstring>
+#include <gtest/gtest.h>
+#include "com/centreon/engine/events/sorted_timed_event.hh"
+#include "com/centreon/engine/events/timed_event.hh"
+
+using namespace com::centreon::engine;
+
+class SortedTimedEventTest : public ::testing::Test {
+public:
+  void SetUp() {
+    memset(_events, 0, sizeof(_events));
+    for (unsigned int i(0); i < sizeof(_events) / sizeof(*_events); ++i)
+      _events[i].run_time = 1000 + 10 * i;
+  }
+
+protected:
+  events::sorted_timed_event _sorted;
+  timed_event                _events[4];
+};
+
+// Given an empty index
+// When insert() is called
+// Then no previous event is returned
+TEST_F(SortedTimedEventTest, InsertFirst) {
+  ASSERT_EQ(_sorted.insert(events::hash_timed_event::low, &_events[0]), (timed_event*)NULL);
+  ASSERT_EQ(_sorted.size(events::hash_timed_event::low), 1u);
+  ASSERT_TRUE(_sorted.empty(events::hash_timed_event::high));
+}
+
+// Given an index with events
+// When insert() is called with an event executed later
+// Then the last event executed before it is returned
+TEST_F(SortedTimedEventTest, InsertAfter) {
+  _sorted.insert(events::hash_timed_event::low, &_events[0]);
+  _sorted.insert(events::hash_timed_event::low, &_events[2]);
+  ASSERT_EQ(_sorted.insert(events::hash_timed_event::low, &_events[1]), &_events[0]);
+  ASSERT_EQ(_sorted.insert(events::hash_timed_event::low, &_events[3]), &_events[2]);
+}
+
+// Given an index with an event
+// When insert() is called with an event with the same execution time
+// Then the new event is placed after the existing one
+TEST_F(SortedTimedEventTest, InsertSameTimeKeepsOrder) {
+  _events[1].run_time = _events[0].run_time;
+  _sorted.insert(events::hash_timed_event::low, &_events[0]);
+  ASSERT_EQ(_sorted.insert(events::hash_timed_event::low, &_events[1]), &_events[0]);
+  ASSERT_EQ(_sorted.insert(events::hash_timed_event::low, &_events[2]), &_events[1]);
+}
+
+// Given an index with events
+// When erase() is called after the event execution time changed
+// Then the event is removed from the index
+TEST_F(SortedTimedEventTest, EraseModifiedEvent) {
+  _sorted.insert(events::hash_timed_event::high, &_events[0]);
+  _sorted.insert(events::hash_timed_event::high, &_events[1]);
+  _events[0].run_time = 5000;
+  _sorted.erase(events::hash_timed_event::high, &_events[0]);
+  ASSERT_EQ(_sorted.size(events::hash_timed_event::high), 1u);
+  ASSERT_EQ(_sorted.insert(events::hash_timed_event::high, &_events[2]), &_events[1]);
+}
+
+// Given an index with an event
+// When insert() is called again with this event
+// Then the event is moved at its new execution time
+TEST_F(SortedTimedEventTest, Reinsert) {
+  _sorted.insert(events::hash_timed_event::low, &_events[0]);
+  _sorted.insert(events::hash_timed_event::low, &_events[1]);
+  _events[0].run_time = 5000;
+  ASSERT_EQ(_sorted.insert(events::hash_timed_event::low, &_events[0]), &_events[1]);
+  ASSERT_EQ(_sorted.size(events::hash_timed_event::low), 2u);
+}
+
+// Given an index copied from another one
+// When erase() is called on the copy
+// Then the original index is not modified
+TEST_F(SortedTimedEventTest, Copy) {
+  _sorted.insert(events::hash_timed_event::low, &_events[0]);
+  _sorted.insert(events::hash_timed_event::low, &_events[1]);
+  events::sorted_timed_event copy(_sorted);
+  copy.erase(events::hash_timed_event::low, &_events[0]);
+  ASSERT_EQ(copy.size(events::hash_timed_event::low), 1u);
+  ASSERT_EQ(_sorted.size(events::hash_timed_event::low), 2u);
+}
@@ -0,0 +1,124 @@
+/*
+** Copyright 2017 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstring>
+#include <gtest/gtest.h>
+#include <string>
+#include "com/centreon/engine/globals.hh"
+#include "com/centreon/engine/macros.hh"
+#include "com/centreon/engine/macros/plan.hh"
+
+using namespace com::centreon::engine;
+
+class MacrosPlan : public ::testing::Test {
+public:
+  void SetUp() {
+    memset(&_mac, 0, sizeof(_mac));
+    _mac.argv[0] = const_cast<char*>("first");
+    _mac.argv[1] = const_cast<char*>("second");
+  }
+
+  /**
+   *  Process a text with process_macros_r().
+   */
+  std::string process_macros(std::string const& text) {
+    char* output(NULL);
+    process_macros_r(&_mac, text.c_str(), &output, 0);
+    std::string retval(output);
+    delete[] output;
+    return (retval);
+  }
+
+  /**
+   *  Process a text with a plan.
+   */
+  std::string process_plan(std::string const& text) {
+    std::string output;
+    macros::plan(text).process(&_mac, output);
+    return (output);
+  }
+
+protected:
+  nagios_macros _mac;
+};
+
+// Given a text without macros
+// When it is processed by a plan
+// Then the text is returned as is
+TEST_F(MacrosPlan, PlainText) {
+  ASSERT_TRUE(macros::plan().empty());
+  ASSERT_TRUE(macros::plan("").empty());
+  ASSERT_EQ(process_plan("[PERFDATA]\tnothing to do"), "[PERFDATA]\tnothing to do");
+}
+
+// Given a text with argument macros and escaped dollars
+// When it is processed by a plan
+// Then the result is the one of process_macros_r()
+TEST_F(MacrosPlan, SameAsProcessMacros) {
+  char const* const texts[] = {
+    "$ARG1$",
+    "check -a $ARG1$ -b $ARG2$",
+    "$ARG1$$ARG2$",
+    "price: $$10 $ARG2$",
+    "$$$ARG1$$$",
+    "trailing $ARG1",
+    "$ARG3$ is empty",
+    "$ARG0$ is invalid",
+    "$ARG33$ is out of range",
+    "$ARGS$ is not a number",
+    "$ARG2:ignored$",
+    "a single $",
+    "$$",
+    "$"
+  };
+  for (unsigned int i(0); i < sizeof(texts) / sizeof(*texts); ++i)
+    ASSERT_EQ(process_plan(texts[i]), process_macros(texts[i]))
+      << "text: " << texts[i];
+  ASSERT_EQ(
+    process_plan("check -a $ARG1$ -b $ARG2$ $$"),
+    "check -a first -b second $");
+}
+
+// Given a text with user macros
+// When it is processed by a plan
+// Then user macros are replaced by their current value
+TEST_F(MacrosPlan, UserMacros) {
+  macros::plan p("$USER1$/check -x $USER0$$USER257$");
+  std::string output;
+  p.process(&_mac, output);
+  ASSERT_EQ(output, "/check -x ");
+  macro_user[0] = const_cast<char*>("/usr/lib/plugins");
+  p.process(&_mac, output);
+  macro_user[0] = NULL;
+  ASSERT_EQ(output, "/usr/lib/plugins/check -x ");
+}
+
+// Given a plan
+// When it is copied and the original is compiled again
+// Then the copy is not modified
+TEST_F(MacrosPlan, Copy) {
+  macros::plan p("$ARG1$");
+  macros::plan copy(p);
+  p.compile("$ARG2$");
+  std::string output;
+  copy.process(&_mac, output);
+  ASSERT_EQ(output, "first");
+  p.process(&_mac, output);
+  ASSERT_EQ(output, "second");
+}
@@ -0,0 +1,217 @@
+/*
+** Copyright 2017 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstring>
+#include <gtest/gtest.h>
+#include <vector>
+#include "com/centreon/engine/configuration/applier/state.hh"
+#include "com/centreon/engine/configuration/state.hh"
+#include "com/centreon/engine/globals.hh"
+#include "com/centreon/engine/macros/summary.hh"
+#include "com/centreon/engine/objects/contactgroup.hh"
+#include "com/centreon/engine/objects/contactgroupsmember.hh"
+#include "com/centreon/engine/objects/contactsmember.hh"
+#include "com/centreon/engine/objects/servicesmember.hh"
+
+using namespace com::centreon::engine;
+
+typedef macros::summary summary;
+
+class MacrosSummary : public ::testing::Test {
+public:
+  void SetUp() {
+    config = new configuration::state;
+    configuration::applier::state::load();
+    summary::load();
+
+    // Two hosts up, the first one with two services.
+    memset(_hosts, 0, sizeof(_hosts));
+    memset(_services, 0, sizeof(_services));
+    memset(_contacts, 0, sizeof(_contacts));
+    memset(_members, 0, sizeof(_members));
+    memset(&_group, 0, sizeof(_group));
+    memset(&_group_member, 0, sizeof(_group_member));
+    memset(_host_services, 0, sizeof(_host_services));
+    for (unsigned int i(0); i < 2; ++i) {
+      _hosts[i].current_state = HOST_UP;
+      _hosts[i].has_been_checked = true;
+      _hosts[i].checks_enabled = true;
+      _hosts[i].next = (i < 1 ? &_hosts[i + 1] : NULL);
+    }
+    for (unsigned int i(0); i < 3; ++i) {
+      _services[i].current_state = STATE_OK;
+      _services[i].has_been_checked = true;
+      _services[i].checks_enabled = true;
+      _services[i].host_ptr = &_hosts[i < 2 ? 0 : 1];
+      _services[i].next = (i < 2 ? &_services[i + 1] : NULL);
+    }
+    _host_services[0].service_ptr = &_services[0];
+    _host_services[0].next = &_host_services[1];
+    _host_services[1].service_ptr = &_services[1];
+    _hosts[0].services = _host_services;
+
+    // The first contact is a contact of the first service, the second
+    // one is a group member and a direct contact of the last service.
+    _members[0].contact_ptr = &_contacts[0];
+    _services[0].contacts = &_members[0];
+    _members[1].contact_ptr = &_contacts[1];
+    _group.members = &_members[1];
+    _group_member.group_ptr = &_group;
+    _hosts[1].contact_groups = &_group_member;
+    _services[2].contact_groups = &_group_member;
+    _members[2].contact_ptr = &_contacts[1];
+    _services[2].contacts = &_members[2];
+
+    host_list = _hosts;
+    service_list = _services;
+  }
+
+  void TearDown() {
+    host_list = NULL;
+    service_list = NULL;
+    summary::unload();
+    configuration::applier::state::unload();
+    delete config;
+    config = NULL;
+  }
+
+  /**
+   *  Get totals updated since the last rebuild.
+   */
+  std::vector<unsigned int> updated(contact* cntct = NULL) {
+    summary::counters const& c(summary::instance().get(cntct));
+    return (std::vector<unsigned int>(c.value, c.value + summary::counter_num));
+  }
+
+  /**
+   *  Get totals of all objects counted again.
+   */
+  std::vector<unsigned int> rebuilt(contact* cntct = NULL) {
+    summary::unload();
+    summary::load();
+    return (updated(cntct));
+  }
+
+protected:
+  contact             _contacts[2];
+  contactgroup        _group;
+  contactgroupsmember _group_member;
+  servicesmember      _host_services[2];
+  host                _hosts[2];
+  contactsmember      _members[3];
+  service             _services[3];
+};
+
+// Given checked and pending hosts and services
+// When totals are read
+// Then only checked objects are counted as up or ok
+TEST_F(MacrosSummary, Totals) {
+  _hosts[1].has_been_checked = false;
+  _services[2].has_been_checked = false;
+  std::vector<unsigned int> totals(updated());
+  ASSERT_EQ(totals[summary::hosts_up], 1u);
+  ASSERT_EQ(totals[summary::services_ok], 2u);
+  for (unsigned int i(0); i < summary::counter_num; ++i) {
+    if ((i != summary::hosts_up) && (i != summary::services_ok)) {
+      ASSERT_EQ(totals[i], 0u);
+    }
+  }
+}
+
+// Given counted services
+// When their status changes and they are updated
+// Then totals are the same as the ones of a rebuild
+TEST_F(MacrosSummary, ServiceUpdate) {
+  updated();
+  _services[0].current_state = STATE_CRITICAL;
+  summary::instance().update(&_services[0]);
+  _services[1].current_state = STATE_WARNING;
+  _services[1].problem_has_been_acknowledged = true;
+  summary::instance().update(&_services[1]);
+  _services[2].current_state = STATE_UNKNOWN;
+  _services[2].scheduled_downtime_depth = 1;
+  summary::instance().update(&_services[2]);
+
+  std::vector<unsigned int> totals(updated());
+  ASSERT_EQ(totals[summary::services_ok], 0u);
+  ASSERT_EQ(totals[summary::services_critical], 1u);
+  ASSERT_EQ(totals[summary::services_critical_unhandled], 1u);
+  ASSERT_EQ(totals[summary::services_warning], 1u);
+  ASSERT_EQ(totals[summary::services_warning_unhandled], 0u);
+  ASSERT_EQ(totals[summary::services_unknown], 1u);
+  ASSERT_EQ(totals[summary::services_unknown_unhandled], 0u);
+  ASSERT_EQ(totals, rebuilt());
+
+  // Back to ok.
+  _services[0].current_state = STATE_OK;
+  summary::instance().update(&_services[0]);
+  totals = updated();
+  ASSERT_EQ(totals[summary::services_ok], 1u);
+  ASSERT_EQ(totals[summary::services_critical], 0u);
+  ASSERT_EQ(totals[summary::services_critical_unhandled], 0u);
+  ASSERT_EQ(totals, rebuilt());
+}
+
+// Given a host with a critical service
+// When the host goes down and is updated
+// Then the service problem is not unhandled anymore
+TEST_F(MacrosSummary, HostDown) {
+  _services[0].current_state = STATE_CRITICAL;
+  ASSERT_EQ(updated()[summary::services_critical_unhandled], 1u);
+
+  _hosts[0].current_state = HOST_DOWN;
+  summary::instance().update(&_hosts[0]);
+  std::vector<unsigned int> totals(updated());
+  ASSERT_EQ(totals[summary::hosts_up], 1u);
+  ASSERT_EQ(totals[summary::hosts_down], 1u);
+  ASSERT_EQ(totals[summary::hosts_down_unhandled], 1u);
+  ASSERT_EQ(totals[summary::services_critical], 1u);
+  ASSERT_EQ(totals[summary::services_critical_unhandled], 0u);
+  ASSERT_EQ(totals, rebuilt());
+
+  _hosts[0].current_state = HOST_UNREACHABLE;
+  _hosts[0].problem_has_been_acknowledged = true;
+  summary::instance().update(&_hosts[0]);
+  totals = updated();
+  ASSERT_EQ(totals[summary::hosts_down], 0u);
+  ASSERT_EQ(totals[summary::hosts_unreachable], 1u);
+  ASSERT_EQ(totals[summary::hosts_unreachable_unhandled], 0u);
+  ASSERT_EQ(totals, rebuilt());
+}
+
+// Given contacts of objects, directly and through a contact group
+// When totals of a contact are read
+// Then only its objects are counted, once each
+TEST_F(MacrosSummary, Contacts) {
+  std::vector<unsigned int> first(updated(&_contacts[0]));
+  ASSERT_EQ(first[summary::hosts_up], 0u);
+  ASSERT_EQ(first[summary::services_ok], 1u);
+  std::vector<unsigned int> second(updated(&_contacts[1]));
+  ASSERT_EQ(second[summary::hosts_up], 1u);
+  ASSERT_EQ(second[summary::services_ok], 1u);
+
+  _services[2].current_state = STATE_CRITICAL;
+  summary::instance().update(&_services[2]);
+  second = updated(&_contacts[1]);
+  ASSERT_EQ(second[summary::services_ok], 0u);
+  ASSERT_EQ(second[summary::services_critical], 1u);
+  ASSERT_EQ(second[summary::services_critical_unhandled], 1u);
+  ASSERT_EQ(updated(&_contacts[0]), first);
+  ASSERT_EQ(second, rebuilt(&_contacts[1]));
+}
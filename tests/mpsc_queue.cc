@@ -0,0 +1,113 @@
+/*
+** Copyright 2017 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <gtest/gtest.h>
+#include <vector>
+#include "com/centreon/concurrency/thread.hh"
+#include "com/centreon/engine/mpsc_queue.hh"
+
+using namespace com::centreon;
+using namespace com::centreon::engine;
+
+struct node {
+  unsigned int producer;
+  unsigned int value;
+  node*        next;
+};
+
+class producer : public concurrency::thread {
+public:
+  producer(mpsc_queue<node>& q, unsigned int id, unsigned int count)
+    : _count(count), _id(id), _q(q) {}
+  ~producer() throw () {}
+
+private:
+  void _run() {
+    for (unsigned int i(0); i < _count; ++i) {
+      node* n(new node);
+      n->producer = _id;
+      n->value = i;
+      _q.push(n);
+    }
+  }
+
+  unsigned int      _count;
+  unsigned int      _id;
+  mpsc_queue<node>& _q;
+};
+
+// Given an empty queue
+// When pop_all() is called
+// Then NULL is returned
+TEST(MpscQueue, PopEmpty) {
+  mpsc_queue<node> q;
+  ASSERT_TRUE(q.empty());
+  ASSERT_EQ(q.pop_all(), (node*)NULL);
+}
+
+// Given a queue with nodes
+// When pop_all() is called
+// Then all nodes are returned in push order and the queue is empty
+TEST(MpscQueue, PopAllKeepsOrder) {
+  mpsc_queue<node> q;
+  node nodes[3];
+  for (unsigned int i(0); i < 3; ++i) {
+    nodes[i].value = i;
+    q.push(&nodes[i]);
+  }
+  ASSERT_FALSE(q.empty());
+  node* n(q.pop_all());
+  ASSERT_TRUE(q.empty());
+  for (unsigned int i(0); i < 3; ++i, n = n->next)
+    ASSERT_EQ(n, &nodes[i]);
+  ASSERT_EQ(n, (node*)NULL);
+}
+
+// Given 8 producers pushing nodes concurrently
+// When the consumer pops the nodes while they are pushed
+// Then every node is received once, in push order for each producer
+TEST(MpscQueue, MultipleProducers) {
+  unsigned int const producers(8);
+  unsigned int const count(20000);
+  mpsc_queue<node> q;
+  std::vector<producer*> threads;
+  for (unsigned int i(0); i < producers; ++i) {
+    threads.push_back(new producer(q, i, count));
+    threads.back()->exec();
+  }
+
+  std::vector<unsigned int> expected(producers, 0);
+  unsigned int received(0);
+  while (received < producers * count) {
+    for (node* n(q.pop_all()); n;) {
+      ASSERT_EQ(n->value, expected[n->producer]);
+      ++expected[n->producer];
+      ++received;
+      node* next(n->next);
+      delete n;
+      n = next;
+    }
+  }
+
+  for (unsigned int i(0); i < producers; ++i) {
+    threads[i]->wait();
+    delete threads[i];
+  }
+  ASSERT_TRUE(q.empty());
+}
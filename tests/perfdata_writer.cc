@@ -0,0 +1,152 @@
+/*
+** Copyright 2017 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstdio>
+#include <gtest/gtest.h>
+#include <string>
+#include "com/centreon/concurrency/thread.hh"
+#include "com/centreon/engine/perfdata_writer.hh"
+
+using namespace com::centreon;
+using namespace com::centreon::engine;
+
+/**
+ *  Get the content of a file.
+ */
+static std::string content(FILE* fp) {
+  std::string retval;
+  fflush(fp);
+  rewind(fp);
+  char buffer[256];
+  std::size_t size;
+  while ((size = fread(buffer, 1, sizeof(buffer), fp)))
+    retval.append(buffer, size);
+  fseek(fp, 0, SEEK_END);
+  return (retval);
+}
+
+/**
+ *  Push a line.
+ */
+static void push(perfdata_writer& w, char const* data) {
+  std::string line(data);
+  w.push(line);
+}
+
+// Given a writer with a flush interval of 0
+// When lines are pushed
+// Then they are written immediately
+TEST(PerfdataWriter, Unbuffered) {
+  FILE* fp(tmpfile());
+  ASSERT_TRUE(fp);
+  {
+    perfdata_writer w("test", 0, 65536, 65536);
+    w.attach(fp);
+    push(w, "line 1");
+    ASSERT_EQ(content(fp), "line 1\n");
+    push(w, "line 2");
+    ASSERT_EQ(content(fp), "line 1\nline 2\n");
+    perfdata_writer::stats s(w.get_stats());
+    ASSERT_EQ(s.lines, 2u);
+    ASSERT_EQ(s.writes, 2u);
+    ASSERT_EQ(w.detach(), fp);
+  }
+  fclose(fp);
+}
+
+// Given a writer with a long flush interval
+// When pushed lines reach the flush size
+// Then they are written in a single write
+TEST(PerfdataWriter, FlushSize) {
+  FILE* fp(tmpfile());
+  ASSERT_TRUE(fp);
+  {
+    perfdata_writer w("test", 60000, 14, 65536);
+    w.attach(fp);
+    push(w, "line 1");
+    concurrency::thread::msleep(50);
+    ASSERT_EQ(content(fp), "");
+    push(w, "line 2");
+    for (unsigned int i(0); (i < 100) && (w.get_stats().writes == 0); ++i)
+      concurrency::thread::msleep(10);
+    ASSERT_EQ(content(fp), "line 1\nline 2\n");
+    perfdata_writer::stats s(w.get_stats());
+    ASSERT_EQ(s.lines, 2u);
+    ASSERT_EQ(s.writes, 1u);
+    w.detach();
+  }
+  fclose(fp);
+}
+
+// Given a writer with a short flush interval
+// When a line is pushed
+// Then it is written once the interval elapsed
+TEST(PerfdataWriter, FlushInterval) {
+  FILE* fp(tmpfile());
+  ASSERT_TRUE(fp);
+  {
+    perfdata_writer w("test", 20, 65536, 65536);
+    w.attach(fp);
+    push(w, "line 1");
+    for (unsigned int i(0); (i < 100) && (w.get_stats().writes == 0); ++i)
+      concurrency::thread::msleep(10);
+    ASSERT_EQ(content(fp), "line 1\n");
+    w.detach();
+  }
+  fclose(fp);
+}
+
+// Given a writer without a file
+// When lines are pushed and a file is attached
+// Then the lines are written to the file
+TEST(PerfdataWriter, Detached) {
+  FILE* fp(tmpfile());
+  ASSERT_TRUE(fp);
+  {
+    perfdata_writer w("test", 0, 65536, 65536);
+    push(w, "line 1");
+    push(w, "line 2");
+    w.flush();
+    ASSERT_EQ(w.get_stats().lines, 0u);
+    w.attach(fp);
+    ASSERT_EQ(content(fp), "line 1\nline 2\n");
+    ASSERT_EQ(w.get_stats().writes, 1u);
+    w.detach();
+  }
+  fclose(fp);
+}
+
+// Given a writer without a file and a small maximum size
+// When more lines are pushed than it can keep
+// Then the oldest ones are dropped
+TEST(PerfdataWriter, DetachedOverflow) {
+  FILE* fp(tmpfile());
+  ASSERT_TRUE(fp);
+  {
+    perfdata_writer w("test", 0, 65536, 14);
+    push(w, "line 1");
+    push(w, "line 2");
+    push(w, "line 3");
+    w.attach(fp);
+    ASSERT_EQ(content(fp), "line 2\nline 3\n");
+    ASSERT_EQ(w.get_stats().lines, 2u);
+    w.detach();
+  }
+  fclose(fp);
+}
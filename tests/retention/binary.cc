@@ -0,0 +1,129 @@
+/*
+** Copyright 2017 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include "com/centreon/engine/error.hh"
+#include "com/centreon/engine/retention/binary.hh"
+
+using namespace com::centreon::engine;
+using namespace com::centreon::engine::retention;
+
+static char const* const path("/tmp/centengine_binary_retention");
+
+// Given objects written through a binary writer
+// When the file is read back
+// Then records hold the types, keys and values of the objects
+TEST(RetentionBinary, RoundTrip) {
+  {
+    binary::writer writer(path);
+    writer.begin("info");
+    writer.field("created") << 12345;
+    writer.end();
+    writer.begin("service");
+    writer.field("host_name") << "h1";
+    writer.field("plugin_output");
+    writer.field("service_description") << "s " << 1;
+    writer.end();
+    writer.commit();
+  }
+  ASSERT_TRUE(binary::is_binary(path));
+
+  binary::reader reader(path);
+  ASSERT_EQ(reader.size(), 2u);
+  binary::reader::fields f;
+  ASSERT_STREQ(reader.get(0, f), "info");
+  ASSERT_EQ(f.size(), 1u);
+  ASSERT_STREQ(f[0].first, "created");
+  ASSERT_STREQ(f[0].second, "12345");
+  ASSERT_STREQ(reader.get(1, f), "service");
+  ASSERT_EQ(f.size(), 3u);
+  ASSERT_STREQ(f[0].first, "host_name");
+  ASSERT_STREQ(f[0].second, "h1");
+  ASSERT_STREQ(f[1].first, "plugin_output");
+  ASSERT_STREQ(f[1].second, "");
+  ASSERT_STREQ(f[2].first, "service_description");
+  ASSERT_STREQ(f[2].second, "s 1");
+  remove(path);
+}
+
+// Given records built in a buffer
+// When they are appended to a binary writer before other objects
+// Then all of them are read back in order
+TEST(RetentionBinary, Append) {
+  {
+    binary::buffer head;
+    head.begin("info");
+    head.field("created") << 1;
+    head.end();
+    head.begin("program");
+    head.end();
+    ASSERT_EQ(head.count(), 2u);
+    binary::writer writer(path);
+    writer.append(head.data());
+    writer.begin("host");
+    writer.field("host_name") << "h1";
+    writer.end();
+    writer.commit();
+  }
+  binary::reader reader(path);
+  ASSERT_EQ(reader.size(), 3u);
+  binary::reader::fields f;
+  ASSERT_STREQ(reader.get(0, f), "info");
+  ASSERT_STREQ(reader.get(1, f), "program");
+  ASSERT_TRUE(f.empty());
+  ASSERT_STREQ(reader.get(2, f), "host");
+  ASSERT_EQ(f.size(), 1u);
+  ASSERT_STREQ(f[0].second, "h1");
+  remove(path);
+}
+
+// Given a binary writer that is not committed
+// When it is destroyed
+// Then the target file is not created
+TEST(RetentionBinary, NoCommit) {
+  remove(path);
+  {
+    binary::writer writer(path);
+    writer.begin("info");
+    writer.field("created") << 1;
+    writer.end();
+  }
+  std::ifstream stream(path);
+  ASSERT_FALSE(stream.is_open());
+}
+
+// Given a truncated binary retention file
+// When it is read
+// Then an error is thrown
+TEST(RetentionBinary, Truncated) {
+  {
+    binary::writer writer(path);
+    writer.begin("info");
+    writer.field("created") << 1;
+    writer.end();
+    writer.commit();
+  }
+  ASSERT_TRUE(truncate(path, 30) == 0);
+  ASSERT_THROW(binary::reader reader(path), error);
+  remove(path);
+}
@@ -0,0 +1,122 @@
+/*
+** Copyright 2017 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "com/centreon/concurrency/thread.hh"
+#include "com/centreon/engine/configuration/state.hh"
+#include "com/centreon/engine/globals.hh"
+#include "com/centreon/engine/snapshot.hh"
+#include "com/centreon/engine/snapshot_writer.hh"
+
+using namespace com::centreon;
+using namespace com::centreon::engine;
+
+static std::vector<std::string> written;
+
+static bool slow_write(snapshot const& snap, std::string const& path) {
+  (void)path;
+  concurrency::thread::msleep(100);
+  written.push_back(snap.head());
+  return (true);
+}
+
+class SnapshotWriter : public ::testing::Test {
+public:
+  void SetUp() {
+    written.clear();
+    config = new configuration::state;
+    snapshot_writer::load();
+  }
+
+  void TearDown() {
+    snapshot_writer::unload();
+    delete config;
+    config = NULL;
+  }
+};
+
+// Given a snapshot writer
+// When a snapshot is pushed and the writer is flushed
+// Then the snapshot is written with its head
+TEST_F(SnapshotWriter, Flush) {
+  snapshot_writer::instance().push(
+    snapshot_writer::status_file,
+    new snapshot("status"),
+    &slow_write,
+    "/dev/null");
+  snapshot_writer::instance().flush();
+  ASSERT_EQ(written.size(), 1u);
+  ASSERT_EQ(written[0], "status");
+  snapshot_writer::stats
+    s(snapshot_writer::instance().get_stats(snapshot_writer::status_file));
+  ASSERT_EQ(s.dropped, 0u);
+  ASSERT_GE(s.snapshot_size, 6u);
+  ASSERT_GT(s.write_time, 0u);
+}
+
+// Given a snapshot writer busy writing a snapshot
+// When two other snapshots of the same file are pushed
+// Then the first waiting one is dropped and the last one is written
+TEST_F(SnapshotWriter, DropWaiting) {
+  snapshot_writer::instance().push(
+    snapshot_writer::retention_file,
+    new snapshot("1"),
+    &slow_write,
+    "/dev/null");
+  concurrency::thread::msleep(20);
+  snapshot_writer::instance().push(
+    snapshot_writer::retention_file,
+    new snapshot("2"),
+    &slow_write,
+    "/dev/null");
+  snapshot_writer::instance().push(
+    snapshot_writer::retention_file,
+    new snapshot("3"),
+    &slow_write,
+    "/dev/null");
+  snapshot_writer::instance().flush();
+  ASSERT_EQ(written.size(), 2u);
+  ASSERT_EQ(written[0], "1");
+  ASSERT_EQ(written[1], "3");
+  ASSERT_EQ(
+    snapshot_writer::instance().get_stats(
+      snapshot_writer::retention_file).dropped,
+    1u);
+}
+
+// Given a snapshot taken with some retention settings
+// When the configuration is reloaded with other settings
+// Then the snapshot keeps the settings it was taken with
+TEST_F(SnapshotWriter, Settings) {
+  config->retained_contact_host_attribute_mask(1);
+  config->retained_host_attribute_mask(2);
+  config->use_binary_state_retention(true);
+  snapshot snap("");
+
+  delete config;
+  config = new configuration::state;
+  config->retained_contact_host_attribute_mask(4);
+  config->retained_host_attribute_mask(8);
+  config->use_binary_state_retention(false);
+  ASSERT_EQ(snap.retained_contact_host_attribute_mask(), 1u);
+  ASSERT_EQ(snap.retained_host_attribute_mask(), 2u);
+  ASSERT_TRUE(snap.use_binary_state_retention());
+}
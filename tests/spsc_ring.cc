@@ -0,0 +1,124 @@
+/*
+** Copyright 2017 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <gtest/gtest.h>
+#include <string>
+#include "com/centreon/concurrency/thread.hh"
+#include "com/centreon/engine/spsc_ring.hh"
+
+using namespace com::centreon;
+using namespace com::centreon::engine;
+
+struct slot {
+  unsigned int value;
+  std::string  data;
+};
+
+class ring_producer : public concurrency::thread {
+public:
+  ring_producer(spsc_ring<slot>& r, unsigned int count)
+    : _count(count), _r(r) {}
+  ~ring_producer() throw () {}
+
+private:
+  void _run() {
+    for (unsigned int i(0); i < _count; ++i) {
+      slot* s;
+      while (!(s = _r.back()))
+        concurrency::thread::yield();
+      s->value = i;
+      s->data.assign(i % 64, 'x');
+      _r.push();
+    }
+  }
+
+  unsigned int     _count;
+  spsc_ring<slot>& _r;
+};
+
+// Given an empty ring
+// When front() is called
+// Then NULL is returned
+TEST(SpscRing, FrontEmpty) {
+  spsc_ring<slot> r(4);
+  ASSERT_EQ(r.size(), 0u);
+  ASSERT_EQ(r.front(), (slot*)NULL);
+}
+
+// Given a ring with as many pushed slots as its capacity
+// When back() is called
+// Then NULL is returned until a slot is popped
+TEST(SpscRing, BackFull) {
+  spsc_ring<slot> r(3);
+  ASSERT_EQ(r.capacity(), 3u);
+  for (unsigned int i(0); i < 3; ++i) {
+    slot* s(r.back());
+    ASSERT_NE(s, (slot*)NULL);
+    s->value = i;
+    r.push();
+  }
+  ASSERT_EQ(r.size(), 3u);
+  ASSERT_EQ(r.back(), (slot*)NULL);
+  ASSERT_EQ(r.front()->value, 0u);
+  r.pop();
+  ASSERT_NE(r.back(), (slot*)NULL);
+}
+
+// Given a ring whose slots were used
+// When slots are reused
+// Then they are returned in push order with their previous memory
+TEST(SpscRing, SlotsAreReused) {
+  spsc_ring<slot> r(2);
+  slot* first(r.back());
+  first->data = "first";
+  r.push();
+  r.front();
+  r.pop();
+  r.back();
+  r.push();
+  r.front();
+  r.pop();
+  ASSERT_EQ(r.back(), first);
+  ASSERT_EQ(first->data, "first");
+}
+
+// Given a producer filling a small ring concurrently
+// When the consumer pops the slots while they are pushed
+// Then every slot is received once, in push order
+TEST(SpscRing, ConcurrentProducer) {
+  unsigned int const count(20000);
+  spsc_ring<slot> r(16);
+  ring_producer p(r, count);
+  p.exec();
+
+  for (unsigned int expected(0); expected < count;) {
+    slot* s(r.front());
+    if (!s) {
+      concurrency::thread::yield();
+      continue ;
+    }
+    ASSERT_EQ(s->value, expected);
+    ASSERT_EQ(s->data.size(), expected % 64);
+    r.pop();
+    ++expected;
+  }
+
+  p.wait();
+  ASSERT_EQ(r.size(), 0u);
+}
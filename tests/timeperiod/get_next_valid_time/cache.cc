@@ -0,0 +1,167 @@
+/*
+** Copyright 2017 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <gtest/gtest.h>
+#include <vector>
+#include "com/centreon/engine/objects/timeperiod.hh"
+#include "com/centreon/engine/timeperiod.hh"
+#include "tests/timeperiod/utils.hh"
+
+using namespace com::centreon::engine;
+
+class        GetNextValidTimeCache : public ::testing::Test {
+ public:
+  void       SetUp() {
+    _tp = _creator.new_timeperiod();
+  }
+
+  /**
+   *  Get next valid times computed without the cache. The cache only
+   *  answers from its first day, times before are computed.
+   */
+  std::vector<time_t> uncached(time_t from, time_t to, time_t step) {
+    clear_timeperiod_cache();
+    time_t computed;
+    set_time(to + 30 * 24 * 60 * 60);
+    get_next_valid_time(to + 30 * 24 * 60 * 60, &computed, _tp);
+
+    std::vector<time_t> retval;
+    for (time_t t(from); t < to; t += step) {
+      set_time(t);
+      get_next_valid_time(t, &computed, _tp);
+      retval.push_back(computed);
+    }
+    clear_timeperiod_cache();
+    return (retval);
+  }
+
+  /**
+   *  Get next valid times as time goes on, from a cache built at the
+   *  first time.
+   */
+  std::vector<time_t> cached(time_t from, time_t to, time_t step) {
+    std::vector<time_t> retval;
+    for (time_t t(from); t < to; t += step) {
+      time_t computed;
+      set_time(t);
+      get_next_valid_time(t, &computed, _tp);
+      retval.push_back(computed);
+    }
+    return (retval);
+  }
+
+ protected:
+  timeperiod_creator _creator;
+  timeperiod*        _tp;
+};
+
+// Given a timeperiod with time ranges on both sides of DST changes
+// When next valid times are computed around the DST changes
+// Then cached and computed next valid times are the same
+TEST_F(GetNextValidTimeCache, DST) {
+  for (int i(0); i < 7; ++i) {
+    _creator.new_timerange(1, 0, 2, 0, i);
+    _creator.new_timerange(3, 0, 4, 0, i);
+    _creator.new_timerange(18, 30, 19, 0, i);
+  }
+  time_t from(strtotimet("2017-03-24 00:00:00"));
+  time_t to(strtotimet("2017-03-29 00:00:00"));
+  ASSERT_EQ(cached(from, to, 600), uncached(from, to, 600));
+  from = strtotimet("2017-10-27 00:00:00");
+  to = strtotimet("2017-11-01 00:00:00");
+  ASSERT_EQ(cached(from, to, 600), uncached(from, to, 600));
+}
+
+// Given a timeperiod with full and partial days excluded
+// When next valid times are computed around the exclusions
+// Then cached and computed next valid times are the same
+TEST_F(GetNextValidTimeCache, Exclusion) {
+  for (int i(1); i < 6; ++i)
+    _creator.new_timerange(8, 0, 18, 0, i);
+  timeperiod* holidays(_creator.new_timeperiod());
+  daterange* dr(_creator.new_calendar_date(2016, 11, 26, 2016, 11, 26));
+  _creator.new_timerange(0, 0, 24, 0, dr);
+  dr = _creator.new_calendar_date(2016, 11, 28, 2016, 11, 30);
+  _creator.new_timerange(12, 0, 14, 0, dr);
+  _creator.new_exclusion(holidays, _tp);
+  time_t from(strtotimet("2016-12-22 00:00:00"));
+  time_t to(strtotimet("2017-01-04 00:00:00"));
+  ASSERT_EQ(cached(from, to, 900), uncached(from, to, 900));
+}
+
+// Given a timeperiod and a cache built for the next days
+// When next valid times are computed past these days
+// Then cached and computed next valid times are the same
+TEST_F(GetNextValidTimeCache, PastHorizon) {
+  _creator.new_timerange(9, 0, 12, 0, 1);
+  _creator.new_timerange(14, 0, 17, 0, 4);
+  time_t from(strtotimet("2017-05-01 00:00:00"));
+  time_t to(strtotimet("2017-05-31 00:00:00"));
+  ASSERT_EQ(cached(from, to, 1800), uncached(from, to, 1800));
+}
+
+// Given a timeperiod whose next valid time is weeks ahead
+// When the next valid time is computed
+// Then it is the same as without the cache
+TEST_F(GetNextValidTimeCache, NoValidTimeWithinHorizon) {
+  daterange* dr(_creator.new_calendar_date(2017, 5, 15, 2017, 5, 15));
+  _creator.new_timerange(10, 0, 11, 0, dr);
+  time_t from(strtotimet("2017-06-01 00:00:00"));
+  time_t to(strtotimet("2017-06-03 00:00:00"));
+  std::vector<time_t> computed(uncached(from, to, 3600));
+  ASSERT_EQ(cached(from, to, 3600), computed);
+  ASSERT_EQ(computed.front(), strtotimet("2017-06-15 10:00:00"));
+}
+
+// Given a timeperiod whose next valid times are cached
+// When the timeperiod is modified and the cache cleared
+// Then next valid times are the ones of the modified timeperiod
+TEST_F(GetNextValidTimeCache, Cleared) {
+  _creator.new_timerange(9, 0, 12, 0, 1);
+  time_t from(strtotimet("2017-05-01 00:00:00"));
+  time_t to(strtotimet("2017-05-08 00:00:00"));
+  std::vector<time_t> before(cached(from, to, 1800));
+
+  _creator.new_timerange(14, 0, 17, 0, 3);
+  clear_timeperiod_cache();
+  std::vector<time_t> after(cached(from, to, 1800));
+  ASSERT_NE(after, before);
+  ASSERT_EQ(after, uncached(from, to, 1800));
+}
+
+// Given a timeperiod whose next valid times are cached for the current
+// days
+// When a next valid time is computed months ahead
+// Then the current days are still answered from the cache
+TEST_F(GetNextValidTimeCache, FarQueryKeepsCurrentDays) {
+  for (int i(0); i < 7; ++i)
+    _creator.new_timerange(9, 0, 12, 0, i);
+  time_t from(strtotimet("2017-05-01 00:00:00"));
+  time_t to(strtotimet("2017-05-04 00:00:00"));
+  std::vector<time_t> before(cached(from, to, 1800));
+
+  time_t computed;
+  get_next_valid_time(strtotimet("2017-08-01 00:00:00"), &computed, _tp);
+  ASSERT_EQ(computed, strtotimet("2017-08-01 09:00:00"));
+
+  // Not clearing the cache shows which days it still holds.
+  _creator.new_timerange(14, 0, 17, 0, 3);
+  ASSERT_EQ(cached(from, to, 1800), before);
+  ASSERT_NE(uncached(from, to, 1800), before);
+}
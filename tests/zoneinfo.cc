@@ -0,0 +1,124 @@
+/*
+** Copyright 2017 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <gtest/gtest.h>
+#include <string>
+#include "com/centreon/engine/zoneinfo.hh"
+
+using namespace com::centreon::engine;
+
+/**
+ *  Build a broken-down local time.
+ */
+static struct tm make_tm(int year, int mon, int mday, int hour, int min) {
+  struct tm t;
+  memset(&t, 0, sizeof(t));
+  t.tm_year = year - 1900;
+  t.tm_mon = mon - 1;
+  t.tm_mday = mday;
+  t.tm_hour = hour;
+  t.tm_min = min;
+  t.tm_isdst = -1;
+  return (t);
+}
+
+// Given the process timezone
+// When times of a year are converted
+// Then results are the same as localtime_r() and mktime()
+TEST(Zoneinfo, SameAsLibc) {
+  zoneinfo const& zone(zoneinfo::find(NULL));
+  for (time_t t(1451606400); t < 1483228800; t += 30 * 60) {
+    struct tm expected;
+    struct tm computed;
+    localtime_r(&t, &expected);
+    zone.localtime(t, &computed);
+    ASSERT_EQ(computed.tm_year, expected.tm_year);
+    ASSERT_EQ(computed.tm_yday, expected.tm_yday);
+    ASSERT_EQ(computed.tm_hour, expected.tm_hour);
+    ASSERT_EQ(computed.tm_min, expected.tm_min);
+    ASSERT_EQ(computed.tm_wday, expected.tm_wday);
+    ASSERT_EQ(computed.tm_isdst, expected.tm_isdst);
+
+    computed.tm_isdst = -1;
+    expected.tm_isdst = -1;
+    ASSERT_EQ(zone.mktime(&computed), mktime(&expected));
+  }
+}
+
+// Given the Europe/Paris zone
+// When nonexistent and ambiguous local times are converted
+// Then they are resolved like the GNU C library does
+TEST(Zoneinfo, DstTransitions) {
+  zoneinfo const& zone(zoneinfo::find(":Europe/Paris"));
+  struct tm t(make_tm(2016, 3, 27, 2, 30));
+  ASSERT_EQ(zone.mktime(&t), 1459042200);
+  ASSERT_EQ(t.tm_hour, 3);
+  ASSERT_EQ(t.tm_isdst, 1);
+  t = make_tm(2016, 10, 30, 2, 30);
+  ASSERT_EQ(zone.mktime(&t), 1477787400);
+  ASSERT_EQ(t.tm_isdst, 1);
+  t = make_tm(2016, 10, 30, 2, 30);
+  t.tm_isdst = 0;
+  ASSERT_EQ(zone.mktime(&t), 1477791000);
+}
+
+// Given a zone other than the process one
+// When a time is converted
+// Then the TZ environment variable is unchanged
+TEST(Zoneinfo, NoEnvironmentChange) {
+  char const* tz(getenv("TZ"));
+  std::string before(tz ? tz : "");
+  zoneinfo const& zone(zoneinfo::find(":America/New_York"));
+  struct tm t;
+  zone.localtime(1467374400, &t);
+  ASSERT_EQ(t.tm_hour, 8);
+  ASSERT_EQ(t.tm_isdst, 1);
+  tz = getenv("TZ");
+  ASSERT_EQ(std::string(tz ? tz : ""), before);
+}
+
+// Given a POSIX TZ string
+// When times are converted
+// Then its rules are applied
+TEST(Zoneinfo, PosixString) {
+  zoneinfo const& zone(zoneinfo::find("XST5XDT,M3.2.0,M11.1.0"));
+  struct tm t;
+  zone.localtime(1467374400, &t);
+  ASSERT_EQ(t.tm_hour, 8);
+  ASSERT_EQ(t.tm_isdst, 1);
+  zone.localtime(1451649600, &t);
+  ASSERT_EQ(t.tm_hour, 7);
+  ASSERT_EQ(t.tm_isdst, 0);
+  t = make_tm(2016, 7, 1, 8, 0);
+  ASSERT_EQ(zone.mktime(&t), 1467374400);
+}
+
+// Given an unknown zone
+// When a time is converted
+// Then UTC is used
+TEST(Zoneinfo, UnknownIsUTC) {
+  zoneinfo const& zone(zoneinfo::find("Nowhere/Unknown"));
+  struct tm t;
+  zone.localtime(1467374400, &t);
+  ASSERT_EQ(t.tm_hour, 12);
+  ASSERT_EQ(t.tm_isdst, 0);
+}